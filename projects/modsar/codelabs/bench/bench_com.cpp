@@ -0,0 +1,454 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 各 binding 的时延和吞吐基准 结果按 HDR 直方图输出 JSON 用于回归对比
+ * \author ZYL
+ * \date 2026/10/18
+ *
+ * g++ -O2 -std=c++14 -pthread -I../../include bench_com.cpp ../../sources/ara/com/trace/latency_histogram.cpp ../../sources/ara/com/event/token_bucket.cpp
+ * ./a.out --transport inproc,tcp --test pingpong --sizes 8,4096,1048576 --json result.json
+ *
+ * 测试项
+ * - pingpong   方法调用 请求到达后对端立即回复 记录往返时延
+ * - throughput event 单订阅者 发布端全速发送 记录吞吐和单向时延
+ * - fanout     event 多订阅者 发布端按固定频率发送 记录每个订阅者的单向时延
+ * 每个消息的前 8 字节是发送时间 所以 payload 最小 8 字节
+ *
+ * 传输
+ * - inproc 进程内 EventDistributor 传 shared_ptr 不拷贝
+ * - uds    unix domain socket 本机 binding 的通道
+ * - udp    UDP 回环 SOME/IP over UDP 的内核路径 最大 65507 字节 可能丢包
+ * - tcp    TCP 回环 SOME/IP over TCP 的内核路径
+ * 其他 binding 实现 bench::Transport 后加到 CreateTransport 即可参与对比
+ */
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <thread>
+
+#include "ara/com/trace/latency_histogram.h"
+#include "bench_transport.h"
+#include "inproc_transport.hpp"
+#include "socket_transport.hpp"
+
+using ara::com::trace::LatencyHistogram;
+using ara::com::trace::LatencySummary;
+
+namespace bench
+{
+    std::unique_ptr<Transport> CreateTransport(const std::string &name)
+    {
+        if (name == "inproc")
+        {
+            return std::unique_ptr<Transport>(new InprocTransport());
+        }
+        if (name == "uds")
+        {
+            return std::unique_ptr<Transport>(new StreamTransport(false));
+        }
+        if (name == "udp")
+        {
+            return std::unique_ptr<Transport>(new UdpTransport());
+        }
+        if (name == "tcp")
+        {
+            return std::unique_ptr<Transport>(new StreamTransport(true));
+        }
+        return nullptr;
+    }
+
+    std::vector<std::string> TransportNames()
+    {
+        return {"inproc", "uds", "udp", "tcp"};
+    }
+} // namespace bench
+
+using namespace bench;
+
+namespace
+{
+    const int64_t kTakeTimeoutNs = 200 * 1000 * 1000;
+    const size_t kBytesPerCase = 256 * 1024 * 1024; // 每个用例大约传输的数据量 决定大 payload 的迭代次数
+
+    struct Options
+    {
+        std::vector<std::string> transports = TransportNames();
+        std::vector<std::string> tests = {"pingpong", "throughput", "fanout"};
+        std::vector<size_t> sizes = {8, 64, 512, 4096, 32768, 262144, 1048576, 8388608};
+        size_t subscribers = 4;
+        size_t maxIterations = 10000;
+        int64_t durationMs = 1000;
+        double fanoutRate = 1000.0;
+        std::string json;
+    };
+
+    struct CaseResult
+    {
+        std::string transport;
+        std::string test;
+        size_t payload = 0;
+        size_t subscribers = 0;
+        uint64_t sent = 0;
+        uint64_t received = 0;
+        double seconds = 0.0;
+        std::unique_ptr<LatencyHistogram> latency{new LatencyHistogram()};
+    };
+
+    std::vector<std::string> split(const std::string &text)
+    {
+        std::vector<std::string> parts;
+        std::stringstream stream(text);
+        std::string part;
+        while (std::getline(stream, part, ','))
+        {
+            if (!part.empty())
+            {
+                parts.push_back(part);
+            }
+        }
+        return parts;
+    }
+
+    size_t iterationsFor(const Options &options, size_t payload, size_t copies)
+    {
+        const size_t budget = kBytesPerCase / (payload * copies);
+        return std::max<size_t>(50, std::min(options.maxIterations, budget));
+    }
+
+    void stampAndSend(Publisher &publisher, size_t payload)
+    {
+        uint8_t *buffer = publisher.Loan(payload);
+        const int64_t now = NowNs();
+        std::memcpy(buffer, &now, sizeof(now));
+        publisher.Send(payload);
+    }
+
+    int64_t stampOf(const uint8_t *data)
+    {
+        int64_t stamp;
+        std::memcpy(&stamp, data, sizeof(stamp));
+        return stamp;
+    }
+
+    bool runPingPong(Transport &transport, const Options &options, CaseResult &result)
+    {
+        std::unique_ptr<Publisher> request;
+        std::unique_ptr<Publisher> response;
+        std::vector<std::unique_ptr<Subscriber>> requestSide;
+        std::vector<std::unique_ptr<Subscriber>> responseSide;
+        if (!transport.CreateChannel(1, result.payload, request, requestSide) ||
+            !transport.CreateChannel(1, result.payload, response, responseSide))
+        {
+            return false;
+        }
+        std::atomic<bool> stop(false);
+        std::thread server([&]
+                           {
+                               while (!stop.load(std::memory_order_relaxed))
+                               {
+                                   size_t length = 0;
+                                   const uint8_t *data = requestSide[0]->Take(length, kTakeTimeoutNs);
+                                   if (data == nullptr)
+                                   {
+                                       continue;
+                                   }
+                                   uint8_t *reply = response->Loan(length);
+                                   std::memcpy(reply, data, sizeof(int64_t));
+                                   response->Send(length);
+                               } });
+
+        const size_t iterations = iterationsFor(options, result.payload, 2);
+        const size_t warmup = iterations / 10;
+        const int64_t begin = NowNs();
+        for (size_t i = 0; i < warmup + iterations; ++i)
+        {
+            stampAndSend(*request, result.payload);
+            size_t length = 0;
+            const uint8_t *data = responseSide[0]->Take(length, kTakeTimeoutNs);
+            if (i < warmup)
+            {
+                continue;
+            }
+            ++result.sent;
+            if (data != nullptr)
+            {
+                result.latency->Record(static_cast<uint64_t>(NowNs() - stampOf(data)));
+                ++result.received;
+            }
+        }
+        result.seconds = static_cast<double>(NowNs() - begin) / 1e9;
+        stop.store(true, std::memory_order_relaxed);
+        server.join();
+        return true;
+    }
+
+    /**
+     * \brief 接收线程 直到 stop 后再等不到消息为止
+     */
+    void receiveUntilStopped(Subscriber &subscriber, const std::atomic<bool> &stop, LatencyHistogram &latency,
+                             std::atomic<uint64_t> &received)
+    {
+        for (;;)
+        {
+            size_t length = 0;
+            const uint8_t *data = subscriber.Take(length, stop.load(std::memory_order_acquire) ? kTakeTimeoutNs / 10 : kTakeTimeoutNs);
+            if (data == nullptr)
+            {
+                if (stop.load(std::memory_order_acquire))
+                {
+                    return;
+                }
+                continue;
+            }
+            latency.Record(static_cast<uint64_t>(NowNs() - stampOf(data)));
+            received.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    bool runThroughput(Transport &transport, const Options &options, CaseResult &result)
+    {
+        std::unique_ptr<Publisher> publisher;
+        std::vector<std::unique_ptr<Subscriber>> subscribers;
+        if (!transport.CreateChannel(1, result.payload, publisher, subscribers))
+        {
+            return false;
+        }
+        std::atomic<bool> stop(false);
+        std::atomic<uint64_t> received(0);
+        std::thread receiver([&]
+                             { receiveUntilStopped(*subscribers[0], stop, *result.latency, received); });
+
+        const int64_t begin = NowNs();
+        const int64_t end = begin + options.durationMs * 1000000;
+        while (NowNs() < end)
+        {
+            stampAndSend(*publisher, result.payload);
+            ++result.sent;
+        }
+        result.seconds = static_cast<double>(NowNs() - begin) / 1e9;
+        stop.store(true, std::memory_order_release);
+        receiver.join();
+        result.received = received.load(std::memory_order_relaxed);
+        return true;
+    }
+
+    bool runFanOut(Transport &transport, const Options &options, CaseResult &result)
+    {
+        std::unique_ptr<Publisher> publisher;
+        std::vector<std::unique_ptr<Subscriber>> subscribers;
+        if (!transport.CreateChannel(options.subscribers, result.payload, publisher, subscribers))
+        {
+            return false;
+        }
+        std::atomic<bool> stop(false);
+        std::atomic<uint64_t> received(0);
+        std::vector<std::thread> receivers;
+        for (std::unique_ptr<Subscriber> &subscriber : subscribers)
+        {
+            Subscriber *current = subscriber.get();
+            receivers.emplace_back([&, current]
+                                   { receiveUntilStopped(*current, stop, *result.latency, received); });
+        }
+
+        // 固定频率发送 时延不包含发布端积压
+        const size_t count = iterationsFor(options, result.payload, options.subscribers);
+        const std::chrono::nanoseconds period(static_cast<int64_t>(1e9 / options.fanoutRate));
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < count; ++i)
+        {
+            std::this_thread::sleep_until(start + period * static_cast<int64_t>(i));
+            stampAndSend(*publisher, result.payload);
+            result.sent += options.subscribers;
+        }
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        stop.store(true, std::memory_order_release);
+        for (std::thread &receiver : receivers)
+        {
+            receiver.join();
+        }
+        result.received = received.load(std::memory_order_relaxed);
+        return true;
+    }
+
+    void printRow(const CaseResult &result)
+    {
+        const LatencySummary summary = result.latency->Summarize();
+        const double messagesPerSecond = result.seconds > 0.0 ? static_cast<double>(result.received) / result.seconds : 0.0;
+        printf("%-7s %-10s %9zu %4zu %10.0f %10.1f %9.1f %9.1f %9.1f %9.1f %9.1f %6.2f%%\n", result.transport.c_str(),
+               result.test.c_str(), result.payload, result.subscribers, messagesPerSecond,
+               messagesPerSecond * static_cast<double>(result.payload) / 1e6, summary.min / 1e3, summary.p50 / 1e3,
+               summary.p99 / 1e3, summary.p999 / 1e3, summary.max / 1e3,
+               result.sent != 0 ? 100.0 * static_cast<double>(result.sent - std::min(result.sent, result.received)) / static_cast<double>(result.sent) : 0.0);
+        fflush(stdout);
+    }
+
+    /**
+     * \brief 每个用例一个对象 histogram 是非空桶的 [桶上界 ns, 计数] 可以还原任意分位数
+     */
+    void writeJson(FILE *file, const std::vector<CaseResult> &results)
+    {
+        fprintf(file, "{\n  \"unit\": \"ns\",\n  \"results\": [");
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const CaseResult &result = results[i];
+            const LatencySummary summary = result.latency->Summarize();
+            fprintf(file, "%s\n    {\"transport\": \"%s\", \"test\": \"%s\", \"payload\": %zu, \"subscribers\": %zu, ", i == 0 ? "" : ",",
+                    result.transport.c_str(), result.test.c_str(), result.payload, result.subscribers);
+            fprintf(file, "\"sent\": %llu, \"received\": %llu, \"seconds\": %.6f,\n", static_cast<unsigned long long>(result.sent),
+                    static_cast<unsigned long long>(result.received), result.seconds);
+            fprintf(file,
+                    "     \"latency\": {\"count\": %llu, \"min\": %llu, \"mean\": %llu, \"p50\": %llu, \"p90\": %llu, \"p99\": %llu, "
+                    "\"p999\": %llu, \"max\": %llu},\n",
+                    static_cast<unsigned long long>(summary.count), static_cast<unsigned long long>(summary.min),
+                    static_cast<unsigned long long>(summary.mean), static_cast<unsigned long long>(summary.p50),
+                    static_cast<unsigned long long>(summary.p90), static_cast<unsigned long long>(summary.p99),
+                    static_cast<unsigned long long>(summary.p999), static_cast<unsigned long long>(summary.max));
+            fprintf(file, "     \"histogram\": [");
+            bool first = true;
+            for (size_t bucket = 0; bucket < LatencyHistogram::kBucketCount; ++bucket)
+            {
+                const uint64_t count = result.latency->BucketValueCount(bucket);
+                if (count != 0)
+                {
+                    fprintf(file, "%s[%llu, %llu]", first ? "" : ", ",
+                            static_cast<unsigned long long>(LatencyHistogram::BucketUpperBound(bucket)), static_cast<unsigned long long>(count));
+                    first = false;
+                }
+            }
+            fprintf(file, "]}");
+        }
+        fprintf(file, "\n  ]\n}\n");
+    }
+
+    bool parseOptions(int argc, char **argv, Options &options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string name = argv[i];
+            if (i + 1 >= argc)
+            {
+                return false;
+            }
+            const std::string value = argv[++i];
+            if (name == "--transport")
+            {
+                options.transports = split(value);
+            }
+            else if (name == "--test")
+            {
+                options.tests = split(value);
+            }
+            else if (name == "--sizes")
+            {
+                options.sizes.clear();
+                for (const std::string &size : split(value))
+                {
+                    options.sizes.push_back(std::max<size_t>(sizeof(int64_t), std::strtoull(size.c_str(), nullptr, 10)));
+                }
+            }
+            else if (name == "--subscribers")
+            {
+                options.subscribers = std::max<size_t>(1, std::strtoull(value.c_str(), nullptr, 10));
+            }
+            else if (name == "--iterations")
+            {
+                options.maxIterations = std::max<size_t>(1, std::strtoull(value.c_str(), nullptr, 10));
+            }
+            else if (name == "--duration-ms")
+            {
+                options.durationMs = std::max<int64_t>(1, std::strtoll(value.c_str(), nullptr, 10));
+            }
+            else if (name == "--rate")
+            {
+                options.fanoutRate = std::max(1.0, std::strtod(value.c_str(), nullptr));
+            }
+            else if (name == "--json")
+            {
+                options.json = value;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        fprintf(stderr, "usage: %s [--transport inproc,uds,udp,tcp] [--test pingpong,throughput,fanout] [--sizes 8,4096]\n"
+                        "          [--subscribers 4] [--iterations 10000] [--duration-ms 1000] [--rate 1000] [--json file]\n",
+                argv[0]);
+        return 1;
+    }
+
+    printf("%-7s %-10s %9s %4s %10s %10s %9s %9s %9s %9s %9s %7s\n", "binding", "test", "payload", "subs", "msg/s", "MB/s",
+           "min(us)", "p50(us)", "p99(us)", "p999(us)", "max(us)", "lost");
+    std::vector<CaseResult> results;
+    for (const std::string &name : options.transports)
+    {
+        std::unique_ptr<Transport> transport = CreateTransport(name);
+        if (!transport)
+        {
+            fprintf(stderr, "unknown transport %s\n", name.c_str());
+            continue;
+        }
+        for (const std::string &test : options.tests)
+        {
+            for (size_t payload : options.sizes)
+            {
+                if (payload > transport->MaxPayload())
+                {
+                    continue;
+                }
+                CaseResult result;
+                result.transport = transport->Name();
+                result.test = test;
+                result.payload = payload;
+                result.subscribers = test == "fanout" ? options.subscribers : 1;
+                bool done = false;
+                if (test == "pingpong")
+                {
+                    done = runPingPong(*transport, options, result);
+                }
+                else if (test == "throughput")
+                {
+                    done = runThroughput(*transport, options, result);
+                }
+                else if (test == "fanout")
+                {
+                    done = runFanOut(*transport, options, result);
+                }
+                if (!done)
+                {
+                    fprintf(stderr, "%s %s %zu: failed to run\n", name.c_str(), test.c_str(), payload);
+                    continue;
+                }
+                printRow(result);
+                results.push_back(std::move(result));
+            }
+        }
+    }
+
+    if (!options.json.empty())
+    {
+        FILE *file = options.json == "-" ? stdout : fopen(options.json.c_str(), "w");
+        if (file == nullptr)
+        {
+            fprintf(stderr, "cannot write %s\n", options.json.c_str());
+            return 1;
+        }
+        writeJson(file, results);
+        if (file != stdout)
+        {
+            fclose(file);
+        }
+    }
+    return 0;
+}
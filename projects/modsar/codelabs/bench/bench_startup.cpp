@@ -0,0 +1,341 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 启动基准 N 个服务 每个 M 个事件 从开始 Offer 到所有订阅者收到第一个 sample 的时间
+ * \author ZYL
+ * \date 2026/10/18
+ *
+ * g++ -O2 -std=c++14 -pthread -I../../include bench_startup.cpp ../../sources/ara/com/routing/service_offer.cpp ../../sources/ara/com/routing/routing_table.cpp
+ *     ../../sources/ara/com/sd/shm_service_binding.cpp ../../sources/ara/com/sd/shm_service_registry.cpp ../../sources/ara/com/local/local_service_registry.cpp
+ *     ../../sources/ara/com/someip/someip_connection.cpp ../../sources/ara/com/tp/someip_tp.cpp ../../sources/ara/com/tp/tp_reassembler.cpp
+ *     ../../sources/ara/com/rpc/chunk_pool.cpp ../../sources/ara/com/utils/rcu.cpp -lvsomeip3 -lrt
+ * ./a.out --services 100 --events 20 --rounds 5
+ *
+ * 每轮分别按逐个 和批量两种方式走一遍启动过程 调用的是 skeleton 和 proxy 实际使用的接口
+ * - offer     每个服务一个带共享内存 binding 的 routing::ServiceOffer 逐个 ServiceOffer::Offer / 一次 routing::OfferServices
+ * - discover  proxy 端线程被 futex 唤醒后查共享内存注册表 直到看到全部服务
+ * - subscribe proxy 端在 SomeIpConnection 上为每个服务的全部事件注册 handler 并订阅
+ *             逐个 RegisterResponseHandler 和 SubscribeEvent (同 EventProxy::Subscribe)
+ *             每个服务一次 RegisterResponseHandlers 和 SubscribeEvents (同 EventProxy::SubscribeEvents)
+ * - first     每个事件一条通知经 SomeIpConnection::Dispatch 交付 到全部订阅者收到第一个 sample 为止
+ * 另外统计注册表的修改次数 (唤醒 watcher 的次数) 和分发表的重建次数
+ *
+ * 连接没有 Acquire 不创建 vsomeip application 结果只是进程内的开销
+ * SOME/IP SD 和路由管理器的握手都不在这里 这里的数字不是 SD 的启动时间
+ */
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <vsomeip/vsomeip.hpp>
+
+#include "ara/com/routing/service_offer.h"
+#include "ara/com/sd/shm_service_binding.h"
+#include "ara/com/sd/shm_service_registry.h"
+#include "ara/com/someip/someip_connection.h"
+
+using ara::com::routing::ServiceOffer;
+using ara::com::sd::ServiceOfferRecord;
+using ara::com::sd::ShmRegistryConfig;
+using ara::com::sd::ShmServiceBinding;
+using ara::com::sd::ShmServiceRegistry;
+using ara::com::someip::EventSubscription;
+using ara::com::someip::HandlerId;
+using ara::com::someip::SomeIpConnection;
+using ara::com::someip::SomeIpDispatchTable;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    const uint16_t kFirstServiceId = 0x1000;
+    const uint16_t kInstanceId = 1;
+    const uint16_t kEventgroupId = 1;
+    const uint16_t kFirstEventId = 0x8001;
+
+    struct Options
+    {
+        size_t services = 100;
+        size_t events = 20;
+        size_t rounds = 5;
+    };
+
+    struct Timing
+    {
+        double offerUs = 0;
+        double discoverUs = 0;
+        double subscribeUs = 0;
+        double firstSampleUs = 0;
+        uint32_t registryChanges = 0;
+        size_t tableRebuilds = 0;
+    };
+
+    double microsBetween(Clock::time_point begin, Clock::time_point end)
+    {
+        return std::chrono::duration<double, std::micro>(end - begin).count();
+    }
+
+    ServiceOfferRecord recordOf(size_t service)
+    {
+        ServiceOfferRecord record;
+        std::memset(&record, 0, sizeof(record));
+        record.serviceId = static_cast<uint16_t>(kFirstServiceId + service);
+        record.instanceId = kInstanceId;
+        record.majorVersion = 1;
+        std::snprintf(record.endpoint, sizeof(record.endpoint), "bench_%zu", service);
+        return record;
+    }
+
+    /**
+     * \brief 走一遍启动过程 batch 为 false 时逐个 Offer 逐个订阅
+     */
+    bool runOnce(const Options &options, bool batch, Timing &timing)
+    {
+        ShmRegistryConfig config;
+        config.name = "/aracom_bench_startup_" + std::to_string(::getpid());
+        config.capacity = static_cast<uint32_t>(options.services * 2);
+        ::shm_unlink(config.name.c_str());
+        ara::core::Result<std::shared_ptr<ShmServiceRegistry>> opened = ShmServiceRegistry::Open(config);
+        if (!opened.HasValue())
+        {
+            std::fprintf(stderr, "cannot open %s\n", config.name.c_str());
+            return false;
+        }
+        std::shared_ptr<ShmServiceRegistry> registry = opened.Value();
+        std::vector<std::unique_ptr<ServiceOffer>> offers;
+        for (size_t service = 0; service < options.services; ++service)
+        {
+            offers.emplace_back(new ServiceOffer());
+            offers.back()->AddBinding(std::make_shared<ShmServiceBinding>(registry, recordOf(service)));
+        }
+        SomeIpConnection &connection = SomeIpConnection::Instance();
+        const size_t handlerCount = options.services * options.events;
+        std::vector<std::shared_ptr<Message>> notifications;
+        for (size_t service = 0; service < options.services; ++service)
+        {
+            for (size_t event = 0; event < options.events; ++event)
+            {
+                std::shared_ptr<Message> notification = vsomeip::runtime::get()->create_notification(false);
+                notification->set_service(static_cast<uint16_t>(kFirstServiceId + service));
+                notification->set_instance(kInstanceId);
+                notification->set_method(static_cast<uint16_t>(kFirstEventId + event));
+                notifications.push_back(std::move(notification));
+            }
+        }
+        std::atomic<size_t> received(0);
+        std::vector<std::atomic<uint8_t>> first(handlerCount);
+        for (std::atomic<uint8_t> &flag : first)
+        {
+            flag.store(0, std::memory_order_relaxed);
+        }
+        std::vector<HandlerId> handlerIds;
+        std::atomic<bool> subscribed(false);
+        Clock::time_point discovered;
+        Clock::time_point registered;
+        const uint32_t changesBefore = registry->Changes();
+
+        // proxy 端 等全部服务出现后注册事件 handler 并订阅
+        std::thread proxy([&]
+                          {
+                              uint32_t seen = registry->Changes();
+                              size_t found = 0;
+                              std::vector<bool> known(options.services, false);
+                              while (found < options.services)
+                              {
+                                  for (size_t service = 0; service < options.services; ++service)
+                                  {
+                                      ServiceOfferRecord record;
+                                      if (!known[service] && registry->Find(static_cast<uint16_t>(kFirstServiceId + service), kInstanceId, record))
+                                      {
+                                          known[service] = true;
+                                          ++found;
+                                      }
+                                  }
+                                  if (found < options.services)
+                                  {
+                                      registry->WaitForChange(seen, std::chrono::milliseconds(100));
+                                      seen = registry->Changes();
+                                  }
+                              }
+                              discovered = Clock::now();
+                              for (size_t service = 0; service < options.services; ++service)
+                              {
+                                  const uint16_t serviceId = static_cast<uint16_t>(kFirstServiceId + service);
+                                  std::vector<std::pair<uint16_t, SomeIpDispatchTable<Message>::Handler>> handlers;
+                                  std::vector<EventSubscription> events;
+                                  for (size_t event = 0; event < options.events; ++event)
+                                  {
+                                      const size_t index = service * options.events + event;
+                                      const uint16_t eventId = static_cast<uint16_t>(kFirstEventId + event);
+                                      handlers.emplace_back(eventId, [&first, &received, index](const std::shared_ptr<Message> &)
+                                                            {
+                                                                if (first[index].exchange(1, std::memory_order_relaxed) == 0)
+                                                                {
+                                                                    received.fetch_add(1, std::memory_order_release);
+                                                                }
+                                                            });
+                                      events.push_back(EventSubscription{kEventgroupId, eventId});
+                                  }
+                                  if (batch)
+                                  {
+                                      std::vector<HandlerId> ids = connection.RegisterResponseHandlers(serviceId, kInstanceId, std::move(handlers));
+                                      handlerIds.insert(handlerIds.end(), ids.begin(), ids.end());
+                                      connection.SubscribeEvents(serviceId, kInstanceId, events);
+                                      ++timing.tableRebuilds;
+                                  }
+                                  else
+                                  {
+                                      for (auto &handler : handlers)
+                                      {
+                                          handlerIds.push_back(connection.RegisterResponseHandler(serviceId, kInstanceId, handler.first, std::move(handler.second)));
+                                          connection.SubscribeEvent(serviceId, kInstanceId, kEventgroupId, handler.first);
+                                          ++timing.tableRebuilds;
+                                      }
+                                  }
+                              }
+                              registered = Clock::now();
+                              subscribed.store(true, std::memory_order_release); });
+
+        // skeleton 端
+        const Clock::time_point start = Clock::now();
+        bool offeredAll = true;
+        if (batch)
+        {
+            std::vector<ServiceOffer *> pending;
+            for (const std::unique_ptr<ServiceOffer> &offer : offers)
+            {
+                pending.push_back(offer.get());
+            }
+            offeredAll = ara::com::routing::OfferServices(pending).HasValue();
+        }
+        else
+        {
+            for (const std::unique_ptr<ServiceOffer> &offer : offers)
+            {
+                offeredAll = offer->Offer().HasValue() && offeredAll;
+            }
+        }
+        const Clock::time_point offered = Clock::now();
+        if (!offeredAll)
+        {
+            // proxy 端线程等不到全部服务 不再继续
+            std::fprintf(stderr, "offer failed in %s\n", config.name.c_str());
+            std::exit(1);
+        }
+
+        // 发布端 订阅建立后每个事件发一个 sample 实际系统里 proxy 订阅后才会收到 eventgroup 的初始值
+        while (!subscribed.load(std::memory_order_acquire))
+        {
+            std::this_thread::yield();
+        }
+        for (const std::shared_ptr<Message> &notification : notifications)
+        {
+            connection.Dispatch(notification);
+        }
+        while (received.load(std::memory_order_acquire) < handlerCount)
+        {
+            std::this_thread::yield();
+        }
+        const Clock::time_point done = Clock::now();
+        proxy.join();
+
+        timing.offerUs = microsBetween(start, offered);
+        timing.discoverUs = microsBetween(start, discovered);
+        timing.subscribeUs = microsBetween(discovered, registered);
+        timing.firstSampleUs = microsBetween(start, done);
+        timing.registryChanges = registry->Changes() - changesBefore;
+
+        // 连接是进程唯一的 下一轮之前撤回这一轮的 handler 和订阅
+        connection.UnregisterHandlers(handlerIds);
+        for (size_t service = 0; service < options.services; ++service)
+        {
+            std::vector<EventSubscription> events;
+            for (size_t event = 0; event < options.events; ++event)
+            {
+                events.push_back(EventSubscription{kEventgroupId, static_cast<uint16_t>(kFirstEventId + event)});
+            }
+            connection.UnsubscribeEvents(static_cast<uint16_t>(kFirstServiceId + service), kInstanceId, events);
+        }
+        offers.clear();
+        registry.reset();
+        ::shm_unlink(config.name.c_str());
+        return true;
+    }
+
+    bool parseOptions(int argc, char **argv, Options &options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string name = argv[i];
+            if (i + 1 >= argc)
+            {
+                return false;
+            }
+            const size_t value = std::strtoul(argv[++i], nullptr, 10);
+            if (name == "--services" && value > 0 && value < 0x7000)
+            {
+                options.services = value;
+            }
+            else if (name == "--events" && value > 0 && value < 0x7000)
+            {
+                options.events = value;
+            }
+            else if (name == "--rounds" && value > 0)
+            {
+                options.rounds = value;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    double median(std::vector<double> values)
+    {
+        std::sort(values.begin(), values.end());
+        return values[values.size() / 2];
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        std::fprintf(stderr, "usage: %s [--services N] [--events M] [--rounds R]\n", argv[0]);
+        return 1;
+    }
+    std::printf("%zu services x %zu events, median of %zu rounds\n\n", options.services, options.events, options.rounds);
+    std::printf("%-10s %12s %12s %12s %12s %10s %10s\n", "mode", "offer(us)", "discover(us)", "subscribe(us)", "first(us)", "changes", "rebuilds");
+    for (int mode = 0; mode < 2; ++mode)
+    {
+        const bool batch = mode == 1;
+        std::vector<double> offer, discover, subscribe, firstSample;
+        Timing timing;
+        for (size_t round = 0; round < options.rounds; ++round)
+        {
+            timing = Timing();
+            if (!runOnce(options, batch, timing))
+            {
+                return 1;
+            }
+            offer.push_back(timing.offerUs);
+            discover.push_back(timing.discoverUs);
+            subscribe.push_back(timing.subscribeUs);
+            firstSample.push_back(timing.firstSampleUs);
+        }
+        std::printf("%-10s %12.1f %12.1f %12.1f %12.1f %10u %10zu\n", batch ? "batch" : "single", median(offer), median(discover),
+                    median(subscribe), median(firstSample), timing.registryChanges, timing.tableRebuilds);
+    }
+    return 0;
+}
@@ -0,0 +1,99 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 基准测试用的传输抽象 每种 binding 实现一个 Transport 测试代码不关心底层
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _BENCH_TRANSPORT_H_
+#define _BENCH_TRANSPORT_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+    inline int64_t NowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /**
+     * \brief 发送端 先 Loan 拿到可写的缓冲区 写好后 Send 发给全部接收端
+     * 零拷贝的 binding 直接把缓冲区交给接收端 其余的在 Send 里拷贝或写 socket
+     */
+    class Publisher
+    {
+    public:
+        virtual ~Publisher() = default;
+
+        /**
+         * \brief 至少 length 字节的缓冲区 在下一次 Send 之前有效
+         */
+        virtual uint8_t *Loan(size_t length) = 0;
+
+        /**
+         * \brief 发送最近一次 Loan 的缓冲区
+         */
+        virtual bool Send(size_t length) = 0;
+    };
+
+    /**
+     * \brief 接收端 只在一个线程里使用
+     */
+    class Subscriber
+    {
+    public:
+        virtual ~Subscriber() = default;
+
+        /**
+         * \brief 等待下一个消息 超时返回 nullptr
+         * 返回的数据在下一次 Take 之前有效
+         */
+        virtual const uint8_t *Take(size_t &length, int64_t timeoutNs) = 0;
+    };
+
+    /**
+     * \brief 一种 binding 的测试入口
+     */
+    class Transport
+    {
+    public:
+        virtual ~Transport() = default;
+
+        virtual std::string Name() const = 0;
+
+        /**
+         * \brief 单个消息的上限 超过的 payload 大小跳过
+         */
+        virtual size_t MaxPayload() const = 0;
+
+        /**
+         * \brief 是否可能丢消息 可能丢的传输在吞吐测试里按收到的个数统计
+         */
+        virtual bool Lossy() const = 0;
+
+        /**
+         * \brief 建一个一对多的通道 subscriberCount 个接收端
+         * \param maxPayload 通道上最大的消息 用来预留缓冲区
+         */
+        virtual bool CreateChannel(size_t subscriberCount, size_t maxPayload, std::unique_ptr<Publisher> &publisher,
+                                   std::vector<std::unique_ptr<Subscriber>> &subscribers) = 0;
+    };
+
+    /**
+     * \brief 按名字创建 不支持时返回 nullptr
+     */
+    std::unique_ptr<Transport> CreateTransport(const std::string &name);
+
+    /**
+     * \brief 本次编译支持的传输名字
+     */
+    std::vector<std::string> TransportNames();
+
+} // namespace bench
+
+#endif // _BENCH_TRANSPORT_H_
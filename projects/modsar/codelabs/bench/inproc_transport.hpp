@@ -0,0 +1,136 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 进程内传输 用 EventDistributor 把缓冲区的 shared_ptr 交给订阅者 不拷贝不序列化
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _INPROC_TRANSPORT_HPP_
+#define _INPROC_TRANSPORT_HPP_
+
+#include <thread>
+
+#include "ara/com/event/event_distributor.hpp"
+#include "ara/com/utils/seqlock.hpp"
+#include "bench_transport.h"
+
+namespace bench
+{
+    struct InprocMessage
+    {
+        explicit InprocMessage(size_t capacity) : data(capacity), length(0) {}
+
+        std::vector<uint8_t> data; // 按通道上最大的消息分配 复用
+        size_t length;
+    };
+
+    using InprocBuffer = std::shared_ptr<InprocMessage>;
+    using InprocSample = std::shared_ptr<const InprocMessage>;
+    using InprocDistributor = ara::com::event::EventDistributor<InprocSample>;
+
+    class InprocPublisher : public Publisher
+    {
+    public:
+        InprocPublisher(std::shared_ptr<InprocDistributor> distributor, size_t maxPayload)
+            : distributor_(std::move(distributor)), maxPayload_(maxPayload)
+        {
+        }
+
+        /**
+         * \brief 和零拷贝 binding 的 loan 一样 复用订阅者已经放开的缓冲区
+         */
+        uint8_t *Loan(size_t length) override
+        {
+            (void)length;
+            for (InprocBuffer &buffer : pool_)
+            {
+                if (buffer.use_count() == 1)
+                {
+                    loaned_ = buffer;
+                    return loaned_->data.data();
+                }
+            }
+            pool_.push_back(std::make_shared<InprocMessage>(maxPayload_));
+            loaned_ = pool_.back();
+            return loaned_->data.data();
+        }
+
+        bool Send(size_t length) override
+        {
+            loaned_->length = length;
+            InprocSample sample = std::move(loaned_);
+            return distributor_->Publish(sample).dropped == 0;
+        }
+
+    private:
+        std::shared_ptr<InprocDistributor> distributor_;
+        const size_t maxPayload_;
+        std::vector<InprocBuffer> pool_;
+        InprocBuffer loaned_;
+    };
+
+    class InprocSubscriber : public Subscriber
+    {
+    public:
+        explicit InprocSubscriber(std::shared_ptr<InprocDistributor::Queue> queue) : queue_(std::move(queue))
+        {
+        }
+
+        const uint8_t *Take(size_t &length, int64_t timeoutNs) override
+        {
+            current_.reset();
+            const int64_t deadline = NowNs() + timeoutNs;
+            // 短暂自旋后让出 CPU 核数少时不和发布端抢
+            for (uint32_t spins = 0; !queue_->TryPop(current_); ++spins)
+            {
+                if ((spins & 0x3f) == 0 && NowNs() > deadline)
+                {
+                    return nullptr;
+                }
+                if (spins < 64)
+                {
+                    ara::com::utils::CpuRelax();
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+            length = current_->length;
+            return current_->data.data();
+        }
+
+    private:
+        std::shared_ptr<InprocDistributor::Queue> queue_;
+        InprocSample current_;
+    };
+
+    class InprocTransport : public Transport
+    {
+    public:
+        std::string Name() const override { return "inproc"; }
+
+        size_t MaxPayload() const override { return static_cast<size_t>(1) << 30; }
+
+        bool Lossy() const override { return false; }
+
+        bool CreateChannel(size_t subscriberCount, size_t maxPayload, std::unique_ptr<Publisher> &publisher,
+                           std::vector<std::unique_ptr<Subscriber>> &subscribers) override
+        {
+            // 不丢消息 慢订阅者让发布者等待 和其他 binding 的可靠传输对齐
+            ara::com::event::EventQosConfig qos;
+            qos.queue.policy = ara::com::event::QueuePolicy::kBlockPublisher;
+            qos.queue.depth = 16;
+            qos.queue.blockTimeout = std::chrono::seconds(1);
+            std::shared_ptr<InprocDistributor> distributor = std::make_shared<InprocDistributor>(qos);
+            for (size_t i = 0; i < subscriberCount; ++i)
+            {
+                subscribers.emplace_back(new InprocSubscriber(distributor->Subscribe(qos.queue.depth)));
+            }
+            publisher.reset(new InprocPublisher(distributor, maxPayload));
+            return true;
+        }
+    };
+
+} // namespace bench
+
+#endif // _INPROC_TRANSPORT_HPP_
@@ -0,0 +1,370 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 本机回环的 socket 传输 UDP TCP 和 unix domain socket
+ * 对应 SOME/IP 在 UDP TCP 上的传输和本机 binding 的 unix socket 通道 只测内核路径的开销
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _SOCKET_TRANSPORT_HPP_
+#define _SOCKET_TRANSPORT_HPP_
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <cerrno>
+
+#include "bench_transport.h"
+
+namespace bench
+{
+    namespace socket_detail
+    {
+        inline void closeAll(std::vector<int> &fds)
+        {
+            for (int fd : fds)
+            {
+                if (fd >= 0)
+                {
+                    ::close(fd);
+                }
+            }
+            fds.clear();
+        }
+
+        inline bool waitReadable(int fd, int64_t timeoutNs)
+        {
+            struct pollfd entry;
+            entry.fd = fd;
+            entry.events = POLLIN;
+            const int timeoutMs = static_cast<int>((timeoutNs + 999999) / 1000000);
+            int ready;
+            do
+            {
+                ready = ::poll(&entry, 1, timeoutMs);
+            } while (ready < 0 && errno == EINTR);
+            return ready > 0;
+        }
+
+        inline bool readFully(int fd, uint8_t *data, size_t length)
+        {
+            while (length != 0)
+            {
+                const ssize_t got = ::read(fd, data, length);
+                if (got <= 0)
+                {
+                    if (got < 0 && errno == EINTR)
+                    {
+                        continue;
+                    }
+                    return false;
+                }
+                data += got;
+                length -= static_cast<size_t>(got);
+            }
+            return true;
+        }
+
+        inline bool writeFully(int fd, struct iovec *parts, int count)
+        {
+            while (count != 0)
+            {
+                ssize_t written = ::writev(fd, parts, count);
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    return false;
+                }
+                while (count != 0 && static_cast<size_t>(written) >= parts->iov_len)
+                {
+                    written -= static_cast<ssize_t>(parts->iov_len);
+                    ++parts;
+                    --count;
+                }
+                if (count != 0)
+                {
+                    parts->iov_base = static_cast<uint8_t *>(parts->iov_base) + written;
+                    parts->iov_len -= static_cast<size_t>(written);
+                }
+            }
+            return true;
+        }
+
+        inline void setBuffers(int fd, int bytes)
+        {
+            ::setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &bytes, sizeof(bytes));
+            ::setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &bytes, sizeof(bytes));
+        }
+    } // namespace socket_detail
+
+    /**
+     * \brief UDP 发布端 每个接收端一个目标端口 一个数据报一个消息
+     */
+    class UdpPublisher : public Publisher
+    {
+    public:
+        UdpPublisher(int fd, std::vector<struct sockaddr_in> targets, size_t maxPayload)
+            : fd_(fd), targets_(std::move(targets)), buffer_(maxPayload)
+        {
+        }
+
+        ~UdpPublisher() override { ::close(fd_); }
+
+        uint8_t *Loan(size_t length) override
+        {
+            (void)length;
+            return buffer_.data();
+        }
+
+        bool Send(size_t length) override
+        {
+            bool sent = true;
+            for (const struct sockaddr_in &target : targets_)
+            {
+                sent = ::sendto(fd_, buffer_.data(), length, 0, reinterpret_cast<const struct sockaddr *>(&target), sizeof(target)) ==
+                           static_cast<ssize_t>(length) &&
+                       sent;
+            }
+            return sent;
+        }
+
+    private:
+        const int fd_;
+        const std::vector<struct sockaddr_in> targets_;
+        std::vector<uint8_t> buffer_;
+    };
+
+    class UdpSubscriber : public Subscriber
+    {
+    public:
+        UdpSubscriber(int fd, size_t maxPayload) : fd_(fd), buffer_(maxPayload) {}
+
+        ~UdpSubscriber() override { ::close(fd_); }
+
+        const uint8_t *Take(size_t &length, int64_t timeoutNs) override
+        {
+            if (!socket_detail::waitReadable(fd_, timeoutNs))
+            {
+                return nullptr;
+            }
+            const ssize_t got = ::recv(fd_, buffer_.data(), buffer_.size(), 0);
+            if (got < 0)
+            {
+                return nullptr;
+            }
+            length = static_cast<size_t>(got);
+            return buffer_.data();
+        }
+
+    private:
+        const int fd_;
+        std::vector<uint8_t> buffer_;
+    };
+
+    class UdpTransport : public Transport
+    {
+    public:
+        std::string Name() const override { return "udp"; }
+
+        size_t MaxPayload() const override { return 65507; }
+
+        bool Lossy() const override { return true; }
+
+        bool CreateChannel(size_t subscriberCount, size_t maxPayload, std::unique_ptr<Publisher> &publisher,
+                           std::vector<std::unique_ptr<Subscriber>> &subscribers) override
+        {
+            std::vector<int> fds;
+            std::vector<struct sockaddr_in> targets;
+            for (size_t i = 0; i < subscriberCount; ++i)
+            {
+                const int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+                fds.push_back(fd);
+                struct sockaddr_in address = {};
+                address.sin_family = AF_INET;
+                address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+                socklen_t length = sizeof(address);
+                if (fd < 0 || ::bind(fd, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) != 0 ||
+                    ::getsockname(fd, reinterpret_cast<struct sockaddr *>(&address), &length) != 0)
+                {
+                    socket_detail::closeAll(fds);
+                    return false;
+                }
+                socket_detail::setBuffers(fd, 8 * 1024 * 1024);
+                targets.push_back(address);
+            }
+            const int sender = ::socket(AF_INET, SOCK_DGRAM, 0);
+            if (sender < 0)
+            {
+                socket_detail::closeAll(fds);
+                return false;
+            }
+            socket_detail::setBuffers(sender, 8 * 1024 * 1024);
+            for (int fd : fds)
+            {
+                subscribers.emplace_back(new UdpSubscriber(fd, maxPayload));
+            }
+            publisher.reset(new UdpPublisher(sender, std::move(targets), maxPayload));
+            return true;
+        }
+    };
+
+    /**
+     * \brief 流式发布端 每个消息前加 4 字节长度 逐个连接写
+     */
+    class StreamPublisher : public Publisher
+    {
+    public:
+        StreamPublisher(std::vector<int> fds, size_t maxPayload) : fds_(std::move(fds)), buffer_(maxPayload) {}
+
+        ~StreamPublisher() override { socket_detail::closeAll(fds_); }
+
+        uint8_t *Loan(size_t length) override
+        {
+            (void)length;
+            return buffer_.data();
+        }
+
+        bool Send(size_t length) override
+        {
+            uint32_t header = static_cast<uint32_t>(length);
+            bool sent = true;
+            for (int fd : fds_)
+            {
+                struct iovec parts[2];
+                parts[0].iov_base = &header;
+                parts[0].iov_len = sizeof(header);
+                parts[1].iov_base = buffer_.data();
+                parts[1].iov_len = length;
+                sent = socket_detail::writeFully(fd, parts, 2) && sent;
+            }
+            return sent;
+        }
+
+    private:
+        std::vector<int> fds_;
+        std::vector<uint8_t> buffer_;
+    };
+
+    class StreamSubscriber : public Subscriber
+    {
+    public:
+        StreamSubscriber(int fd, size_t maxPayload) : fd_(fd), buffer_(maxPayload) {}
+
+        ~StreamSubscriber() override { ::close(fd_); }
+
+        const uint8_t *Take(size_t &length, int64_t timeoutNs) override
+        {
+            uint32_t header = 0;
+            if (!socket_detail::waitReadable(fd_, timeoutNs) ||
+                !socket_detail::readFully(fd_, reinterpret_cast<uint8_t *>(&header), sizeof(header)) || header > buffer_.size() ||
+                !socket_detail::readFully(fd_, buffer_.data(), header))
+            {
+                return nullptr;
+            }
+            length = header;
+            return buffer_.data();
+        }
+
+    private:
+        const int fd_;
+        std::vector<uint8_t> buffer_;
+    };
+
+    /**
+     * \brief TCP 回环或 unix domain socket 可靠传输 没有消息大小限制
+     */
+    class StreamTransport : public Transport
+    {
+    public:
+        explicit StreamTransport(bool tcp) : tcp_(tcp) {}
+
+        std::string Name() const override { return tcp_ ? "tcp" : "uds"; }
+
+        size_t MaxPayload() const override { return UINT32_MAX; }
+
+        bool Lossy() const override { return false; }
+
+        bool CreateChannel(size_t subscriberCount, size_t maxPayload, std::unique_ptr<Publisher> &publisher,
+                           std::vector<std::unique_ptr<Subscriber>> &subscribers) override
+        {
+            std::vector<int> senders;
+            std::vector<int> receivers;
+            for (size_t i = 0; i < subscriberCount; ++i)
+            {
+                int pair[2] = {-1, -1};
+                if (!(tcp_ ? connectTcp(pair) : ::socketpair(AF_UNIX, SOCK_STREAM, 0, pair) == 0))
+                {
+                    socket_detail::closeAll(senders);
+                    socket_detail::closeAll(receivers);
+                    return false;
+                }
+                socket_detail::setBuffers(pair[0], 4 * 1024 * 1024);
+                socket_detail::setBuffers(pair[1], 4 * 1024 * 1024);
+                senders.push_back(pair[0]);
+                receivers.push_back(pair[1]);
+            }
+            for (int fd : receivers)
+            {
+                subscribers.emplace_back(new StreamSubscriber(fd, maxPayload));
+            }
+            publisher.reset(new StreamPublisher(std::move(senders), maxPayload));
+            return true;
+        }
+
+    private:
+        /**
+         * \brief 经过回环网卡建立一对连接 pair[0] 发送 pair[1] 接收
+         */
+        static bool connectTcp(int pair[2])
+        {
+            const int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+            if (listener < 0)
+            {
+                return false;
+            }
+            struct sockaddr_in address = {};
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            socklen_t length = sizeof(address);
+            bool connected = ::bind(listener, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) == 0 &&
+                             ::listen(listener, 1) == 0 &&
+                             ::getsockname(listener, reinterpret_cast<struct sockaddr *>(&address), &length) == 0;
+            if (connected)
+            {
+                pair[0] = ::socket(AF_INET, SOCK_STREAM, 0);
+                connected = pair[0] >= 0 && ::connect(pair[0], reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) == 0;
+            }
+            if (connected)
+            {
+                pair[1] = ::accept(listener, nullptr, nullptr);
+                connected = pair[1] >= 0;
+            }
+            ::close(listener);
+            if (!connected)
+            {
+                if (pair[0] >= 0)
+                {
+                    ::close(pair[0]);
+                }
+                return false;
+            }
+            const int noDelay = 1;
+            ::setsockopt(pair[0], IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+            ::setsockopt(pair[1], IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+            return true;
+        }
+
+    private:
+        const bool tcp_;
+    };
+
+} // namespace bench
+
+#endif // _SOCKET_TRANSPORT_HPP_
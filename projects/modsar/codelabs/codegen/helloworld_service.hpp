@@ -0,0 +1,264 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 由 aragen 从 helloworld.idl 生成 不要手工修改
+ * \author aragen
+ */
+#ifndef _HELLOWORLD_SERVICE_HPP_
+#define _HELLOWORLD_SERVICE_HPP_
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ara/com/codegen/static_service.hpp"
+
+namespace helloworld
+{
+    struct HelloRequest
+    {
+        uint32_t id{};
+        std::string name{};
+    };
+
+    ARA_COM_SOMEIP_STRUCT(HelloRequest, &HelloRequest::id, &HelloRequest::name)
+
+    struct HelloReply
+    {
+        uint32_t id{};
+        std::string message{};
+        std::vector<uint8_t> digest{};
+    };
+
+    ARA_COM_SOMEIP_STRUCT(HelloReply, &HelloReply::id, &HelloReply::message, &HelloReply::digest)
+
+    /**
+     * \brief Greeter 的编译期描述 service 0x1234 版本 1.0
+     */
+    struct GreeterService
+    {
+        static constexpr uint16_t kServiceId = 0x1234;
+        static constexpr uint8_t kMajorVersion = 1;
+        static constexpr uint32_t kMinorVersion = 0;
+
+        using SayHello = ::ara::com::codegen::Method<0x0001, HelloRequest, HelloReply>;
+        using Add = ::ara::com::codegen::Method<0x0002, std::array<int32_t, 2>, int32_t>;
+        using Ping = ::ara::com::codegen::FireAndForget<0x0003, uint32_t>;
+        using Greeted = ::ara::com::codegen::Event<0x8001, 0x0001, HelloReply>;
+
+        using ServerMessages = ::ara::com::codegen::IdList<SayHello, Add, Ping>; // skeleton 接收的请求
+        using ClientMessages = ::ara::com::codegen::IdList<SayHello, Add, Greeted>; // proxy 接收的应答和事件
+        using Events = ::ara::com::codegen::EventList<Greeted>;
+
+        static_assert(::ara::com::codegen::IdList<SayHello, Add, Ping, Greeted>::kDistinct, "duplicate method or event id");
+    };
+
+    /**
+     * \brief GreeterProxy 默认的事件接收者 丢弃全部事件
+     */
+    struct GreeterIgnoreEvents
+    {
+        void OnGreeted(const HelloReply &) {}
+    };
+
+    /**
+     * \brief Greeter 的 proxy 方法调用直接序列化后交给 Transport
+     *
+     * 收到的应答按 method id switch 到对应方法的 CallSlotTable 事件交给 Listener 的 On<事件名>
+     * 超过 SetCallTimeout 的时长仍未应答的调用以 kCommunicationLinkError 结束
+     * Listener 的函数在 transport 的接收线程上执行
+     */
+    template <typename Transport, typename Listener = GreeterIgnoreEvents>
+    class GreeterProxy
+    {
+    public:
+        using Service = GreeterService;
+
+        /**
+         * \brief 构造时注册应答和事件的接收 不订阅事件
+         * \param maxInFlight 每个方法的最大在途调用数
+         */
+        GreeterProxy(Transport &transport, uint16_t instanceId, Listener listener = Listener(), size_t maxInFlight = 64)
+            : transport_(transport), endpoint_{Service::kServiceId, instanceId}, listener_(std::move(listener)), sayHelloCalls_(std::make_shared<::ara::com::rpc::CallSlotTable<HelloReply>>(maxInFlight)), addCalls_(std::make_shared<::ara::com::rpc::CallSlotTable<int32_t>>(maxInFlight)), callTimeout_(::ara::com::rpc::kDefaultCallTimeout), subscribed_(false)
+        {
+            listenId_ = transport_.Listen(::ara::com::codegen::Role::kClient, endpoint_, Service::ClientMessages::Ids().data(),
+                                          Service::ClientMessages::kSize, &GreeterProxy::onMessage, this);
+        }
+
+        /**
+         * \brief 注销接收后 在途调用以 kServiceNotAvailable 结束
+         */
+        ~GreeterProxy()
+        {
+            Unsubscribe();
+            transport_.Unlisten(listenId_);
+        }
+
+        GreeterProxy(const GreeterProxy &) = delete;
+        GreeterProxy &operator=(const GreeterProxy &) = delete;
+
+        ara::core::Future<HelloReply> SayHello(const HelloRequest &request)
+        {
+            return ::ara::com::codegen::Call<Service::SayHello>(transport_, listenId_, endpoint_, sayHelloCalls_, request, callTimeout_);
+        }
+
+        ara::core::Future<int32_t> Add(const std::array<int32_t, 2> &request)
+        {
+            return ::ara::com::codegen::Call<Service::Add>(transport_, listenId_, endpoint_, addCalls_, request, callTimeout_);
+        }
+
+        ara::core::Result<void> Ping(const uint32_t &request)
+        {
+            return ::ara::com::codegen::Send<Service::Ping>(transport_, endpoint_, request);
+        }
+
+        /**
+         * \brief 之后发出的调用等待应答的时长 默认 ::ara::com::rpc::kDefaultCallTimeout
+         */
+        void SetCallTimeout(std::chrono::milliseconds timeout) { callTimeout_ = timeout; }
+
+        void Subscribe()
+        {
+            if (!subscribed_)
+            {
+                transport_.Subscribe(endpoint_, Service::Events::Addresses().data(), Service::Events::kSize);
+                subscribed_ = true;
+            }
+        }
+
+        void Unsubscribe()
+        {
+            if (subscribed_)
+            {
+                transport_.Unsubscribe(endpoint_, Service::Events::Addresses().data(), Service::Events::kSize);
+                subscribed_ = false;
+            }
+        }
+
+        Listener &GetListener() { return listener_; }
+
+    private:
+        static void onMessage(void *target, const ::ara::com::codegen::InboundMessage &message)
+        {
+            GreeterProxy &self = *static_cast<GreeterProxy *>(target);
+            switch (message.id)
+            {
+            case Service::SayHello::kId:
+                ::ara::com::codegen::Complete<Service::SayHello>(*self.sayHelloCalls_, message);
+                break;
+            case Service::Add::kId:
+                ::ara::com::codegen::Complete<Service::Add>(*self.addCalls_, message);
+                break;
+            case Service::Greeted::kId:
+                ::ara::com::codegen::Deliver<Service::Greeted>(message, [&self](const HelloReply &sample)
+                                                               { self.listener_.OnGreeted(sample); });
+                break;
+            default:
+                break;
+            }
+        }
+
+        Transport &transport_;
+        const ::ara::com::codegen::Endpoint endpoint_;
+        Listener listener_;
+        std::shared_ptr<::ara::com::rpc::CallSlotTable<HelloReply>> sayHelloCalls_;
+        std::shared_ptr<::ara::com::rpc::CallSlotTable<int32_t>> addCalls_;
+        std::chrono::milliseconds callTimeout_;
+        bool subscribed_;
+        uint64_t listenId_;
+    };
+
+    /**
+     * \brief Greeter 的 skeleton 派生类以 public 成员函数实现全部方法
+     *
+     * ara::core::Result<HelloReply> SayHello(const HelloRequest &request);
+     * ara::core::Result<int32_t> Add(const std::array<int32_t, 2> &request);
+     * void Ping(const uint32_t &request);
+     *
+     * 请求按 method id switch 后直接调用派生类的函数 返回错误时发送错误应答
+     * 派生类的析构函数里先调用 StopOfferService
+     */
+    template <typename Derived, typename Transport>
+    class GreeterSkeleton
+    {
+    public:
+        using Service = GreeterService;
+
+        GreeterSkeleton(Transport &transport, uint16_t instanceId)
+            : Greeted(transport, ::ara::com::codegen::Endpoint{Service::kServiceId, instanceId}), transport_(transport), endpoint_{Service::kServiceId, instanceId}, listenId_(::ara::com::codegen::kInvalidListenId)
+        {
+        }
+
+        ~GreeterSkeleton()
+        {
+            StopOfferService();
+        }
+
+        GreeterSkeleton(const GreeterSkeleton &) = delete;
+        GreeterSkeleton &operator=(const GreeterSkeleton &) = delete;
+
+        /**
+         * \return 同一实例的方法已被其他 skeleton 注册时返回 kCouldNotExecute
+         */
+        ara::core::Result<void> OfferService()
+        {
+            if (listenId_ == ::ara::com::codegen::kInvalidListenId)
+            {
+                listenId_ = transport_.Listen(::ara::com::codegen::Role::kServer, endpoint_, Service::ServerMessages::Ids().data(),
+                                              Service::ServerMessages::kSize, &GreeterSkeleton::onMessage, this);
+                if (listenId_ == ::ara::com::codegen::kInvalidListenId)
+                {
+                    return ara::core::Result<void>::FromError(::ara::com::MakeErrorCode(::ara::com::ComErrc::kCouldNotExecute, 0));
+                }
+                transport_.OfferService(endpoint_, Service::Events::Addresses().data(), Service::Events::kSize);
+            }
+            return ara::core::Result<void>::FromValue();
+        }
+
+        void StopOfferService()
+        {
+            if (listenId_ != ::ara::com::codegen::kInvalidListenId)
+            {
+                transport_.StopOfferService(endpoint_, Service::Events::Addresses().data(), Service::Events::kSize);
+                transport_.Unlisten(listenId_);
+                listenId_ = ::ara::com::codegen::kInvalidListenId;
+            }
+        }
+
+        ::ara::com::codegen::EventSender<Service::Greeted, Transport> Greeted; // Greeted.Send(sample)
+
+    private:
+        static void onMessage(void *target, const ::ara::com::codegen::InboundMessage &message)
+        {
+            GreeterSkeleton &self = *static_cast<GreeterSkeleton *>(target);
+            Derived &service = static_cast<Derived &>(self);
+            switch (message.id)
+            {
+            case Service::SayHello::kId:
+                ::ara::com::codegen::Serve<Service::SayHello>(self.transport_, message, [&service](const HelloRequest &request)
+                                                              { return service.SayHello(request); });
+                break;
+            case Service::Add::kId:
+                ::ara::com::codegen::Serve<Service::Add>(self.transport_, message, [&service](const std::array<int32_t, 2> &request)
+                                                         { return service.Add(request); });
+                break;
+            case Service::Ping::kId:
+                ::ara::com::codegen::Accept<Service::Ping>(message, [&service](const uint32_t &request)
+                                                           { service.Ping(request); });
+                break;
+            default:
+                break;
+            }
+        }
+
+        Transport &transport_;
+        const ::ara::com::codegen::Endpoint endpoint_;
+        uint64_t listenId_;
+    };
+
+} // namespace helloworld
+
+#endif // _HELLOWORLD_SERVICE_HPP_
@@ -0,0 +1,220 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 同线程的回环 transport 请求 应答 事件在发送的调用里直接交给对端 用于试验生成代码
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _LOOPBACK_TRANSPORT_HPP_
+#define _LOOPBACK_TRANSPORT_HPP_
+
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include "ara/com/codegen/static_service.hpp"
+
+namespace codelab
+{
+    /**
+     * \brief 满足 codegen 的 Transport 要求 只在一个进程内
+     *
+     * 发送时序列化到一块复用的缓冲区 按 (方向 service instance id) 找到对端后同步调用它的 handler
+     * 应答由 SendResponse 按请求的 session 发回 事件只发给 Subscribe 过的 proxy
+     * 应答只发给发出请求的 proxy 同一实例的多个 proxy 互不干扰
+     * Unlisten 不等待其他线程上正在执行的 handler 多线程使用时由调用者保证
+     */
+    class LoopbackTransport
+    {
+    public:
+        struct Counters
+        {
+            size_t requests = 0;
+            size_t responses = 0;
+            size_t notifications = 0;
+            size_t dropped = 0; // 没有接收者
+        };
+
+        uint64_t Listen(ara::com::codegen::Role role, const ara::com::codegen::Endpoint &endpoint, const uint16_t *ids, size_t count,
+                        ara::com::codegen::InboundHandler handler, void *target)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (role == ara::com::codegen::Role::kServer && receivers_.count(keyOf(role, endpoint, ids[i])) != 0)
+                {
+                    return ara::com::codegen::kInvalidListenId;
+                }
+            }
+            const uint64_t id = nextListenId_++;
+            for (size_t i = 0; i < count; ++i)
+            {
+                receivers_.emplace(keyOf(role, endpoint, ids[i]), Receiver{id, handler, target});
+            }
+            return id;
+        }
+
+        void Unlisten(uint64_t listenId)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto receiver = receivers_.begin(); receiver != receivers_.end();)
+            {
+                receiver = receiver->second.listenId == listenId ? receivers_.erase(receiver) : std::next(receiver);
+            }
+        }
+
+        template <typename Writer>
+        ara::core::Result<void> SendRequest(uint64_t listenId, const ara::com::codegen::Endpoint &endpoint, uint16_t methodId, uint16_t session,
+                                            bool, size_t size, Writer &&write)
+        {
+            ++counters_.requests;
+            std::vector<uint8_t> buffer = serialize(size, write);
+            const Route route{endpoint, methodId, listenId};
+            deliver(ara::com::codegen::Role::kServer, endpoint, ara::com::codegen::InboundMessage{methodId, session, false, buffer.data(), size, &route});
+            release(std::move(buffer));
+            return ara::core::Result<void>::FromValue();
+        }
+
+        template <typename Writer>
+        ara::core::Result<void> SendResponse(const ara::com::codegen::InboundMessage &request, bool ok, size_t size, Writer &&write)
+        {
+            ++counters_.responses;
+            std::vector<uint8_t> buffer = serialize(size, write);
+            const Route &route = *static_cast<const Route *>(request.context);
+            deliver(ara::com::codegen::Role::kClient, route.endpoint,
+                    ara::com::codegen::InboundMessage{route.methodId, request.session, !ok, buffer.data(), size, nullptr}, route.listenId);
+            release(std::move(buffer));
+            return ara::core::Result<void>::FromValue();
+        }
+
+        template <typename Writer>
+        ara::core::Result<void> Notify(const ara::com::codegen::Endpoint &endpoint, uint16_t eventId, size_t size, Writer &&write)
+        {
+            ++counters_.notifications;
+            std::vector<uint8_t> buffer = serialize(size, write);
+            deliver(ara::com::codegen::Role::kClient, endpoint, ara::com::codegen::InboundMessage{eventId, 0, false, buffer.data(), size, nullptr});
+            release(std::move(buffer));
+            return ara::core::Result<void>::FromValue();
+        }
+
+        void OfferService(const ara::com::codegen::Endpoint &, const ara::com::codegen::EventAddress *, size_t) {}
+
+        void StopOfferService(const ara::com::codegen::Endpoint &, const ara::com::codegen::EventAddress *, size_t) {}
+
+        /**
+         * \brief 之后的事件发给该 endpoint 的全部 proxy 回环里不区分 eventgroup
+         */
+        void Subscribe(const ara::com::codegen::Endpoint &endpoint, const ara::com::codegen::EventAddress *events, size_t count)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (size_t i = 0; i < count; ++i)
+            {
+                ++subscriptions_[keyOf(ara::com::codegen::Role::kClient, endpoint, events[i].eventId)];
+            }
+        }
+
+        void Unsubscribe(const ara::com::codegen::Endpoint &endpoint, const ara::com::codegen::EventAddress *events, size_t count)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (size_t i = 0; i < count; ++i)
+            {
+                auto found = subscriptions_.find(keyOf(ara::com::codegen::Role::kClient, endpoint, events[i].eventId));
+                if (found != subscriptions_.end() && --found->second == 0)
+                {
+                    subscriptions_.erase(found);
+                }
+            }
+        }
+
+        const Counters &GetCounters() const { return counters_; }
+
+    private:
+        using Key = std::tuple<ara::com::codegen::Role, uint16_t, uint16_t, uint16_t>;
+
+        struct Receiver
+        {
+            uint64_t listenId;
+            ara::com::codegen::InboundHandler handler;
+            void *target;
+        };
+
+        // 请求的 context 应答按它找回 proxy
+        struct Route
+        {
+            ara::com::codegen::Endpoint endpoint;
+            uint16_t methodId;
+            uint64_t listenId; // 发出请求的 proxy
+        };
+
+        static Key keyOf(ara::com::codegen::Role role, const ara::com::codegen::Endpoint &endpoint, uint16_t id)
+        {
+            return Key(role, endpoint.serviceId, endpoint.instanceId, id);
+        }
+
+        template <typename Writer>
+        std::vector<uint8_t> serialize(size_t size, Writer &write)
+        {
+            std::vector<uint8_t> buffer;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!spare_.empty())
+                {
+                    buffer.swap(spare_.back());
+                    spare_.pop_back();
+                }
+            }
+            buffer.resize(size);
+            write(buffer.data());
+            return buffer;
+        }
+
+        void release(std::vector<uint8_t> buffer)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            spare_.push_back(std::move(buffer));
+        }
+
+        // 在锁外调用 handler handler 里可以再发送 listenId 不是 kInvalidListenId 时只交给它
+        void deliver(ara::com::codegen::Role role, const ara::com::codegen::Endpoint &endpoint, const ara::com::codegen::InboundMessage &message,
+                     uint64_t listenId = ara::com::codegen::kInvalidListenId)
+        {
+            std::vector<Receiver> receivers;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                const Key key = keyOf(role, endpoint, message.id);
+                const bool event = message.id >= 0x8000;
+                if (!event || subscriptions_.count(key) != 0)
+                {
+                    auto range = receivers_.equal_range(key);
+                    for (auto receiver = range.first; receiver != range.second; ++receiver)
+                    {
+                        if (listenId == ara::com::codegen::kInvalidListenId || receiver->second.listenId == listenId)
+                        {
+                            receivers.push_back(receiver->second);
+                        }
+                    }
+                }
+            }
+            if (receivers.empty())
+            {
+                ++counters_.dropped;
+            }
+            for (const Receiver &receiver : receivers)
+            {
+                receiver.handler(receiver.target, message);
+            }
+        }
+
+        std::mutex mutex_;
+        std::multimap<Key, Receiver> receivers_;
+        std::map<Key, uint32_t> subscriptions_;
+        std::vector<std::vector<uint8_t>> spare_; // 复用的发送缓冲区
+        uint64_t nextListenId_ = 1;
+        Counters counters_;
+    };
+
+} // namespace codelab
+
+#endif // _LOOPBACK_TRANSPORT_HPP_
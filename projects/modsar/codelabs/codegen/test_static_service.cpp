@@ -0,0 +1,192 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief aragen 生成的 GreeterProxy GreeterSkeleton 经回环 transport 的调用 应答 事件
+ * \author ZYL
+ * \date 2026/10/18
+ *
+ * g++ -O2 -std=c++14 -pthread -I../../include test_static_service.cpp ../../sources/ara/com/serialization/byte_swap.cpp \
+ *     ../../sources/ara/com/utils/task_scheduler.cpp
+ * helloworld_service.hpp 由 helloworld.idl 生成 修改 IDL 后重新生成
+ * ../../tools/aragen/aragen helloworld.idl -o .
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <type_traits>
+
+#include "helloworld_service.hpp"
+#include "loopback_transport.hpp"
+
+using codelab::LoopbackTransport;
+
+namespace
+{
+    int failures = 0;
+
+    void check(bool condition, const char *what)
+    {
+        if (!condition)
+        {
+            std::printf("FAILED: %s\n", what);
+            ++failures;
+        }
+    }
+
+    /**
+     * \brief 用户实现 不需要虚函数 生成的 skeleton 按 method id 直接调用这些成员函数
+     */
+    class Greeter : public helloworld::GreeterSkeleton<Greeter, LoopbackTransport>
+    {
+    public:
+        Greeter(LoopbackTransport &transport, uint16_t instanceId) : GreeterSkeleton(transport, instanceId) {}
+
+        ~Greeter() { StopOfferService(); }
+
+        ara::core::Result<helloworld::HelloReply> SayHello(const helloworld::HelloRequest &request)
+        {
+            if (request.name.empty())
+            {
+                return ara::core::Result<helloworld::HelloReply>::FromError(ara::com::MakeErrorCode(ara::com::ComErrc::kFieldValueIsNotValid, 0));
+            }
+            helloworld::HelloReply reply;
+            reply.id = request.id;
+            reply.message = "hello " + request.name;
+            reply.digest.assign(request.name.begin(), request.name.end());
+            return ara::core::Result<helloworld::HelloReply>::FromValue(std::move(reply));
+        }
+
+        ara::core::Result<int32_t> Add(const std::array<int32_t, 2> &operands)
+        {
+            return ara::core::Result<int32_t>::FromValue(operands[0] + operands[1]);
+        }
+
+        void Ping(const uint32_t &sequence) { lastPing = sequence; }
+
+        uint32_t lastPing = 0;
+    };
+
+    struct GreetedCounter
+    {
+        void OnGreeted(const helloworld::HelloReply &sample)
+        {
+            ++count;
+            lastId = sample.id;
+        }
+
+        size_t count = 0;
+        uint32_t lastId = 0;
+    };
+
+    using Proxy = helloworld::GreeterProxy<LoopbackTransport, GreetedCounter>;
+
+    static_assert(!std::is_polymorphic<Proxy>::value, "generated proxy must not have virtual functions");
+    static_assert(!std::is_polymorphic<Greeter>::value, "generated skeleton must not have virtual functions");
+    static_assert(helloworld::GreeterService::ClientMessages::kSize == 3, "two methods with responses and one event");
+
+    void testCalls()
+    {
+        LoopbackTransport transport;
+        Greeter greeter(transport, 1);
+        check(greeter.OfferService().HasValue(), "offer");
+        Greeter duplicate(transport, 1);
+        check(!duplicate.OfferService().HasValue(), "second skeleton of the same instance is rejected");
+        Proxy proxy(transport, 1);
+
+        helloworld::HelloRequest request;
+        request.id = 7;
+        request.name = "modsar";
+        ara::core::Result<helloworld::HelloReply> reply = proxy.SayHello(request).GetResult();
+        check(reply.HasValue() && reply.Value().id == 7 && reply.Value().message == "hello modsar" && reply.Value().digest.size() == 6,
+              "SayHello round trip");
+
+        ara::core::Result<int32_t> sum = proxy.Add(std::array<int32_t, 2>{{40, 2}}).GetResult();
+        check(sum.HasValue() && sum.Value() == 42, "Add round trip");
+
+        request.name.clear();
+        ara::core::Result<helloworld::HelloReply> rejected = proxy.SayHello(request).GetResult();
+        check(!rejected.HasValue() && rejected.Error() == ara::com::MakeErrorCode(ara::com::ComErrc::kCouldNotExecute, 0),
+              "error returned by the skeleton arrives as kCouldNotExecute");
+
+        check(proxy.Ping(99).HasValue() && greeter.lastPing == 99, "fire and forget");
+        check(transport.GetCounters().responses == 3, "fire and forget sends no response");
+
+        greeter.Greeted.Send(reply.Value());
+        check(proxy.GetListener().count == 0, "no event before Subscribe");
+        proxy.Subscribe();
+        greeter.Greeted.Send(reply.Value());
+        check(proxy.GetListener().count == 1 && proxy.GetListener().lastId == 7, "event after Subscribe");
+        proxy.Unsubscribe();
+        greeter.Greeted.Send(reply.Value());
+        check(proxy.GetListener().count == 1, "no event after Unsubscribe");
+    }
+
+    void testPendingCallsEndWithProxy()
+    {
+        LoopbackTransport transport;
+        ara::core::Future<helloworld::HelloReply> pending = [&transport]
+        {
+            Proxy proxy(transport, 2); // 没有 skeleton 请求被丢弃
+            helloworld::HelloRequest request;
+            request.name = "nobody";
+            return proxy.SayHello(request);
+        }();
+        ara::core::Result<helloworld::HelloReply> result = pending.GetResult();
+        check(!result.HasValue() && result.Error() == ara::com::MakeErrorCode(ara::com::ComErrc::kServiceNotAvailable, 0),
+              "calls in flight end with kServiceNotAvailable when the proxy is destroyed");
+    }
+
+    void testCallTimeout()
+    {
+        LoopbackTransport transport;
+        Proxy proxy(transport, 4); // 没有 skeleton 请求被丢弃
+        proxy.SetCallTimeout(std::chrono::milliseconds(20));
+        helloworld::HelloRequest request;
+        request.name = "nobody";
+        ara::core::Result<helloworld::HelloReply> result = proxy.SayHello(request).GetResult();
+        check(!result.HasValue() && result.Error() == ara::com::MakeErrorCode(ara::com::ComErrc::kCommunicationLinkError, 0),
+              "a call without response ends with kCommunicationLinkError after the timeout");
+    }
+
+    void testResponsesGoToTheCaller()
+    {
+        LoopbackTransport transport;
+        Greeter greeter(transport, 5);
+        greeter.OfferService();
+        Proxy first(transport, 5);
+        Proxy second(transport, 5);
+        // 两个 proxy 的 session 都从 1 开始 应答只回到发出请求的 proxy
+        ara::core::Result<int32_t> a = first.Add(std::array<int32_t, 2>{{1, 1}}).GetResult();
+        ara::core::Result<int32_t> b = second.Add(std::array<int32_t, 2>{{2, 2}}).GetResult();
+        check(a.HasValue() && a.Value() == 2 && b.HasValue() && b.Value() == 4, "proxies of the same instance get their own responses");
+        check(transport.GetCounters().dropped == 0, "responses are not fanned out");
+    }
+
+    void benchCalls(size_t rounds)
+    {
+        LoopbackTransport transport;
+        Greeter greeter(transport, 3);
+        greeter.OfferService();
+        Proxy proxy(transport, 3);
+        const std::array<int32_t, 2> operands{{1, 2}};
+        int64_t total = 0;
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < rounds; ++i)
+        {
+            total += proxy.Add(operands).GetResult().Value();
+        }
+        const double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        check(total == static_cast<int64_t>(rounds) * 3, "bench results");
+        std::printf("Add round trip over loopback: %.1f ns per call (%zu calls)\n", elapsed / rounds, rounds);
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    testCalls();
+    testPendingCallsEndWithProxy();
+    testCallTimeout();
+    testResponsesGoToTheCaller();
+    benchCalls(argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000);
+    std::printf("%s\n", failures == 0 ? "PASSED" : "FAILED");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,57 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief E2E profile 使用的 CRC 在不同数据长度下的吞吐
+ * \author ZYL
+ * \date 2026/10/18
+ *
+ * g++ -O2 -std=c++14 -I../../include bench_crc.cpp ../../sources/ara/com/e2e/crc.cpp
+ */
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "ara/com/e2e/crc.h"
+
+using namespace ara::com::e2e;
+
+static const size_t kTotalBytes = 256 * 1024 * 1024;
+
+template <typename Function>
+static double gigabytesPerSecond(size_t length, Function &&function)
+{
+    const size_t rounds = kTotalBytes / length;
+    volatile uint64_t sink = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for (size_t round = 0; round < rounds; ++round)
+    {
+        sink = sink + function();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+    return static_cast<double>(rounds * length) / elapsed.count() / 1e9;
+}
+
+int main()
+{
+    const size_t lengths[] = {16, 64, 256, 4096, 65536, 1024 * 1024};
+    std::vector<uint8_t> data(1024 * 1024);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<uint8_t>(i * 131 + 7);
+    }
+    printf("pclmul: %s\n", IsCrcAccelerated() ? "yes" : "no");
+    printf("%10s %10s %10s %10s %10s  (GB/s)\n", "length", "crc8h2f", "crc16", "crc32p4", "crc64");
+    for (size_t length : lengths)
+    {
+        const uint8_t *bytes = data.data();
+        double crc8 = gigabytesPerSecond(length, [&]
+                                         { return CalculateCrc8H2F(bytes, length, 0, true); });
+        double crc16 = gigabytesPerSecond(length, [&]
+                                          { return CalculateCrc16(bytes, length, 0, true); });
+        double crc32 = gigabytesPerSecond(length, [&]
+                                          { return CalculateCrc32P4(bytes, length, 0, true); });
+        double crc64 = gigabytesPerSecond(length, [&]
+                                          { return CalculateCrc64(bytes, length, 0, true); });
+        printf("%10zu %10.2f %10.2f %10.2f %10.2f\n", length, crc8, crc16, crc32, crc64);
+    }
+    return 0;
+}
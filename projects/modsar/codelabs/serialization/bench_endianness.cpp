@@ -0,0 +1,98 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 1M 元素数组的 SOME/IP 序列化/反序列化耗时 对比各字节序转换内核与 memcpy
+ * \author ZYL
+ * \date 2026/10/18
+ *
+ * g++ -O2 -std=c++14 -I../../include bench_endianness.cpp ../../sources/ara/com/serialization/byte_swap.cpp
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "ara/core/vector.h"
+#include "ara/com/serialization/someip_serializer.hpp"
+
+using namespace ara::com::serialization;
+
+struct LidarPoint
+{
+    float x;
+    float y;
+    float z;
+    float intensity;
+};
+ARA_COM_SOMEIP_STRUCT(LidarPoint, &LidarPoint::x, &LidarPoint::y, &LidarPoint::z, &LidarPoint::intensity)
+
+static const size_t kElements = 1000000;
+static const int kRounds = 50;
+
+template <typename Function>
+static double bestOf(Function &&function)
+{
+    double best = 1e30;
+    for (int round = 0; round < kRounds; ++round)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        function();
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - begin;
+        if (elapsed.count() < best)
+        {
+            best = elapsed.count();
+        }
+    }
+    return best;
+}
+
+static void report(const char *name, const char *kernel, size_t bytes, double serializeUs, double deserializeUs)
+{
+    printf("%-22s %-8s %8.1f us %8.2f GB/s | %8.1f us %8.2f GB/s\n", name, kernel,
+           serializeUs, bytes / serializeUs / 1e3, deserializeUs, bytes / deserializeUs / 1e3);
+}
+
+template <typename T>
+static void benchArray(const char *name, const ara::core::Vector<T> &input)
+{
+    std::vector<uint8_t> wire(GetSerializedSize(input));
+    ara::core::Vector<T> output;
+    const ByteSwapKernel kernels[] = {ByteSwapKernel::kScalar, ByteSwapKernel::kSsse3, ByteSwapKernel::kAvx2, ByteSwapKernel::kNeon};
+    for (ByteSwapKernel kernel : kernels)
+    {
+        if (!SetByteSwapKernel(kernel))
+        {
+            continue;
+        }
+        double serializeUs = bestOf([&]
+                                    { Serialize(input, wire.data(), wire.size()); });
+        double deserializeUs = bestOf([&]
+                                      { Deserialize(wire.data(), wire.size(), output); });
+        report(name, ByteSwapKernelName(kernel), wire.size(), serializeUs, deserializeUs);
+    }
+    // 主机序与网络序相同时的路径 作为上限参考
+    std::vector<uint8_t> copy(wire.size());
+    double copyUs = bestOf([&]
+                           { std::memcpy(copy.data(), input.data(), input.size() * sizeof(T)); });
+    report(name, "memcpy", wire.size(), copyUs, copyUs);
+}
+
+int main()
+{
+    ara::core::Vector<float> floats(kElements);
+    ara::core::Vector<uint16_t> shorts(kElements);
+    ara::core::Vector<double> doubles(kElements);
+    ara::core::Vector<LidarPoint> points(kElements);
+    for (size_t i = 0; i < kElements; ++i)
+    {
+        floats[i] = static_cast<float>(i) * 0.5f;
+        shorts[i] = static_cast<uint16_t>(i);
+        doubles[i] = static_cast<double>(i) * 0.25;
+        points[i] = LidarPoint{floats[i], floats[i] + 1, floats[i] + 2, 0.5f};
+    }
+    printf("%-22s %-8s %22s | %22s\n", "payload", "kernel", "serialize", "deserialize");
+    benchArray("Vector<float>", floats);
+    benchArray("Vector<uint16_t>", shorts);
+    benchArray("Vector<double>", doubles);
+    benchArray("Vector<LidarPoint>", points);
+    return 0;
+}
@@ -0,0 +1,91 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 周期性打印另一个进程的追踪统计页 按阶段看时延分布
+ * \author ZYL
+ * \date 2026/10/18
+ *
+ * g++ -O2 -std=c++14 -I../../include trace_stat.cpp ../../sources/ara/com/trace/trace_registry.cpp ../../sources/ara/com/trace/trace_channel.cpp \
+ *     ../../sources/ara/com/trace/latency_histogram.cpp ../../sources/ara/com/trace/trace_types.cpp -lrt
+ * ./a.out /aracom_trace.camera 1
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#include "ara/com/trace/trace_registry.h"
+
+using namespace ara::com::trace;
+
+static const char *roleName(ChannelRole role)
+{
+    switch (role)
+    {
+    case ChannelRole::kEventSender:
+        return "event-tx";
+    case ChannelRole::kEventReceiver:
+        return "event-rx";
+    case ChannelRole::kMethodClient:
+        return "client";
+    case ChannelRole::kMethodServer:
+        return "server";
+    }
+    return "?";
+}
+
+static void printStage(const char *stage, const LatencySummary &summary)
+{
+    if (summary.count == 0)
+    {
+        return;
+    }
+    std::printf("    %-10s n=%-10llu p50=%8.1f p99=%8.1f p99.9=%8.1f max=%8.1f us\n", stage,
+                static_cast<unsigned long long>(summary.count), summary.p50 / 1e3, summary.p99 / 1e3, summary.p999 / 1e3,
+                summary.max / 1e3);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        std::printf("usage: %s <page name> [interval seconds]\n", argv[0]);
+        return 1;
+    }
+    const int interval = argc > 2 ? std::atoi(argv[2]) : 1;
+    TraceStatsReader reader(argv[1]);
+    if (!reader.Open().HasValue())
+    {
+        std::printf("cannot open %s\n", argv[1]);
+        return 1;
+    }
+    for (;;)
+    {
+        std::printf("pid %u\n", reader.PublisherPid());
+        reader.ForEachChannel([](const TraceStatistics &statistics)
+                              {
+                                  const ChannelDescriptor &descriptor = statistics.descriptor;
+                                  std::printf("  %-24s %-8s %04x.%04x.%04x sent=%llu received=%llu untraced=%llu gaps=%llu "
+                                              "reordered=%llu duplicates=%llu restarts=%llu\n",
+                                              descriptor.name, roleName(descriptor.role), descriptor.service, descriptor.instance,
+                                              descriptor.id, static_cast<unsigned long long>(statistics.sent),
+                                              static_cast<unsigned long long>(statistics.received),
+                                              static_cast<unsigned long long>(statistics.untraced),
+                                              static_cast<unsigned long long>(statistics.gaps),
+                                              static_cast<unsigned long long>(statistics.reordered),
+                                              static_cast<unsigned long long>(statistics.duplicates),
+                                              static_cast<unsigned long long>(statistics.restarts));
+                                  printStage("serialize", statistics.serialize);
+                                  printStage("transport", statistics.transport);
+                                  printStage("queue", statistics.queue);
+                                  printStage("handler", statistics.handler);
+                                  printStage("roundTrip", statistics.roundTrip);
+                              });
+        // 输出接到管道或 tee 时不刷新会一直停在缓冲区里
+        std::fflush(stdout);
+        if (interval <= 0)
+        {
+            return 0;
+        }
+        std::this_thread::sleep_for(std::chrono::seconds(interval));
+    }
+}
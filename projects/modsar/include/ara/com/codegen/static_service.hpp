@@ -0,0 +1,337 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief aragen 生成的 proxy skeleton 使用的编译期方法表和内联的收发函数
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _STATIC_SERVICE_HPP_
+#define _STATIC_SERVICE_HPP_
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "ara/core/future.h"
+#include "ara/core/promise.h"
+#include "ara/core/result.h"
+#include "ara/com/com_error_domain.h"
+#include "ara/com/rpc/call_slot_table.hpp"
+#include "ara/com/serialization/someip_serializer.hpp"
+
+/**
+ * 生成代码不继承 MethodProxy / MethodSkeleton 也不经过 std::function
+ * 方法 id 和类型在编译期确定 收到消息后按 id switch 到具体类型的反序列化
+ * 发送时直接调用 transport 的模板函数 序列化由 Writer lambda 内联写进 transport 的缓冲区
+ *
+ * Transport 是模板参数 需要提供
+ * \code
+ * uint64_t Listen(Role role, const Endpoint &endpoint, const uint16_t *ids, size_t count, InboundHandler handler, void *target);
+ * void Unlisten(uint64_t listenId);
+ * template <typename Writer> ara::core::Result<void> SendRequest(uint64_t listenId, const Endpoint &endpoint, uint16_t methodId, uint16_t session, bool expectResponse, size_t size, Writer &&write);
+ * template <typename Writer> ara::core::Result<void> SendResponse(const InboundMessage &request, bool ok, size_t size, Writer &&write);
+ * template <typename Writer> ara::core::Result<void> Notify(const Endpoint &endpoint, uint16_t eventId, size_t size, Writer &&write);
+ * void OfferService(const Endpoint &endpoint, const EventAddress *events, size_t count);
+ * void StopOfferService(const Endpoint &endpoint, const EventAddress *events, size_t count);
+ * void Subscribe(const Endpoint &endpoint, const EventAddress *events, size_t count);
+ * void Unsubscribe(const Endpoint &endpoint, const EventAddress *events, size_t count);
+ * \endcode
+ * Writer 为 void(uint8_t *buffer) 向 buffer 写入恰好 size 个字节
+ * Listen 失败时返回 kInvalidListenId Unlisten 返回后 handler 不再被调用
+ * SendRequest 的应答只交给 listenId 对应的 handler session 保持调用方传入的值 多个 proxy 的 session 可以重复
+ * 没有应答的请求 listenId 为 kInvalidListenId
+ * SOME/IP 的实现见 someip::SomeIpStaticTransport
+ */
+namespace ara
+{
+    namespace com
+    {
+        namespace codegen
+        {
+            constexpr uint64_t kInvalidListenId = 0;
+
+            enum class Role : uint8_t
+            {
+                kClient, // 接收应答和事件
+                kServer  // 接收请求
+            };
+
+            struct Endpoint
+            {
+                uint16_t serviceId;
+                uint16_t instanceId;
+            };
+
+            struct EventAddress
+            {
+                uint16_t eventgroupId;
+                uint16_t eventId;
+            };
+
+            /**
+             * \brief transport 交给生成代码的一条消息 data 只在 handler 执行期间有效
+             */
+            struct InboundMessage
+            {
+                uint16_t id;         // method id 或 event id
+                uint16_t session;
+                bool error;          // 应答为错误应答
+                const uint8_t *data;
+                size_t length;
+                const void *context; // transport 私有 SendResponse 据此找到请求
+            };
+
+            /**
+             * \brief target 为 Listen 时传入的 proxy 或 skeleton
+             */
+            using InboundHandler = void (*)(void *target, const InboundMessage &message);
+
+            /**
+             * \brief 有应答的方法 SOME/IP 规定 method id 小于 0x8000
+             */
+            template <uint16_t Id, typename Request, typename Response>
+            struct Method
+            {
+                static_assert(Id < 0x8000, "method id must be below 0x8000");
+
+                static constexpr uint16_t kId = Id;
+                using RequestType = Request;
+                using ResponseType = Response;
+            };
+
+            /**
+             * \brief 没有应答的方法
+             */
+            template <uint16_t Id, typename Request>
+            struct FireAndForget
+            {
+                static_assert(Id < 0x8000, "method id must be below 0x8000");
+
+                static constexpr uint16_t kId = Id;
+                using RequestType = Request;
+            };
+
+            /**
+             * \brief 事件 event id 不小于 0x8000
+             */
+            template <uint16_t Id, uint16_t EventgroupId, typename Sample>
+            struct Event
+            {
+                static_assert(Id >= 0x8000 && Id != 0xFFFF, "event id must be in 0x8000..0xFFFE");
+
+                static constexpr uint16_t kId = Id;
+                static constexpr uint16_t kEventgroupId = EventgroupId;
+                using SampleType = Sample;
+            };
+
+            namespace detail
+            {
+                template <size_t N>
+                constexpr bool Distinct(const std::array<uint16_t, N> &ids)
+                {
+                    for (size_t i = 0; i < N; ++i)
+                    {
+                        for (size_t j = i + 1; j < N; ++j)
+                        {
+                            if (ids[i] == ids[j])
+                            {
+                                return false;
+                            }
+                        }
+                    }
+                    return true;
+                }
+
+                inline void WriteNothing(uint8_t *) {}
+            } // namespace detail
+
+            /**
+             * \brief 一组方法或事件的 id 交给 transport 的 Listen
+             */
+            template <typename... Entries>
+            struct IdList
+            {
+                static constexpr size_t kSize = sizeof...(Entries);
+                static constexpr bool kDistinct = detail::Distinct(std::array<uint16_t, sizeof...(Entries)>{{Entries::kId...}});
+
+                static const std::array<uint16_t, sizeof...(Entries)> &Ids()
+                {
+                    static const std::array<uint16_t, sizeof...(Entries)> ids{{Entries::kId...}};
+                    return ids;
+                }
+            };
+
+            /**
+             * \brief 服务的全部事件 交给 transport 的 OfferService 和 Subscribe
+             */
+            template <typename... Events>
+            struct EventList
+            {
+                static constexpr size_t kSize = sizeof...(Events);
+
+                static const std::array<EventAddress, sizeof...(Events)> &Addresses()
+                {
+                    static const std::array<EventAddress, sizeof...(Events)> addresses{{EventAddress{Events::kEventgroupId, Events::kId}...}};
+                    return addresses;
+                }
+            };
+
+            /**
+             * \brief proxy 发起调用 应答由 Complete 按 session 找回
+             * \param listenId proxy 以 kClient Listen 得到的 id 应答只交给它
+             * \param timeout 超过这个时长仍未应答时以 kCommunicationLinkError 结束
+             * \return 在途调用已满或发送失败时 Future 直接带错误返回
+             */
+            template <typename MethodType, typename Transport>
+            inline ara::core::Future<typename MethodType::ResponseType> Call(Transport &transport, uint64_t listenId, const Endpoint &endpoint,
+                                                                              const std::shared_ptr<ara::com::rpc::CallSlotTable<typename MethodType::ResponseType>> &calls,
+                                                                              const typename MethodType::RequestType &request, std::chrono::milliseconds timeout)
+            {
+                using Response = typename MethodType::ResponseType;
+                using Table = ara::com::rpc::CallSlotTable<Response>;
+                const typename Table::Clock::time_point deadline = Table::Clock::now() + timeout;
+                ara::core::Result<typename Table::Call> reserved = calls->Reserve(deadline);
+                if (!reserved.HasValue())
+                {
+                    ara::core::Promise<Response> failed;
+                    failed.SetError(reserved.Error());
+                    return failed.get_future();
+                }
+                typename Table::Call call = std::move(reserved).Value();
+                ara::core::Result<void> sent = transport.SendRequest(listenId, endpoint, MethodType::kId, call.session, true,
+                                                                     ara::com::serialization::GetSerializedSize(request),
+                                                                     [&request](uint8_t *buffer)
+                                                                     { ara::com::serialization::SomeIpCodec<typename MethodType::RequestType>::Write(request, buffer); });
+                if (!sent.HasValue())
+                {
+                    calls->Cancel(call.session, sent.Error());
+                    return std::move(call.future);
+                }
+                ara::com::rpc::ScheduleExpiry(calls, deadline, [](Table &table) -> Table &
+                                              { return table; },
+                                              [](Table &, uint16_t) {});
+                return std::move(call.future);
+            }
+
+            /**
+             * \brief 发送没有应答的请求
+             */
+            template <typename MethodType, typename Transport>
+            inline ara::core::Result<void> Send(Transport &transport, const Endpoint &endpoint, const typename MethodType::RequestType &request)
+            {
+                return transport.SendRequest(kInvalidListenId, endpoint, MethodType::kId, 0, false, ara::com::serialization::GetSerializedSize(request),
+                                             [&request](uint8_t *buffer)
+                                             { ara::com::serialization::SomeIpCodec<typename MethodType::RequestType>::Write(request, buffer); });
+            }
+
+            /**
+             * \brief proxy 收到应答 错误应答以 kCouldNotExecute 结束 格式错误以 kCommunicationStackError 结束
+             * \return session 没有对应的在途调用时返回 false
+             */
+            template <typename MethodType>
+            inline bool Complete(ara::com::rpc::CallSlotTable<typename MethodType::ResponseType> &calls, const InboundMessage &message)
+            {
+                return calls.Complete(message.session, [&message](ara::core::Promise<typename MethodType::ResponseType> &promise)
+                                      {
+                                          if (message.error)
+                                          {
+                                              promise.SetError(MakeErrorCode(ComErrc::kCouldNotExecute, 0));
+                                              return;
+                                          }
+                                          typename MethodType::ResponseType response;
+                                          if (!ara::com::serialization::Deserialize(message.data, message.length, response).HasValue())
+                                          {
+                                              promise.SetError(MakeErrorCode(ComErrc::kCommunicationStackError, 0));
+                                              return;
+                                          }
+                                          promise.set_value(std::move(response));
+                                      });
+            }
+
+            /**
+             * \brief proxy 收到事件 格式错误的 sample 被丢弃
+             * \param receive void(const SampleType &)
+             */
+            template <typename EventType, typename Receive>
+            inline bool Deliver(const InboundMessage &message, Receive &&receive)
+            {
+                typename EventType::SampleType sample;
+                if (!ara::com::serialization::Deserialize(message.data, message.length, sample).HasValue())
+                {
+                    return false;
+                }
+                receive(static_cast<const typename EventType::SampleType &>(sample));
+                return true;
+            }
+
+            /**
+             * \brief skeleton 处理有应答的请求 格式错误或 handler 返回错误时发送错误应答
+             * \param handler ara::core::Result<ResponseType>(const RequestType &)
+             */
+            template <typename MethodType, typename Transport, typename Handler>
+            inline ara::core::Result<void> Serve(Transport &transport, const InboundMessage &message, Handler &&handler)
+            {
+                using Response = typename MethodType::ResponseType;
+                typename MethodType::RequestType request;
+                if (!ara::com::serialization::Deserialize(message.data, message.length, request).HasValue())
+                {
+                    return transport.SendResponse(message, false, 0, detail::WriteNothing);
+                }
+                const ara::core::Result<Response> response = handler(static_cast<const typename MethodType::RequestType &>(request));
+                if (!response.HasValue())
+                {
+                    return transport.SendResponse(message, false, 0, detail::WriteNothing);
+                }
+                const Response &value = response.Value();
+                return transport.SendResponse(message, true, ara::com::serialization::GetSerializedSize(value), [&value](uint8_t *buffer)
+                                              { ara::com::serialization::SomeIpCodec<Response>::Write(value, buffer); });
+            }
+
+            /**
+             * \brief skeleton 处理没有应答的请求 格式错误的请求被丢弃
+             * \param handler void(const RequestType &)
+             */
+            template <typename MethodType, typename Handler>
+            inline bool Accept(const InboundMessage &message, Handler &&handler)
+            {
+                typename MethodType::RequestType request;
+                if (!ara::com::serialization::Deserialize(message.data, message.length, request).HasValue())
+                {
+                    return false;
+                }
+                handler(static_cast<const typename MethodType::RequestType &>(request));
+                return true;
+            }
+
+            /**
+             * \brief skeleton 的事件成员 用法和 ara::com 的 skeleton.Event.Send(sample) 一致
+             */
+            template <typename EventType, typename Transport>
+            class EventSender
+            {
+            public:
+                using SampleType = typename EventType::SampleType;
+
+                EventSender(Transport &transport, const Endpoint &endpoint) : transport_(transport), endpoint_(endpoint) {}
+
+                ara::core::Result<void> Send(const SampleType &sample)
+                {
+                    return transport_.Notify(endpoint_, EventType::kId, ara::com::serialization::GetSerializedSize(sample), [&sample](uint8_t *buffer)
+                                             { ara::com::serialization::SomeIpCodec<SampleType>::Write(sample, buffer); });
+                }
+
+            private:
+                Transport &transport_;
+                const Endpoint endpoint_;
+            };
+
+        } // namespace codegen
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _STATIC_SERVICE_HPP_
@@ -0,0 +1,189 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief ara::com 错误域定义
+ * \author ZYL
+ * \date 2026/10/18
+ */
+
+#ifndef _ARA_COM_COM_ERROR_DOMAIN_H_
+#define _ARA_COM_COM_ERROR_DOMAIN_H_
+
+#include "ara/core/error_code.h"
+#include "ara/core/error_domain.h"
+#include "ara/core/exception.h"
+
+namespace ara
+{
+    namespace com
+    {
+        /**
+         * \brief ComErrc 错误码枚举定义
+         *
+         * @ID{[SWS_CM_10432]}
+         */
+        enum class ComErrc : ara::core::ErrorDomain::CodeType
+        {
+            kServiceNotAvailable = 1,             ///< 服务不可用
+            kMaxSamplesExceeded = 2,              ///< 应用持有的 SamplePtr 超过 Subscribe 时约定的数量
+            kNetworkBindingFailure = 3,           ///< 本地 binding 出错
+            kGrantEnforcementError = 4,           ///< IAM 拒绝了请求
+            kPeerIsUnreachable = 5,               ///< TLS 握手失败 对端不可达
+            kFieldValueIsNotValid = 6,            ///< Field 在 OfferService 前没有通过 Update 设置初值
+            kSetHandlerNotSet = 7,                ///< 有 setter 的 Field 没有注册 SetHandler
+            kUnsetFailure = 8,                    ///< 注销 handler 失败
+            kSampleAllocationFailure = 9,         ///< 没有可用的 sample 内存
+            kIllegalUseOfAllocate = 10,           ///< Allocate 在 binding 不支持时被调用
+            kServiceNotOffered = 11,              ///< 服务没有被 Offer
+            kCommunicationLinkError = 12,         ///< 通信链路中断
+            kNoClients = 13,                      ///< 没有客户端连接
+            kCommunicationStackError = 14,        ///< 通信栈出错
+            kMaxSampleCountNotRealizable = 18,    ///< 申请的 sample 数量无法满足
+            kMaxSubscribersExceeded = 19,         ///< 订阅者数量超出上限
+            kWrongMethodCallProcessingMode = 20,  ///< 当前 MethodCallProcessingMode 不允许该调用
+            kErroneousFileHandle = 21,            ///< 文件句柄无效
+            kCouldNotExecute = 22,                ///< 命令无法执行
+            kInvalidInstanceIdentifierString = 23 ///< InstanceIdentifier 字符串格式错误
+        };
+
+        /**
+         * \brief ara::com 错误对应的异常类型
+         *
+         * @ID{[SWS_CM_11327]}
+         */
+        class ComException : public ara::core::Exception
+        {
+        public:
+            /**
+             * \brief 通过 ErrorCode 构造 ComException
+             * \param err  错误码
+             */
+            explicit ComException(ara::core::ErrorCode err) noexcept : ara::core::Exception(err) {}
+        };
+
+        /**
+         * \brief ara::com 的错误域
+         * \domainid{0x8000'0000'0000'1267}
+         *
+         * @ID{[SWS_CM_11329]}
+         */
+        class ComErrorDomain final : public ara::core::ErrorDomain
+        {
+            constexpr static ara::core::ErrorDomain::IdType kId = 0x8000000000001267;
+
+        public:
+            /**
+             * \brief 错误码的枚举值
+             */
+            using Errc = ComErrc;
+
+            /**
+             * \brief 异常的类型
+             */
+            using Exception = ComException;
+
+            /**
+             * \brief 默认构造函数
+             */
+            constexpr ComErrorDomain() noexcept : ara::core::ErrorDomain(kId) {}
+
+            /**
+             * \brief 返回 ComErrorDomain 文字表示
+             * \returns "Com"
+             */
+            char const *Name() const noexcept override { return "Com"; }
+
+            /**
+             * \brief 返回错误码对应文字信息
+             * \param errorCode  Com 类型错误码
+             * \returns 错误码对应错误类型
+             */
+            char const *Message(ara::core::ErrorDomain::CodeType errorCode) const noexcept override
+            {
+                Errc const code = static_cast<Errc>(errorCode);
+                switch (code)
+                {
+                case Errc::kServiceNotAvailable:
+                    return "Service not available";
+                case Errc::kMaxSamplesExceeded:
+                    return "Max samples exceeded";
+                case Errc::kNetworkBindingFailure:
+                    return "Network binding failure";
+                case Errc::kGrantEnforcementError:
+                    return "Grant enforcement error";
+                case Errc::kPeerIsUnreachable:
+                    return "Peer is unreachable";
+                case Errc::kFieldValueIsNotValid:
+                    return "Field value is not valid";
+                case Errc::kSetHandlerNotSet:
+                    return "Set handler not set";
+                case Errc::kUnsetFailure:
+                    return "Unset failure";
+                case Errc::kSampleAllocationFailure:
+                    return "Sample allocation failure";
+                case Errc::kIllegalUseOfAllocate:
+                    return "Illegal use of allocate";
+                case Errc::kServiceNotOffered:
+                    return "Service not offered";
+                case Errc::kCommunicationLinkError:
+                    return "Communication link error";
+                case Errc::kNoClients:
+                    return "No clients";
+                case Errc::kCommunicationStackError:
+                    return "Communication stack error";
+                case Errc::kMaxSampleCountNotRealizable:
+                    return "Max sample count not realizable";
+                case Errc::kMaxSubscribersExceeded:
+                    return "Max subscribers exceeded";
+                case Errc::kWrongMethodCallProcessingMode:
+                    return "Wrong method call processing mode";
+                case Errc::kErroneousFileHandle:
+                    return "Erroneous file handle";
+                case Errc::kCouldNotExecute:
+                    return "Could not execute";
+                case Errc::kInvalidInstanceIdentifierString:
+                    return "Invalid instance identifier string";
+                default:
+                    return "Unknown error";
+                }
+            }
+
+            /**
+             * \brief 抛出错误码对应 ComException
+             * \param errorCode  Com 错误码实例
+             */
+            void ThrowAsException(ara::core::ErrorCode const &errorCode) const noexcept(false) override
+            {
+                ara::core::ThrowOrTerminate<Exception>(errorCode);
+            }
+        };
+
+        namespace internal
+        {
+            constexpr ComErrorDomain g_comErrorDomain;
+        } // namespace internal
+
+        /**
+         * \brief 返回全局 ComErrorDomain 的引用
+         *
+         * @ID{[SWS_CM_11330]}
+         */
+        constexpr ara::core::ErrorDomain const &GetComErrorDomain() noexcept { return internal::g_comErrorDomain; }
+
+        /**
+         * \brief 创建 ComErrorDomain 内的 ErrorCode
+         * \param code  ComErrc 错误码
+         * \param data  补充数据
+         * \returns 一个新的 ErrorCode 实例
+         *
+         * @ID{[SWS_CM_11331]}
+         */
+        constexpr ara::core::ErrorCode MakeErrorCode(ComErrc code, ara::core::ErrorDomain::SupportDataType data) noexcept
+        {
+            return ara::core::ErrorCode(static_cast<ara::core::ErrorDomain::CodeType>(code), GetComErrorDomain(), data);
+        }
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _ARA_COM_COM_ERROR_DOMAIN_H_
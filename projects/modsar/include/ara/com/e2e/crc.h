@@ -0,0 +1,67 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief E2E profile 使用的 CRC 算法 接口语义与 AUTOSAR Crc 模块相同
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _CRC_H_
+#define _CRC_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ara
+{
+    namespace com
+    {
+        namespace e2e
+        {
+            /**
+             * \brief 所有函数都可以分段计算
+             *
+             * isFirstCall 为 true 时从算法的初值开始 忽略 startValue
+             * 否则 startValue 为上一段的返回值 用于跳过 CRC 字段分两段计算
+             *
+             * 实现使用 slicing-by-8 查表 长数据的 CRC32P4 / CRC64 在支持 PCLMULQDQ 的 CPU 上用无进位乘法折叠
+             */
+
+            /**
+             * \brief CRC8H2F 多项式 0x2F 初值 0xFF 结果异或 0xFF (profile 22)
+             *
+             * @ID{[SWS_Crc_00043]}
+             */
+            uint8_t CalculateCrc8H2F(const uint8_t *data, size_t length, uint8_t startValue, bool isFirstCall);
+
+            /**
+             * \brief CRC16 CCITT-FALSE 多项式 0x1021 初值 0xFFFF (profile 5 / 6)
+             *
+             * @ID{[SWS_Crc_00019]}
+             */
+            uint16_t CalculateCrc16(const uint8_t *data, size_t length, uint16_t startValue, bool isFirstCall);
+
+            /**
+             * \brief CRC32P4 多项式 0xF4ACFB13 反射 初值和结果异或 0xFFFFFFFF (profile 4)
+             *
+             * @ID{[SWS_Crc_00058]}
+             */
+            uint32_t CalculateCrc32P4(const uint8_t *data, size_t length, uint32_t startValue, bool isFirstCall);
+
+            /**
+             * \brief CRC64 ECMA-182 多项式 0x42F0E1EBA9EA3693 反射 初值和结果异或全 1 (profile 7)
+             *
+             * @ID{[SWS_Crc_00061]}
+             */
+            uint64_t CalculateCrc64(const uint8_t *data, size_t length, uint64_t startValue, bool isFirstCall);
+
+            /**
+             * \brief CRC32P4 / CRC64 是否使用了 PCLMULQDQ
+             */
+            bool IsCrcAccelerated();
+
+        } // namespace e2e
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _CRC_H_
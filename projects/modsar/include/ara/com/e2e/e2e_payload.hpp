@@ -0,0 +1,99 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 带 E2E 头部的序列化和反序列化
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _E2E_PAYLOAD_HPP_
+#define _E2E_PAYLOAD_HPP_
+
+#include <cstring>
+#include <vector>
+
+#include "ara/com/e2e/e2e_protector.h"
+#include "ara/com/serialization/someip_serializer.hpp"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace e2e
+        {
+            /**
+             * \brief 序列化并在 offset 处插入 E2E 头部 offset 之后的数据顺延 HeaderSize 个字节
+             *
+             * 只分配一次 序列化结果直接写到头部两侧
+             */
+            template <typename T, typename PayloadType>
+            ara::core::Result<void> SerializeProtected(const T &value, E2EProtector &protector, PayloadType &payload)
+            {
+                const size_t bodySize = serialization::GetSerializedSize(value);
+                const size_t headerSize = protector.HeaderSize();
+                const size_t offset = protector.HeaderOffset();
+                if (offset > bodySize)
+                {
+                    return ara::core::Result<void>::FromError(MakeErrorCode(ComErrc::kCommunicationStackError, 0));
+                }
+                std::vector<uint8_t> buffer(bodySize + headerSize);
+                ara::core::Result<size_t> written = serialization::Serialize(value, buffer.data() + headerSize, bodySize);
+                if (!written.HasValue())
+                {
+                    return ara::core::Result<void>::FromError(written.Error());
+                }
+                // offset 之前的数据挪到开头 头部落在 [offset, offset + headerSize)
+                std::memmove(buffer.data(), buffer.data() + headerSize, offset);
+                if (!protector.Protect(buffer.data(), buffer.size()))
+                {
+                    return ara::core::Result<void>::FromError(MakeErrorCode(ComErrc::kCommunicationStackError, 0));
+                }
+                payload.set_data(std::move(buffer));
+                return ara::core::Result<void>::FromValue();
+            }
+
+            /**
+             * \brief 校验 E2E 头部后去掉头部再反序列化
+             *
+             * kError 时不反序列化 其余状态照常交给应用 由应用根据状态决定是否使用
+             * \return 检查结果 反序列化失败时返回反序列化的错误
+             */
+            template <typename T>
+            ara::core::Result<ProfileCheckStatus> CheckAndDeserialize(const uint8_t *data, size_t length, E2EChecker &checker, T &value)
+            {
+                const ProfileCheckStatus status = checker.Check(data, length);
+                if (status == ProfileCheckStatus::kError)
+                {
+                    return ara::core::Result<ProfileCheckStatus>::FromValue(status);
+                }
+                if (!checker.IsValid())
+                {
+                    return ara::core::Result<ProfileCheckStatus>::FromError(MakeErrorCode(ComErrc::kCommunicationStackError, 0));
+                }
+                const size_t headerSize = checker.HeaderSize();
+                const size_t offset = checker.HeaderOffset();
+                ara::core::Result<void> read = ara::core::Result<void>::FromValue();
+                if (offset == 0)
+                {
+                    // 头部在最前面时直接从原数据反序列化
+                    read = serialization::Deserialize(data + headerSize, length - headerSize, value);
+                }
+                else
+                {
+                    std::vector<uint8_t> body(length - headerSize);
+                    std::memcpy(body.data(), data, offset);
+                    std::memcpy(body.data() + offset, data + offset + headerSize, length - offset - headerSize);
+                    read = serialization::Deserialize(body.data(), body.size(), value);
+                }
+                if (!read.HasValue())
+                {
+                    return ara::core::Result<ProfileCheckStatus>::FromError(read.Error());
+                }
+                return ara::core::Result<ProfileCheckStatus>::FromValue(status);
+            }
+
+        } // namespace e2e
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _E2E_PAYLOAD_HPP_
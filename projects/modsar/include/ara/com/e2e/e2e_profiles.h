@@ -0,0 +1,79 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief E2E profile 4 / 5 / 6 / 7 / 22 的头部布局和 CRC 计算
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _E2E_PROFILES_H_
+#define _E2E_PROFILES_H_
+
+#include <memory>
+
+#include "ara/com/e2e/e2e_types.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace e2e
+        {
+            /**
+             * \brief 单个 profile 只负责写头部和校验头部 counter 的连续性由 E2EChecker 判断
+             *
+             * data / length 是包含头部的完整数据 头部位于 config.offset 处
+             */
+            class IE2EProfile
+            {
+            public:
+                virtual ~IE2EProfile() = default;
+
+                /**
+                 * \brief 头部字节数
+                 */
+                virtual size_t HeaderSize() const = 0;
+
+                /**
+                 * \brief counter 的取值个数 counter 在 [0, CounterRange) 里循环
+                 */
+                virtual uint64_t CounterRange() const = 0;
+
+                /**
+                 * \brief 头部 Length 字段能表示的最大长度 没有 Length 字段的 profile 不限制
+                 */
+                virtual uint64_t MaxLength() const = 0;
+
+                /**
+                 * \brief 长度是否在配置范围内且放得下头部
+                 */
+                bool AcceptsLength(size_t length) const;
+
+                /**
+                 * \brief 填写头部并计算 CRC 长度不满足 AcceptsLength 时返回 false 数据不变
+                 */
+                virtual bool Protect(uint8_t *data, size_t length, uint32_t counter) const = 0;
+
+                /**
+                 * \brief 校验 CRC / Length / DataID 通过时取出 counter 返回 kOk 否则返回 kError
+                 */
+                virtual ProfileCheckStatus Check(const uint8_t *data, size_t length, uint32_t &counter) const = 0;
+
+                const E2EProfileConfig &GetConfig() const { return config_; }
+
+            protected:
+                explicit IE2EProfile(const E2EProfileConfig &config) : config_(config) {}
+
+                const E2EProfileConfig config_;
+            };
+
+            /**
+             * \brief 按 config.profile 创建 profile 不支持的 profile 返回 nullptr
+             */
+            std::unique_ptr<IE2EProfile> CreateE2EProfile(const E2EProfileConfig &config);
+
+        } // namespace e2e
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _E2E_PROFILES_H_
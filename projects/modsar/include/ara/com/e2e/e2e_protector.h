@@ -0,0 +1,94 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 发送端的 E2E 保护和接收端的 counter 检查
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _E2E_PROTECTOR_H_
+#define _E2E_PROTECTOR_H_
+
+#include <atomic>
+#include <memory>
+
+#include "ara/com/e2e/e2e_profiles.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace e2e
+        {
+            /**
+             * \brief 发送端 每个事件或方法方向一个 可以多线程同时调用
+             */
+            class E2EProtector
+            {
+            public:
+                explicit E2EProtector(const E2EProfileConfig &config);
+
+                /**
+                 * \brief 是否创建成功 config.profile 不支持时为 false
+                 */
+                bool IsValid() const { return profile_ != nullptr; }
+
+                size_t HeaderSize() const { return profile_->HeaderSize(); }
+
+                uint32_t HeaderOffset() const { return profile_->GetConfig().offset; }
+
+                /**
+                 * \brief 写头部并推进 counter
+                 * \param data 包含头部的完整数据 头部位置的内容会被覆盖
+                 * \return 长度不满足配置时返回 false counter 不推进
+                 */
+                bool Protect(uint8_t *data, size_t length);
+
+            private:
+                std::unique_ptr<IE2EProfile> profile_;
+                std::atomic<uint32_t> counter_; // counter 的取值个数都能整除 2^32 回绕后取模仍然连续
+            };
+
+            /**
+             * \brief 接收端 每个订阅一个 只能在一个线程里调用
+             */
+            class E2EChecker
+            {
+            public:
+                explicit E2EChecker(const E2EProfileConfig &config);
+
+                bool IsValid() const { return profile_ != nullptr; }
+
+                size_t HeaderSize() const { return profile_->HeaderSize(); }
+
+                uint32_t HeaderOffset() const { return profile_->GetConfig().offset; }
+
+                /**
+                 * \brief 校验头部并与上一个通过的 sample 比较 counter
+                 *
+                 * 第一个通过的 sample 返回 kOk 之后 counter 差为 0 返回 kRepeated
+                 * 超过 maxDeltaCounter 返回 kWrongSequence kError 的 sample 不更新 counter
+                 */
+                ProfileCheckStatus Check(const uint8_t *data, size_t length);
+
+                /**
+                 * \brief 周期检查时没有收到新数据
+                 */
+                ProfileCheckStatus CheckNoNewData() const { return ProfileCheckStatus::kNoNewData; }
+
+                /**
+                 * \brief 重新订阅后丢弃上一次的 counter
+                 */
+                void Reset() { hasLastCounter_ = false; }
+
+            private:
+                std::unique_ptr<IE2EProfile> profile_;
+                uint32_t lastCounter_;
+                bool hasLastCounter_;
+            };
+
+        } // namespace e2e
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _E2E_PROTECTOR_H_
@@ -0,0 +1,71 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief E2E 状态机 把逐个 sample 的检查结果汇总成通信通道的状态
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _E2E_STATE_MACHINE_H_
+#define _E2E_STATE_MACHINE_H_
+
+#include "ara/com/e2e/e2e_types.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace e2e
+        {
+            /**
+             * \brief 窗口内只统计 kOk 和 kError kRepeated / kWrongSequence 等只占位
+             *
+             * kNoData 收到第一个不是 kError / kNoNewData 的结果后进入 kInit
+             * kInit 满足 minOk / maxError 进入 kValid 错误过多进入 kInvalid
+             * kValid 不再满足条件进入 kInvalid kInvalid 重新满足条件回到 kValid
+             *
+             * 只能在一个线程里调用
+             *
+             * @ID{[SWS_E2E_00345]}
+             */
+            class E2EStateMachine
+            {
+            public:
+                static constexpr uint8_t kMaxWindowSize = 64;
+
+                explicit E2EStateMachine(const E2EStateMachineConfig &config);
+
+                /**
+                 * \brief 加入一个检查结果 返回更新后的状态
+                 */
+                SMState Update(ProfileCheckStatus status);
+
+                SMState GetState() const { return state_; }
+
+                /**
+                 * \brief 回到 kNoData 并清空窗口
+                 */
+                void Reset();
+
+            private:
+                uint8_t windowSize() const;
+
+                void clearWindow();
+
+                bool accepted(uint8_t minOk, uint8_t maxError) const;
+
+            private:
+                E2EStateMachineConfig config_;
+                SMState state_;
+                ProfileCheckStatus window_[kMaxWindowSize];
+                uint8_t next_;     // 下一个写入位置
+                uint8_t filled_;   // 窗口里的有效个数
+                uint8_t okCount_;
+                uint8_t errorCount_;
+            };
+
+        } // namespace e2e
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _E2E_STATE_MACHINE_H_
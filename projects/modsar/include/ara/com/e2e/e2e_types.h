@@ -0,0 +1,100 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief E2E 保护的配置和检查结果
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _E2E_TYPES_H_
+#define _E2E_TYPES_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ara
+{
+    namespace com
+    {
+        namespace e2e
+        {
+            /**
+             * \brief 单个 sample 的检查结果
+             *
+             * @ID{[SWS_CM_90421]}
+             */
+            enum class ProfileCheckStatus : uint8_t
+            {
+                kOk = 0,        ///< 检查通过 counter 连续
+                kRepeated,      ///< 与上一个 sample 的 counter 相同
+                kWrongSequence, ///< counter 跳变超过 maxDeltaCounter
+                kError,         ///< CRC / Length / DataID 不一致
+                kNotAvailable,  ///< 还没有收到可检查的数据
+                kNoNewData,     ///< 本周期没有新数据
+                kCheckDisabled  ///< 该事件没有配置 E2E
+            };
+
+            /**
+             * \brief E2E 状态机的状态
+             *
+             * @ID{[SWS_CM_90422]}
+             */
+            enum class SMState : uint8_t
+            {
+                kValid = 0,
+                kNoData,
+                kInit,
+                kInvalid,
+                kStateMDisabled
+            };
+
+            enum class E2EProfile : uint8_t
+            {
+                kProfile04 = 4,  ///< CRC32P4 Length16 Counter16 DataID32 头长 12
+                kProfile05 = 5,  ///< CRC16 Counter8 DataID 隐式参与 CRC 头长 3
+                kProfile06 = 6,  ///< CRC16 Length16 Counter8 DataID 隐式参与 CRC 头长 5
+                kProfile07 = 7,  ///< CRC64 Length32 Counter32 DataID32 头长 20
+                kProfile22 = 22  ///< CRC8H2F Counter4 DataIDList 隐式参与 CRC 头长 2
+            };
+
+            /**
+             * \brief 一个事件或方法方向上的 E2E 配置 由部署配置生成
+             *
+             * 长度和偏移都以字节为单位 头部放在序列化数据的 offset 处 其余数据前后顺延
+             */
+            struct E2EProfileConfig
+            {
+                E2EProfile profile = E2EProfile::kProfile04;
+                uint32_t dataId = 0;            ///< profile 22 不使用
+                uint8_t dataIdList[16] = {};    ///< 仅 profile 22 按 counter 取值
+                uint32_t offset = 0;            ///< 头部在数据中的字节偏移
+                uint32_t maxDeltaCounter = 1;   ///< 允许的最大 counter 跳变
+                uint32_t minDataLength = 0;     ///< 包含头部的最小长度
+                uint32_t maxDataLength = 4096;  ///< 包含头部的最大长度
+                uint32_t dataLength = 0;        ///< profile 5 / 22 的固定长度 包含头部
+            };
+
+            /**
+             * \brief 状态机在滑动窗口里统计 kOk 和 kError 的个数
+             *
+             * @ID{[SWS_E2E_00342]}
+             */
+            struct E2EStateMachineConfig
+            {
+                uint8_t windowSizeValid = 10;
+                uint8_t windowSizeInit = 10;
+                uint8_t windowSizeInvalid = 10;
+                uint8_t minOkStateInit = 5;
+                uint8_t maxErrorStateInit = 2;
+                uint8_t minOkStateValid = 3;
+                uint8_t maxErrorStateValid = 2;
+                uint8_t minOkStateInvalid = 5;
+                uint8_t maxErrorStateInvalid = 1;
+                bool clearToInvalid = false;    ///< 进入 kInvalid 时是否清空窗口
+            };
+
+        } // namespace e2e
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _E2E_TYPES_H_
@@ -0,0 +1,159 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief binding 在发布端把 sample 分发到各订阅者队列 执行限速和队列策略
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _EVENT_DISTRIBUTOR_HPP_
+#define _EVENT_DISTRIBUTOR_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "ara/com/event/subscriber_queue.hpp"
+#include "ara/com/event/token_bucket.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace event
+        {
+            /**
+             * \brief 一次 Publish 的结果
+             */
+            struct PublishResult
+            {
+                bool rateLimited = false; ///< 超过限速 没有分发
+                uint32_t delivered = 0;   ///< 放进队列的订阅者数 包括挤掉旧 sample 和覆盖的
+                uint32_t dropped = 0;     ///< 丢掉新 sample 的订阅者数
+            };
+
+            /**
+             * \brief 一个 event 实例的发布端分发器 同主机的 binding 每个 EventSkeleton 一个
+             *
+             * 订阅者列表写时复制 Publish 只取一次快照 不和 Subscribe / Unsubscribe 互斥
+             * 先分发给不会阻塞的订阅者 最后才是 kBlockPublisher 的订阅者
+             * 一个慢订阅者最多让发布者等待它的 blockTimeout 不影响其他订阅者拿到 sample
+             *
+             * \tparam T 放进队列的类型 一般是指向只读 sample 的 shared_ptr
+             */
+            template <typename T>
+            class EventDistributor
+            {
+            public:
+                using Queue = SubscriberQueue<T>;
+
+                explicit EventDistributor(const EventQosConfig &config)
+                    : config_(config), rateLimiter_(config.rateLimit), subscribers_(std::make_shared<const List>()), published_(0)
+                {
+                }
+
+                EventDistributor(const EventDistributor &) = delete;
+                EventDistributor &operator=(const EventDistributor &) = delete;
+
+                /**
+                 * \brief 按部署配置的默认队列策略订阅
+                 */
+                std::shared_ptr<Queue> Subscribe(size_t sampleCount)
+                {
+                    return Subscribe(sampleCount, config_.queue);
+                }
+
+                /**
+                 * \brief 订阅者单独指定队列策略
+                 */
+                std::shared_ptr<Queue> Subscribe(size_t sampleCount, const SubscriberQueueConfig &queueConfig)
+                {
+                    std::shared_ptr<Queue> queue = std::make_shared<Queue>(queueConfig, sampleCount);
+                    std::lock_guard<std::mutex> lock(writeMutex_);
+                    std::shared_ptr<List> next = std::make_shared<List>(*std::atomic_load(&subscribers_));
+                    // kBlockPublisher 的订阅者排在后面
+                    if (queue->Policy() == QueuePolicy::kBlockPublisher)
+                    {
+                        next->push_back(queue);
+                    }
+                    else
+                    {
+                        next->insert(std::find_if(next->begin(), next->end(), [](const std::shared_ptr<Queue> &existing)
+                                                  { return existing->Policy() == QueuePolicy::kBlockPublisher; }),
+                                     queue);
+                    }
+                    std::atomic_store(&subscribers_, std::shared_ptr<const List>(std::move(next)));
+                    return queue;
+                }
+
+                /**
+                 * \brief 取消订阅 正在等待这个队列的发布者立即返回
+                 */
+                void Unsubscribe(const std::shared_ptr<Queue> &queue)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(writeMutex_);
+                        std::shared_ptr<List> next = std::make_shared<List>(*std::atomic_load(&subscribers_));
+                        next->erase(std::remove(next->begin(), next->end(), queue), next->end());
+                        std::atomic_store(&subscribers_, std::shared_ptr<const List>(std::move(next)));
+                    }
+                    queue->Close();
+                }
+
+                /**
+                 * \brief 限速后分发给全部订阅者 可以在多个线程上调用
+                 */
+                PublishResult Publish(const T &sample)
+                {
+                    PublishResult result;
+                    if (!rateLimiter_.TryAcquire())
+                    {
+                        result.rateLimited = true;
+                        return result;
+                    }
+                    published_.fetch_add(1, std::memory_order_relaxed);
+                    const std::shared_ptr<const List> subscribers = std::atomic_load(&subscribers_);
+                    for (const std::shared_ptr<Queue> &queue : *subscribers)
+                    {
+                        const PushResult pushed = queue->Push(sample);
+                        if (pushed == PushResult::kDroppedNewest || pushed == PushResult::kTimedOut)
+                        {
+                            ++result.dropped;
+                        }
+                        else if (pushed != PushResult::kClosed)
+                        {
+                            ++result.delivered;
+                        }
+                    }
+                    return result;
+                }
+
+                size_t SubscriberCount() const { return std::atomic_load(&subscribers_)->size(); }
+
+                /**
+                 * \brief 通过限速分发出去的 sample 数
+                 */
+                uint64_t Published() const { return published_.load(std::memory_order_relaxed); }
+
+                /**
+                 * \brief 被限速丢弃的 sample 数
+                 */
+                uint64_t RateLimited() const { return rateLimiter_.Rejected(); }
+
+            private:
+                using List = std::vector<std::shared_ptr<Queue>>;
+
+                const EventQosConfig config_;
+                TokenBucket rateLimiter_;
+                std::mutex writeMutex_; // 串行化订阅列表的修改
+                std::shared_ptr<const List> subscribers_;
+                std::atomic<uint64_t> published_;
+            };
+
+        } // namespace event
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _EVENT_DISTRIBUTOR_HPP_
@@ -8,7 +8,23 @@
 #define _EVENT_PROXY_HPP_
 
 #include <functional>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "ara/com/com_error_domain.h"
+#include "ara/com/e2e/e2e_payload.hpp"
+#include "ara/com/e2e/e2e_protector.h"
+#include "ara/com/e2e/e2e_state_machine.h"
+#include "ara/com/event/subscriber_queue.hpp"
+#include "ara/com/local/local_service.hpp"
+#include "ara/com/record/recorder.h"
+#include "ara/com/serialization/someip_serializer.hpp"
+#include "ara/com/someip/someip_connection.h"
+#include "ara/com/tp/tp_reassembler.h"
+#include "ara/com/trace/trace_registry.h"
 
 namespace ara
 {
@@ -17,19 +33,431 @@ namespace ara
           namespace event
           {
                typedef std::function<void(const std::shared_ptr<SamplePtr<DataType>> &)> Sample_handler_t;
+               typedef std::function<void(const std::shared_ptr<const tp::TpPayload> &)> RawSample_handler_t;
                class EventProxy
                {
                public:
-                    EventProxy(std::shared_ptr<Proxy> &proxy) : proxy_(proxy)
+                    using SampleQueue = SubscriberQueue<std::shared_ptr<SamplePtr<DataType>>>;
+
+                    EventProxy(std::shared_ptr<Proxy> &proxy) : EventProxy(proxy, 0, 0, 0, 0)
+                    {
+                    }
+                    EventProxy(std::shared_ptr<Proxy> &proxy, uint16_t service, uint16_t instance, uint16_t eventgroupId, uint16_t eventId)
+                        : proxy_(proxy), service_(service), instance_(instance), eventgroupId_(eventgroupId), eventId_(eventId)
+                    {
+                    }
+                    ~EventProxy()
+                    {
+                         Unsubscribe();
+                         DisableTp();
+                    }
+                    bool IsSubscribed() const
+                    {
+                         return sampleQueue_ != nullptr;
+                    }
+
+                    /**
+                     * \brief 实例在本进程 Offer 时直接订阅 LocalEvent 队列由发布端按 GetQueuePolicy 创建
+                     * 否则经 SomeIpConnection 订阅 eventgroup 队列在本端按 GetQueuePolicy 创建 接收线程反序列化后放入
+                     * \return 已经订阅时不做任何事 连接启动失败时返回连接的错误
+                     *
+                     * @ID{[SWS_CM_00141]}
+                     */
+                    ara::core::Result<void> Subscribe(size_t maxSampleCount)
+                    {
+                         if (sampleQueue_)
+                         {
+                              return ara::core::Result<void>::FromValue();
+                         }
+                         if (subscribeLocal(maxSampleCount))
+                         {
+                              return ara::core::Result<void>::FromValue();
+                         }
+                         return subscribeSomeIp(maxSampleCount);
+                    }
+
+                    /**
+                     * \brief 启动时一次订阅多个 event 同进程的照常直接订阅 已经订阅的被跳过
+                     * 经 SOME/IP 的按 service instance 分组 每组用一次 RegisterResponseHandlers 和一次 SubscribeEvents
+                     * 分发表只重建一次 同一 eventgroup 只 subscribe 一次
+                     * \return 连接启动失败时一个都不经 SOME/IP 订阅 返回连接的错误
+                     */
+                    static ara::core::Result<void> SubscribeEvents(const std::vector<EventProxy *> &events, size_t maxSampleCount)
+                    {
+                         std::vector<EventProxy *> remote;
+                         for (EventProxy *event : events)
+                         {
+                              if (!event->sampleQueue_ && !event->subscribeLocal(maxSampleCount))
+                              {
+                                   remote.push_back(event);
+                              }
+                         }
+                         if (remote.empty())
+                         {
+                              return ara::core::Result<void>::FromValue();
+                         }
+                         someip::SomeIpConnection &connection = someip::SomeIpConnection::Instance();
+                         ara::core::Result<void> acquired = connection.Acquire();
+                         if (!acquired.HasValue())
+                         {
+                              return acquired;
+                         }
+                         // 每个订阅各占一次 Unsubscribe 时各自 Release 连接已经启动 后面的不会失败
+                         for (size_t i = 1; i < remote.size(); ++i)
+                         {
+                              connection.Acquire();
+                         }
+                         std::vector<bool> grouped(remote.size(), false);
+                         for (size_t first = 0; first < remote.size(); ++first)
+                         {
+                              if (grouped[first])
+                              {
+                                   continue;
+                              }
+                              const uint16_t service = remote[first]->service_;
+                              const uint16_t instance = remote[first]->instance_;
+                              std::vector<EventProxy *> group;
+                              std::vector<std::shared_ptr<Receiver>> receivers;
+                              std::vector<std::pair<uint16_t, someip::SomeIpDispatchTable<Message>::Handler>> handlers;
+                              std::vector<someip::EventSubscription> subscriptions;
+                              for (size_t i = first; i < remote.size(); ++i)
+                              {
+                                   EventProxy *event = remote[i];
+                                   if (grouped[i] || event->service_ != service || event->instance_ != instance)
+                                   {
+                                        continue;
+                                   }
+                                   grouped[i] = true;
+                                   std::shared_ptr<Receiver> receiver = event->makeReceiver(maxSampleCount);
+                                   group.push_back(event);
+                                   handlers.emplace_back(event->eventId_, receiverHandler(receiver));
+                                   subscriptions.push_back(someip::EventSubscription{event->eventgroupId_, event->eventId_});
+                                   receivers.push_back(std::move(receiver));
+                              }
+                              std::vector<someip::HandlerId> ids = connection.RegisterResponseHandlers(service, instance, std::move(handlers));
+                              connection.SubscribeEvents(service, instance, subscriptions);
+                              for (size_t i = 0; i < group.size(); ++i)
+                              {
+                                   group[i]->notificationHandler_ = ids[i];
+                                   group[i]->AttachSampleQueue(receivers[i]->queue);
+                              }
+                         }
+                         return ara::core::Result<void>::FromValue();
+                    }
+
+                    /**
+                     * \brief 队列里还没有取走的 sample 一并丢弃
+                     *
+                     * @ID{[SWS_CM_00151]}
+                     */
+                    void Unsubscribe()
+                    {
+                         if (!sampleQueue_)
+                         {
+                              return;
+                         }
+                         if (localEvent_)
+                         {
+                              localEvent_->Unsubscribe(sampleQueue_);
+                         }
+                         else
+                         {
+                              someip::SomeIpConnection &connection = someip::SomeIpConnection::Instance();
+                              connection.UnsubscribeEvent(service_, instance_, eventgroupId_, eventId_);
+                              connection.UnregisterHandler(notificationHandler_);
+                              connection.Release();
+                              sampleQueue_->Close();
+                         }
+                         sampleQueue_.reset();
+                    }
+
+                    /**
+                     * \brief FindService 找到同进程的实例时 binding 在 Subscribe 之前调用 之后 sample 直接引用发布者的对象
+                     * 没有调用时 Subscribe 按 service instance 查 LocalServiceRegistry
+                     * \return 实例没有以相同 sample 类型注册该 event 时返回 false 保持走网络
+                     */
+                    bool AttachLocal(const std::shared_ptr<local::LocalService> &service)
                     {
+                         localEvent_ = service->template GetEvent<DataType>(eventId_);
+                         return localEvent_ != nullptr;
                     }
-                    bool IsSubscribed();
-                    void Unsubscribe();
-                    void Subscribe(size_t SampleCount);
+
                     void GetNewSample(Sample_handler_t handler);
 
+                    /**
+                     * \brief 轮询取出最多 maxNumberOfSamples 个新 sample 在调用线程上依次交给 f
+                     * 适合在 TimeTriggeredExecutor 的 activity 里按周期调用 不需要接收回调
+                     * \return 取出的个数 未订阅时为 0
+                     */
+                    template <typename F>
+                    ara::core::Result<size_t> GetNewSamples(F &&f, size_t maxNumberOfSamples = std::numeric_limits<size_t>::max())
+                    {
+                         const std::shared_ptr<SampleQueue> queue = sampleQueue_;
+                         if (!queue)
+                         {
+                              return ara::core::Result<size_t>::FromValue(0);
+                         }
+                         return ara::core::Result<size_t>::FromValue(queue->PopAll(maxNumberOfSamples, std::forward<F>(f)));
+                    }
+
+                    /**
+                     * \brief 部署配置里该订阅的队列策略 在 Subscribe 之前设置 未设置时为 kDropOldest
+                     */
+                    void SetQueuePolicy(const SubscriberQueueConfig &config)
+                    {
+                         queueConfig_ = config;
+                    }
+
+                    const SubscriberQueueConfig &GetQueuePolicy() const
+                    {
+                         return queueConfig_;
+                    }
+
+                    /**
+                     * \brief binding 在 Subscribe 时挂上该订阅的队列 GetNewSample 从这里取
+                     *
+                     * 同主机时来自发布端 EventDistributor::Subscribe 经过网络时 binding 按 GetQueuePolicy 在本端创建
+                     * 队列深度不超过 maxSampleCount 消费者慢时按策略丢弃 不会无限增长
+                     */
+                    void AttachSampleQueue(std::shared_ptr<SampleQueue> queue)
+                    {
+                         sampleQueue_ = std::move(queue);
+                    }
+
+                    /**
+                     * \brief 该订阅的丢弃计数 未订阅时全为 0
+                     */
+                    SubscriberQueueStatistics GetSubscriberStatistics() const
+                    {
+                         return sampleQueue_ ? sampleQueue_->GetStatistics() : SubscriberQueueStatistics();
+                    }
+
+                    /**
+                     * \brief 大块数据直接拿 SOME/IP-TP 重组后的 payload 引用的是重组缓冲区 不拷贝 在 EnableTp 之前设置
+                     *
+                     * payload 释放后缓冲区才归还内存池 应用不要长期持有 否则后续消息会因缓冲区不足被丢弃
+                     */
+                    void SetRawSampleHandler(RawSample_handler_t handler)
+                    {
+                         rawSampleHandler_ = std::move(handler);
+                    }
+
+                    /**
+                     * \brief 部署配置为 SOME/IP-TP 的事件 在 SomeIpConnection 上启用分段重组
+                     * 设置了 raw handler 时重组结果直接交给它 否则换成完整 payload 后照常反序列化
+                     * handler 按值交给连接 析构后连接可能还在调用它 不要在里面引用 EventProxy
+                     */
+                    void EnableTp(uint16_t service, uint16_t instance, uint16_t eventId)
+                    {
+                         DisableTp();
+                         someip::TpReassembledHandler reassembled;
+                         if (rawSampleHandler_)
+                         {
+                              reassembled = rawSampleHandler_;
+                         }
+                         someip::SomeIpConnection::Instance().EnableTp(service, instance, eventId, std::move(reassembled));
+                         tpEvent_.reset(new TpEvent{service, instance, eventId});
+                    }
+
+                    void DisableTp()
+                    {
+                         if (tpEvent_)
+                         {
+                              someip::SomeIpConnection::Instance().DisableTp(tpEvent_->service, tpEvent_->instance, tpEvent_->eventId);
+                              tpEvent_.reset();
+                         }
+                    }
+
+                    /**
+                     * \brief 按部署配置启用 E2E 检查 在 Subscribe 之前调用 经 SOME/IP 收到的 sample 用 e2e::CheckAndDeserialize 反序列化
+                     * 结果写入 SamplePtr::SetProfileCheckStatus 并驱动状态机 同进程订阅不经过线格式 为 kCheckDisabled
+                     */
+                    bool SetE2ECheck(const e2e::E2EProfileConfig &profile, const e2e::E2EStateMachineConfig &stateMachine)
+                    {
+                         std::shared_ptr<e2e::E2EChecker> checker = std::make_shared<e2e::E2EChecker>(profile);
+                         if (!checker->IsValid())
+                         {
+                              return false;
+                         }
+                         checker_ = checker;
+                         stateMachine_ = std::make_shared<e2e::E2EStateMachine>(stateMachine);
+                         return true;
+                    }
+
+                    /**
+                     * \brief 通道的 E2E 状态 没有配置 E2E 时为 kStateMDisabled
+                     *
+                     * @ID{[SWS_CM_90423]}
+                     */
+                    e2e::SMState GetSMState() const
+                    {
+                         return stateMachine_ ? stateMachine_->GetState() : e2e::SMState::kStateMDisabled;
+                    }
+
+                    /**
+                     * \brief 在默认统计页上启用时延追踪
+                     * binding 收到 sample 后先 TraceChannel::Receive 去掉末尾的追踪信息 再做 E2E 检查和反序列化
+                     * 用 trace::RunTraced 调用 sample handler 记录排队和执行耗时
+                     * \return 没有设置默认统计页或槽位用完时返回 false
+                     */
+                    bool EnableTracing(const std::string &name, uint16_t service, uint16_t instance, uint16_t eventId)
+                    {
+                         traceChannel_ = trace::CreateTraceChannel(trace::ChannelRole::kEventReceiver, name, service, instance, eventId);
+                         return traceChannel_ != nullptr;
+                    }
+
+                    /**
+                     * \brief 时延分布和丢包乱序计数 没有启用追踪时返回 nullptr
+                     */
+                    std::shared_ptr<trace::TraceChannel> GetTraceChannel() const
+                    {
+                         return traceChannel_;
+                    }
+
                private:
+                    // 实例在本进程 Offer 时直接订阅 LocalEvent 返回 false 时走 SOME/IP
+                    bool subscribeLocal(size_t maxSampleCount)
+                    {
+                         if (!localEvent_)
+                         {
+                              std::shared_ptr<local::LocalService> service = local::LocalServiceRegistry::Instance().Find(service_, instance_);
+                              if (service)
+                              {
+                                   AttachLocal(service);
+                              }
+                         }
+                         if (!localEvent_)
+                         {
+                              return false;
+                         }
+                         AttachSampleQueue(localEvent_->Subscribe(maxSampleCount, queueConfig_));
+                         return true;
+                    }
+
+                    ara::core::Result<void> subscribeSomeIp(size_t maxSampleCount)
+                    {
+                         someip::SomeIpConnection &connection = someip::SomeIpConnection::Instance();
+                         ara::core::Result<void> acquired = connection.Acquire();
+                         if (!acquired.HasValue())
+                         {
+                              return acquired;
+                         }
+                         std::shared_ptr<Receiver> receiver = makeReceiver(maxSampleCount);
+                         notificationHandler_ = connection.RegisterResponseHandler(service_, instance_, eventId_, receiverHandler(receiver));
+                         connection.SubscribeEvent(service_, instance_, eventgroupId_, eventId_);
+                         AttachSampleQueue(receiver->queue);
+                         return ara::core::Result<void>::FromValue();
+                    }
+
+                    // 一个 SOME/IP 订阅的接收状态 通知 handler 持有
+                    struct Receiver
+                    {
+                         std::shared_ptr<SampleQueue> queue;
+                         std::shared_ptr<e2e::E2EChecker> checker;
+                         std::shared_ptr<e2e::E2EStateMachine> stateMachine;
+                         std::shared_ptr<trace::TraceChannel> trace;
+                         std::mutex checkerMutex; // 通知可能在多个 dispatch 线程上到达 checker 的 counter 和状态机需要串行
+                    };
+
+                    std::shared_ptr<Receiver> makeReceiver(size_t maxSampleCount)
+                    {
+                         std::shared_ptr<Receiver> receiver = std::make_shared<Receiver>();
+                         receiver->queue = std::make_shared<SampleQueue>(queueConfig_, maxSampleCount);
+                         receiver->checker = checker_;
+                         receiver->stateMachine = stateMachine_;
+                         receiver->trace = traceChannel_;
+                         if (checker_)
+                         {
+                              checker_->Reset();
+                         }
+                         return receiver;
+                    }
+
+                    // 连接注销 handler 时不等待正在执行的回调 只捕获共享的状态
+                    static someip::SomeIpDispatchTable<Message>::Handler receiverHandler(const std::shared_ptr<Receiver> &receiver)
+                    {
+                         return [receiver](const std::shared_ptr<Message> &message)
+                         { receive(*message, *receiver); };
+                    }
+
+                    // 录制的是不带 E2E 头部和追踪信息的 SOME/IP 格式 和发送端一致 可以用 MakeEventSink 回放
+                    static void record(const Message &message, const uint8_t *data, size_t length, const DataType *value)
+                    {
+                         const record::RecordKey key{message.get_service(), message.get_instance(), message.get_method(), 0, 0};
+                         if (value == nullptr)
+                         {
+                              record::RecordPayload(record::RecordKind::kEvent, key, data, length);
+                              return;
+                         }
+                         std::vector<uint8_t> buffer(serialization::GetSerializedSize(*value));
+                         if (serialization::Serialize(*value, buffer.data(), buffer.size()).HasValue())
+                         {
+                              record::RecordPayload(record::RecordKind::kEvent, key, buffer.data(), buffer.size());
+                         }
+                    }
+
+                    // 在 vsomeip 的 dispatch 线程上执行 kBlockPublisher 时最多等待 blockTimeout
+                    static void receive(const Message &message, Receiver &receiver)
+                    {
+                         const uint8_t *data = message.get_payload()->get_data();
+                         size_t length = message.get_payload()->get_length();
+                         if (receiver.trace)
+                         {
+                              trace::TraceContext context;
+                              length = receiver.trace->Receive(data, length, true, context);
+                         }
+                         std::unique_ptr<DataType> value(new DataType());
+                         e2e::ProfileCheckStatus status = e2e::ProfileCheckStatus::kCheckDisabled;
+                         if (receiver.checker)
+                         {
+                              std::lock_guard<std::mutex> lock(receiver.checkerMutex);
+                              ara::core::Result<e2e::ProfileCheckStatus> checked = e2e::CheckAndDeserialize(data, length, *receiver.checker, *value);
+                              if (!checked.HasValue())
+                              {
+                                   return;
+                              }
+                              status = checked.Value();
+                              receiver.stateMachine->Update(status);
+                              if (status == e2e::ProfileCheckStatus::kError)
+                              {
+                                   return; // 头部校验失败 没有可用的数据 只计入状态机
+                              }
+                         }
+                         else if (!serialization::Deserialize(data, length, *value).HasValue())
+                         {
+                              return;
+                         }
+                         if (record::GetActiveRecorder() != nullptr)
+                         {
+                              record(message, data, length, receiver.checker ? value.get() : nullptr); // 有 E2E 头部时重新序列化
+                         }
+                         std::shared_ptr<SamplePtr<DataType>> sample = std::make_shared<SamplePtr<DataType>>();
+                         sample->Reset(value.release());
+                         sample->SetProfileCheckStatus(status);
+                         receiver.queue->Push(std::move(sample));
+                    }
+
+                    struct TpEvent
+                    {
+                         uint16_t service;
+                         uint16_t instance;
+                         uint16_t eventId;
+                    };
+
                     std::shared_ptr<Proxy> proxy_;
+                    const uint16_t service_;
+                    const uint16_t instance_;
+                    const uint16_t eventgroupId_;
+                    const uint16_t eventId_;
+                    std::shared_ptr<local::LocalEvent<DataType>> localEvent_; // 同进程订阅时的发布端
+                    someip::HandlerId notificationHandler_ = 0;                  // 经 SOME/IP 订阅时的通知 handler
+                    std::shared_ptr<e2e::E2EChecker> checker_;            // Subscribe 时交给 Receiver 由它串行使用
+                    std::shared_ptr<e2e::E2EStateMachine> stateMachine_;
+                    RawSample_handler_t rawSampleHandler_;
+                    std::unique_ptr<TpEvent> tpEvent_; // 启用了 TP 的事件 析构时停用
+                    std::shared_ptr<trace::TraceChannel> traceChannel_;
+                    SubscriberQueueConfig queueConfig_;
+                    std::shared_ptr<SampleQueue> sampleQueue_;
                };
           } // namespace name
 
@@ -0,0 +1,79 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief event 的拥塞控制配置 订阅者队列策略和发布限速 由部署配置按实例给出
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _EVENT_QOS_H_
+#define _EVENT_QOS_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace ara
+{
+    namespace com
+    {
+        namespace event
+        {
+            /**
+             * \brief 订阅者队列满时的处理策略
+             */
+            enum class QueuePolicy : uint8_t
+            {
+                kDropOldest = 0, ///< 丢掉最早的 sample 放入新的 默认策略
+                kDropNewest,     ///< 丢掉新的 sample 保留队列里的
+                kBlockPublisher, ///< 发布者最多等待 blockTimeout 超时后丢掉新的
+                kConflate        ///< 只保留最新的一个 适合状态类数据
+            };
+
+            /**
+             * \brief 一个订阅的队列配置
+             */
+            struct SubscriberQueueConfig
+            {
+                QueuePolicy policy = QueuePolicy::kDropOldest;
+                size_t depth = 0;                                 ///< 队列深度 为 0 时取 Subscribe 的 maxSampleCount
+                std::chrono::microseconds blockTimeout{1000};     ///< kBlockPublisher 下发布者的最长等待
+            };
+
+            /**
+             * \brief 发布者的令牌桶限速
+             */
+            struct RateLimitConfig
+            {
+                double samplesPerSecond = 0.0; ///< 平均速率 为 0 时不限速
+                uint32_t burst = 1;            ///< 允许的突发个数
+            };
+
+            /**
+             * \brief 一个 event 实例的部署配置
+             */
+            struct EventQosConfig
+            {
+                RateLimitConfig rateLimit;
+                SubscriberQueueConfig queue; ///< 订阅者没有单独指定时使用
+            };
+
+            /**
+             * \brief 一个订阅者队列的计数
+             */
+            struct SubscriberQueueStatistics
+            {
+                uint64_t accepted = 0;      ///< 放入队列的 sample 数
+                uint64_t droppedNewest = 0; ///< 队列满丢掉的新 sample 数 包括 kBlockPublisher 超时和降级期间
+                uint64_t droppedOldest = 0; ///< 为新 sample 让位丢掉的旧 sample 数
+                uint64_t conflated = 0;     ///< kConflate 下被覆盖的 sample 数
+                uint64_t blockTimeouts = 0; ///< kBlockPublisher 下等待超时的次数
+                uint64_t blockedNs = 0;     ///< 发布者累计等待的时间
+                size_t queued = 0;          ///< 当前在队列里的 sample 数
+            };
+
+        } // namespace event
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _EVENT_QOS_H_
@@ -7,6 +7,19 @@
 #ifndef _EVENT_SKELETON_HPP_
 #define _EVENT_SKELETON_HPP_
 #include <memory>
+#include <vector>
+
+#include "ara/com/com_error_domain.h"
+#include "ara/com/e2e/e2e_payload.hpp"
+#include "ara/com/e2e/e2e_protector.h"
+#include "ara/com/event/event_qos.h"
+#include "ara/com/event/token_bucket.h"
+#include "ara/com/local/local_event.hpp"
+#include "ara/com/record/recorder.h"
+#include "ara/com/routing/multi_binding_event.hpp"
+#include "ara/com/someip/someip_event_sink.hpp"
+#include "ara/com/trace/trace_payload.hpp"
+#include "ara/com/trace/trace_registry.h"
 
 template<class SampleType>
 class EventSkeleton
@@ -20,14 +33,236 @@ public:
         
     }
     
-    void Send(SampleType&& data);    
+    /**
+     * \brief 在 SetQos SetE2EProtection EnableTracing 之后 skeleton 的 OfferService 之前调用
+     * skeleton 启用了同进程 binding 时注册 LocalEvent someIp 为 true 时在 SOME/IP 上 Offer 该 event
+     * binding 已经 SetFanout 时不再创建
+     * \return event id 已经注册或 skeleton 已经 Offer 时返回 kCouldNotExecute 连接启动失败时返回连接的错误
+     */
+    ara::core::Result<void> Register(uint16_t service, uint16_t instance, uint16_t eventgroupId, uint16_t eventId, bool someIp = true)
+    {
+        if (fanout_)
+        {
+            return ara::core::Result<void>::FromValue();
+        }
+        std::shared_ptr<ara::com::routing::MultiBindingEvent<SampleType>> fanout = std::make_shared<ara::com::routing::MultiBindingEvent<SampleType>>();
+        std::shared_ptr<ara::com::local::LocalService> local = skeleton_->GetLocalService();
+        if (local)
+        {
+            // 限速在 Send 里对所有 binding 只做一次 本地分发只执行队列策略
+            ara::com::event::EventQosConfig localQos = qos_;
+            localQos.rateLimit = ara::com::event::RateLimitConfig();
+            std::shared_ptr<ara::com::local::LocalEvent<SampleType>> event = local->template RegisterEvent<SampleType>(eventId, localQos);
+            if (!event)
+            {
+                return ara::core::Result<void>::FromError(ara::com::MakeErrorCode(ara::com::ComErrc::kCouldNotExecute, 0));
+            }
+            localEvent_ = event;
+            fanout->AddSink(std::make_shared<ara::com::routing::LocalEventSink<SampleType>>(std::move(event)));
+        }
+        if (someIp)
+        {
+            ara::core::Result<std::shared_ptr<ara::com::someip::SomeIpEventSink<SampleType>>> sink =
+                ara::com::someip::SomeIpEventSink<SampleType>::Create(service, instance, eventgroupId, eventId);
+            if (!sink.HasValue())
+            {
+                return ara::core::Result<void>::FromError(sink.Error());
+            }
+            fanout->AddSink(sink.Value());
+            fanout->SetSerializer(ara::com::routing::WireFormat::kSomeIp, makeSerializer());
+        }
+        rateLimiter_.reset(new ara::com::event::TokenBucket(qos_.rateLimit));
+        recordKey_ = ara::com::record::RecordKey{service, instance, eventId, 0, 0};
+        fanout_ = fanout;
+        return ara::core::Result<void>::FromValue();
+    }
+
+    /**
+     * \brief 同进程订阅者直接引用 sample 网络 binding 每种线格式只序列化一次
+     * 超过 GetQos 的限速时丢弃 不阻塞 计入 RateLimited
+     * 有活动的录制器时按 SOME/IP 格式另外序列化一次录制 不带 E2E 头部和追踪信息
+     * \return 没有 Register 或 SetFanout 时返回 kServiceNotOffered
+     *
+     * @ID{[SWS_CM_90437]}
+     */
+    ara::core::Result<void> Send(SampleType&& data)
+    {
+        const std::shared_ptr<ara::com::routing::MultiBindingEvent<SampleType>> fanout = fanout_;
+        if (!fanout)
+        {
+            return ara::core::Result<void>::FromError(ara::com::MakeErrorCode(ara::com::ComErrc::kServiceNotOffered, 0));
+        }
+        if (rateLimiter_ && !rateLimiter_->TryAcquire())
+        {
+            return ara::core::Result<void>::FromValue();
+        }
+        if (ara::com::record::GetActiveRecorder() != nullptr)
+        {
+            record(data);
+        }
+        fanout->Send(std::move(data));
+        return ara::core::Result<void>::FromValue();
+    }
     std::shared_ptr<Skeleton> GetSkeleton()
     {
         return skeleton_;
     }
+
+    /**
+     * \brief 按部署配置启用 E2E 保护 在 Register 之前调用 SOME/IP 的序列化用 e2e::SerializeProtected 写头部
+     * \return profile 不支持时返回 false 保持不保护
+     */
+    bool SetE2EProtection(const ara::com::e2e::E2EProfileConfig &config)
+    {
+        std::shared_ptr<ara::com::e2e::E2EProtector> protector = std::make_shared<ara::com::e2e::E2EProtector>(config);
+        if (!protector->IsValid())
+        {
+            return false;
+        }
+        protector_ = protector;
+        return true;
+    }
+
+    /**
+     * \brief 没有配置 E2E 时返回 nullptr
+     */
+    std::shared_ptr<ara::com::e2e::E2EProtector> GetE2EProtector() const
+    {
+        return protector_;
+    }
+
+    /**
+     * \brief 在默认统计页上启用时延追踪 binding 在 Send 时用 trace::SerializeTraced 附上追踪信息
+     * 有 E2E 保护时先 SerializeProtected 再 trace::AppendTrailer
+     * \return 没有设置默认统计页或槽位用完时返回 false
+     */
+    bool EnableTracing(const std::string &name, uint16_t service, uint16_t instance, uint16_t eventId)
+    {
+        traceChannel_ = ara::com::trace::CreateTraceChannel(ara::com::trace::ChannelRole::kEventSender, name, service, instance, eventId);
+        return traceChannel_ != nullptr;
+    }
+
+    /**
+     * \brief 没有启用追踪时返回 nullptr
+     */
+    std::shared_ptr<ara::com::trace::TraceChannel> GetTraceChannel() const
+    {
+        return traceChannel_;
+    }
+
+    /**
+     * \brief 部署配置里该 event 实例的限速和订阅者队列默认策略 在 Register 之前设置
+     * Send 据此对所有 binding 限速 同进程的订阅者队列按它的策略创建
+     */
+    void SetQos(const ara::com::event::EventQosConfig &config)
+    {
+        qos_ = config;
+    }
+
+    const ara::com::event::EventQosConfig &GetQos() const
+    {
+        return qos_;
+    }
+
+    /**
+     * \brief 被限速丢弃的 sample 数
+     */
+    uint64_t RateLimited() const
+    {
+        return rateLimiter_ ? rateLimiter_->Rejected() : 0;
+    }
+
+    /**
+     * \brief Register 在 skeleton 启用了同进程 binding 时用 local::LocalService::RegisterEvent 创建并设置
+     * Send 把 sample 直接交给本地订阅者 只有远端订阅者才需要序列化
+     */
+    void SetLocalEvent(std::shared_ptr<ara::com::local::LocalEvent<SampleType>> event)
+    {
+        localEvent_ = std::move(event);
+    }
+
+    /**
+     * \brief 没有同进程 binding 时返回 nullptr
+     */
+    std::shared_ptr<ara::com::local::LocalEvent<SampleType>> GetLocalEvent() const
+    {
+        return localEvent_;
+    }
+
+    /**
+     * \brief Register 按 skeleton 启用的 binding 创建 每个 binding 一个 sink 其他 binding 可以在 Register 之前自己设置
+     * Send 经过它分发 每种线格式只序列化一次 本地订阅者零拷贝
+     */
+    void SetFanout(std::shared_ptr<ara::com::routing::MultiBindingEvent<SampleType>> fanout)
+    {
+        fanout_ = std::move(fanout);
+    }
+
+    /**
+     * \brief 只在一个 binding 上 Offer 时返回 nullptr
+     */
+    std::shared_ptr<ara::com::routing::MultiBindingEvent<SampleType>> GetFanout() const
+    {
+        return fanout_;
+    }
 private:
+    // 让 e2e 和 trace 的序列化函数写进 MultiBindingEvent 给的缓冲区
+    struct BufferPayload
+    {
+        std::vector<uint8_t> &buffer;
+
+        const uint8_t *get_data() const { return buffer.data(); }
+        size_t get_length() const { return buffer.size(); }
+        void set_data(std::vector<uint8_t> &&data) { buffer = std::move(data); }
+    };
+
+    // SOME/IP 线格式 配置了 E2E 时插入头部 启用追踪时末尾附上追踪信息
+    typename ara::com::routing::MultiBindingEvent<SampleType>::Serializer makeSerializer() const
+    {
+        std::shared_ptr<ara::com::e2e::E2EProtector> protector = protector_;
+        std::shared_ptr<ara::com::trace::TraceChannel> trace = traceChannel_;
+        return [protector, trace](const SampleType &sample, std::vector<uint8_t> &buffer)
+        {
+            BufferPayload payload{buffer};
+            if (protector)
+            {
+                const uint64_t start = trace ? trace->Now() : 0;
+                if (!ara::com::e2e::SerializeProtected(sample, *protector, payload).HasValue())
+                {
+                    return false;
+                }
+                if (trace)
+                {
+                    ara::com::trace::AppendTrailer(*trace, start, payload);
+                }
+                return true;
+            }
+            if (trace)
+            {
+                return ara::com::trace::SerializeTraced(sample, *trace, payload).HasValue();
+            }
+            buffer.resize(ara::com::serialization::GetSerializedSize(sample));
+            return ara::com::serialization::Serialize(sample, buffer.data(), buffer.size()).HasValue();
+        };
+    }
+
+    void record(const SampleType &sample) const
+    {
+        std::vector<uint8_t> buffer(ara::com::serialization::GetSerializedSize(sample));
+        if (ara::com::serialization::Serialize(sample, buffer.data(), buffer.size()).HasValue())
+        {
+            ara::com::record::RecordPayload(ara::com::record::RecordKind::kEvent, recordKey_, buffer.data(), buffer.size());
+        }
+    }
 
     std::shared_ptr<Skeleton> skeleton_;
+    std::shared_ptr<ara::com::e2e::E2EProtector> protector_;
+    std::shared_ptr<ara::com::trace::TraceChannel> traceChannel_;
+    ara::com::event::EventQosConfig qos_;
+    std::unique_ptr<ara::com::event::TokenBucket> rateLimiter_; // Register 按 qos_ 创建
+    std::shared_ptr<ara::com::local::LocalEvent<SampleType>> localEvent_;
+    std::shared_ptr<ara::com::routing::MultiBindingEvent<SampleType>> fanout_;
+    ara::com::record::RecordKey recordKey_{}; // Register 时确定 SetFanout 时为 0
 };
 
 #endif // _EVENT_SKELETON_HPP_
\ No newline at end of file
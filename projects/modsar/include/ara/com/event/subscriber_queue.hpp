@@ -0,0 +1,272 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 单个订阅者的有界 sample 队列 满时按 QueuePolicy 处理
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _SUBSCRIBER_QUEUE_HPP_
+#define _SUBSCRIBER_QUEUE_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "ara/com/event/event_qos.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace event
+        {
+            /**
+             * \brief Push 的结果
+             */
+            enum class PushResult : uint8_t
+            {
+                kAccepted = 0,   ///< 放入队列
+                kReplacedOldest, ///< 丢掉最早的后放入
+                kConflated,      ///< 覆盖了未取走的 sample
+                kDroppedNewest,  ///< 新 sample 被丢弃
+                kTimedOut,       ///< kBlockPublisher 等待超时 新 sample 被丢弃
+                kClosed          ///< 已取消订阅
+            };
+
+            /**
+             * \brief 订阅者队列 内存上限是 depth 个 sample 不随消费者变慢增长
+             *
+             * 一般放 shared_ptr 多个订阅者共享同一个 sample 不拷贝数据
+             * kBlockPublisher 等待超时后进入降级状态 按 kDropNewest 处理
+             * 直到消费者把队列取到一半以下 慢消费者不会让发布者每次都等满超时
+             *
+             * \tparam T 可默认构造和移动的类型
+             */
+            template <typename T>
+            class SubscriberQueue
+            {
+            public:
+                /**
+                 * \param sampleCount Subscribe 的 maxSampleCount config.depth 为 0 时作为队列深度
+                 */
+                SubscriberQueue(const SubscriberQueueConfig &config, size_t sampleCount)
+                    : config_(config),
+                      capacity_(config.policy == QueuePolicy::kConflate ? 1 : (config.depth != 0 ? config.depth : (sampleCount != 0 ? sampleCount : 1))),
+                      slots_(capacity_), head_(0), size_(0), waiters_(0), degraded_(false), closed_(false),
+                      accepted_(0), droppedNewest_(0), droppedOldest_(0), conflated_(0), blockTimeouts_(0), blockedNs_(0)
+                {
+                }
+
+                SubscriberQueue(const SubscriberQueue &) = delete;
+                SubscriberQueue &operator=(const SubscriberQueue &) = delete;
+
+                /**
+                 * \brief 发布者调用 只有 kBlockPublisher 会等待 其余策略立即返回
+                 */
+                PushResult Push(T sample)
+                {
+                    T evicted; // 被丢弃的 sample 在锁外析构
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    if (closed_)
+                    {
+                        return PushResult::kClosed;
+                    }
+                    if (size_ < capacity_)
+                    {
+                        pushBack(std::move(sample));
+                        return PushResult::kAccepted;
+                    }
+                    switch (config_.policy)
+                    {
+                    case QueuePolicy::kConflate:
+                        evicted = std::move(slots_[head_]);
+                        slots_[head_] = std::move(sample);
+                        conflated_.fetch_add(1, std::memory_order_relaxed);
+                        return PushResult::kConflated;
+                    case QueuePolicy::kDropOldest:
+                        evicted = popFront();
+                        droppedOldest_.fetch_add(1, std::memory_order_relaxed);
+                        pushBack(std::move(sample));
+                        return PushResult::kReplacedOldest;
+                    case QueuePolicy::kBlockPublisher:
+                        if (!degraded_)
+                        {
+                            return waitAndPush(lock, std::move(sample));
+                        }
+                        break;
+                    case QueuePolicy::kDropNewest:
+                        break;
+                    }
+                    droppedNewest_.fetch_add(1, std::memory_order_relaxed);
+                    return PushResult::kDroppedNewest;
+                }
+
+                /**
+                 * \brief 消费者取出最早的 sample
+                 * \return 队列为空时返回 false
+                 */
+                bool TryPop(T &sample)
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (size_ == 0)
+                    {
+                        return false;
+                    }
+                    sample = popFront();
+                    onPopped();
+                    return true;
+                }
+
+                /**
+                 * \brief 一次取出最多 maxCount 个 sample 交给 handler GetNewSamples 使用
+                 * handler 在锁外调用
+                 * \return 取出的个数
+                 */
+                template <typename Handler>
+                size_t PopAll(size_t maxCount, Handler &&handler)
+                {
+                    std::vector<T> taken;
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        const size_t count = size_ < maxCount ? size_ : maxCount;
+                        taken.reserve(count);
+                        for (size_t i = 0; i < count; ++i)
+                        {
+                            taken.push_back(popFront());
+                        }
+                        if (count != 0)
+                        {
+                            onPopped();
+                        }
+                    }
+                    for (T &sample : taken)
+                    {
+                        handler(std::move(sample));
+                    }
+                    return taken.size();
+                }
+
+                /**
+                 * \brief 取消订阅 唤醒等待中的发布者 之后的 Push 返回 kClosed
+                 */
+                void Close()
+                {
+                    std::vector<T> remaining;
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        closed_ = true;
+                        remaining.swap(slots_);
+                        size_ = 0;
+                    }
+                    notFull_.notify_all();
+                }
+
+                size_t Size() const
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    return size_;
+                }
+
+                size_t Capacity() const { return capacity_; }
+
+                QueuePolicy Policy() const { return config_.policy; }
+
+                SubscriberQueueStatistics GetStatistics() const
+                {
+                    SubscriberQueueStatistics statistics;
+                    statistics.accepted = accepted_.load(std::memory_order_relaxed);
+                    statistics.droppedNewest = droppedNewest_.load(std::memory_order_relaxed);
+                    statistics.droppedOldest = droppedOldest_.load(std::memory_order_relaxed);
+                    statistics.conflated = conflated_.load(std::memory_order_relaxed);
+                    statistics.blockTimeouts = blockTimeouts_.load(std::memory_order_relaxed);
+                    statistics.blockedNs = blockedNs_.load(std::memory_order_relaxed);
+                    statistics.queued = Size();
+                    return statistics;
+                }
+
+            private:
+                void pushBack(T &&sample)
+                {
+                    slots_[(head_ + size_) % capacity_] = std::move(sample);
+                    ++size_;
+                    accepted_.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                T popFront()
+                {
+                    T sample = std::move(slots_[head_]);
+                    slots_[head_] = T();
+                    head_ = (head_ + 1) % capacity_;
+                    --size_;
+                    return sample;
+                }
+
+                /**
+                 * \brief 取走 sample 后调用 持有锁
+                 */
+                void onPopped()
+                {
+                    if (degraded_ && size_ <= capacity_ / 2)
+                    {
+                        degraded_ = false;
+                    }
+                    if (waiters_ != 0)
+                    {
+                        notFull_.notify_one();
+                    }
+                }
+
+                PushResult waitAndPush(std::unique_lock<std::mutex> &lock, T &&sample)
+                {
+                    const std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+                    ++waiters_;
+                    const bool ready = notFull_.wait_for(lock, config_.blockTimeout, [this]
+                                                         { return size_ < capacity_ || closed_; });
+                    --waiters_;
+                    blockedNs_.fetch_add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                                   std::chrono::steady_clock::now() - begin)
+                                                                   .count()),
+                                         std::memory_order_relaxed);
+                    if (closed_)
+                    {
+                        return PushResult::kClosed;
+                    }
+                    if (!ready)
+                    {
+                        degraded_ = true;
+                        blockTimeouts_.fetch_add(1, std::memory_order_relaxed);
+                        droppedNewest_.fetch_add(1, std::memory_order_relaxed);
+                        return PushResult::kTimedOut;
+                    }
+                    pushBack(std::move(sample));
+                    return PushResult::kAccepted;
+                }
+
+            private:
+                const SubscriberQueueConfig config_;
+                const size_t capacity_;
+                mutable std::mutex mutex_;
+                std::condition_variable notFull_;
+                std::vector<T> slots_;
+                size_t head_;
+                size_t size_;
+                size_t waiters_;
+                bool degraded_;
+                bool closed_;
+                std::atomic<uint64_t> accepted_;
+                std::atomic<uint64_t> droppedNewest_;
+                std::atomic<uint64_t> droppedOldest_;
+                std::atomic<uint64_t> conflated_;
+                std::atomic<uint64_t> blockTimeouts_;
+                std::atomic<uint64_t> blockedNs_;
+            };
+
+        } // namespace event
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _SUBSCRIBER_QUEUE_HPP_
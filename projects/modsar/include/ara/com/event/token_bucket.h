@@ -0,0 +1,67 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 发布者限速用的令牌桶 无锁
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _TOKEN_BUCKET_H_
+#define _TOKEN_BUCKET_H_
+
+#include <atomic>
+#include <cstdint>
+
+#include "ara/com/event/event_qos.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace event
+        {
+            /**
+             * \brief 令牌桶 按 GCRA 实现 只有一个原子的理论到达时间 没有定时补充令牌的线程
+             *
+             * 每个 sample 让理论到达时间后移一个发送间隔 超前量超过 burst - 1 个间隔时拒绝
+             * 效果等同于容量为 burst 速率为 samplesPerSecond 的令牌桶
+             * 被拒绝的 sample 由调用者丢弃 不阻塞发布者
+             */
+            class TokenBucket
+            {
+            public:
+                explicit TokenBucket(const RateLimitConfig &config);
+
+                TokenBucket(const TokenBucket &) = delete;
+                TokenBucket &operator=(const TokenBucket &) = delete;
+
+                /**
+                 * \brief 取一个令牌 可以在多个线程上调用
+                 * \return 超过速率时返回 false
+                 */
+                bool TryAcquire();
+
+                /**
+                 * \param nowNs steady_clock 的当前时间
+                 */
+                bool TryAcquire(int64_t nowNs);
+
+                bool IsUnlimited() const { return intervalNs_ == 0; }
+
+                uint64_t Accepted() const { return accepted_.load(std::memory_order_relaxed); }
+
+                uint64_t Rejected() const { return rejected_.load(std::memory_order_relaxed); }
+
+            private:
+                const int64_t intervalNs_;  // 两个 sample 之间的平均间隔 为 0 时不限速
+                const int64_t toleranceNs_; // 允许提前的量 (burst - 1) 个间隔
+                std::atomic<int64_t> theoreticalArrival_;
+                std::atomic<uint64_t> accepted_;
+                std::atomic<uint64_t> rejected_;
+            };
+
+        } // namespace event
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _TOKEN_BUCKET_H_
@@ -0,0 +1,102 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief Field 最近一次取值的缓存
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _FIELD_CACHE_HPP_
+#define _FIELD_CACHE_HPP_
+
+#include <atomic>
+#include <memory>
+#include <type_traits>
+
+#include "ara/core/result.h"
+#include "ara/com/com_error_domain.h"
+#include "ara/com/utils/seqlock.hpp"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace field
+        {
+            /**
+             * \brief Field 值缓存
+             *
+             * trivially copyable 的类型使用 SeqLock 读端无锁
+             * 其它类型 (Vector String 等) 使用不可变 shared_ptr 原子替换
+             * 写端由 FieldSkeleton 串行化 这里不再加锁
+             */
+            template <typename T, bool = std::is_trivially_copyable<T>::value>
+            class FieldCache;
+
+            template <typename T>
+            class FieldCache<T, true>
+            {
+            public:
+                FieldCache() noexcept : valid_(false) {}
+
+                /**
+                 * \brief 写入新值
+                 */
+                void Store(const T &value) noexcept
+                {
+                    value_.Store(value);
+                    valid_.store(true, std::memory_order_release);
+                }
+
+                /**
+                 * \brief 读取缓存 未写入过时返回 kFieldValueIsNotValid
+                 */
+                ara::core::Result<T> Load() const
+                {
+                    if (!IsValid())
+                    {
+                        return ara::core::Result<T>::FromError(MakeErrorCode(ComErrc::kFieldValueIsNotValid, 0));
+                    }
+                    return ara::core::Result<T>::FromValue(value_.Load());
+                }
+
+                bool IsValid() const noexcept { return valid_.load(std::memory_order_acquire); }
+
+            private:
+                utils::SeqLock<T> value_;
+                std::atomic<bool> valid_;
+            };
+
+            template <typename T>
+            class FieldCache<T, false>
+            {
+            public:
+                void Store(const T &value)
+                {
+                    std::atomic_store_explicit(&value_, std::make_shared<const T>(value), std::memory_order_release);
+                }
+
+                ara::core::Result<T> Load() const
+                {
+                    std::shared_ptr<const T> snapshot = std::atomic_load_explicit(&value_, std::memory_order_acquire);
+                    if (!snapshot)
+                    {
+                        return ara::core::Result<T>::FromError(MakeErrorCode(ComErrc::kFieldValueIsNotValid, 0));
+                    }
+                    return ara::core::Result<T>::FromValue(*snapshot);
+                }
+
+                bool IsValid() const noexcept
+                {
+                    return static_cast<bool>(std::atomic_load_explicit(&value_, std::memory_order_acquire));
+                }
+
+            private:
+                std::shared_ptr<const T> value_;
+            };
+
+        } // namespace field
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _FIELD_CACHE_HPP_
@@ -0,0 +1,167 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief Field 的客户端实现
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _FIELD_PROXY_HPP_
+#define _FIELD_PROXY_HPP_
+
+#include <memory>
+#include <utility>
+
+#include "ara/core/future.h"
+#include "ara/core/promise.h"
+#include "ara/com/com_error_domain.h"
+#include "ara/com/event/event_proxy.hpp"
+#include "ara/com/field/field_types.h"
+#include "ara/com/rpc/call_slot_table.hpp"
+#include "ara/com/serialization/someip_serializer.hpp"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace field
+        {
+            /**
+             * \brief Field 客户端
+             *
+             * Get/Set 的应答 handler 在构造时注册一次 应答按 session id 经 CallSlotTable 找回 Promise
+             * notifier 部分复用 EventProxy
+             *
+             * \tparam T Field 的数据类型
+             *
+             * @ID{[SWS_CM_00008]}
+             */
+            template <typename T>
+            class FieldProxy
+            {
+            public:
+                using FieldType = T;
+
+                FieldProxy(std::shared_ptr<Proxy> &proxy, const FieldConfig &config)
+                    : proxy_(proxy), config_(config), notifier_(proxy), pending_(std::make_shared<Pending>())
+                {
+                    // handler 的生命周期跟随 proxy 这里只持有关联表的弱引用 FieldProxy 析构后迟到的应答直接丢弃
+                    std::weak_ptr<Pending> pending = pending_;
+                    if (config_.hasGetter)
+                    {
+                        proxy_->RegisterMessageHandler(config_.getterId, [pending](const std::shared_ptr<Message> &response)
+                                                       {
+                                                           std::shared_ptr<Pending> locked = pending.lock();
+                                                           if (locked)
+                                                           {
+                                                               onResponse(locked->get, response);
+                                                           }
+                                                       });
+                    }
+                    if (config_.hasSetter)
+                    {
+                        proxy_->RegisterMessageHandler(config_.setterId, [pending](const std::shared_ptr<Message> &response)
+                                                       {
+                                                           std::shared_ptr<Pending> locked = pending.lock();
+                                                           if (locked)
+                                                           {
+                                                               onResponse(locked->set, response);
+                                                           }
+                                                       });
+                    }
+                }
+
+                FieldProxy(const FieldProxy &) = delete;
+                FieldProxy &operator=(const FieldProxy &) = delete;
+
+                /**
+                 * \brief 请求服务端当前值 服务端一般直接由缓存应答
+                 *
+                 * @ID{[SWS_CM_00112]}
+                 */
+                ara::core::Future<T> Get()
+                {
+                    return sendRequest(pending_->get, config_.getterId, nullptr);
+                }
+
+                /**
+                 * \brief 请求设置新值 返回服务端实际生效的值
+                 *
+                 * @ID{[SWS_CM_00113]}
+                 */
+                ara::core::Future<T> Set(const T &value)
+                {
+                    return sendRequest(pending_->set, config_.setterId, &value);
+                }
+
+                void Subscribe(size_t maxSampleCount) { notifier_.Subscribe(maxSampleCount); }
+
+                void Unsubscribe() { notifier_.Unsubscribe(); }
+
+                bool IsSubscribed() { return notifier_.IsSubscribed(); }
+
+                void GetNewSample(event::Sample_handler_t handler) { notifier_.GetNewSample(handler); }
+
+            private:
+                using SlotTable = rpc::CallSlotTable<T>;
+
+                static constexpr size_t kFieldMaxInFlight = 16; // Field 的 Get/Set 很少并发 关联表按小容量预分配
+
+                /**
+                 * \brief 应答 handler 与 FieldProxy 共享的关联表
+                 */
+                struct Pending
+                {
+                    Pending() : get(kFieldMaxInFlight), set(kFieldMaxInFlight) {}
+
+                    SlotTable get;
+                    SlotTable set;
+                };
+
+                ara::core::Future<T> sendRequest(SlotTable &table, method_t methodId, const T *value)
+                {
+                    ara::core::Result<typename SlotTable::Call> reserved = table.Reserve();
+                    if (!reserved.HasValue())
+                    {
+                        ara::core::Promise<T> failed;
+                        failed.SetError(reserved.Error());
+                        return failed.get_future();
+                    }
+                    typename SlotTable::Call call = std::move(reserved).Value();
+                    std::shared_ptr<Message> request = runtime::CreateMessage(methodId);
+                    request->set_session(call.session);
+                    if (value != nullptr)
+                    {
+                        serialization::SerializeToPayload(*value, *request->get_payload());
+                    }
+                    proxy_->SendRequest(request);
+                    return std::move(call.future);
+                }
+
+                static void onResponse(SlotTable &table, const std::shared_ptr<Message> &response)
+                {
+                    table.Complete(response->get_session(), [&response](ara::core::Promise<T> &promise)
+                                   {
+                                       T value;
+                                       ara::core::Result<void> decoded = serialization::DeserializeFromPayload(*response->get_payload(), value);
+                                       if (!decoded.HasValue())
+                                       {
+                                           promise.SetError(decoded.Error());
+                                           return;
+                                       }
+                                       promise.set_value(std::move(value));
+                                   });
+                }
+
+            private:
+                std::shared_ptr<Proxy> proxy_;
+                FieldConfig config_;
+                event::EventProxy notifier_;
+                std::shared_ptr<Pending> pending_;
+            };
+
+        } // namespace field
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _FIELD_PROXY_HPP_
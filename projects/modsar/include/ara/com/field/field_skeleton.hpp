@@ -0,0 +1,341 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief Field 的服务端实现
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _FIELD_SKELETON_HPP_
+#define _FIELD_SKELETON_HPP_
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+
+#include "ara/core/future.h"
+#include "ara/core/promise.h"
+#include "ara/core/result.h"
+#include "ara/com/com_error_domain.h"
+#include "ara/com/event/event_skeleton.hpp"
+#include "ara/com/field/field_cache.hpp"
+#include "ara/com/field/field_types.h"
+#include "ara/com/serialization/someip_serializer.hpp"
+#include "ara/com/utils/task_scheduler.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace field
+        {
+            /**
+             * \brief Field 服务端
+             *
+             * 最近一次的值保存在 FieldCache 中 没有注册 GetHandler 时 Get 请求直接由缓存应答 不进入用户代码
+             * Update 只有在值发生变化时才发送 notification 配置了 minUpdatePeriod 时 间隔内的变化合并为一次
+             * 合并后的最后一次变化到期时在 utils::TaskScheduler 线程上发出
+             * 构造时向 Skeleton 注册 getter / setter 方法 收到请求后调用 HandleGet / HandleSet 并应答
+             *
+             * \tparam T     Field 的数据类型
+             * \tparam Equal 判断值是否变化的比较器
+             *
+             * @ID{[SWS_CM_00007]}
+             */
+            template <typename T, typename Equal = std::equal_to<T>>
+            class FieldSkeleton
+            {
+            public:
+                using FieldType = T;
+                using GetHandler = std::function<ara::core::Future<T>()>;
+                using SetHandler = std::function<ara::core::Future<T>(const T &)>;
+                using Clock = std::chrono::steady_clock;
+
+                FieldSkeleton(std::shared_ptr<Skeleton> skeleton, const FieldConfig &config)
+                    : skeleton_(skeleton), config_(config), notifier_(skeleton), pending_(false), scheduled_(false),
+                      guard_(std::make_shared<Guard>(this))
+                {
+                    // handler 在 skeleton 的执行器上执行 和网络 binding 的其他方法一样按 MethodCallProcessingMode 处理
+                    // handler 的生命周期跟随 skeleton 经 guard_ 找到 FieldSkeleton 析构后排队中的请求不再应答
+                    std::shared_ptr<Guard> guard = guard_;
+                    if (config_.hasGetter)
+                    {
+                        skeleton_->RegisterServiceMethod(config_.getterId, [guard](const std::shared_ptr<Message> &request)
+                                                         {
+                                                             std::shared_lock<std::shared_timed_mutex> lock(guard->mutex);
+                                                             if (guard->owner != nullptr)
+                                                             {
+                                                                 guard->owner->respond(request, guard->owner->HandleGet());
+                                                             }
+                                                         });
+                    }
+                    if (config_.hasSetter)
+                    {
+                        skeleton_->RegisterServiceMethod(config_.setterId, [guard](const std::shared_ptr<Message> &request)
+                                                         {
+                                                             std::shared_lock<std::shared_timed_mutex> lock(guard->mutex);
+                                                             if (guard->owner != nullptr)
+                                                             {
+                                                                 guard->owner->onSet(request);
+                                                             }
+                                                         });
+                    }
+                }
+
+                /**
+                 * \brief 等待正在执行的 handler 和 flush 结束 不能在 GetHandler SetHandler 里析构
+                 */
+                ~FieldSkeleton()
+                {
+                    std::lock_guard<std::shared_timed_mutex> lock(guard_->mutex);
+                    guard_->owner = nullptr;
+                }
+
+                FieldSkeleton(const FieldSkeleton &) = delete;
+                FieldSkeleton &operator=(const FieldSkeleton &) = delete;
+
+                /**
+                 * \brief 更新 Field 的值 值有变化时发送 notification
+                 * \param data 新值
+                 * \return ara::core::Result<void>
+                 *
+                 * @ID{[SWS_CM_00119]}
+                 */
+                ara::core::Result<void> Update(const T &data)
+                {
+                    std::lock_guard<std::mutex> lock(writeMutex_);
+                    if (cache_.IsValid())
+                    {
+                        ara::core::Result<T> last = cache_.Load();
+                        if (last.HasValue() && equal_(last.Value(), data))
+                        {
+                            return ara::core::Result<void>::FromValue();
+                        }
+                    }
+                    cache_.Store(data);
+                    notifyLocked(data, Clock::now());
+                    return ara::core::Result<void>::FromValue();
+                }
+
+                /**
+                 * \brief 注册 GetHandler 需要在 OfferService 之前调用
+                 *
+                 * 注册后 Get 请求会进入用户代码 不再由缓存直接应答
+                 *
+                 * @ID{[SWS_CM_00114]}
+                 */
+                ara::core::Result<void> RegisterGetHandler(GetHandler getHandler)
+                {
+                    getHandler_ = std::move(getHandler);
+                    return ara::core::Result<void>::FromValue();
+                }
+
+                /**
+                 * \brief 注册 SetHandler 需要在 OfferService 之前调用
+                 *
+                 * @ID{[SWS_CM_00116]}
+                 */
+                ara::core::Result<void> RegisterSetHandler(SetHandler setHandler)
+                {
+                    setHandler_ = std::move(setHandler);
+                    return ara::core::Result<void>::FromValue();
+                }
+
+                /**
+                 * \brief OfferService 前的检查 需要有初值 有 setter 时需要有 SetHandler
+                 *
+                 * @ID{[SWS_CM_00128]}
+                 * @ID{[SWS_CM_00129]}
+                 */
+                ara::core::Result<void> Verify() const
+                {
+                    if (config_.hasSetter && !setHandler_)
+                    {
+                        return ara::core::Result<void>::FromError(MakeErrorCode(ComErrc::kSetHandlerNotSet, 0));
+                    }
+                    if (!getHandler_ && !cache_.IsValid())
+                    {
+                        return ara::core::Result<void>::FromError(MakeErrorCode(ComErrc::kFieldValueIsNotValid, 0));
+                    }
+                    return ara::core::Result<void>::FromValue();
+                }
+
+                /**
+                 * \brief 到期时发送被 minUpdatePeriod 推迟的 notification
+                 *
+                 * 推迟时已经在 TaskScheduler 上安排了发送 周期任务想在自己的线程上发出时也可以调用
+                 */
+                void ProcessPendingNotification()
+                {
+                    std::lock_guard<std::mutex> lock(writeMutex_);
+                    flushLocked();
+                }
+
+                /**
+                 * \brief binding 收到 Get 请求时调用
+                 * \return 缓存值 或 GetHandler 的结果
+                 */
+                ara::core::Result<T> HandleGet()
+                {
+                    if (getHandler_)
+                    {
+                        return getHandler_().GetResult();
+                    }
+                    return cache_.Load();
+                }
+
+                /**
+                 * \brief binding 收到 Set 请求时调用 SetHandler 返回的有效值会写回缓存
+                 * \param requested 客户端请求的值
+                 * \return SetHandler 实际生效的值
+                 */
+                ara::core::Result<T> HandleSet(const T &requested)
+                {
+                    if (!setHandler_)
+                    {
+                        return ara::core::Result<T>::FromError(MakeErrorCode(ComErrc::kSetHandlerNotSet, 0));
+                    }
+                    ara::core::Result<T> effective = setHandler_(requested).GetResult();
+                    if (effective.HasValue())
+                    {
+                        Update(effective.Value());
+                    }
+                    return effective;
+                }
+
+                const FieldConfig &GetConfig() const { return config_; }
+
+            private:
+                /**
+                 * \brief 判断是否需要立即发送 调用者持有 writeMutex_
+                 */
+                void notifyLocked(const T &data, Clock::time_point now)
+                {
+                    if (!config_.hasNotifier)
+                    {
+                        return;
+                    }
+                    if (config_.minUpdatePeriod.count() == 0 || now - lastNotify_ >= config_.minUpdatePeriod)
+                    {
+                        sendLocked(data, now);
+                    }
+                    else
+                    {
+                        pending_ = true;
+                        scheduleLocked();
+                    }
+                }
+
+                /**
+                 * \brief 发送到期的推迟 notification 还没到期时重新安排 调用者持有 writeMutex_
+                 */
+                void flushLocked()
+                {
+                    if (!pending_)
+                    {
+                        return;
+                    }
+                    const Clock::time_point now = Clock::now();
+                    if (now - lastNotify_ < config_.minUpdatePeriod)
+                    {
+                        scheduleLocked();
+                        return;
+                    }
+                    ara::core::Result<T> latest = cache_.Load();
+                    if (latest.HasValue())
+                    {
+                        sendLocked(latest.Value(), now);
+                    }
+                }
+
+                /**
+                 * \brief 在 lastNotify_ + minUpdatePeriod 安排一次 flush 同时只安排一个 调用者持有 writeMutex_
+                 */
+                void scheduleLocked()
+                {
+                    if (scheduled_)
+                    {
+                        return;
+                    }
+                    scheduled_ = true;
+                    std::shared_ptr<Guard> guard = guard_;
+                    ara::com::utils::TaskScheduler::Instance().At(lastNotify_ + config_.minUpdatePeriod, [guard]
+                                                                  {
+                                                                      std::shared_lock<std::shared_timed_mutex> lock(guard->mutex);
+                                                                      if (guard->owner != nullptr)
+                                                                      {
+                                                                          guard->owner->onTimer();
+                                                                      }
+                                                                  });
+                }
+
+                void onTimer()
+                {
+                    std::lock_guard<std::mutex> lock(writeMutex_);
+                    scheduled_ = false;
+                    flushLocked();
+                }
+
+                void onSet(const std::shared_ptr<Message> &request)
+                {
+                    T requested;
+                    if (!serialization::DeserializeFromPayload(*request->get_payload(), requested).HasValue())
+                    {
+                        respond(request, ara::core::Result<T>::FromError(MakeErrorCode(ComErrc::kCommunicationStackError, 0)));
+                        return;
+                    }
+                    respond(request, HandleSet(requested));
+                }
+
+                /**
+                 * \brief 出错时应答不带 payload FieldProxy 反序列化失败 Future 以错误结束
+                 */
+                void respond(const std::shared_ptr<Message> &request, const ara::core::Result<T> &result)
+                {
+                    std::shared_ptr<Message> response = runtime::CreateResponse(request);
+                    if (result.HasValue())
+                    {
+                        serialization::SerializeToPayload(result.Value(), *response->get_payload());
+                    }
+                    skeleton_->SendResponse(response);
+                }
+
+                void sendLocked(const T &data, Clock::time_point now)
+                {
+                    notifier_.Send(T(data));
+                    lastNotify_ = now;
+                    pending_ = false;
+                }
+
+            private:
+                // getter / setter handler 和 TaskScheduler 的任务经它找到 FieldSkeleton 析构后什么也不做
+                // 执行时持有共享锁 互相不阻塞 析构持有独占锁
+                struct Guard
+                {
+                    explicit Guard(FieldSkeleton *field) : owner(field) {}
+
+                    std::shared_timed_mutex mutex;
+                    FieldSkeleton *owner;
+                };
+
+                std::shared_ptr<Skeleton> skeleton_;
+                FieldConfig config_;
+                FieldCache<T> cache_;
+                EventSkeleton<T> notifier_;
+                GetHandler getHandler_;
+                SetHandler setHandler_;
+                Equal equal_;
+                std::mutex writeMutex_;          // 串行化 Update 与 HandleSet 读端不加锁
+                Clock::time_point lastNotify_;   // 上一次发送 notification 的时间
+                bool pending_;                   // 有被推迟的 notification
+                bool scheduled_;                 // TaskScheduler 上有等待中的 flush
+                std::shared_ptr<Guard> guard_;
+            };
+
+        } // namespace field
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _FIELD_SKELETON_HPP_
@@ -0,0 +1,46 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief Field 的部署配置
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _FIELD_TYPES_H_
+#define _FIELD_TYPES_H_
+
+#include <chrono>
+
+namespace ara
+{
+    namespace com
+    {
+        namespace field
+        {
+            /**
+             * \brief Field 的部署信息 对应 vsomeip 配置里 is_field 的 event 以及 getter/setter 方法
+             *
+             * 由生成代码填写 Proxy 和 Skeleton 使用同一份配置
+             */
+            struct FieldConfig
+            {
+                bool hasGetter = true;   ///< 是否有 getter 方法
+                bool hasSetter = false;  ///< 是否有 setter 方法
+                bool hasNotifier = true; ///< 是否有 notifier 事件
+                method_t getterId = 0;   ///< getter 方法 id
+                method_t setterId = 0;   ///< setter 方法 id
+                event_t notifierId = 0;  ///< notifier 事件 id
+
+                /**
+                 * \brief 两次 notification 之间的最小间隔 0 代表不限制
+                 *
+                 * 间隔内的多次变化只发送最后一次的值 与 vsomeip 的 update-cycle (周期重发) 无关
+                 */
+                std::chrono::milliseconds minUpdatePeriod{0};
+            };
+
+        } // namespace field
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _FIELD_TYPES_H_
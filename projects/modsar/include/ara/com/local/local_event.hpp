@@ -0,0 +1,99 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 同进程的 event 订阅者拿到的 SamplePtr 指向发布者的 sample 不序列化不拷贝
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _LOCAL_EVENT_HPP_
+#define _LOCAL_EVENT_HPP_
+
+#include <memory>
+#include <utility>
+
+#include "ara/com/event/event_distributor.hpp"
+#include "ara/com/sample_ptr.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace local
+        {
+            /**
+             * \brief LocalService 按 event id 保存 proxy 取出时按 sample 类型向下转换
+             */
+            class LocalEventBase
+            {
+            public:
+                virtual ~LocalEventBase() = default;
+            };
+
+            /**
+             * \brief 一个 event 的本地分发
+             *
+             * 每次 Send 只构造一个 SamplePtr 所有订阅者共享 订阅者队列的类型和 EventProxy::SampleQueue 一致
+             * binding 在 EventProxy::Subscribe 时把 Subscribe 返回的队列交给 EventProxy::AttachSampleQueue
+             * 限速和队列策略沿用 EventSkeleton::GetQos
+             *
+             * \tparam T sample 类型
+             */
+            template <typename T>
+            class LocalEvent : public LocalEventBase
+            {
+            public:
+                using Sample = std::shared_ptr<SamplePtr<T>>;
+                using Distributor = ara::com::event::EventDistributor<Sample>;
+                using Queue = typename Distributor::Queue;
+
+                explicit LocalEvent(const ara::com::event::EventQosConfig &qos) : distributor_(qos) {}
+
+                /**
+                 * \brief 发送已经在堆上的 sample 订阅者直接引用它
+                 * 发送之后发布者不能再修改 sample
+                 */
+                ara::com::event::PublishResult Send(std::shared_ptr<T> data)
+                {
+                    Sample sample = std::make_shared<SamplePtr<T>>();
+                    sample->ResetShared(std::move(data));
+                    return distributor_.Publish(sample);
+                }
+
+                /**
+                 * \brief 对应 EventSkeleton::Send(SampleType &&) 移动进共享的 sample
+                 */
+                ara::com::event::PublishResult Send(T &&data)
+                {
+                    return Send(std::make_shared<T>(std::move(data)));
+                }
+
+                std::shared_ptr<Queue> Subscribe(size_t maxSampleCount)
+                {
+                    return distributor_.Subscribe(maxSampleCount);
+                }
+
+                /**
+                 * \param queueConfig 订阅者自己的队列策略 即 EventProxy::GetQueuePolicy
+                 */
+                std::shared_ptr<Queue> Subscribe(size_t maxSampleCount, const ara::com::event::SubscriberQueueConfig &queueConfig)
+                {
+                    return distributor_.Subscribe(maxSampleCount, queueConfig);
+                }
+
+                void Unsubscribe(const std::shared_ptr<Queue> &queue)
+                {
+                    distributor_.Unsubscribe(queue);
+                }
+
+                size_t SubscriberCount() const { return distributor_.SubscriberCount(); }
+
+            private:
+                Distributor distributor_;
+            };
+
+        } // namespace local
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _LOCAL_EVENT_HPP_
@@ -0,0 +1,116 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 同进程的方法调用 请求对象直接交给 skeleton 的 handler 不序列化
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _LOCAL_METHOD_HPP_
+#define _LOCAL_METHOD_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "ara/core/future.h"
+#include "ara/core/promise.h"
+#include "ara/core/result.h"
+#include "ara/com/com_error_domain.h"
+#include "ara/com/skeleton/method_call_dispatcher.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace local
+        {
+            /**
+             * \brief LocalService 按方法 id 保存 proxy 取出时按请求应答类型向下转换
+             */
+            class LocalMethodBase
+            {
+            public:
+                LocalMethodBase() : available_(false) {}
+                virtual ~LocalMethodBase() = default;
+
+                void SetAvailable(bool available) { available_.store(available, std::memory_order_release); }
+
+                bool IsAvailable() const { return available_.load(std::memory_order_acquire); }
+
+            private:
+                std::atomic<bool> available_;
+            };
+
+            /**
+             * \brief 一个方法的本地入口
+             *
+             * Call 把 handler 交给 skeleton 的 MethodCallDispatcher 执行 和网络来的请求一样遵守 MethodCallProcessingMode
+             * kPoll 下在应用调用 ProcessNextMethodCall 的线程执行 kEvent 下在 WorkerPool 上执行
+             * 请求在 Call 里移动进任务 应答移动进 Future 全程没有序列化和额外拷贝
+             *
+             * \tparam Request 请求参数类型
+             * \tparam Response 应答类型
+             */
+            template <typename Request, typename Response>
+            class LocalMethod : public LocalMethodBase
+            {
+            public:
+                using Handler = std::function<ara::core::Result<Response>(const Request &)>;
+
+                /**
+                 * \param ordered 同一客户端的调用保持顺序 和 Skeleton::RegisterServiceMethod 的 ordered 一致
+                 */
+                LocalMethod(std::shared_ptr<ara::com::skeleton::MethodCallDispatcher> dispatcher, Handler handler, bool ordered = false)
+                    : dispatcher_(std::move(dispatcher)), handler_(std::make_shared<const Handler>(std::move(handler))), ordered_(ordered)
+                {
+                }
+
+                /**
+                 * \param client 调用方的客户端 id 由 LocalServiceRegistry::NextClientId 分配
+                 * \return 服务已经 StopOffer 时 Future 直接带 kServiceNotAvailable kPoll 队列已满时带 kMaxSamplesExceeded
+                 */
+                ara::core::Future<Response> Call(uint16_t client, Request request)
+                {
+                    std::shared_ptr<ara::core::Promise<Response>> promise = std::make_shared<ara::core::Promise<Response>>();
+                    ara::core::Future<Response> future = promise->get_future();
+                    if (!IsAvailable())
+                    {
+                        promise->SetError(MakeErrorCode(ComErrc::kServiceNotAvailable, 0));
+                        return future;
+                    }
+                    std::shared_ptr<const Handler> handler = handler_;
+                    std::shared_ptr<Request> argument = std::make_shared<Request>(std::move(request));
+                    ara::core::Result<void> dispatched = dispatcher_->Dispatch(
+                        client, [handler, argument, promise]
+                        {
+                            ara::core::Result<Response> result = (*handler)(*argument);
+                            if (result.HasValue())
+                            {
+                                promise->set_value(std::move(result).Value());
+                            }
+                            else
+                            {
+                                promise->SetError(result.Error());
+                            } },
+                        ordered_);
+                    if (!dispatched.HasValue())
+                    {
+                        promise->SetError(dispatched.Error());
+                    }
+                    return future;
+                }
+
+            private:
+                const std::shared_ptr<ara::com::skeleton::MethodCallDispatcher> dispatcher_;
+                const std::shared_ptr<const Handler> handler_;
+                const bool ordered_;
+            };
+
+        } // namespace local
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _LOCAL_METHOD_HPP_
@@ -0,0 +1,156 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 同进程 binding 的服务实例 skeleton 注册方法和 event proxy 直接取用
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _LOCAL_SERVICE_HPP_
+#define _LOCAL_SERVICE_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+#include "ara/com/local/local_event.hpp"
+#include "ara/com/local/local_method.hpp"
+#include "ara/com/local/local_service_registry.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace local
+        {
+            /**
+             * \brief 一个 skeleton 实例在同进程 binding 上的入口
+             *
+             * 方法和 event 在 Offer 之前注册 Offer 之后表只读 proxy 查找不加锁
+             * 方法调用交给 skeleton 的 MethodCallDispatcher 和网络 binding 共用同一个执行器
+             */
+            class LocalService : public std::enable_shared_from_this<LocalService>
+            {
+            public:
+                LocalService(uint16_t serviceId, uint16_t instanceId, std::shared_ptr<ara::com::skeleton::MethodCallDispatcher> dispatcher)
+                    : serviceId_(serviceId), instanceId_(instanceId), dispatcher_(std::move(dispatcher)), offered_(false)
+                {
+                }
+
+                LocalService(const LocalService &) = delete;
+                LocalService &operator=(const LocalService &) = delete;
+
+                uint16_t ServiceId() const { return serviceId_; }
+
+                uint16_t InstanceId() const { return instanceId_; }
+
+                /**
+                 * \brief 注册方法 只能在 Offer 之前调用
+                 * \return 已经 Offer 或方法 id 重复时返回 false
+                 */
+                template <typename Request, typename Response>
+                bool RegisterMethod(uint16_t methodId, typename LocalMethod<Request, Response>::Handler handler, bool ordered = false)
+                {
+                    if (offered_ || methods_.count(methodId) != 0)
+                    {
+                        return false;
+                    }
+                    methods_.emplace(methodId, std::make_shared<LocalMethod<Request, Response>>(dispatcher_, std::move(handler), ordered));
+                    return true;
+                }
+
+                /**
+                 * \brief 注册 event 只能在 Offer 之前调用 skeleton 用返回值发送
+                 * \param qos EventSkeleton::GetQos
+                 * \return 已经 Offer 或 event id 重复时返回 nullptr
+                 */
+                template <typename T>
+                std::shared_ptr<LocalEvent<T>> RegisterEvent(uint16_t eventId, const ara::com::event::EventQosConfig &qos)
+                {
+                    if (offered_ || events_.count(eventId) != 0)
+                    {
+                        return nullptr;
+                    }
+                    std::shared_ptr<LocalEvent<T>> event = std::make_shared<LocalEvent<T>>(qos);
+                    events_.emplace(eventId, event);
+                    return event;
+                }
+
+                /**
+                 * \brief proxy 取方法 类型和注册时不一致时返回 nullptr
+                 */
+                template <typename Request, typename Response>
+                std::shared_ptr<LocalMethod<Request, Response>> GetMethod(uint16_t methodId) const
+                {
+                    auto found = methods_.find(methodId);
+                    return found != methods_.end() ? std::dynamic_pointer_cast<LocalMethod<Request, Response>>(found->second) : nullptr;
+                }
+
+                /**
+                 * \brief proxy 取 event 类型和注册时不一致时返回 nullptr
+                 */
+                template <typename T>
+                std::shared_ptr<LocalEvent<T>> GetEvent(uint16_t eventId) const
+                {
+                    auto found = events_.find(eventId);
+                    return found != events_.end() ? std::dynamic_pointer_cast<LocalEvent<T>>(found->second) : nullptr;
+                }
+
+                /**
+                 * \brief 登记到 LocalServiceRegistry 同进程的 FindService 从此能找到
+                 * 登记期间 registry 持有实例 skeleton 在 StopOfferService 时调用 StopOffer
+                 * \return 同一个实例已经被其他 skeleton Offer 时返回 kCouldNotExecute
+                 */
+                ara::core::Result<void> Offer()
+                {
+                    if (offered_)
+                    {
+                        return ara::core::Result<void>::FromValue();
+                    }
+                    ara::core::Result<void> offered = LocalServiceRegistry::Instance().Offer(shared_from_this());
+                    if (offered.HasValue())
+                    {
+                        offered_ = true;
+                        setAvailable(true);
+                    }
+                    return offered;
+                }
+
+                /**
+                 * \brief 之后新的调用直接以 kServiceNotAvailable 结束 已经在执行器里的调用照常完成
+                 */
+                void StopOffer()
+                {
+                    if (!offered_)
+                    {
+                        return;
+                    }
+                    offered_ = false;
+                    setAvailable(false);
+                    LocalServiceRegistry::Instance().StopOffer(serviceId_, instanceId_, this);
+                }
+
+                bool IsOffered() const { return offered_; }
+
+            private:
+                void setAvailable(bool available)
+                {
+                    for (auto &method : methods_)
+                    {
+                        method.second->SetAvailable(available);
+                    }
+                }
+
+                const uint16_t serviceId_;
+                const uint16_t instanceId_;
+                const std::shared_ptr<ara::com::skeleton::MethodCallDispatcher> dispatcher_;
+                std::unordered_map<uint16_t, std::shared_ptr<LocalMethodBase>> methods_;
+                std::unordered_map<uint16_t, std::shared_ptr<LocalEventBase>> events_;
+                bool offered_; // 只在 skeleton 的线程修改
+            };
+
+        } // namespace local
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _LOCAL_SERVICE_HPP_
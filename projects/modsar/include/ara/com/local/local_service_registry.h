@@ -0,0 +1,124 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 进程内已经 Offer 的服务实例表 FindService 先查这里 命中时走同进程 binding
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _LOCAL_SERVICE_REGISTRY_H_
+#define _LOCAL_SERVICE_REGISTRY_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "ara/core/result.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace local
+        {
+            class LocalService;
+
+            using LocalFindHandler = std::function<void(const std::vector<std::shared_ptr<LocalService>> &services)>;
+
+            /**
+             * \brief 进程唯一的本地服务表
+             *
+             * 表写时复制 Offer / StopOffer 加锁换表 查找只读一次快照 不和 Offer 互斥
+             * StartFind 的 handler 在 Offer / StopOffer 的线程上 换表之后 锁外调用 只在结果变化时调用
+             */
+            class LocalServiceRegistry
+            {
+            public:
+                static constexpr uint16_t kAnyInstance = 0xFFFF;
+
+                static LocalServiceRegistry &Instance();
+
+                LocalServiceRegistry(const LocalServiceRegistry &) = delete;
+                LocalServiceRegistry &operator=(const LocalServiceRegistry &) = delete;
+
+                /**
+                 * \return 同一个 service instance 已经登记时返回 kCouldNotExecute
+                 */
+                ara::core::Result<void> Offer(std::shared_ptr<LocalService> service);
+
+                /**
+                 * \brief 只移除 owner 自己登记的实例
+                 */
+                void StopOffer(uint16_t serviceId, uint16_t instanceId, const LocalService *owner);
+
+                /**
+                 * \return 没有登记时返回 nullptr instanceId 为 kAnyInstance 时返回任意一个
+                 */
+                std::shared_ptr<LocalService> Find(uint16_t serviceId, uint16_t instanceId) const;
+
+                /**
+                 * \brief 按 instance id 排序 instanceId 为 kAnyInstance 时返回该服务的全部实例
+                 */
+                std::vector<std::shared_ptr<LocalService>> FindAll(uint16_t serviceId, uint16_t instanceId) const;
+
+                bool IsOffered(uint16_t serviceId, uint16_t instanceId) const { return Find(serviceId, instanceId) != nullptr; }
+
+                /**
+                 * \brief 本地 proxy 的客户端 id 用于 kEvent 模式下按客户端保持顺序
+                 * 从 0x8000 开始 不和 SOME/IP 分配的客户端 id 重叠
+                 */
+                uint16_t NextClientId();
+
+                /**
+                 * \brief 立即用当前结果调用一次 handler 之后结果变化时调用 结果和 FindAll 相同
+                 * handler 里可以 Offer / StopOffer 和 StartFind / StopFind
+                 * \return 停止时传给 StopFind 的 id 从 1 开始
+                 */
+                uint64_t StartFind(uint16_t serviceId, uint16_t instanceId, LocalFindHandler handler);
+
+                /**
+                 * \brief 返回后 handler 不会再被调用 在其他线程上正在执行的 handler 会先执行完
+                 */
+                void StopFind(uint64_t id);
+
+            private:
+                using Table = std::unordered_map<uint32_t, std::shared_ptr<LocalService>>;
+
+                struct Watch
+                {
+                    uint64_t id;
+                    uint16_t serviceId;
+                    uint16_t instanceId;
+                    LocalFindHandler handler;
+                    std::vector<std::shared_ptr<LocalService>> last; // 上次通知的结果
+                };
+
+                LocalServiceRegistry();
+
+                static uint32_t keyOf(uint16_t serviceId, uint16_t instanceId)
+                {
+                    return (static_cast<uint32_t>(serviceId) << 16) | instanceId;
+                }
+
+                // 换表之后调用 不持有 writeMutex_
+                void notifyWatches();
+
+                std::mutex writeMutex_; // 串行化表的修改
+                std::shared_ptr<const Table> table_;
+                std::atomic<uint16_t> nextClient_;
+
+                std::mutex watchMutex_;              // 保护 watches_ 和 nextWatchId_
+                std::recursive_mutex handlerMutex_; // 串行化通知 StopFind 据此等待正在执行的 handler
+                std::vector<std::shared_ptr<Watch>> watches_;
+                uint64_t nextWatchId_;
+            };
+
+        } // namespace local
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _LOCAL_SERVICE_REGISTRY_H_
@@ -27,6 +27,9 @@
 #endif
 #include "method_proxy.hpp"
 #include "instance_identifer.h"
+#include "ara/com/routing/routing_table.h"
+#include "ara/com/sd/find_probes.hpp"
+#include "ara/com/sd/parallel_find.hpp"
 /***
  * \brief 方法代理的实现 头文件名称不采用缩写 尽量全称
  *  MethodProxyImplemation
@@ -101,6 +104,13 @@ public:
         delete call;
         return status;
     }
+    /**
+     * \brief 异步调用 立即返回 应答由 sayHelloCall_ 常驻的 handler 按 session id 完成
+     */
+    ara::core::Future<::helloworld::HelloReply> sayHelloAsync(const ::helloworld::HelloRequest &request)
+    {
+        return sayHelloCall_.invoke(request);
+    }
     // 实际上需要在Proxy对应的实现为
     core::Futher<void> sayHello1(const int &helloType) override
     {
@@ -116,9 +126,60 @@ public:
     ara::core::Result<ara::com::ServiceHandleContainer<IHelloworldMethodProxy::HandleType>> 
     FindService(ara::com::InstanceIdentifier instance)
     {
-        ::com::SetDeploymentType(instance, ::ara::com::DeploymentType::<#if serviceId == "0x0">IPC<#else>SOME_IP</#if>);
+        // kInvalidId 或超出 16 位的 id 截断后会指向另一个实例
+        const ::ara::core::Result<uint16_t> instanceId = instance.BindingId();
+        if (!instanceId.HasValue())
+        {
+            return ara::core::Result<ara::com::ServiceHandleContainer<IHelloworldMethodProxy::HandleType>>::FromError(instanceId.Error());
+        }
+        // 实例可能同时在多个 binding 上 Offer 选对本进程开销最低的 同进程 > 共享内存 > SOME/IP 或 DDS
+        ::ara::core::Result<::ara::com::routing::BindingKind> binding =
+            ::ara::com::routing::RoutingTable::Instance().Select(${name}::GetServiceIdentifier(), instanceId.Value());
+        if (binding.HasValue())
+        {
+            ::com::SetDeploymentType(instance, binding.Value());
+        }
+        else
+        {
+            // 还没有 binding 上报这个实例 (SOME/IP 只在 RequestService 之后才知道可用状态) 按部署配置的类型查找
+            ::com::SetDeploymentType(instance, ::ara::com::DeploymentType::<#if serviceId == "0x0">IPC<#else>SOME_IP</#if>);
+        }
         return ::com::sd::Runtime::GetInstance().findService(${name}::GetServiceIdentifier(), instance);
     }
+
+    /**
+     * \brief 不阻塞 同时在部署配置的每个 binding 上查找 先找到的结果或超时 (空列表) 完成 Future
+     * 实例没有合法的 16 位 id 时 Future 直接带 kInvalidInstanceIdentifierString 返回
+     */
+    static ara::core::Future<ara::com::ServiceHandleContainer<IHelloworldMethodProxy::HandleType>>
+    FindServiceAsync(ara::com::InstanceIdentifier instance, std::chrono::milliseconds timeout)
+    {
+        const ::ara::core::Result<uint16_t> instanceId = instance.BindingId();
+        if (!instanceId.HasValue())
+        {
+            ara::core::Promise<ara::com::ServiceHandleContainer<IHelloworldMethodProxy::HandleType>> failed;
+            failed.SetError(instanceId.Error());
+            return failed.get_future();
+        }
+        // 第一次调用时添加各 binding 的查找 找到的 handle 记下找到它的 binding
+        static const bool probesAdded = []
+        {
+            ::ara::com::sd::AddDefaultProbes<IHelloworldMethodProxy::HandleType>(
+                [](uint16_t, uint16_t id, ::ara::com::routing::BindingKind kind)
+                {
+                    ara::com::InstanceIdentifier found = ara::com::InstanceIdentifier::Create(std::to_string(id)).Value();
+                    ::com::SetDeploymentType(found, kind);
+                    return IHelloworldMethodProxy::HandleType(found);
+                });
+            return true;
+        }();
+        (void)probesAdded;
+        return ::ara::com::sd::ParallelFind<IHelloworldMethodProxy::HandleType>::Instance().FindServiceAsync(
+            ${name}::GetServiceIdentifier(), instanceId.Value(), timeout);
+    }
+
+private:
+    NonBlockingCall<::helloworld::HelloRequest, ::helloworld::HelloReply, Proxy> sayHelloCall_{rpcmethod_, GetProxy()};
 };
 
 #endif // METHOD_PROXY_IMPL_HPP_
\ No newline at end of file
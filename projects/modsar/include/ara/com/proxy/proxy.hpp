@@ -1,16 +1,66 @@
 #ifndef _PROXY_HPP_
 #define _PROXY_HPP_
 #include <memory>
+#include <unordered_map>
+#include <vector>
 #include "instance_identifer.h"
+#include "ara/com/event/event_proxy.hpp"
+#include "ara/com/rpc/request_pipeline.h"
+#include "ara/com/someip/someip_connection.h"
 
 class Proxy : public Adapter
 {
 public:
+     /**
+      * SOME/IP binding 的收发都经过进程共用的 someip::SomeIpConnection
+      * 构造时 Acquire 析构时 Release 不再每个 Proxy 创建一个 vsomeip application
+      */
      Proxy();
+     /**
+      * 经 SomeIpConnection::SendRequest 发出 带上该方法在 RegisterMessageHandler 时得到的 handler id
+      * 应答只回到这个 Proxy 其他 Proxy 的同名 session 不会认领它
+      */
      void SendRequest(Message data);
+     /**
+      * 一次 transport 写出多条请求 RequestPipeline 合并突发请求后调用
+      * 经 SomeIpConnection::SendRequests 整批发出 每条请求带上所属方法的 handler id
+      * 连接没有运行时整批丢弃 由调用的超时结束
+      */
+     void SendRequests(const std::vector<std::shared_ptr<Message>> &batch)
+     {
+          std::vector<ara::com::someip::HandlerId> handlers;
+          handlers.reserve(batch.size());
+          for (const std::shared_ptr<Message> &request : batch)
+          {
+               auto found = responseHandlers_.find(request->get_method());
+               handlers.push_back(found != responseHandlers_.end() ? found->second : ara::com::someip::kInvalidHandlerId);
+          }
+          ara::com::someip::SomeIpConnection::Instance().SendRequests(batch, handlers);
+     }
      void RegisterMessageHandler(MethodId method_id, message_handler_t handler);
+     /**
+      * 启动时一次订阅该 proxy 的多个 event 代替逐个 EventProxy::Subscribe
+      * 经 SOME/IP 的 handler 用一次 RegisterResponseHandlers 注册 再用一次 SubscribeEvents 订阅
+      */
+     ara::core::Result<void> SubscribeEvents(const std::vector<ara::com::event::EventProxy *> &events, size_t maxSampleCount)
+     {
+          return ara::com::event::EventProxy::SubscribeEvents(events, maxSampleCount);
+     }
+     /**
+      * 配置方法调用流水线 需要在创建 NonBlockingCall 之前调用
+      * 未配置时请求直接经 SendRequest 发出 没有在途窗口限制
+      */
+     void ConfigurePipeline(const ara::com::rpc::PipelineConfig &config)
+     {
+          pipeline_ = std::make_shared<ara::com::rpc::RequestPipeline>(
+              config, [this](const std::vector<std::shared_ptr<Message>> &batch)
+              { SendRequests(batch); });
+     }
+     std::shared_ptr<ara::com::rpc::RequestPipeline> GetRequestPipeline() { return pipeline_; }
 private:
      std::shared_ptr<stub> stub_;
+     std::shared_ptr<ara::com::rpc::RequestPipeline> pipeline_;
+     std::unordered_map<MethodId, ara::com::someip::HandlerId> responseHandlers_; // RegisterMessageHandler 登记 SendRequest 查找
 };
 
 #endif // _PROXY_HPP_
\ No newline at end of file
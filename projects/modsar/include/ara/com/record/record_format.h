@@ -0,0 +1,96 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 录制文件的格式 录制和回放共用
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _RECORD_FORMAT_H_
+#define _RECORD_FORMAT_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ara
+{
+    namespace com
+    {
+        namespace record
+        {
+            /**
+             * \brief 录制的是哪一类报文
+             */
+            enum class RecordKind : uint8_t
+            {
+                kEvent = 0,
+                kRequest,
+                kResponse
+            };
+
+            /**
+             * \brief 报文属于哪个服务实例的哪个 event / method
+             */
+            struct RecordKey
+            {
+                uint16_t service;
+                uint16_t instance;
+                uint16_t id;      ///< event id 或 method id
+                uint16_t client;  ///< event 为 0
+                uint16_t session; ///< 请求和应答按 session 配对
+            };
+
+            /**
+             * \brief 每个分段文件开头的 64 字节
+             *
+             * 文件按 segmentSize 预先扩展后 mmap 写入 usedBytes 在每轮写入后更新
+             * 进程异常退出时回放只读到 usedBytes 为止
+             */
+            struct SegmentHeader
+            {
+                char magic[8];          ///< "ARACOMRC"
+                uint32_t version;
+                uint32_t headerSize;    ///< 第一条记录的偏移
+                uint64_t segmentIndex;  ///< 从 0 开始
+                uint64_t usedBytes;     ///< 包含本头部的已写入字节数
+                uint64_t reserved[4];
+            };
+
+            /**
+             * \brief 每条记录的 32 字节头部 后面跟 payloadLength 字节数据 再补齐到 8 字节
+             */
+            struct RecordHeader
+            {
+                uint32_t payloadLength;
+                RecordKind kind;
+                uint8_t reserved;
+                uint16_t client;
+                uint64_t timestampNs;   ///< steady_clock 时间 回放只用差值
+                uint16_t service;
+                uint16_t instance;
+                uint16_t id;
+                uint16_t session;
+                uint32_t threadIndex;   ///< 录制线程的编号
+                uint32_t reserved2;
+            };
+
+            constexpr char kRecordMagic[8] = {'A', 'R', 'A', 'C', 'O', 'M', 'R', 'C'};
+            constexpr uint32_t kRecordVersion = 1;
+            constexpr size_t kRecordAlignment = 8;
+
+            static_assert(sizeof(SegmentHeader) == 64, "SegmentHeader must stay 64 bytes");
+            static_assert(sizeof(RecordHeader) == 32, "RecordHeader must stay 32 bytes");
+
+            /**
+             * \brief 一条记录在文件和线程缓冲区里占用的字节数
+             */
+            inline size_t RecordSize(size_t payloadLength)
+            {
+                return sizeof(RecordHeader) + (payloadLength + kRecordAlignment - 1) / kRecordAlignment * kRecordAlignment;
+            }
+
+        } // namespace record
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _RECORD_FORMAT_H_
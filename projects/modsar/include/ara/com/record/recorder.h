@@ -0,0 +1,155 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 在 binding 层录制 event 和方法请求/应答 写入内存映射的分段文件
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _RECORDER_H_
+#define _RECORDER_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ara/core/result.h"
+#include "ara/com/record/record_format.h"
+#include "ara/com/utils/rcu.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace record
+        {
+            struct RecorderConfig
+            {
+                std::string directory = ".";                       ///< 分段文件所在目录 必须已存在
+                std::string prefix = "capture";                    ///< 文件名为 prefix.000000.arcrec
+                size_t segmentSize = 64 * 1024 * 1024;             ///< 单个分段文件的大小
+                size_t threadBufferSize = 1024 * 1024;             ///< 每个线程的缓冲区 向上取整到 2 的幂
+                std::chrono::milliseconds flushInterval{5};        ///< 写线程的轮询间隔
+            };
+
+            struct RecorderStatistics
+            {
+                uint64_t recorded = 0;  ///< 写入文件的记录数
+                uint64_t dropped = 0;   ///< 线程缓冲区满或记录超过分段大小而丢弃的记录数
+                uint64_t bytes = 0;     ///< 写入文件的字节数
+                uint64_t segments = 0;  ///< 已打开的分段文件数
+            };
+
+            /**
+             * \brief 录制器
+             *
+             * 热路径 Record 只把记录拷进本线程的单生产者环形缓冲区 不加锁 不做系统调用
+             * 缓冲区满时丢弃并计数 不阻塞业务线程
+             * 后台写线程周期性地把各线程缓冲区搬到 mmap 的分段文件里 写满一个分段再开下一个
+             *
+             * 不同线程的记录在文件里只是大致按时间排列 回放时按时间戳排序
+             */
+            class Recorder
+            {
+            public:
+                explicit Recorder(const RecorderConfig &config);
+                ~Recorder();
+
+                Recorder(const Recorder &) = delete;
+                Recorder &operator=(const Recorder &) = delete;
+
+                /**
+                 * \brief 打开第一个分段并启动写线程
+                 */
+                ara::core::Result<void> Start();
+
+                /**
+                 * \brief 写完缓冲区里剩余的记录 截断并关闭当前分段
+                 */
+                void Stop();
+
+                /**
+                 * \brief 录制一条报文 可以在任意线程调用
+                 * \return 缓冲区满或未启动时返回 false
+                 */
+                bool Record(RecordKind kind, const RecordKey &key, const uint8_t *payload, size_t length);
+
+                RecorderStatistics GetStatistics() const;
+
+            private:
+                class ThreadBuffer;
+                class SegmentWriter;
+
+                ThreadBuffer *threadBuffer();
+
+                void writerLoop();
+
+                void drainAll();
+
+            private:
+                const RecorderConfig config_;
+                const uint64_t id_; // 区分先后创建的录制器 线程局部缓存用它判断是否失效
+                std::atomic<bool> running_;
+                std::mutex buffersMutex_; // 只在线程第一次录制和写线程遍历时加锁
+                std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+                std::unique_ptr<SegmentWriter> writer_;
+                std::thread thread_;
+                std::mutex wakeMutex_;
+                std::condition_variable wake_;
+                std::atomic<uint64_t> recorded_;
+                std::atomic<uint64_t> dropped_;
+                std::atomic<uint64_t> bytes_;
+            };
+
+            /**
+             * \brief binding 录制的入口 没有活动的录制器时只有一次原子读
+             *
+             * binding 在 RCU 读区里使用录制器 录制器析构时先摘下自己 再等读区结束 可以直接销毁
+             * 换成另一个录制器后旧的录制器同样在析构时等待
+             */
+            void SetActiveRecorder(Recorder *recorder);
+
+            Recorder *GetActiveRecorder();
+
+            /**
+             * \brief 交给活动的录制器录制 读区保证录制期间录制器不被销毁
+             * \return 没有活动的录制器或录制器丢弃时返回 false
+             */
+            inline bool RecordPayload(RecordKind kind, const RecordKey &key, const uint8_t *payload, size_t length)
+            {
+                if (GetActiveRecorder() == nullptr)
+                {
+                    return false;
+                }
+                utils::RcuDomain::ReadGuard guard;
+                Recorder *recorder = GetActiveRecorder();
+                return recorder != nullptr && recorder->Record(kind, key, payload, length);
+            }
+
+            /**
+             * \brief 录制一个 vsomeip 风格的 message 取 service / instance / method / client / session 和 payload
+             * \param length 只录制 payload 的前 length 个字节 用于去掉末尾的追踪信息 默认录制全部
+             */
+            template <typename MessageType>
+            inline void RecordMessage(RecordKind kind, const MessageType &message, size_t length = static_cast<size_t>(-1))
+            {
+                if (GetActiveRecorder() == nullptr)
+                {
+                    return;
+                }
+                const RecordKey key{message.get_service(), message.get_instance(), message.get_method(), message.get_client(),
+                                    message.get_session()};
+                const size_t payloadLength = message.get_payload()->get_length();
+                RecordPayload(kind, key, message.get_payload()->get_data(), length < payloadLength ? length : payloadLength);
+            }
+
+        } // namespace record
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _RECORDER_H_
@@ -0,0 +1,65 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 把回放的记录重新交给 Skeleton 发布
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _REPLAY_SINK_HPP_
+#define _REPLAY_SINK_HPP_
+
+#include <memory>
+
+#include "ara/com/record/replayer.h"
+#include "ara/com/serialization/someip_serializer.hpp"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace record
+        {
+            /**
+             * \brief 反序列化 event 记录后通过 EventSkeleton::Send 重新发布 格式不对的记录被忽略
+             *
+             * \code
+             * replayer.RegisterSink(RecordKind::kEvent, 0x1234, 0x0001, 0x8001, MakeEventSink(skeleton->pointCloud));
+             * replayer.Run(ReplayMode::kOriginalTiming);
+             * \endcode
+             */
+            template <template <typename> class EventType, typename SampleType>
+            ReplaySink MakeEventSink(EventType<SampleType> &event)
+            {
+                return [&event](const RecordHeader &header, const uint8_t *payload)
+                {
+                    SampleType sample;
+                    if (serialization::Deserialize(payload, header.payloadLength, sample).HasValue())
+                    {
+                        event.Send(std::move(sample));
+                    }
+                };
+            }
+
+            /**
+             * \brief 请求记录转成 binding 的 message 交给 Skeleton 注册的方法 handler 应答照常由 Skeleton 发出
+             *
+             * 用于对服务端做离线的性能回归
+             */
+            template <typename Handler>
+            ReplaySink MakeRequestSink(Handler handler)
+            {
+                return [handler](const RecordHeader &header, const uint8_t *payload)
+                {
+                    std::shared_ptr<Message> request = runtime::CreateMessage(header.id);
+                    request->set_session(header.session);
+                    request->get_payload()->set_data(payload, header.payloadLength);
+                    handler(request);
+                };
+            }
+
+        } // namespace record
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _REPLAY_SINK_HPP_
@@ -0,0 +1,110 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 回放 Recorder 录制的分段文件 按原始节奏或尽快重新发布
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _REPLAYER_H_
+#define _REPLAYER_H_
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ara/core/result.h"
+#include "ara/com/record/record_format.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace record
+        {
+            enum class ReplayMode : uint8_t
+            {
+                kOriginalTiming = 0, ///< 按录制时的时间间隔 可以用 speed 加速或减速
+                kAsFastAsPossible    ///< 不等待 用于吞吐回归
+            };
+
+            struct ReplayStatistics
+            {
+                uint64_t replayed = 0;              ///< 交给 sink 的记录数
+                uint64_t skipped = 0;               ///< 没有注册 sink 的记录数
+                uint64_t bytes = 0;                 ///< 交给 sink 的 payload 字节数
+                std::chrono::nanoseconds maxLateness{0}; ///< kOriginalTiming 下相对计划时间的最大延迟
+                std::chrono::nanoseconds duration{0};    ///< 回放总耗时
+            };
+
+            /**
+             * \brief 记录的消费者 一般把 payload 反序列化后交给 Skeleton 发布 见 replay_sink.hpp
+             */
+            using ReplaySink = std::function<void(const RecordHeader &header, const uint8_t *payload)>;
+
+            /**
+             * \brief 打开 prefix.000000.arcrec 起连续编号的全部分段 只读 mmap 不拷贝 payload
+             *
+             * 打开时按时间戳对全部记录做一次稳定排序 Run 按排序后的顺序交给 sink
+             */
+            class Replayer
+            {
+            public:
+                Replayer(const std::string &directory, const std::string &prefix);
+                ~Replayer();
+
+                Replayer(const Replayer &) = delete;
+                Replayer &operator=(const Replayer &) = delete;
+
+                /**
+                 * \brief 映射分段并建立索引 第一个分段不存在或格式不对时返回 kErroneousFileHandle
+                 */
+                ara::core::Result<void> Open();
+
+                /**
+                 * \brief 为某个服务实例的 event / 请求 / 应答 注册 sink
+                 */
+                void RegisterSink(RecordKind kind, uint16_t service, uint16_t instance, uint16_t id, ReplaySink sink);
+
+                /**
+                 * \brief 在调用线程上回放全部记录 可以从其他线程 Stop
+                 * \param speed kOriginalTiming 下的倍速 2.0 表示两倍速
+                 */
+                ReplayStatistics Run(ReplayMode mode, double speed = 1.0);
+
+                void Stop() { stopped_.store(true, std::memory_order_relaxed); }
+
+                size_t RecordCount() const { return records_.size(); }
+
+                size_t SegmentCount() const { return segments_.size(); }
+
+            private:
+                struct Segment
+                {
+                    void *base;
+                    size_t size;
+                };
+
+                static uint64_t sinkKey(RecordKind kind, uint16_t service, uint16_t instance, uint16_t id);
+
+                bool index(const Segment &segment);
+
+                void close();
+
+            private:
+                const std::string directory_;
+                const std::string prefix_;
+                std::vector<Segment> segments_;
+                std::vector<const RecordHeader *> records_;
+                std::unordered_map<uint64_t, ReplaySink> sinks_;
+                std::atomic<bool> stopped_;
+            };
+
+        } // namespace record
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _REPLAYER_H_
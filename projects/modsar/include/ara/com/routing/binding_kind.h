@@ -0,0 +1,72 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief binding 的种类和线格式 按开销从低到高排列
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _BINDING_KIND_H_
+#define _BINDING_KIND_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ara
+{
+    namespace com
+    {
+        namespace routing
+        {
+            /**
+             * \brief 数值越小开销越低 路由时选可用的最小值
+             */
+            enum class BindingKind : uint8_t
+            {
+                kInProcess = 0, ///< 同进程 直接调用 见 local::LocalService
+                kSharedMemory,  ///< 同主机共享内存 (iceoryx)
+                kSomeIp,        ///< SOME/IP
+                kDds            ///< DDS
+            };
+
+            static constexpr size_t kBindingKindCount = 4;
+
+            /**
+             * \brief BindingKind 的集合 第 n 位对应数值为 n 的 BindingKind
+             */
+            using BindingMask = uint8_t;
+
+            static constexpr BindingMask kAllBindings = (1U << kBindingKindCount) - 1;
+
+            inline constexpr BindingMask MaskOf(BindingKind kind)
+            {
+                return static_cast<BindingMask>(1U << static_cast<uint8_t>(kind));
+            }
+
+            /**
+             * \brief sample 交给 binding 时的形式 同一种格式只序列化一次 所有该格式的 binding 共用
+             */
+            enum class WireFormat : uint8_t
+            {
+                kObject = 0, ///< 不序列化 直接共享 sample 对象
+                kSomeIp,     ///< SOME/IP 序列化 共享内存 binding 默认也用它
+                kCdr         ///< DDS 的 CDR
+            };
+
+            static constexpr size_t kWireFormatCount = 3;
+
+            /**
+             * \brief binding 没有特别指定时使用的格式
+             */
+            inline constexpr WireFormat DefaultWireFormat(BindingKind kind)
+            {
+                return kind == BindingKind::kInProcess ? WireFormat::kObject : (kind == BindingKind::kDds ? WireFormat::kCdr : WireFormat::kSomeIp);
+            }
+
+            const char *ToString(BindingKind kind);
+
+        } // namespace routing
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _BINDING_KIND_H_
@@ -0,0 +1,187 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 一个 event 同时发往多个 binding 每种线格式只序列化一次
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _MULTI_BINDING_EVENT_HPP_
+#define _MULTI_BINDING_EVENT_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "ara/com/local/local_event.hpp"
+#include "ara/com/routing/binding_kind.h"
+#include "ara/com/serialization/someip_serializer.hpp"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace routing
+        {
+            using SerializedSample = std::shared_ptr<const std::vector<uint8_t>>;
+
+            /**
+             * \brief 一个 binding 上的 event 发送端 各 binding 实现
+             */
+            template <typename T>
+            class EventSink
+            {
+            public:
+                virtual ~EventSink() = default;
+
+                virtual BindingKind Kind() const = 0;
+
+                virtual WireFormat Format() const { return DefaultWireFormat(Kind()); }
+
+                /**
+                 * \brief 没有订阅者时返回 false 该 binding 不参与序列化和发送
+                 */
+                virtual bool HasSubscribers() const = 0;
+
+                /**
+                 * \param sample 原始 sample 只读
+                 * \param serialized Format 对应的序列化结果 kObject 时为 nullptr 同格式的 binding 共享
+                 */
+                virtual void Deliver(const std::shared_ptr<T> &sample, const SerializedSample &serialized) = 0;
+            };
+
+            /**
+             * \brief 同进程 binding 直接把 sample 交给 LocalEvent 的订阅者
+             */
+            template <typename T>
+            class LocalEventSink : public EventSink<T>
+            {
+            public:
+                explicit LocalEventSink(std::shared_ptr<local::LocalEvent<T>> event) : event_(std::move(event)) {}
+
+                BindingKind Kind() const override { return BindingKind::kInProcess; }
+
+                bool HasSubscribers() const override { return event_->SubscriberCount() != 0; }
+
+                void Deliver(const std::shared_ptr<T> &sample, const SerializedSample &) override { event_->Send(sample); }
+
+            private:
+                std::shared_ptr<local::LocalEvent<T>> event_;
+            };
+
+            /**
+             * \brief EventSkeleton 在多个 binding 上 Offer 时的发送端
+             *
+             * 每次 Send 按需序列化 只有存在订阅者的格式才序列化 同格式的 binding 共用一份结果
+             * 同进程订阅者拿到的是 sample 本身 没有序列化 共享内存 binding 和 SOME/IP 默认共用 SOME/IP 格式
+             * sink 在 Offer 之前添加 之后只读
+             */
+            template <typename T>
+            class MultiBindingEvent
+            {
+            public:
+                /**
+                 * \brief 序列化成某种线格式 失败返回 false
+                 */
+                using Serializer = std::function<bool(const T &, std::vector<uint8_t> &)>;
+
+                MultiBindingEvent()
+                {
+                    serializers_[static_cast<size_t>(WireFormat::kSomeIp)] = [](const T &sample, std::vector<uint8_t> &buffer)
+                    {
+                        buffer.resize(ara::com::serialization::GetSerializedSize(sample));
+                        return ara::com::serialization::Serialize(sample, buffer.data(), buffer.size()).HasValue();
+                    };
+                    for (std::atomic<uint64_t> &count : serializations_)
+                    {
+                        count.store(0, std::memory_order_relaxed);
+                    }
+                }
+
+                MultiBindingEvent(const MultiBindingEvent &) = delete;
+                MultiBindingEvent &operator=(const MultiBindingEvent &) = delete;
+
+                void AddSink(std::shared_ptr<EventSink<T>> sink)
+                {
+                    sinks_.push_back(std::move(sink));
+                }
+
+                /**
+                 * \brief 注册 SOME/IP 以外的格式 例如 DDS binding 的 CDR
+                 */
+                void SetSerializer(WireFormat format, Serializer serializer)
+                {
+                    serializers_[static_cast<size_t>(format)] = std::move(serializer);
+                }
+
+                /**
+                 * \return 实际发送的 binding 数 某种格式序列化失败时跳过该格式的 binding
+                 */
+                size_t Send(std::shared_ptr<T> sample)
+                {
+                    SerializedSample encoded[kWireFormatCount];
+                    bool failed[kWireFormatCount] = {};
+                    size_t delivered = 0;
+                    for (const std::shared_ptr<EventSink<T>> &sink : sinks_)
+                    {
+                        if (!sink->HasSubscribers())
+                        {
+                            continue;
+                        }
+                        const size_t format = static_cast<size_t>(sink->Format());
+                        if (format != static_cast<size_t>(WireFormat::kObject) && !encoded[format] && !failed[format])
+                        {
+                            failed[format] = !encode(format, *sample, encoded[format]);
+                        }
+                        if (failed[format])
+                        {
+                            continue;
+                        }
+                        sink->Deliver(sample, encoded[format]);
+                        ++delivered;
+                    }
+                    return delivered;
+                }
+
+                size_t Send(T &&sample)
+                {
+                    return Send(std::make_shared<T>(std::move(sample)));
+                }
+
+                /**
+                 * \brief 某种格式累计的序列化次数
+                 */
+                uint64_t Serializations(WireFormat format) const
+                {
+                    return serializations_[static_cast<size_t>(format)].load(std::memory_order_relaxed);
+                }
+
+            private:
+                bool encode(size_t format, const T &sample, SerializedSample &encoded)
+                {
+                    if (!serializers_[format])
+                    {
+                        return false;
+                    }
+                    std::shared_ptr<std::vector<uint8_t>> buffer = std::make_shared<std::vector<uint8_t>>();
+                    if (!serializers_[format](sample, *buffer))
+                    {
+                        return false;
+                    }
+                    serializations_[format].fetch_add(1, std::memory_order_relaxed);
+                    encoded = std::move(buffer);
+                    return true;
+                }
+
+                std::vector<std::shared_ptr<EventSink<T>>> sinks_;
+                Serializer serializers_[kWireFormatCount];
+                std::atomic<uint64_t> serializations_[kWireFormatCount];
+            };
+
+        } // namespace routing
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _MULTI_BINDING_EVENT_HPP_
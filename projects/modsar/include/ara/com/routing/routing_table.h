@@ -0,0 +1,88 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 服务实例在各 binding 上的 Offer 状态 proxy 据此选开销最低的 binding
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _ROUTING_TABLE_H_
+#define _ROUTING_TABLE_H_
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+#include "ara/core/result.h"
+#include "ara/com/routing/binding_kind.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace routing
+        {
+            /**
+             * \brief 进程唯一的路由表
+             *
+             * 各 binding 的服务发现只上报本进程能到达的 Offer 共享内存 binding 只看得到同主机的实例
+             * 所以 Select 取可用集合里开销最低的就是对调用方位置最合适的 binding
+             * 同进程的实例直接查 local::LocalServiceRegistry 同主机的共享内存实例直接查 sd::ShmServiceRegistry 不需要上报
+             */
+            class RoutingTable
+            {
+            public:
+                static RoutingTable &Instance();
+
+                RoutingTable(const RoutingTable &) = delete;
+                RoutingTable &operator=(const RoutingTable &) = delete;
+
+                /**
+                 * \brief binding 的服务发现收到 Offer 时调用
+                 */
+                void ReportOffer(uint16_t serviceId, uint16_t instanceId, BindingKind kind);
+
+                /**
+                 * \brief binding 的服务发现收到 StopOffer 或实例超时时调用
+                 */
+                void ReportStopOffer(uint16_t serviceId, uint16_t instanceId, BindingKind kind);
+
+                /**
+                 * \brief 部署配置限制实例可以使用的 binding 未设置时全部允许
+                 */
+                void SetAllowedBindings(uint16_t serviceId, uint16_t instanceId, BindingMask allowed);
+
+                /**
+                 * \brief 当前可用的 binding 集合 包括同进程和同主机共享内存
+                 */
+                BindingMask Available(uint16_t serviceId, uint16_t instanceId) const;
+
+                /**
+                 * \brief 开销最低的可用 binding 顺序为同进程 共享内存 SOME/IP DDS
+                 * \return 没有可用的 binding 时返回 kServiceNotAvailable
+                 */
+                ara::core::Result<BindingKind> Select(uint16_t serviceId, uint16_t instanceId) const;
+
+            private:
+                struct Route
+                {
+                    BindingMask offered = 0;
+                    BindingMask allowed = kAllBindings;
+                };
+
+                RoutingTable() = default;
+
+                static uint32_t keyOf(uint16_t serviceId, uint16_t instanceId)
+                {
+                    return (static_cast<uint32_t>(serviceId) << 16) | instanceId;
+                }
+
+                mutable std::mutex mutex_;
+                std::unordered_map<uint32_t, Route> routes_;
+            };
+
+        } // namespace routing
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _ROUTING_TABLE_H_
@@ -0,0 +1,121 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 一个 skeleton 实例同时在多个 binding 上 Offer
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _SERVICE_OFFER_H_
+#define _SERVICE_OFFER_H_
+
+#include <memory>
+#include <vector>
+
+#include "ara/core/result.h"
+#include "ara/com/routing/binding_kind.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace local
+        {
+            class LocalService;
+        } // namespace local
+
+        namespace routing
+        {
+            /**
+             * \brief 一个 binding 上的服务实例 各 binding 实现
+             */
+            class IServiceBinding
+            {
+            public:
+                virtual ~IServiceBinding() = default;
+
+                virtual BindingKind Kind() const = 0;
+
+                virtual ara::core::Result<void> Offer() = 0;
+
+                virtual void StopOffer() = 0;
+
+                /**
+                 * \brief 批量 Offer 时由同种 binding 里的第一个调用 sameKind 包含自己
+                 * 默认逐个 Offer 失败时撤回已经 Offer 的 SOME/IP 和共享内存 binding 覆盖它 合并成一次 SD 交互
+                 */
+                virtual ara::core::Result<void> OfferBatch(const std::vector<IServiceBinding *> &sameKind);
+            };
+
+            /**
+             * \brief 同进程 binding 的适配 Offer 时登记到 LocalServiceRegistry
+             */
+            class LocalServiceBinding : public IServiceBinding
+            {
+            public:
+                explicit LocalServiceBinding(std::shared_ptr<local::LocalService> service) : service_(std::move(service)) {}
+
+                BindingKind Kind() const override { return BindingKind::kInProcess; }
+
+                ara::core::Result<void> Offer() override;
+
+                void StopOffer() override;
+
+            private:
+                std::shared_ptr<local::LocalService> service_;
+            };
+
+            /**
+             * \brief skeleton 的 OfferService 对部署配置里列出的每个 binding Offer
+             *
+             * 同进程 共享内存 SOME/IP DDS 可以同时存在 proxy 按 RoutingTable::Select 选其中开销最低的
+             * 同一个 service id 和 instance id 本地订阅者不需要第二个服务 id 就能走零拷贝
+             */
+            class ServiceOffer
+            {
+            public:
+                ServiceOffer() : offered_(false) {}
+
+                ~ServiceOffer() { StopOffer(); }
+
+                ServiceOffer(const ServiceOffer &) = delete;
+                ServiceOffer &operator=(const ServiceOffer &) = delete;
+
+                /**
+                 * \brief 在 Offer 之前添加 同一种 binding 只能有一个
+                 */
+                bool AddBinding(std::shared_ptr<IServiceBinding> binding);
+
+                /**
+                 * \brief 依次 Offer 任何一个失败时撤回已经 Offer 的 返回该错误
+                 */
+                ara::core::Result<void> Offer();
+
+                void StopOffer();
+
+                /**
+                 * \brief 已经 Offer 的 binding 集合
+                 */
+                BindingMask Offered() const;
+
+            private:
+                friend ara::core::Result<void> OfferServices(const std::vector<ServiceOffer *> &offers);
+
+                std::vector<std::shared_ptr<IServiceBinding>> bindings_;
+                bool offered_;
+            };
+
+            /**
+             * \brief 启动时一次 Offer 多个 skeleton
+             *
+             * 按 binding 种类从低开销到高开销依次进行 同一种 binding 的全部实例交给 IServiceBinding::OfferBatch 一次处理
+             * 100 个 skeleton 时 SOME/IP 的 Offer 合并进少数几条 SD 消息 共享内存注册表只加一次锁
+             * 任何一种 binding 失败时撤回这一批已经 Offer 的 返回该错误 已经 Offer 的 ServiceOffer 被跳过
+             */
+            ara::core::Result<void> OfferServices(const std::vector<ServiceOffer *> &offers);
+
+        } // namespace routing
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _SERVICE_OFFER_H_
@@ -0,0 +1,338 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 异步方法调用的 session id -> Promise 关联表
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _CALL_SLOT_TABLE_HPP_
+#define _CALL_SLOT_TABLE_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "ara/core/future.h"
+#include "ara/core/promise.h"
+#include "ara/core/result.h"
+#include "ara/com/com_error_domain.h"
+#include "ara/com/utils/task_scheduler.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace rpc
+        {
+            /**
+             * \brief 没有单独配置时方法调用等待应答的时长
+             */
+            constexpr std::chrono::milliseconds kDefaultCallTimeout{5000};
+
+            /**
+             * \brief 预分配的无锁关联表 把应答的 session id 映射回调用者的 Promise
+             *
+             * slot 下标为 session & (capacity - 1) slot 的 tag 记录占用它的 session
+             * 发送前 Reserve 占用 slot 收到应答后 Complete 按 session 取回 Promise
+             * tag 不匹配的应答 (迟到或重复) 直接丢弃 全程只有 CAS 没有锁和堆分配
+             * 每个调用带一个 deadline 到期仍未应答的调用由 Expire 以 kCommunicationLinkError 结束
+             * 清理任务的安排见 ScheduleExpiry
+             *
+             * \tparam T 应答的值类型
+             */
+            template <typename T>
+            class CallSlotTable
+            {
+            public:
+                using SessionId = uint16_t;
+                using Clock = std::chrono::steady_clock;
+
+                /**
+                 * \brief Reserve 的结果 session 需要写入请求消息头
+                 */
+                struct Call
+                {
+                    SessionId session;
+                    ara::core::Future<T> future;
+                };
+
+                /**
+                 * \param capacity 最大在途调用数 向上取整为 2 的幂 不超过 session id 空间
+                 */
+                explicit CallSlotTable(size_t capacity = 1024)
+                    : mask_(roundUp(capacity) - 1), slots_(allocateSlots(mask_ + 1)), nextSession_(0), inFlight_(0),
+                      nextSweep_(kNever)
+                {
+                }
+
+                ~CallSlotTable()
+                {
+                    CancelAll(MakeErrorCode(ComErrc::kServiceNotAvailable, 0));
+                }
+
+                CallSlotTable(const CallSlotTable &) = delete;
+                CallSlotTable &operator=(const CallSlotTable &) = delete;
+
+                /**
+                 * \brief 分配 session 并占用对应 slot
+                 * \param deadline 之后 Expire 会结束这个调用 默认不过期
+                 * \return 在途调用已满时返回 kCommunicationStackError
+                 */
+                ara::core::Result<Call> Reserve(Clock::time_point deadline = Clock::time_point::max())
+                {
+                    const size_t capacity = mask_ + 1;
+                    for (size_t attempt = 0; attempt < capacity; ++attempt)
+                    {
+                        const SessionId session = allocateSession();
+                        Slot &slot = slots_[session & mask_];
+                        uint32_t expected = kFree;
+                        if (!slot.tag.compare_exchange_strong(expected, kBusy, std::memory_order_acquire,
+                                                              std::memory_order_relaxed))
+                        {
+                            continue;
+                        }
+                        ara::core::Promise<T> *promise = new (&slot.storage) ara::core::Promise<T>();
+                        slot.deadline.store(deadline.time_since_epoch().count(), std::memory_order_relaxed);
+                        Call call{session, promise->get_future()};
+                        inFlight_.fetch_add(1, std::memory_order_relaxed);
+                        slot.tag.store(pendingTag(session), std::memory_order_release);
+                        return ara::core::Result<Call>::FromValue(std::move(call));
+                    }
+                    return ara::core::Result<Call>::FromError(MakeErrorCode(ComErrc::kCommunicationStackError, 0));
+                }
+
+                /**
+                 * \brief 按 session 取回 Promise 并交给 fulfill 完成
+                 * \param session 应答消息头里的 session id
+                 * \param fulfill void(ara::core::Promise<T>&) 在 slot 释放前调用
+                 * \return session 没有对应的在途调用时返回 false
+                 */
+                template <typename Fulfill>
+                bool Complete(SessionId session, Fulfill &&fulfill)
+                {
+                    Slot &slot = slots_[session & mask_];
+                    uint32_t expected = pendingTag(session);
+                    if (!slot.tag.compare_exchange_strong(expected, kBusy, std::memory_order_acquire,
+                                                          std::memory_order_relaxed))
+                    {
+                        return false;
+                    }
+                    ara::core::Promise<T> *promise = reinterpret_cast<ara::core::Promise<T> *>(&slot.storage);
+                    fulfill(*promise);
+                    release(slot, promise);
+                    return true;
+                }
+
+                /**
+                 * \brief 以错误结束一个在途调用 (发送失败 超时)
+                 */
+                bool Cancel(SessionId session, const ara::core::ErrorCode &error)
+                {
+                    return Complete(session, [&error](ara::core::Promise<T> &promise)
+                                    { promise.SetError(error); });
+                }
+
+                /**
+                 * \brief 以错误结束全部在途调用 服务下线或 proxy 析构时调用
+                 */
+                void CancelAll(const ara::core::ErrorCode &error)
+                {
+                    CancelAll(error, [](SessionId) {});
+                }
+
+                /**
+                 * \brief 同上 每结束一个调用 cancelled(session) 一次 与并发的 Complete 不会重复结束同一个调用
+                 */
+                template <typename Cancelled>
+                void CancelAll(const ara::core::ErrorCode &error, Cancelled &&cancelled)
+                {
+                    for (size_t i = 0; i <= mask_; ++i)
+                    {
+                        const uint32_t tag = slots_[i].tag.load(std::memory_order_acquire);
+                        if ((tag & kPendingFlag) == 0)
+                        {
+                            continue;
+                        }
+                        const SessionId session = static_cast<SessionId>(tag & 0xFFFFU);
+                        if (Cancel(session, error))
+                        {
+                            cancelled(session);
+                        }
+                    }
+                }
+
+                /**
+                 * \brief 以 error 结束 deadline 不晚于 now 的调用 每结束一个调用 expired(session) 一次
+                 * 开始时清除已安排的清理 返回值不是 max 时调用方要用它重新 Arm
+                 * \return 剩余调用里最早的 deadline 没有时返回 Clock::time_point::max()
+                 */
+                template <typename Expired>
+                Clock::time_point Expire(Clock::time_point now, const ara::core::ErrorCode &error, Expired &&expired)
+                {
+                    nextSweep_.store(kNever);
+                    const Clock::rep current = now.time_since_epoch().count();
+                    Clock::rep earliest = kNever;
+                    for (size_t i = 0; i <= mask_; ++i)
+                    {
+                        const uint32_t tag = slots_[i].tag.load(std::memory_order_acquire);
+                        if ((tag & kPendingFlag) == 0)
+                        {
+                            continue;
+                        }
+                        const Clock::rep deadline = slots_[i].deadline.load(std::memory_order_relaxed);
+                        const SessionId session = static_cast<SessionId>(tag & 0xFFFFU);
+                        if (deadline > current)
+                        {
+                            earliest = std::min(earliest, deadline);
+                        }
+                        else if (Cancel(session, error))
+                        {
+                            expired(session);
+                        }
+                    }
+                    return Clock::time_point(Clock::duration(earliest));
+                }
+
+                /**
+                 * \brief 登记一次在 deadline 的清理 比已安排的清理都早时返回 true 调用方负责安排
+                 */
+                bool Arm(Clock::time_point deadline)
+                {
+                    const Clock::rep wanted = deadline.time_since_epoch().count();
+                    Clock::rep scheduled = nextSweep_.load();
+                    while (wanted < scheduled)
+                    {
+                        if (nextSweep_.compare_exchange_weak(scheduled, wanted))
+                        {
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+
+                /**
+                 * \brief 当前在途调用数
+                 */
+                size_t InFlight() const noexcept { return inFlight_.load(std::memory_order_relaxed); }
+
+                size_t Capacity() const noexcept { return mask_ + 1; }
+
+            private:
+                static constexpr uint32_t kFree = 0;
+                static constexpr uint32_t kBusy = 1;
+                static constexpr uint32_t kPendingFlag = 0x10000U;
+                static constexpr typename Clock::rep kNever = Clock::time_point::max().time_since_epoch().count();
+
+                struct alignas(64) Slot
+                {
+                    Slot() : tag(kFree), deadline(kNever) {}
+                    std::atomic<uint32_t> tag;
+                    std::atomic<typename Clock::rep> deadline; // 在 tag 发布前写入
+                    typename std::aligned_storage<sizeof(ara::core::Promise<T>), alignof(ara::core::Promise<T>)>::type storage;
+                };
+
+                /**
+                 * \brief Slot 按 cache line 对齐 C++14 的 new[] 不保证扩展对齐 用 posix_memalign 分配
+                 */
+                struct SlotDeleter
+                {
+                    void operator()(Slot *slots) const { std::free(slots); }
+                };
+
+                static Slot *allocateSlots(size_t count)
+                {
+                    static_assert(std::is_trivially_destructible<Slot>::value, "Slot is released without running destructors");
+                    void *memory = nullptr;
+                    if (posix_memalign(&memory, alignof(Slot), count * sizeof(Slot)) != 0)
+                    {
+                        throw std::bad_alloc();
+                    }
+                    Slot *slots = static_cast<Slot *>(memory);
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        new (&slots[i]) Slot();
+                    }
+                    return slots;
+                }
+
+                static uint32_t pendingTag(SessionId session) { return kPendingFlag | session; }
+
+                static size_t roundUp(size_t capacity)
+                {
+                    size_t size = 1;
+                    while (size < capacity && size < 0x8000U)
+                    {
+                        size <<= 1;
+                    }
+                    return size;
+                }
+
+                /**
+                 * \brief SOME/IP 的 session id 0 保留 在 1..0xFFFF 内循环
+                 */
+                SessionId allocateSession()
+                {
+                    const uint32_t n = nextSession_.fetch_add(1, std::memory_order_relaxed);
+                    return static_cast<SessionId>(n % 0xFFFFU + 1U);
+                }
+
+                void release(Slot &slot, ara::core::Promise<T> *promise)
+                {
+                    promise->~Promise();
+                    inFlight_.fetch_sub(1, std::memory_order_relaxed);
+                    slot.tag.store(kFree, std::memory_order_release);
+                }
+
+            private:
+                const size_t mask_;
+                std::unique_ptr<Slot[], SlotDeleter> slots_;
+                std::atomic<uint32_t> nextSession_;
+                std::atomic<size_t> inFlight_;
+                std::atomic<typename Clock::rep> nextSweep_; // 已安排的最早一次清理 kNever 表示没有
+            };
+
+            /**
+             * \brief 在 deadline 清理 owner 持有的关联表 之后按剩下最早的 deadline 继续安排
+             *
+             * 每次 Reserve 后调用 只有比已安排的清理更早时才向 utils::TaskScheduler 提交任务
+             * 任务只持有 owner 的弱引用 owner 析构后任务什么也不做
+             *
+             * \param tableOf CallSlotTable<T>&(Owner&) 从 owner 取出关联表
+             * \param expired void(Owner&, SessionId) 每个超时结束的调用之后调用
+             */
+            template <typename Owner, typename TableOf, typename Expired>
+            void ScheduleExpiry(const std::shared_ptr<Owner> &owner, std::chrono::steady_clock::time_point deadline, TableOf tableOf, Expired expired)
+            {
+                if (deadline == std::chrono::steady_clock::time_point::max() || !tableOf(*owner).Arm(deadline))
+                {
+                    return;
+                }
+                std::weak_ptr<Owner> weak = owner;
+                ara::com::utils::TaskScheduler::Instance().At(deadline, [weak, tableOf, expired]
+                                                              {
+                                                                  std::shared_ptr<Owner> locked = weak.lock();
+                                                                  if (!locked)
+                                                                  {
+                                                                      return;
+                                                                  }
+                                                                  Owner &owner = *locked;
+                                                                  const std::chrono::steady_clock::time_point next = tableOf(owner).Expire(
+                                                                      std::chrono::steady_clock::now(), MakeErrorCode(ComErrc::kCommunicationLinkError, 0),
+                                                                      [&owner, &expired](uint16_t session)
+                                                                      { expired(owner, session); });
+                                                                  ScheduleExpiry(locked, next, tableOf, expired);
+                                                              });
+            }
+
+        } // namespace rpc
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _CALL_SLOT_TABLE_HPP_
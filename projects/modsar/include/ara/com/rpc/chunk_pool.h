@@ -0,0 +1,109 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 定长 chunk 内存池 用于 stream 数据帧
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _CHUNK_POOL_H_
+#define _CHUNK_POOL_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace ara
+{
+    namespace com
+    {
+        namespace rpc
+        {
+            class ChunkPool;
+
+            /**
+             * \brief 池中的一块定长内存
+             */
+            struct Chunk
+            {
+                uint8_t *data;   ///< 起始地址
+                size_t capacity; ///< 容量
+                size_t length;   ///< 已使用长度
+                ChunkPool *pool; ///< 所属内存池
+                uint32_t index;  ///< 在池中的下标
+            };
+
+            /**
+             * \brief 释放时把 chunk 归还内存池
+             */
+            struct ChunkDeleter
+            {
+                void operator()(Chunk *chunk) const noexcept;
+            };
+
+            using ChunkPtr = std::unique_ptr<Chunk, ChunkDeleter>;
+
+            /**
+             * \brief 定长 chunk 内存池
+             *
+             * 构造时一次性分配 chunkCount * chunkSize 的连续内存
+             * 空闲链表是带版本号的无锁栈 Allocate/Release 不加锁 不触发堆分配
+             * 多个使用者共用时各自先 Reserve 自己最多同时占用的数量 预留总数不超过 chunk 数
+             * 每个使用者不超出自己的预留时 Allocate 不会因为其他使用者而失败
+             */
+            class ChunkPool
+            {
+            public:
+                ChunkPool(size_t chunkSize, size_t chunkCount);
+                ~ChunkPool();
+
+                ChunkPool(const ChunkPool &) = delete;
+                ChunkPool &operator=(const ChunkPool &) = delete;
+
+                /**
+                 * \brief 取一个空闲 chunk
+                 * \return ChunkPtr 池耗尽时为空
+                 */
+                ChunkPtr Allocate() noexcept;
+
+                /**
+                 * \brief 预留 count 个 chunk 只记账 不取出 chunk
+                 * \return 超出剩余可预留的数量时返回 false 不预留
+                 */
+                bool Reserve(size_t count) noexcept;
+
+                void Unreserve(size_t count) noexcept;
+
+                size_t ChunkSize() const noexcept { return chunkSize_; }
+
+                size_t ChunkCount() const noexcept { return chunkCount_; }
+
+                /**
+                 * \brief 当前空闲的 chunk 数 仅用于统计
+                 */
+                size_t Available() const noexcept { return available_.load(std::memory_order_relaxed); }
+
+            private:
+                friend struct ChunkDeleter;
+
+                void release(Chunk *chunk) noexcept;
+
+                static constexpr uint32_t kNil = 0xFFFFFFFFU;
+
+            private:
+                const size_t chunkSize_;
+                const size_t chunkCount_;
+                std::unique_ptr<uint8_t[]> memory_;
+                std::unique_ptr<Chunk[]> chunks_;
+                std::unique_ptr<std::atomic<uint32_t>[]> next_; // 空闲链表的后继下标
+                std::atomic<uint64_t> head_;                     // 高 32 位版本号 低 32 位栈顶下标
+                std::atomic<size_t> available_;
+                std::atomic<size_t> reserved_;
+            };
+
+        } // namespace rpc
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _CHUNK_POOL_H_
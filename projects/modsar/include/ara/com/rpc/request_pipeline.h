@@ -0,0 +1,147 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 方法请求的流水线 在途窗口 本地排队 与突发合并写
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _REQUEST_PIPELINE_H_
+#define _REQUEST_PIPELINE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "ara/core/result.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace rpc
+        {
+            /**
+             * \brief 在途窗口满时的处理策略
+             */
+            enum class OverflowPolicy : uint8_t
+            {
+                kQueue = 0, ///< 本地排队 有应答返回后再发送
+                kFailFast   ///< 立即以 ComErrc::kCommunicationStackError 失败
+            };
+
+            /**
+             * \brief 一个 Proxy 上所有方法共享的流水线配置
+             */
+            struct PipelineConfig
+            {
+                size_t maxInFlightPerProxy = 256; ///< 整个 Proxy 的最大在途请求数
+                size_t maxInFlightPerMethod = 64; ///< 单个方法默认的最大在途请求数
+                size_t maxQueued = 1024;          ///< kQueue 策略下本地排队的上限
+                OverflowPolicy policy = OverflowPolicy::kQueue;
+            };
+
+            /**
+             * \brief 单个方法的在途窗口 由 NonBlockingCall 持有
+             */
+            class MethodWindow
+            {
+            public:
+                explicit MethodWindow(size_t limit) : limit_(limit), inFlight_(0) {}
+
+                MethodWindow(const MethodWindow &) = delete;
+                MethodWindow &operator=(const MethodWindow &) = delete;
+
+                size_t Limit() const { return limit_; }
+
+                size_t InFlight() const { return inFlight_.load(std::memory_order_relaxed); }
+
+            private:
+                friend class RequestPipeline;
+
+                const size_t limit_;
+                std::atomic<size_t> inFlight_;
+            };
+
+            /**
+             * \brief Proxy 级别的请求流水线
+             *
+             * Submit 在方法窗口和 Proxy 窗口都有空位时直接写出 否则按策略排队或失败
+             * 每个应答通过 OnResponse 归还窗口并从队列补发
+             * 写出时第一个到达的线程负责 flush 期间其它线程追加的请求会并入同一次 BatchSender 调用
+             */
+            class RequestPipeline
+            {
+            public:
+                using Request = std::shared_ptr<Message>;
+                using BatchSender = std::function<void(const std::vector<Request> &)>;
+
+                RequestPipeline(const PipelineConfig &config, BatchSender sender);
+
+                RequestPipeline(const RequestPipeline &) = delete;
+                RequestPipeline &operator=(const RequestPipeline &) = delete;
+
+                /**
+                 * \brief 提交一个请求
+                 * \param window 请求所属方法的窗口
+                 * \param request 已经填好 session 的请求消息
+                 * \return kFailFast 策略窗口已满 或排队已满时返回 kCommunicationStackError
+                 */
+                ara::core::Result<void> Submit(MethodWindow &window, const Request &request);
+
+                /**
+                 * \brief 一个请求完成 (收到应答或被取消) 归还窗口并补发排队的请求
+                 */
+                void OnResponse(MethodWindow &window);
+
+                /**
+                 * \brief 丢弃方法的排队请求并清空其在途计数 window 销毁前必须调用
+                 * 会清掉同时在途的其他调用占用的窗口 运行中结束调用要逐个 Withdraw
+                 */
+                void Reset(MethodWindow &window);
+
+                /**
+                 * \brief 调用超时或被 CancelAll 结束时调用 请求还在排队时撤回 已经发出时归还窗口 之后的迟到应答不再调用 OnResponse
+                 * \param session 请求消息头里调用方的 session
+                 */
+                void Withdraw(MethodWindow &window, uint16_t session);
+
+                size_t InFlight() const { return inFlight_.load(std::memory_order_relaxed); }
+
+                size_t Queued() const { return queued_.load(std::memory_order_relaxed); }
+
+                const PipelineConfig &GetConfig() const { return config_; }
+
+            private:
+                bool tryAcquire(MethodWindow &window);
+                void release(MethodWindow &window, size_t count);
+                void drainQueue();
+                void write(std::vector<Request> &requests);
+
+                struct Pending
+                {
+                    MethodWindow *window;
+                    Request request;
+                };
+
+            private:
+                const PipelineConfig config_;
+                BatchSender sender_;
+                std::atomic<size_t> inFlight_;   // Proxy 级别在途数
+                std::atomic<size_t> queued_;     // 快速判断队列是否为空
+                std::mutex queueMutex_;
+                std::deque<Pending> queue_;
+                std::mutex batchMutex_;
+                std::vector<Request> batch_;     // 等待 flush 的请求
+                bool flushing_;                  // 有线程正在调用 sender_
+            };
+
+        } // namespace rpc
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _REQUEST_PIPELINE_H_
@@ -1,8 +1,24 @@
 #ifndef _RPC_CALL_HPP_
 #define _RPC_CALL_HPP_
+#include <algorithm>
+#include <chrono>
 #include <functional>
 #include <memory>
- 
+#include <mutex>
+#include <shared_mutex>
+
+#include "ara/core/future.h"
+#include "ara/core/promise.h"
+#include "ara/com/com_error_domain.h"
+#include "ara/com/e2e/e2e_payload.hpp"
+#include "ara/com/local/local_service.hpp"
+#include "ara/com/record/recorder.h"
+#include "ara/com/rpc/call_slot_table.hpp"
+#include "ara/com/rpc/request_pipeline.h"
+#include "ara/com/serialization/someip_serializer.hpp"
+#include "ara/com/trace/trace_payload.hpp"
+#include "ara/com/trace/trace_registry.h"
+
 typedef std::function< void (const std::shared_ptr< Message > &) > message_handler_t;
 
 class ICall {
@@ -41,12 +57,272 @@ private:
 };
 
 /**
- * 完成消息转发
+ * 异步调用 每个方法一个实例 长期存在
+ * 构造时注册一次应答 handler 之后每次 invoke 只占用关联表的一个 slot 并立即返回 Future
+ * 应答按消息头的 session id 在 CallSlotTable 中找回对应的 Promise
+ * host 配置了 RequestPipeline 时 请求经过方法和 Proxy 两级在途窗口 超出部分按策略排队或失败
+ * 超过 SetTimeout 的时长仍未应答的调用以 kCommunicationLinkError 结束 归还窗口
  * */
 template <class InputMessage, class OutputMessage, class HostType>
-class NonBlockingCall : public ICall {
+class NonBlockingCall
+{
+public:
+    using SlotTable = ara::com::rpc::CallSlotTable<OutputMessage>;
 
-};
+    /**
+     * \param maxInFlight 该方法的最大在途调用数 有流水线时还受 PipelineConfig::maxInFlightPerMethod 限制
+     */
+    NonBlockingCall(const RpcMethod &method, std::shared_ptr<HostType> host, size_t maxInFlight = 1024)
+        : method_(method), host_(host), state_(std::make_shared<CallState>(maxInFlight, host->GetRequestPipeline()))
+    {
+        // handler 的生命周期跟随 host 这里只持有调用状态的弱引用
+        std::weak_ptr<CallState> state = state_;
+        host_->RegisterMessageHandler(method_.methodId(), [state](const std::shared_ptr<Message> &response)
+                                      {
+                                          std::shared_ptr<CallState> locked = state.lock();
+                                          if (locked)
+                                          {
+                                              onResponse(*locked, response);
+                                          }
+                                      });
+    }
+
+    NonBlockingCall(const NonBlockingCall &) = delete;
+    NonBlockingCall &operator=(const NonBlockingCall &) = delete;
+
+    /**
+     * \brief 发送请求 不等待应答
+     * \param request 请求参数
+     * \return ara::core::Future<OutputMessage> 在途调用已满或被流水线拒绝时 Future 直接带错误返回
+     * 超时未应答时以 kCommunicationLinkError 完成
+     */
+    ara::core::Future<OutputMessage> invoke(const InputMessage &request)
+    {
+        if (local_)
+        {
+            return local_->Call(localClient_, request);
+        }
+        const typename SlotTable::Clock::time_point deadline = SlotTable::Clock::now() + timeout_;
+        // 从 Reserve 到 Submit 占用窗口之前 CancelAll 不能结束这个调用 否则会归还还没有占用的窗口
+        std::shared_lock<std::shared_timed_mutex> submitting(state_->cancelMutex, std::defer_lock);
+        if (state_->pipeline)
+        {
+            submitting.lock();
+        }
+        ara::core::Result<typename SlotTable::Call> reserved = state_->table.Reserve(deadline);
+        if (!reserved.HasValue())
+        {
+            ara::core::Promise<OutputMessage> failed;
+            failed.SetError(reserved.Error());
+            return failed.get_future();
+        }
+        typename SlotTable::Call call = std::move(reserved).Value();
+        std::shared_ptr<Message> message = runtime::CreateMessage(method_);
+        // vsomeip 发送时会改写 session SomeIpConnection::SendRequest 交付应答前换回这个值
+        message->set_session(call.session);
+        const std::shared_ptr<ara::com::trace::TraceChannel> &trace = state_->trace;
+        const uint64_t serializeStart = trace ? trace->Now() : 0;
+        if (state_->protector)
+        {
+            ara::core::Result<void> serialized = ara::com::e2e::SerializeProtected(request, *state_->protector, *message->get_payload());
+            if (!serialized.HasValue())
+            {
+                state_->table.Cancel(call.session, serialized.Error());
+                return std::move(call.future);
+            }
+        }
+        else
+        {
+            ara::com::serialization::SerializeToPayload(request, *message->get_payload());
+        }
+        ara::com::record::RecordMessage(ara::com::record::RecordKind::kRequest, *message);
+        if (trace)
+        {
+            // 追踪信息在录制之后附上 回放时不会带着过期的时间戳
+            ara::com::trace::AppendRequestTrailer(*trace, serializeStart, *message);
+        }
+        if (state_->pipeline)
+        {
+            ara::core::Result<void> submitted = state_->pipeline->Submit(state_->window, message);
+            if (!submitted.HasValue())
+            {
+                state_->table.Cancel(call.session, submitted.Error());
+            }
+            submitting.unlock();
+        }
+        else
+        {
+            host_->SendRequest(message);
+        }
+        ara::com::rpc::ScheduleExpiry(state_, deadline, [](CallState &state) -> SlotTable &
+                                      { return state.table; },
+                                      [](CallState &state, uint16_t session)
+                                      {
+                                          if (state.pipeline)
+                                          {
+                                              state.pipeline->Withdraw(state.window, session);
+                                          }
+                                      });
+        return std::move(call.future);
+    }
+
+    /**
+     * \brief 之后发出的调用等待应答的时长 默认 kDefaultCallTimeout
+     */
+    void SetTimeout(std::chrono::milliseconds timeout) { timeout_ = timeout; }
+
+    /**
+     * \brief 按部署配置启用方法的 E2E 保护 在发出第一个请求之前调用
+     * \param request 请求方向的配置 由本端写头部
+     * \param response 应答方向的配置 应答检查为 kError 时调用以 kCommunicationStackError 结束
+     * \return profile 不支持时返回 false 保持不保护
+     */
+    bool SetE2EProtection(const ara::com::e2e::E2EProfileConfig &request, const ara::com::e2e::E2EProfileConfig &response)
+    {
+        std::shared_ptr<ara::com::e2e::E2EProtector> protector = std::make_shared<ara::com::e2e::E2EProtector>(request);
+        std::unique_ptr<ara::com::e2e::E2EChecker> checker(new ara::com::e2e::E2EChecker(response));
+        if (!protector->IsValid() || !checker->IsValid())
+        {
+            return false;
+        }
+        state_->protector = protector;
+        state_->checker = std::move(checker);
+        return true;
+    }
+
+    /**
+     * \brief 在默认统计页上启用时延追踪 请求末尾附上追踪信息 应答带回请求的发送时间 统计往返时延
+     * 在发出第一个请求之前调用
+     * \return 没有设置默认统计页或槽位用完时返回 false
+     */
+    bool EnableTracing()
+    {
+        state_->trace = ara::com::trace::CreateTraceChannel(ara::com::trace::ChannelRole::kMethodClient, method_.name(),
+                                                            method_.serviceId(), method_.instanceId(), method_.methodId());
+        return state_->trace != nullptr;
+    }
+
+    /**
+     * \brief 没有启用追踪时返回 nullptr
+     */
+    std::shared_ptr<ara::com::trace::TraceChannel> GetTraceChannel() const { return state_->trace; }
 
+    /**
+     * \brief FindService 找到同进程的实例时 binding 在发出第一个请求之前调用
+     * 之后 invoke 直接交给 skeleton 的执行器 不序列化不经过 transport 也不做 E2E 保护和录制
+     * \return 服务实例没有以相同的请求应答类型注册该方法时返回 false 保持走网络
+     */
+    bool AttachLocal(const std::shared_ptr<ara::com::local::LocalService> &service)
+    {
+        local_ = service->template GetMethod<InputMessage, OutputMessage>(method_.methodId());
+        localClient_ = ara::com::local::LocalServiceRegistry::Instance().NextClientId();
+        return local_ != nullptr;
+    }
+
+    /**
+     * \brief 当前在途的调用数 不包括同进程的调用
+     */
+    size_t InFlight() const { return state_->table.InFlight(); }
+
+    /**
+     * \brief 服务下线时结束全部在途调用 不能在应答回调里调用
+     * 每个被结束的调用单独归还窗口 与同时到达的应答各自归还 不会清零其他调用占用的窗口
+     */
+    void CancelAll()
+    {
+        const ara::core::ErrorCode error = ara::com::MakeErrorCode(ara::com::ComErrc::kServiceNotAvailable, 0);
+        if (!state_->pipeline)
+        {
+            state_->table.CancelAll(error);
+            return;
+        }
+        CallState &state = *state_;
+        std::lock_guard<std::shared_timed_mutex> lock(state.cancelMutex);
+        state.table.CancelAll(error, [&state](uint16_t session)
+                              { state.pipeline->Withdraw(state.window, session); });
+    }
+
+private:
+    /**
+     * \brief 应答 handler 与调用者共享的状态
+     */
+    struct CallState
+    {
+        CallState(size_t maxInFlight, std::shared_ptr<ara::com::rpc::RequestPipeline> requestPipeline)
+            : table(maxInFlight),
+              window(requestPipeline ? std::min(maxInFlight, requestPipeline->GetConfig().maxInFlightPerMethod) : maxInFlight),
+              pipeline(requestPipeline)
+        {
+        }
+
+        // 排队中的请求引用着 window 析构前先从共享的 pipeline 里撤走
+        ~CallState()
+        {
+            if (pipeline)
+            {
+                pipeline->Reset(window);
+            }
+        }
+
+        SlotTable table;
+        ara::com::rpc::MethodWindow window;
+        std::shared_ptr<ara::com::rpc::RequestPipeline> pipeline;
+        std::shared_ptr<ara::com::e2e::E2EProtector> protector;
+        std::unique_ptr<ara::com::e2e::E2EChecker> checker;
+        std::mutex checkerMutex; // 应答可能在多个线程上回调 checker 里的 counter 需要串行
+        std::shared_timed_mutex cancelMutex; // 有流水线时 invoke 从 Reserve 到 Submit 持有共享锁 CancelAll 持有独占锁
+        std::shared_ptr<ara::com::trace::TraceChannel> trace;
+    };
+
+    /**
+     * \brief 反序列化应答 配置了 E2E 时先检查头部
+     * \param length 去掉末尾追踪信息后的长度
+     */
+    static bool readResponse(CallState &state, const std::shared_ptr<Message> &response, size_t length, OutputMessage &message)
+    {
+        if (!state.checker)
+        {
+            return ara::com::serialization::Deserialize(response->get_payload()->get_data(), length, message).HasValue();
+        }
+        std::lock_guard<std::mutex> lock(state.checkerMutex);
+        ara::core::Result<ara::com::e2e::ProfileCheckStatus> checked =
+            ara::com::e2e::CheckAndDeserialize(response->get_payload()->get_data(), length, *state.checker, message);
+        return checked.HasValue() && checked.Value() != ara::com::e2e::ProfileCheckStatus::kError;
+    }
+
+    static void onResponse(CallState &state, const std::shared_ptr<Message> &response)
+    {
+        // 服务端启用追踪而本端没有时也要去掉追踪信息 由头部的标记决定 不看 payload 的内容
+        ara::com::trace::TraceContext context;
+        const size_t length = ara::com::trace::ReceiveTrailer(state.trace.get(), *response, context);
+        ara::com::record::RecordMessage(ara::com::record::RecordKind::kResponse, *response, length);
+        bool completed = state.table.Complete(response->get_session(), [&state, &response, length](ara::core::Promise<OutputMessage> &promise)
+                                              {
+                                                  /**
+                                                   * payload 里一般是 二进制流
+                                                   * OutputMessage 按 SOME/IP 格式反序列化 这里不能强转
+                                                   */
+                                                  OutputMessage message;
+                                                  if (!readResponse(state, response, length, message))
+                                                  {
+                                                      promise.SetError(ara::com::MakeErrorCode(ara::com::ComErrc::kCommunicationStackError, 0));
+                                                      return;
+                                                  }
+                                                  promise.set_value(std::move(message));
+                                              });
+        if (completed && state.pipeline)
+        {
+            state.pipeline->OnResponse(state.window);
+        }
+    }
+
+private:
+    const RpcMethod method_;
+    std::shared_ptr<HostType> host_;
+    std::shared_ptr<CallState> state_;
+    std::shared_ptr<ara::com::local::LocalMethod<InputMessage, OutputMessage>> local_;
+    uint16_t localClient_ = 0;
+    std::chrono::milliseconds timeout_ = ara::com::rpc::kDefaultCallTimeout;
+};
 
 #endif // _RPC_CALL_HPP_
\ No newline at end of file
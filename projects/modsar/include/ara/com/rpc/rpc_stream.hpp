@@ -0,0 +1,355 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief stream 方法 (CLIENT_STREAMING / SERVER_STREAMING / BIDI_STREAMING) 的 Proxy 和 Skeleton 句柄
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _RPC_STREAM_HPP_
+#define _RPC_STREAM_HPP_
+
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <type_traits>
+
+#include "ara/core/result.h"
+#include "ara/com/com_error_domain.h"
+#include "ara/com/rpc/chunk_pool.h"
+#include "ara/com/rpc/stream_endpoint.h"
+#include "ara/com/serialization/someip_serializer.hpp"
+#include "ara/com/skeleton/worker_pool.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace rpc
+        {
+            /**
+             * \brief stream 元素的编解码 trivially copyable 的类型按内存布局拷贝
+             */
+            template <typename T, typename Enable = void>
+            struct StreamCodec;
+
+            template <typename T>
+            struct StreamCodec<T, typename std::enable_if<std::is_trivially_copyable<T>::value>::type>
+            {
+                static ara::core::Result<size_t> Encode(const T &value, uint8_t *buffer, size_t capacity)
+                {
+                    if (capacity < sizeof(T))
+                    {
+                        return ara::core::Result<size_t>::FromError(MakeErrorCode(ComErrc::kSampleAllocationFailure, 0));
+                    }
+                    std::memcpy(buffer, &value, sizeof(T));
+                    return ara::core::Result<size_t>::FromValue(sizeof(T));
+                }
+
+                static ara::core::Result<void> Decode(const uint8_t *buffer, size_t length, T &value)
+                {
+                    if (length != sizeof(T))
+                    {
+                        return ara::core::Result<void>::FromError(MakeErrorCode(ComErrc::kCommunicationStackError, 0));
+                    }
+                    std::memcpy(static_cast<void *>(&value), buffer, sizeof(T));
+                    return ara::core::Result<void>::FromValue();
+                }
+            };
+
+            /**
+             * \brief 其它类型按 SOME/IP 格式直接序列化进发送 chunk
+             */
+            template <typename T>
+            struct StreamCodec<T, typename std::enable_if<!std::is_trivially_copyable<T>::value>::type>
+            {
+                static ara::core::Result<size_t> Encode(const T &value, uint8_t *buffer, size_t capacity)
+                {
+                    return serialization::Serialize(value, buffer, capacity);
+                }
+
+                static ara::core::Result<void> Decode(const uint8_t *buffer, size_t length, T &value)
+                {
+                    return serialization::Deserialize(buffer, length, value);
+                }
+            };
+
+            /**
+             * \brief stream 句柄 只能移动
+             *
+             * Proxy 侧为 Stream<Request, Response> Skeleton 侧为 Stream<Response, Request>
+             * 析构时本端还没有 Finish 以 kCommunicationLinkError 通知对端
+             * 已经 Finish 时正常关闭 只让对端停止写 对端照常读完已经发出的数据
+             *
+             * \tparam Out 本端写出的类型
+             * \tparam In  本端读入的类型
+             */
+            template <typename Out, typename In>
+            class Stream
+            {
+            public:
+                Stream(std::shared_ptr<StreamEndpoint> endpoint, std::shared_ptr<StreamRegistry> registry, uint32_t scope)
+                    : endpoint_(std::move(endpoint)), registry_(std::move(registry)), scope_(scope)
+                {
+                }
+
+                Stream(Stream &&other) noexcept = default;
+                Stream &operator=(Stream &&other) noexcept
+                {
+                    if (this != &other)
+                    {
+                        close();
+                        endpoint_ = std::move(other.endpoint_);
+                        registry_ = std::move(other.registry_);
+                        scope_ = other.scope_;
+                    }
+                    return *this;
+                }
+
+                Stream(const Stream &) = delete;
+                Stream &operator=(const Stream &) = delete;
+
+                ~Stream() { close(); }
+
+                /**
+                 * \brief 写一个元素 对端没有 credit 时等待 StreamConfig::writeTimeout
+                 */
+                ara::core::Result<void> Write(const Out &value)
+                {
+                    ara::core::Result<ChunkPtr> acquired = endpoint_->AcquireChunk();
+                    if (!acquired.HasValue())
+                    {
+                        return ara::core::Result<void>::FromError(acquired.Error());
+                    }
+                    ChunkPtr chunk = std::move(acquired).Value();
+                    ara::core::Result<size_t> encoded = StreamCodec<Out>::Encode(value, StreamEndpoint::PayloadOf(chunk),
+                                                                                  StreamEndpoint::PayloadCapacityOf(chunk));
+                    if (!encoded.HasValue())
+                    {
+                        return ara::core::Result<void>::FromError(encoded.Error());
+                    }
+                    return endpoint_->Commit(std::move(chunk), encoded.Value());
+                }
+
+                /**
+                 * \brief 读一个元素
+                 * \param value 读到的元素
+                 * \return true 读到数据 false 对端已正常结束 对端出错时返回对应错误
+                 */
+                ara::core::Result<bool> Read(In &value)
+                {
+                    ara::core::Result<ChunkPtr> received = endpoint_->Receive();
+                    if (!received.HasValue())
+                    {
+                        return ara::core::Result<bool>::FromError(received.Error());
+                    }
+                    ChunkPtr chunk = std::move(received).Value();
+                    if (!chunk)
+                    {
+                        return ara::core::Result<bool>::FromValue(false);
+                    }
+                    ara::core::Result<void> decoded = StreamCodec<In>::Decode(chunk->data, chunk->length, value);
+                    if (!decoded.HasValue())
+                    {
+                        return ara::core::Result<bool>::FromError(decoded.Error());
+                    }
+                    return ara::core::Result<bool>::FromValue(true);
+                }
+
+                /**
+                 * \brief 本端写结束 仍然可以继续 Read
+                 */
+                ara::core::Result<void> Finish() { return endpoint_->Finish(); }
+
+                /**
+                 * \brief 以错误结束 对端的 Read/Write 返回该错误
+                 */
+                void Abort(const ara::core::ErrorCode &error) { endpoint_->Abort(error); }
+
+                uint32_t StreamId() const { return endpoint_->StreamId(); }
+
+            private:
+                void close()
+                {
+                    if (!endpoint_)
+                    {
+                        return;
+                    }
+                    endpoint_->Close();
+                    registry_->Remove(scope_, endpoint_->StreamId());
+                    endpoint_.reset();
+                }
+
+            private:
+                std::shared_ptr<StreamEndpoint> endpoint_;
+                std::shared_ptr<StreamRegistry> registry_;
+                uint32_t scope_;
+            };
+
+            /**
+             * \brief Proxy 侧的 stream 方法 每个方法一个实例
+             *
+             * 所有 stream 共用一个 ChunkPool 收到的帧按 streamId 分发到各自的 StreamEndpoint
+             * 每个 stream 预留 StreamEndpoint::ChunksPerStream 个 chunk poolChunks 决定能同时打开的 stream 数
+             */
+            template <class RequestType, class ResponseType, class HostType>
+            class StreamProxy
+            {
+            public:
+                using ClientStream = Stream<RequestType, ResponseType>;
+
+                StreamProxy(const RpcMethod &method, RpcMethod::RpcType type, std::shared_ptr<HostType> host,
+                            const StreamConfig &config = StreamConfig(), size_t poolChunks = 256)
+                    : method_(method),
+                      host_(host),
+                      config_(config),
+                      pool_(std::make_shared<ChunkPool>(config.chunkSize, poolChunks)),
+                      registry_(std::make_shared<StreamRegistry>()),
+                      nextStreamId_(1)
+                {
+                    method_.SetMethodType(type);
+                    std::weak_ptr<StreamRegistry> registry = registry_;
+                    host_->RegisterMessageHandler(method_.methodId(), [registry](const std::shared_ptr<Message> &frame)
+                                                  {
+                                                      std::shared_ptr<StreamRegistry> locked = registry.lock();
+                                                      if (locked)
+                                                      {
+                                                          auto payload = frame->get_payload();
+                                                          locked->Dispatch(0, payload->get_data(), payload->get_length());
+                                                      }
+                                                  });
+                }
+
+                /**
+                 * \brief 打开一个新的 stream
+                 */
+                ara::core::Result<ClientStream> Open()
+                {
+                    const uint32_t streamId = nextStreamId_.fetch_add(1, std::memory_order_relaxed);
+                    std::shared_ptr<HostType> host = host_;
+                    RpcMethod method = method_;
+                    auto endpoint = std::make_shared<StreamEndpoint>(
+                        streamId, config_, pool_, [host, method](const uint8_t *data, size_t length)
+                        {
+                            std::shared_ptr<Message> frame = runtime::CreateMessage(method);
+                            frame->get_payload()->set_data(data, length);
+                            host->SendRequest(frame);
+                            return true;
+                        });
+                    registry_->Add(0, endpoint);
+                    ara::core::Result<void> opened = endpoint->Open();
+                    if (!opened.HasValue())
+                    {
+                        registry_->Remove(0, streamId);
+                        return ara::core::Result<ClientStream>::FromError(opened.Error());
+                    }
+                    return ara::core::Result<ClientStream>::FromValue(ClientStream(endpoint, registry_, 0));
+                }
+
+            private:
+                RpcMethod method_;
+                std::shared_ptr<HostType> host_;
+                const StreamConfig config_;
+                std::shared_ptr<ChunkPool> pool_;
+                std::shared_ptr<StreamRegistry> registry_;
+                std::atomic<uint32_t> nextStreamId_;
+            };
+
+            /**
+             * \brief Skeleton 侧的 stream 方法
+             *
+             * 收到 kOpen 时建立 StreamEndpoint 在 WorkerPool 上 Accept 并调用用户的 StreamHandler
+             * worker 都在执行 handler 时新的 stream 排队 客户端拿到 credit 前不会发数据 排队超过 writeTimeout 时写失败
+             * handler 返回后 Stream 句柄析构 未结束的 stream 会通知客户端
+             * 每个 stream 预留 StreamEndpoint::ChunksPerStream 个 chunk 预留不到时以 kSampleAllocationFailure 拒绝
+             */
+            template <class RequestType, class ResponseType, class HostType>
+            class StreamSkeleton
+            {
+            public:
+                using ServerStream = Stream<ResponseType, RequestType>;
+                using StreamHandler = std::function<void(ServerStream)>;
+
+                /**
+                 * \param workers 执行 handler 的线程池 为空时创建自己的 handler 一直占用 worker 到 stream 结束
+                 * 不要用 WorkerPool::Default 长时间的 stream 会占满普通方法调用的 worker
+                 */
+                StreamSkeleton(const RpcMethod &method, RpcMethod::RpcType type, std::shared_ptr<HostType> host,
+                               StreamHandler handler, const StreamConfig &config = StreamConfig(), size_t poolChunks = 256,
+                               std::shared_ptr<skeleton::WorkerPool> workers = nullptr)
+                    : method_(method),
+                      host_(host),
+                      handler_(std::move(handler)),
+                      config_(config),
+                      pool_(std::make_shared<ChunkPool>(config.chunkSize, poolChunks)),
+                      registry_(std::make_shared<StreamRegistry>()),
+                      workers_(workers ? std::move(workers) : std::make_shared<skeleton::WorkerPool>())
+                {
+                    method_.SetMethodType(type);
+                    // 同一 stream 的帧必须按顺序处理
+                    host_->RegisterServiceMethod(
+                        method_.methodId(), [this](const std::shared_ptr<Message> &frame)
+                        { onFrame(frame); },
+                        true);
+                }
+
+            private:
+                void onFrame(const std::shared_ptr<Message> &frame)
+                {
+                    auto payload = frame->get_payload();
+                    const uint32_t scope = frame->get_client();
+                    if (registry_->Dispatch(scope, payload->get_data(), payload->get_length()))
+                    {
+                        return;
+                    }
+                    StreamFrameHeader header;
+                    if (payload->get_length() < sizeof(header))
+                    {
+                        return;
+                    }
+                    std::memcpy(&header, payload->get_data(), sizeof(header));
+                    if (static_cast<StreamFrameType>(header.type) != StreamFrameType::kOpen)
+                    {
+                        return;
+                    }
+
+                    // 服务端发往客户端的帧都以打开 stream 的请求为模板构造应答
+                    std::shared_ptr<HostType> host = host_;
+                    auto endpoint = std::make_shared<StreamEndpoint>(
+                        header.streamId, config_, pool_, [host, frame](const uint8_t *data, size_t length)
+                        {
+                            std::shared_ptr<Message> response = runtime::CreateResponse(frame);
+                            response->get_payload()->set_data(data, length);
+                            host->SendResponse(response);
+                            return true;
+                        });
+                    registry_->Add(scope, endpoint);
+                    // WorkerPool 的任务要求可拷贝 句柄放在 shared_ptr 里 任务没执行就被丢弃时句柄析构通知客户端
+                    std::shared_ptr<ServerStream> stream = std::make_shared<ServerStream>(endpoint, registry_, scope);
+                    StreamHandler handler = handler_;
+                    const uint32_t peerWindow = header.value;
+                    workers_->Submit([handler, stream, endpoint, peerWindow]
+                                     {
+                                         // 到 worker 上才发 credit 客户端不会在 handler 开始前写满窗口
+                                         if (endpoint->Accept(peerWindow).HasValue())
+                                         {
+                                             handler(std::move(*stream));
+                                         } });
+                }
+
+            private:
+                RpcMethod method_;
+                std::shared_ptr<HostType> host_;
+                StreamHandler handler_;
+                const StreamConfig config_;
+                std::shared_ptr<ChunkPool> pool_;
+                std::shared_ptr<StreamRegistry> registry_;
+                std::shared_ptr<skeleton::WorkerPool> workers_; // 最后声明 最先析构 先等 handler 返回再释放 pool_ 和 registry_
+            };
+
+        } // namespace rpc
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _RPC_STREAM_HPP_
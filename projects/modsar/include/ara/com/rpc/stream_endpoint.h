@@ -0,0 +1,214 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief stream 方法一端的帧协议与基于 credit 的流控
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _STREAM_ENDPOINT_H_
+#define _STREAM_ENDPOINT_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "ara/core/error_code.h"
+#include "ara/core/result.h"
+#include "ara/com/rpc/chunk_pool.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace rpc
+        {
+            /**
+             * \brief stream 帧类型
+             */
+            enum class StreamFrameType : uint8_t
+            {
+                kOpen = 0, ///< 客户端打开 stream value 为客户端的接收窗口
+                kData,     ///< 数据帧 占用对端一个 credit
+                kCredit,   ///< 归还 credit value 为归还的数量
+                kEnd,      ///< 本端写结束 (half close)
+                kError,    ///< 异常结束 value 为 ComErrc
+                kCancel    ///< 本端已经写结束并且不再读 对端停止写 对端已收到的数据照常读完
+            };
+
+            /**
+             * \brief 每个帧的头 紧跟数据
+             */
+            struct StreamFrameHeader
+            {
+                uint32_t streamId;
+                uint32_t value;
+                uint8_t type;
+                uint8_t reserved[3];
+            };
+
+            /**
+             * \brief stream 的配置 Proxy 和 Skeleton 各自配置自己的接收窗口
+             */
+            struct StreamConfig
+            {
+                uint32_t window = 32;                               ///< 接收窗口 即允许对端未确认的数据帧数
+                size_t chunkSize = 64 * 1024;                       ///< 单帧最大长度 含帧头
+                std::chrono::milliseconds writeTimeout{1000};       ///< 等待 credit 的超时
+            };
+
+            /**
+             * \brief stream 的一端
+             *
+             * 写端每发一个数据帧消耗一个 credit 没有 credit 时等待 读端每消费半个窗口归还一次 credit
+             * 接收到的数据拷贝进池化的 chunk 排队 读端取走后 chunk 归还内存池
+             * kEnd 表示对端写结束 kError 使两端都进入错误状态 错误通过 ara::core::Result 交给调用者
+             *
+             * 多个 stream 共用一个 ChunkPool Open / Accept 时为本 stream 预留 ChunksPerStream 个 chunk
+             * 接收端排队的数据不超过窗口 一个 stream 收满窗口不会让另一个 stream 分配失败
+             */
+            class StreamEndpoint
+            {
+            public:
+                using FrameSender = std::function<bool(const uint8_t *data, size_t length)>;
+
+                StreamEndpoint(uint32_t streamId, const StreamConfig &config, std::shared_ptr<ChunkPool> pool, FrameSender sender);
+
+                ~StreamEndpoint();
+
+                StreamEndpoint(const StreamEndpoint &) = delete;
+                StreamEndpoint &operator=(const StreamEndpoint &) = delete;
+
+                uint32_t StreamId() const { return streamId_; }
+
+                /**
+                 * \brief 一个 stream 在共用的 ChunkPool 里预留的 chunk 数 接收窗口加上一个正在写的 chunk
+                 */
+                static size_t ChunksPerStream(const StreamConfig &config) { return static_cast<size_t>(config.window) + 1; }
+
+                /**
+                 * \brief 客户端发起 stream 通告自己的接收窗口
+                 * \return ChunkPool 不够预留时返回 kSampleAllocationFailure
+                 */
+                ara::core::Result<void> Open();
+
+                /**
+                 * \brief 服务端接受 stream
+                 * \param peerWindow kOpen 帧里客户端的接收窗口
+                 * \return ChunkPool 不够预留时以 kSampleAllocationFailure 结束 stream 并通知客户端
+                 */
+                ara::core::Result<void> Accept(uint32_t peerWindow);
+
+                /**
+                 * \brief 等待 credit 并取一个发送用的 chunk 数据从 PayloadOf(chunk) 开始写
+                 */
+                ara::core::Result<ChunkPtr> AcquireChunk();
+
+                /**
+                 * \brief 发送 AcquireChunk 取得的 chunk
+                 * \param payloadLength 写入的数据长度 不含帧头
+                 */
+                ara::core::Result<void> Commit(ChunkPtr chunk, size_t payloadLength);
+
+                /**
+                 * \brief 本端写结束
+                 */
+                ara::core::Result<void> Finish();
+
+                /**
+                 * \brief 以错误结束 stream 对端读写都会收到该错误
+                 */
+                void Abort(const ara::core::ErrorCode &error);
+
+                /**
+                 * \brief 句柄释放时调用
+                 * 本端还没有写结束时按 kCommunicationLinkError 异常结束
+                 * 已经写结束时只通知对端停止写 (kCancel) 对端已经收到的数据和结束标记照常读完
+                 */
+                void Close();
+
+                /**
+                 * \brief 取下一个数据帧 没有数据时等待
+                 * \return chunk 里只有数据 不含帧头 对端已结束时返回空的 ChunkPtr
+                 */
+                ara::core::Result<ChunkPtr> Receive();
+
+                /**
+                 * \brief binding 收到该 stream 的帧时调用
+                 */
+                void OnFrame(const uint8_t *data, size_t length);
+
+                /**
+                 * \brief 两个方向都已结束或出错 可以从注册表中移除
+                 */
+                bool IsClosed() const;
+
+                /**
+                 * \brief 发送 chunk 中数据的起始地址和容量
+                 */
+                static uint8_t *PayloadOf(const ChunkPtr &chunk) { return chunk->data + sizeof(StreamFrameHeader); }
+
+                static size_t PayloadCapacityOf(const ChunkPtr &chunk) { return chunk->capacity - sizeof(StreamFrameHeader); }
+
+            private:
+                bool reserveChunks();
+                bool sendControl(StreamFrameType type, uint32_t value);
+                void failLocked(const ara::core::ErrorCode &error);
+
+            private:
+                const uint32_t streamId_;
+                const StreamConfig config_;
+                std::shared_ptr<ChunkPool> pool_;
+                FrameSender sender_;
+
+                mutable std::mutex mutex_;
+                std::condition_variable cond_;
+                std::deque<ChunkPtr> inbound_;     // 已收到未读取的数据
+                uint32_t sendCredits_;             // 对端允许本端再发的数据帧数
+                uint32_t consumed_;                // 读取后尚未归还的 credit
+                bool localFinished_;
+                bool remoteFinished_;
+                bool peerCancelled_;               // 对端不再读 本端不能再写
+                bool reserved_;                    // 已经在 pool_ 里预留 析构时归还
+                bool failed_;
+                ara::core::ErrorCode error_;
+            };
+
+            /**
+             * \brief 一个方法上所有活动 stream 的注册表 按 (scope, streamId) 分发
+             *
+             * streamId 由各个客户端自己分配 Skeleton 侧用客户端 id 作为 scope 区分 Proxy 侧 scope 固定为 0
+             * 打开和关闭 stream 的频率很低 这里用 mutex 保护 map 即可 stream 由 Stream 句柄析构时移除
+             */
+            class StreamRegistry
+            {
+            public:
+                void Add(uint32_t scope, const std::shared_ptr<StreamEndpoint> &endpoint);
+
+                void Remove(uint32_t scope, uint32_t streamId);
+
+                /**
+                 * \brief 把帧交给对应的 StreamEndpoint
+                 * \return 没有对应的 stream 时返回 false 由调用者处理 kOpen
+                 */
+                bool Dispatch(uint32_t scope, const uint8_t *data, size_t length);
+
+                size_t Size() const;
+
+            private:
+                static uint64_t keyOf(uint32_t scope, uint32_t streamId) { return (static_cast<uint64_t>(scope) << 32) | streamId; }
+
+                mutable std::mutex mutex_;
+                std::map<uint64_t, std::shared_ptr<StreamEndpoint>> endpoints_;
+            };
+
+        } // namespace rpc
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _STREAM_ENDPOINT_H_
@@ -3,12 +3,18 @@
 #define _SAMPLE_PTR_HPP_
 #include <memory>
 
+#include "ara/com/e2e/e2e_types.h"
+
 template <typename T>
 class SamplePtr {
 public:
     // Replaces the managed object
     void Reset(T* dataPtr = nullptr) { dataPtr_ = std::shared_ptr<T>(dataPtr); }
 
+    // This is not AutoSAR interface, only used by local binding
+    // Shares the publisher's sample without copying
+    void ResetShared(std::shared_ptr<T> dataPtr) noexcept { dataPtr_ = std::move(dataPtr); }
+
     // Returns the stored object, is the API of 1911
     T* Get() const noexcept { return dataPtr_.get(); }
 
@@ -17,8 +23,19 @@ public:
     T* get() const noexcept { return dataPtr_.get(); }
 
     long UseCount() const noexcept { return dataPtr_.use_count(); }
+
+    /**
+     * \brief 该 sample 的 E2E 检查结果 事件没有配置 E2E 时为 kCheckDisabled
+     *
+     * @ID{[SWS_CM_90420]}
+     */
+    ara::com::e2e::ProfileCheckStatus GetProfileCheckStatus() const noexcept { return profileCheckStatus_; }
+
+    // This is not AutoSAR interface, only used by binding after E2E check
+    void SetProfileCheckStatus(ara::com::e2e::ProfileCheckStatus status) noexcept { profileCheckStatus_ = status; }
 private:
     std::shared_ptr<T> dataPtr_;    
+    ara::com::e2e::ProfileCheckStatus profileCheckStatus_ = ara::com::e2e::ProfileCheckStatus::kCheckDisabled;
 };
 
 #endif // _SAMPLE_PTR_HPP_
\ No newline at end of file
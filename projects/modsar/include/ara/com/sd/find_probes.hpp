@@ -0,0 +1,243 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief ParallelFind 在同进程 共享内存 SOME/IP 上的查找
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _FIND_PROBES_HPP_
+#define _FIND_PROBES_HPP_
+
+#include <unistd.h>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "ara/core/vector.h"
+#include "ara/com/local/local_service.hpp"
+#include "ara/com/local/local_service_registry.h"
+#include "ara/com/routing/binding_kind.h"
+#include "ara/com/sd/parallel_find.hpp"
+#include "ara/com/sd/shm_service_registry.h"
+#include "ara/com/someip/someip_connection.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace sd
+        {
+            /**
+             * \brief 由 binding 找到的实例构造 handle 生成的 proxy 提供 handle 据 kind 选择 binding
+             */
+            template <typename HandleType>
+            using HandleFactory = std::function<HandleType(uint16_t serviceId, uint16_t instanceId, routing::BindingKind kind)>;
+
+            /**
+             * \brief 同进程 binding 查 local::LocalServiceRegistry 已经 Offer 的实例在 Start 里同步找到
+             */
+            template <typename HandleType>
+            class LocalFindProbe : public IFindProbe<HandleType>
+            {
+            public:
+                using FoundHandler = typename IFindProbe<HandleType>::FoundHandler;
+
+                explicit LocalFindProbe(HandleFactory<HandleType> makeHandle) : makeHandle_(std::move(makeHandle)) {}
+
+                routing::BindingKind Kind() const override { return routing::BindingKind::kInProcess; }
+
+                uint64_t Start(uint16_t serviceId, uint16_t instanceId, FoundHandler found) override
+                {
+                    HandleFactory<HandleType> makeHandle = makeHandle_;
+                    return local::LocalServiceRegistry::Instance().StartFind(
+                        serviceId, instanceId, [serviceId, makeHandle, found](const std::vector<std::shared_ptr<local::LocalService>> &services)
+                        {
+                            ara::core::Vector<HandleType> handles;
+                            for (const std::shared_ptr<local::LocalService> &service : services)
+                            {
+                                handles.push_back(makeHandle(serviceId, service->InstanceId(), routing::BindingKind::kInProcess));
+                            }
+                            found(std::move(handles)); });
+                }
+
+                void Stop(uint64_t probeId) override { local::LocalServiceRegistry::Instance().StopFind(probeId); }
+
+            private:
+                const HandleFactory<HandleType> makeHandle_;
+            };
+
+            /**
+             * \brief 共享内存 binding 查 ShmServiceRegistry 只取在共享内存上 Offer 的记录
+             * 本进程的记录由 LocalFindProbe 找到 这里跳过
+             */
+            template <typename HandleType>
+            class ShmFindProbe : public IFindProbe<HandleType>
+            {
+            public:
+                using FoundHandler = typename IFindProbe<HandleType>::FoundHandler;
+
+                ShmFindProbe(std::shared_ptr<ShmServiceRegistry> registry, HandleFactory<HandleType> makeHandle)
+                    : registry_(std::move(registry)), makeHandle_(std::move(makeHandle))
+                {
+                }
+
+                routing::BindingKind Kind() const override { return routing::BindingKind::kSharedMemory; }
+
+                uint64_t Start(uint16_t serviceId, uint16_t instanceId, FoundHandler found) override
+                {
+                    HandleFactory<HandleType> makeHandle = makeHandle_;
+                    const uint32_t self = static_cast<uint32_t>(::getpid());
+                    return registry_->StartFind(serviceId, instanceId, [serviceId, self, makeHandle, found](const std::vector<ServiceOfferRecord> &offers)
+                                                {
+                                                    ara::core::Vector<HandleType> handles;
+                                                    for (const ServiceOfferRecord &offer : offers)
+                                                    {
+                                                        if (offer.pid != self && (offer.bindings & routing::MaskOf(routing::BindingKind::kSharedMemory)) != 0)
+                                                        {
+                                                            handles.push_back(makeHandle(serviceId, offer.instanceId, routing::BindingKind::kSharedMemory));
+                                                        }
+                                                    }
+                                                    found(std::move(handles)); });
+                }
+
+                void Stop(uint64_t probeId) override { registry_->StopFind(probeId); }
+
+            private:
+                const std::shared_ptr<ShmServiceRegistry> registry_;
+                const HandleFactory<HandleType> makeHandle_;
+            };
+
+            /**
+             * \brief SOME/IP binding 向 vsomeip 请求服务 实例可用时找到
+             * 查找期间持有 SomeIpConnection 结束时释放请求 proxy 已经请求的实例不受影响
+             */
+            template <typename HandleType>
+            class SomeIpFindProbe : public IFindProbe<HandleType>
+            {
+            public:
+                using FoundHandler = typename IFindProbe<HandleType>::FoundHandler;
+
+                explicit SomeIpFindProbe(HandleFactory<HandleType> makeHandle) : makeHandle_(std::move(makeHandle)), nextProbeId_(1) {}
+
+                routing::BindingKind Kind() const override { return routing::BindingKind::kSomeIp; }
+
+                uint64_t Start(uint16_t serviceId, uint16_t instanceId, FoundHandler found) override
+                {
+                    someip::SomeIpConnection &connection = someip::SomeIpConnection::Instance();
+                    std::shared_ptr<Search> search = std::make_shared<Search>();
+                    search->serviceId = serviceId;
+                    search->instanceId = instanceId;
+                    search->found = std::move(found);
+                    search->acquired = connection.Acquire().HasValue();
+                    uint64_t probeId;
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        probeId = nextProbeId_++;
+                        searches_.emplace(probeId, search);
+                    }
+                    if (!search->acquired)
+                    {
+                        return probeId; // 网络 binding 不可用 只靠其他 binding 或超时完成
+                    }
+                    HandleFactory<HandleType> makeHandle = makeHandle_;
+                    // 连接注销 handler 时不等待正在执行的回调 search 的锁和 stopped 保证 Stop 之后不再调用 found
+                    search->availability = connection.RegisterAvailabilityHandler(serviceId, instanceId, [search, makeHandle](uint16_t service, uint16_t instance, bool available)
+                                                                                   {
+                                                                                       std::lock_guard<std::mutex> lock(search->mutex);
+                                                                                       if (search->stopped)
+                                                                                       {
+                                                                                           return;
+                                                                                       }
+                                                                                       if (available)
+                                                                                       {
+                                                                                           search->available.insert(instance);
+                                                                                       }
+                                                                                       else
+                                                                                       {
+                                                                                           search->available.erase(instance);
+                                                                                       }
+                                                                                       ara::core::Vector<HandleType> handles;
+                                                                                       for (uint16_t id : search->available)
+                                                                                       {
+                                                                                           handles.push_back(makeHandle(service, id, routing::BindingKind::kSomeIp));
+                                                                                       }
+                                                                                       search->found(std::move(handles)); });
+                    connection.RequestService(serviceId, instanceId);
+                    return probeId;
+                }
+
+                void Stop(uint64_t probeId) override
+                {
+                    std::shared_ptr<Search> search;
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        auto entry = searches_.find(probeId);
+                        if (entry == searches_.end())
+                        {
+                            return;
+                        }
+                        search = entry->second;
+                        searches_.erase(entry);
+                    }
+                    {
+                        std::lock_guard<std::mutex> lock(search->mutex);
+                        search->stopped = true;
+                    }
+                    if (search->acquired)
+                    {
+                        someip::SomeIpConnection &connection = someip::SomeIpConnection::Instance();
+                        connection.UnregisterAvailabilityHandler(search->availability);
+                        connection.ReleaseService(search->serviceId, search->instanceId);
+                        connection.Release();
+                    }
+                }
+
+            private:
+                struct Search
+                {
+                    std::mutex mutex; // 保护 stopped available 串行化 found
+                    bool stopped = false;
+                    bool acquired = false;
+                    uint16_t serviceId = 0;
+                    uint16_t instanceId = 0;
+                    someip::HandlerId availability = 0;
+                    std::set<uint16_t> available;
+                    FoundHandler found;
+                };
+
+                const HandleFactory<HandleType> makeHandle_;
+                std::mutex mutex_; // 保护 searches_ nextProbeId_
+                std::map<uint64_t, std::shared_ptr<Search>> searches_;
+                uint64_t nextProbeId_;
+            };
+
+            /**
+             * \brief 给一种 proxy 的 ParallelFind 添加同进程 共享内存和 SOME/IP 的查找
+             * 共享内存注册表打开失败时不添加共享内存 已经添加过的 binding 保持不变
+             * 生成的 proxy 在第一次 FindServiceAsync 之前调用一次
+             */
+            template <typename HandleType>
+            void AddDefaultProbes(const HandleFactory<HandleType> &makeHandle)
+            {
+                ParallelFind<HandleType> &find = ParallelFind<HandleType>::Instance();
+                find.AddProbe(std::make_shared<LocalFindProbe<HandleType>>(makeHandle));
+                std::shared_ptr<ShmServiceRegistry> registry = ShmServiceRegistry::Default();
+                if (registry)
+                {
+                    find.AddProbe(std::make_shared<ShmFindProbe<HandleType>>(std::move(registry), makeHandle));
+                }
+                find.AddProbe(std::make_shared<SomeIpFindProbe<HandleType>>(makeHandle));
+            }
+
+        } // namespace sd
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _FIND_PROBES_HPP_
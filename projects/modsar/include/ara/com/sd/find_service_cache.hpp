@@ -0,0 +1,271 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief startFindService 的 handle 缓存 按 (service, specifier) 保存 只通知增量
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _FIND_SERVICE_CACHE_HPP_
+#define _FIND_SERVICE_CACHE_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "ara/core/intern_table.h"
+#include "ara/core/vector.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace sd
+        {
+            /**
+             * \brief 一次可用性变化
+             *
+             * current 是变化后的完整列表 不可修改 多个 handler 共享同一份 只在变化时才换成新的一份
+             * added / removed 只含这次真正变化的 handle 未变化的 handle 保留原来的对象 已经创建的 proxy 不需要重建
+             */
+            template <typename HandleType>
+            struct FindServiceUpdate
+            {
+                std::shared_ptr<const ara::core::Vector<HandleType>> current;
+                std::vector<HandleType> added;
+                std::vector<HandleType> removed;
+                uint64_t findId;
+            };
+
+            template <typename HandleType>
+            using FindServiceDeltaHandler = std::function<void(const FindServiceUpdate<HandleType> &update)>;
+
+            /**
+             * \brief 按 (service id, InstanceSpecifier 或 InstanceIdentifier 的驻留句柄) 缓存 handle 列表
+             *
+             * 列表写时复制 findService 直接取当前列表的 shared_ptr 不拷贝
+             * SD 的 Offer / StopOffer 通过 Apply 或 Replace 更新 没有实际变化时 (重复 Offer 等) 不通知
+             * 通知按更新的顺序串行执行 handler 里可以调用 Start / Stop / Current
+             *
+             * 标准的 FindServiceHandler 按值接收完整容器 由 runtime 用 *update.current 适配 拷贝只在变化时发生一次
+             *
+             * \tparam HandleType 需要 operator< 和 operator== 列表按 operator< 排序
+             */
+            template <typename HandleType>
+            class FindServiceCache
+            {
+            public:
+                using HandleList = std::shared_ptr<const ara::core::Vector<HandleType>>;
+                using Update = FindServiceUpdate<HandleType>;
+                using DeltaHandler = FindServiceDeltaHandler<HandleType>;
+
+                FindServiceCache() : empty_(std::make_shared<const ara::core::Vector<HandleType>>()), nextFindId_(1) {}
+
+                FindServiceCache(const FindServiceCache &) = delete;
+                FindServiceCache &operator=(const FindServiceCache &) = delete;
+
+                /**
+                 * \brief 当前列表 没有缓存时返回空列表 不返回 nullptr
+                 */
+                HandleList Current(uint16_t serviceId, ara::core::InternHandle key) const
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    auto entry = entries_.find(EntryKey(serviceId, key));
+                    return entry == entries_.end() ? empty_ : entry->second.handles;
+                }
+
+                /**
+                 * \brief 立即用当前列表调用一次 handler (added 为当前全部 handle) 之后只在列表变化时调用
+                 * \return 传给 Stop 的 id 从 1 开始
+                 */
+                uint64_t Start(uint16_t serviceId, ara::core::InternHandle key, DeltaHandler handler)
+                {
+                    std::lock_guard<std::recursive_mutex> notifying(notifyMutex_);
+                    std::shared_ptr<DeltaHandler> shared = std::make_shared<DeltaHandler>(std::move(handler));
+                    Update initial;
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        initial.findId = nextFindId_++;
+                        Entry &entry = entryOf(EntryKey(serviceId, key));
+                        entry.watchers.push_back(std::make_pair(initial.findId, shared));
+                        findKeys_[initial.findId] = EntryKey(serviceId, key);
+                        initial.current = entry.handles;
+                    }
+                    initial.added.assign(initial.current->begin(), initial.current->end());
+                    (*shared)(initial);
+                    return initial.findId;
+                }
+
+                /**
+                 * \brief 返回后 handler 不会再被调用 可以在 handler 里调用
+                 */
+                void Stop(uint64_t findId)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        auto found = findKeys_.find(findId);
+                        if (found == findKeys_.end())
+                        {
+                            return;
+                        }
+                        auto entry = entries_.find(found->second);
+                        std::vector<Watcher> &watchers = entry->second.watchers;
+                        watchers.erase(std::remove_if(watchers.begin(), watchers.end(), [findId](const Watcher &watcher)
+                                                      { return watcher.first == findId; }),
+                                       watchers.end());
+                        findKeys_.erase(found);
+                        eraseIfUnused(entry);
+                    }
+                    // 等待正在执行的通知 在 handler 里调用时是同一线程 递归锁直接返回
+                    std::lock_guard<std::recursive_mutex> notifying(notifyMutex_);
+                }
+
+                /**
+                 * \brief 按增量更新 已经存在的 added 和不存在的 removed 被忽略
+                 */
+                void Apply(uint16_t serviceId, ara::core::InternHandle key, std::vector<HandleType> added, std::vector<HandleType> removed)
+                {
+                    normalize(added);
+                    normalize(removed);
+                    std::lock_guard<std::recursive_mutex> notifying(notifyMutex_);
+                    Update update;
+                    std::vector<Watcher> handlers;
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        auto entry = entries_.emplace(EntryKey(serviceId, key), Entry{empty_, {}}).first;
+                        const ara::core::Vector<HandleType> &old = *entry->second.handles;
+                        std::set_difference(added.begin(), added.end(), old.begin(), old.end(), std::back_inserter(update.added));
+                        std::set_intersection(old.begin(), old.end(), removed.begin(), removed.end(), std::back_inserter(update.removed));
+                        if (update.added.empty() && update.removed.empty())
+                        {
+                            eraseIfUnused(entry);
+                            return;
+                        }
+                        std::vector<HandleType> kept;
+                        kept.reserve(old.size());
+                        std::set_difference(old.begin(), old.end(), update.removed.begin(), update.removed.end(), std::back_inserter(kept));
+                        publish(entry, kept, update, handlers);
+                    }
+                    notify(update, handlers);
+                }
+
+                /**
+                 * \brief 用完整列表更新 (如一次 FindService 的应答) 和缓存相同的 handle 保留缓存里的对象
+                 */
+                void Replace(uint16_t serviceId, ara::core::InternHandle key, std::vector<HandleType> handles)
+                {
+                    normalize(handles);
+                    std::lock_guard<std::recursive_mutex> notifying(notifyMutex_);
+                    Update update;
+                    std::vector<Watcher> handlers;
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        auto entry = entries_.emplace(EntryKey(serviceId, key), Entry{empty_, {}}).first;
+                        const ara::core::Vector<HandleType> &old = *entry->second.handles;
+                        std::set_difference(handles.begin(), handles.end(), old.begin(), old.end(), std::back_inserter(update.added));
+                        std::set_difference(old.begin(), old.end(), handles.begin(), handles.end(), std::back_inserter(update.removed));
+                        if (update.added.empty() && update.removed.empty())
+                        {
+                            eraseIfUnused(entry);
+                            return;
+                        }
+                        std::vector<HandleType> kept;
+                        kept.reserve(old.size());
+                        std::set_intersection(old.begin(), old.end(), handles.begin(), handles.end(), std::back_inserter(kept));
+                        publish(entry, kept, update, handlers);
+                    }
+                    notify(update, handlers);
+                }
+
+                /**
+                 * \brief 缓存的 (service, key) 数 空列表且没有 handler 的条目会被删除
+                 */
+                size_t Size() const
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    return entries_.size();
+                }
+
+            private:
+                using EntryKey = std::pair<uint16_t, ara::core::InternHandle>;
+                using Watcher = std::pair<uint64_t, std::shared_ptr<DeltaHandler>>;
+
+                struct Entry
+                {
+                    HandleList handles;
+                    std::vector<Watcher> watchers;
+                };
+
+                using EntryMap = std::map<EntryKey, Entry>;
+
+                static void normalize(std::vector<HandleType> &handles)
+                {
+                    std::sort(handles.begin(), handles.end());
+                    handles.erase(std::unique(handles.begin(), handles.end()), handles.end());
+                }
+
+                // 调用前已经拿到 mutex_
+                Entry &entryOf(const EntryKey &key)
+                {
+                    return entries_.emplace(key, Entry{empty_, {}}).first->second;
+                }
+
+                // 调用前已经拿到 mutex_
+                void eraseIfUnused(typename EntryMap::iterator entry)
+                {
+                    if (entry->second.handles->empty() && entry->second.watchers.empty())
+                    {
+                        entries_.erase(entry);
+                    }
+                }
+
+                // 调用前已经拿到 mutex_ kept 是保留的旧 handle 和 update.added 合并成新列表
+                void publish(typename EntryMap::iterator entry, const std::vector<HandleType> &kept, Update &update,
+                             std::vector<Watcher> &handlers)
+                {
+                    std::shared_ptr<ara::core::Vector<HandleType>> next = std::make_shared<ara::core::Vector<HandleType>>();
+                    next->reserve(kept.size() + update.added.size());
+                    std::merge(kept.begin(), kept.end(), update.added.begin(), update.added.end(), std::back_inserter(*next));
+                    entry->second.handles = next->empty() ? empty_ : HandleList(std::move(next));
+                    update.current = entry->second.handles;
+                    handlers = entry->second.watchers;
+                    eraseIfUnused(entry);
+                }
+
+                // 调用前已经拿到 notifyMutex_ 不持有 mutex_ handler 里可以调用 Current / Start / Stop
+                void notify(Update &update, const std::vector<Watcher> &handlers)
+                {
+                    for (const Watcher &watcher : handlers)
+                    {
+                        {
+                            std::lock_guard<std::mutex> lock(mutex_);
+                            if (findKeys_.count(watcher.first) == 0)
+                            {
+                                continue; // 前一个 handler 里被 Stop
+                            }
+                        }
+                        update.findId = watcher.first;
+                        (*watcher.second)(update);
+                    }
+                }
+
+                const HandleList empty_;
+
+                mutable std::mutex mutex_;           // 保护 entries_ findKeys_ nextFindId_
+                std::recursive_mutex notifyMutex_;   // 串行化通知 Stop 据此等待正在执行的 handler
+                EntryMap entries_;
+                std::map<uint64_t, EntryKey> findKeys_;
+                uint64_t nextFindId_;
+            };
+
+        } // namespace sd
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _FIND_SERVICE_CACHE_HPP_
@@ -0,0 +1,208 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 异步 FindService 同时在所有 binding 上查找 先找到或超时即完成
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _PARALLEL_FIND_HPP_
+#define _PARALLEL_FIND_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "ara/core/future.h"
+#include "ara/core/promise.h"
+#include "ara/core/vector.h"
+#include "ara/com/routing/binding_kind.h"
+#include "ara/com/utils/task_scheduler.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace sd
+        {
+            /**
+             * \brief 一个 binding 的服务发现 各 binding 实现
+             *
+             * 同进程查 local::LocalServiceRegistry 共享内存查 ShmServiceRegistry SOME/IP 注册 availability handler 见 find_probes.hpp
+             */
+            template <typename HandleType>
+            class IFindProbe
+            {
+            public:
+                using FoundHandler = std::function<void(ara::core::Vector<HandleType> handles)>;
+
+                virtual ~IFindProbe() = default;
+
+                virtual routing::BindingKind Kind() const = 0;
+
+                /**
+                 * \brief 开始查找 不阻塞 找到实例时用非空列表调用 found
+                 * found 可以在 Start 返回前同步调用 也可以在任意线程调用 可以调用多次
+                 * \return 传给 Stop 的 id
+                 */
+                virtual uint64_t Start(uint16_t serviceId, uint16_t instanceId, FoundHandler found) = 0;
+
+                /**
+                 * \brief 返回后 found 不再被调用 不会在 found 里调用
+                 */
+                virtual void Stop(uint64_t probeId) = 0;
+            };
+
+            /**
+             * \brief 并行查找
+             *
+             * FindServiceAsync 立即返回 Future 同时在每个 binding 上开始查找
+             * 第一个找到实例的 binding 的结果完成 Future 到达超时仍未找到时以空列表完成 和 FindService 找不到时一致
+             * 完成后其余 binding 的查找在 utils::TaskScheduler 线程上停止
+             * 启动时多个 proxy 的查找互不等待 总时间是最慢的一次查找 而不是所有查找之和
+             */
+            template <typename HandleType>
+            class ParallelFind
+            {
+            public:
+                using Probe = IFindProbe<HandleType>;
+                using HandleList = ara::core::Vector<HandleType>;
+
+                /**
+                 * \brief 每种 HandleType (即每个生成的 proxy 类型) 一个实例 部署初始化时添加 binding
+                 */
+                static ParallelFind &Instance()
+                {
+                    static ParallelFind instance;
+                    return instance;
+                }
+
+                ParallelFind() = default;
+
+                ParallelFind(const ParallelFind &) = delete;
+                ParallelFind &operator=(const ParallelFind &) = delete;
+
+                /**
+                 * \brief 同一种 binding 只能有一个 只影响之后开始的查找
+                 */
+                bool AddProbe(std::shared_ptr<Probe> probe)
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    for (const std::shared_ptr<Probe> &existing : probes_)
+                    {
+                        if (existing->Kind() == probe->Kind())
+                        {
+                            return false;
+                        }
+                    }
+                    probes_.push_back(std::move(probe));
+                    return true;
+                }
+
+                /**
+                 * \param timeout 从调用开始计算 为 0 时只取同步返回的结果
+                 */
+                ara::core::Future<HandleList> FindServiceAsync(uint16_t serviceId, uint16_t instanceId, std::chrono::nanoseconds timeout)
+                {
+                    const utils::TaskScheduler::Clock::time_point deadline = utils::TaskScheduler::Clock::now() + timeout;
+                    std::shared_ptr<Search> search = std::make_shared<Search>();
+                    ara::core::Future<HandleList> future = search->promise.get_future();
+                    std::vector<std::shared_ptr<Probe>> probes;
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        probes = probes_;
+                    }
+                    std::weak_ptr<Search> weak = search;
+                    for (const std::shared_ptr<Probe> &probe : probes)
+                    {
+                        const uint64_t probeId = probe->Start(serviceId, instanceId, [weak](HandleList handles)
+                                                              {
+                                                                  std::shared_ptr<Search> found = weak.lock();
+                                                                  if (found && !handles.empty())
+                                                                  {
+                                                                      finish(found, std::move(handles));
+                                                                  } });
+                        std::lock_guard<std::mutex> lock(search->mutex);
+                        search->running.push_back(std::make_pair(probe, probeId));
+                    }
+                    bool done;
+                    {
+                        std::lock_guard<std::mutex> lock(search->mutex);
+                        search->started = true;
+                        done = search->done;
+                        if (!done)
+                        {
+                            // 定时任务持有 search 完成时被取消 binding 的回调只持有 weak_ptr
+                            search->timer = utils::TaskScheduler::Instance().At(deadline, [search]
+                                                                         { finish(search, HandleList()); });
+                        }
+                    }
+                    if (done)
+                    {
+                        // 在 Start 里同步找到了
+                        stopLater(search);
+                    }
+                    return future;
+                }
+
+            private:
+                struct Search
+                {
+                    std::mutex mutex;
+                    ara::core::Promise<HandleList> promise;
+                    uint64_t timer = 0;   // 超时任务 所有 binding 的 Start 返回后才开始计时
+                    bool done = false;    // promise 已经完成
+                    bool started = false; // 所有 binding 的 Start 都已返回 running 完整
+                    std::vector<std::pair<std::shared_ptr<Probe>, uint64_t>> running;
+                };
+
+                static void finish(const std::shared_ptr<Search> &search, HandleList handles)
+                {
+                    bool started;
+                    uint64_t timer;
+                    {
+                        std::lock_guard<std::mutex> lock(search->mutex);
+                        if (search->done)
+                        {
+                            return;
+                        }
+                        search->done = true;
+                        started = search->started;
+                        timer = search->timer;
+                    }
+                    // done 之后没有其他线程再访问 promise 在锁外完成 continuation 可以再次发起查找
+                    search->promise.set_value(std::move(handles));
+                    if (timer != 0)
+                    {
+                        utils::TaskScheduler::Instance().Cancel(timer);
+                    }
+                    if (started)
+                    {
+                        stopLater(search);
+                    }
+                }
+
+                // found 回调里不能停止 binding 的查找 交给调度线程
+                static void stopLater(const std::shared_ptr<Search> &search)
+                {
+                    utils::TaskScheduler::Instance().Post([search]
+                                                   {
+                                                       for (const auto &running : search->running)
+                                                       {
+                                                           running.first->Stop(running.second);
+                                                       } });
+                }
+
+                std::mutex mutex_; // 保护 probes_
+                std::vector<std::shared_ptr<Probe>> probes_;
+            };
+
+        } // namespace sd
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _PARALLEL_FIND_HPP_
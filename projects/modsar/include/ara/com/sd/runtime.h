@@ -1,5 +1,13 @@
 #ifndef _COM_SD_RUNTIME_H
 #define _COM_SD_RUNTIME_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "ara/com/routing/routing_table.h"
+#include "ara/com/sd/find_service_cache.hpp"
+
 namespace com
 {
     namespace sd
@@ -13,6 +21,10 @@ namespace com
         class IRuntime
         {
         public:
+            using ServiceHandle = ServiceHandleContainer::value_type;
+            using FindServiceCache = ara::com::sd::FindServiceCache<ServiceHandle>;
+            using FindServiceDeltaHandler = ara::com::sd::FindServiceDeltaHandler<ServiceHandle>;
+
             /** @brief Virtual destructor for proper destruction via base pointers. */
             virtual ~IRuntime() = default;
 
@@ -43,8 +55,31 @@ namespace com
 
             /**
              * @brief Request the Runtime to get available Service Instances.
+             *
+             * An instance may be offered on several bindings at once. The binding is chosen by
+             * ara::com::routing::RoutingTable::Select: in-process first, then shared memory, then SOME/IP or DDS.
+             * Instances on this host are read from the in-process and shared-memory registries without SD,
+             * then the snapshot kept by a running startFindService; only when both are empty the request goes to findRemoteService.
              */
-            virtual Result<ServiceHandleContainer> findService(ServiceId serviceId, const InstanceIdentifier &instanceIdentifier) = 0;
+            virtual Result<ServiceHandleContainer> findService(ServiceId serviceId, const InstanceIdentifier &instanceIdentifier)
+            {
+                const ara::core::Result<uint16_t> instanceId = instanceIdentifier.BindingId();
+                if (instanceId.HasValue())
+                {
+                    ServiceHandleContainer handles = findOnHost(serviceId, instanceIdentifier, instanceId.Value());
+                    if (!handles.empty())
+                    {
+                        return Result<ServiceHandleContainer>::FromValue(std::move(handles));
+                    }
+                }
+                // While a startFindService watches this instance, SD keeps the cached list current
+                const FindServiceCache::HandleList cached = findServiceCache_.Current(serviceId, instanceIdentifier.Handle());
+                if (!cached->empty())
+                {
+                    return Result<ServiceHandleContainer>::FromValue(ServiceHandleContainer(cached->begin(), cached->end()));
+                }
+                return findRemoteService(serviceId, instanceIdentifier);
+            }
 
             /**
              * @brief Request the Runtime to get available Service Instances.
@@ -54,22 +89,133 @@ namespace com
 
             /**
              * @brief Request the Runtime to get available Service Instances and availability updates.
+             *
+             * The full container is built from the cached snapshot and only when the list actually changed.
              */
             virtual Result<FindServiceHandle> startFindService(const FindServiceHandler &findServiceHandler,
                                                                ServiceId serviceId,
-                                                               const InstanceIdentifier &instanceIdentifier) = 0;
+                                                               const InstanceIdentifier &instanceIdentifier)
+            {
+                return startFindService(adaptFindServiceHandler(findServiceHandler), serviceId, instanceIdentifier);
+            }
 
             /**
              * @brief Request the Runtime to get available Service Instances and availability updates.
              */
             virtual Result<FindServiceHandle> startFindService(const FindServiceHandler &findServiceHandler,
                                                                ServiceId serviceId,
-                                                               const ara::core::InstanceSpecifier &instanceSpecifier) = 0;
+                                                               const ara::core::InstanceSpecifier &instanceSpecifier)
+            {
+                return startFindService(adaptFindServiceHandler(findServiceHandler), serviceId, instanceSpecifier);
+            }
+
+            /**
+             * @brief Request availability updates as deltas.
+             *
+             * Handles are cached per (serviceId, instanceIdentifier) in an ara::com::sd::FindServiceCache.
+             * The cache is primed with findService; later offers reach it through updateFindServiceCache.
+             * The handler gets only the added and removed handles plus a shared, immutable snapshot of the full list;
+             * it is not called when an offer repeats without changing the list.
+             */
+            virtual Result<FindServiceHandle> startFindService(const FindServiceDeltaHandler &findServiceDeltaHandler,
+                                                               ServiceId serviceId,
+                                                               const InstanceIdentifier &instanceIdentifier)
+            {
+                const ara::core::InternHandle key = instanceIdentifier.Handle();
+                primeFindServiceCache(serviceId, key, findService(serviceId, instanceIdentifier));
+                return Result<FindServiceHandle>::FromValue(makeFindServiceHandle(findServiceCache_.Start(serviceId, key, findServiceDeltaHandler)));
+            }
+
+            /**
+             * @brief Request availability updates as deltas, cached per (serviceId, instanceSpecifier).
+             */
+            virtual Result<FindServiceHandle> startFindService(const FindServiceDeltaHandler &findServiceDeltaHandler,
+                                                               ServiceId serviceId,
+                                                               const ara::core::InstanceSpecifier &instanceSpecifier)
+            {
+                const ara::core::InternHandle key = instanceSpecifier.Handle();
+                primeFindServiceCache(serviceId, key, findService(serviceId, instanceSpecifier));
+                return Result<FindServiceHandle>::FromValue(makeFindServiceHandle(findServiceCache_.Start(serviceId, key, findServiceDeltaHandler)));
+            }
 
             /**
              * @brief Stop availability updates for the given findServiceHandle.
+             *
+             * No handler is called after it returns; it may be called from inside a handler.
+             */
+            virtual void stopFindService(FindServiceHandle findServiceHandle)
+            {
+                findServiceCache_.Stop(findIdOf(findServiceHandle));
+            }
+
+        protected:
+            /**
+             * @brief Wrap the id of a FindServiceCache watch, and get it back in stopFindService.
              */
-            virtual void stopFindService(FindServiceHandle findServiceHandle) = 0;
+            virtual FindServiceHandle makeFindServiceHandle(uint64_t findId) = 0;
+
+            virtual uint64_t findIdOf(const FindServiceHandle &findServiceHandle) const = 0;
+
+            /**
+             * @brief Called by the SD of each binding on offer (added) and stop offer or TTL expiry (removed).
+             *
+             * Handlers of the (serviceId, key) watches only run when the list really changed.
+             * key is InstanceIdentifier::Handle() or InstanceSpecifier::Handle() of the watch.
+             */
+            void updateFindServiceCache(ServiceId serviceId, ara::core::InternHandle key, std::vector<ServiceHandle> added,
+                                        std::vector<ServiceHandle> removed)
+            {
+                findServiceCache_.Apply(serviceId, key, std::move(added), std::move(removed));
+            }
+
+            /**
+             * @brief Find instances through the network SD of the SOME/IP or DDS binding.
+             */
+            virtual Result<ServiceHandleContainer> findRemoteService(ServiceId serviceId, const InstanceIdentifier &instanceIdentifier) = 0;
+
+            /**
+             * @brief Build the handle of an instance found on this host, deployed on the given binding.
+             */
+            virtual ServiceHandle makeServiceHandle(ServiceId serviceId, const InstanceIdentifier &instanceIdentifier,
+                                                    ara::com::routing::BindingKind binding) = 0;
+
+            /**
+             * @brief The instance if it is offered in this process or by another process over shared memory.
+             *
+             * Reads local::LocalServiceRegistry and sd::ShmServiceRegistry through RoutingTable::Select, without locks or SD.
+             */
+            ServiceHandleContainer findOnHost(ServiceId serviceId, const InstanceIdentifier &instanceIdentifier, uint16_t instanceId)
+            {
+                ServiceHandleContainer handles;
+                const ara::core::Result<ara::com::routing::BindingKind> binding =
+                    ara::com::routing::RoutingTable::Instance().Select(serviceId, instanceId);
+                if (binding.HasValue() && (binding.Value() == ara::com::routing::BindingKind::kInProcess ||
+                                           binding.Value() == ara::com::routing::BindingKind::kSharedMemory))
+                {
+                    handles.push_back(makeServiceHandle(serviceId, instanceIdentifier, binding.Value()));
+                }
+                return handles;
+            }
+
+        private:
+            // The standard handler takes the container by value; it is copied from the snapshot only on a change
+            FindServiceDeltaHandler adaptFindServiceHandler(const FindServiceHandler &findServiceHandler)
+            {
+                return [this, findServiceHandler](const ara::com::sd::FindServiceUpdate<ServiceHandle> &update)
+                {
+                    findServiceHandler(ServiceHandleContainer(update.current->begin(), update.current->end()), makeFindServiceHandle(update.findId));
+                };
+            }
+
+            void primeFindServiceCache(ServiceId serviceId, ara::core::InternHandle key, const Result<ServiceHandleContainer> &found)
+            {
+                if (found.HasValue())
+                {
+                    findServiceCache_.Replace(serviceId, key, std::vector<ServiceHandle>(found.Value().begin(), found.Value().end()));
+                }
+            }
+
+            FindServiceCache findServiceCache_;
         };
 
     } // namespace sd
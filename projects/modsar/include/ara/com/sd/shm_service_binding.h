@@ -0,0 +1,66 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief skeleton 在共享内存 binding 上的 Offer 写入 ShmServiceRegistry
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _SHM_SERVICE_BINDING_H_
+#define _SHM_SERVICE_BINDING_H_
+
+#include <memory>
+#include <vector>
+
+#include "ara/core/result.h"
+#include "ara/com/routing/service_offer.h"
+#include "ara/com/sd/shm_service_registry.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace sd
+        {
+            /**
+             * \brief Offer 时写入一条记录 bindings 里总是带上 kSharedMemory 析构时还在 Offer 则撤回
+             * 批量 Offer 时同一注册表的记录一次交给 ShmServiceRegistry::OfferAll 只拿一次写锁
+             */
+            class ShmServiceBinding : public routing::IServiceBinding
+            {
+            public:
+                /**
+                 * \param record 其中的 pid 和 offered 由注册表填写
+                 */
+                ShmServiceBinding(std::shared_ptr<ShmServiceRegistry> registry, const ServiceOfferRecord &record);
+
+                ~ShmServiceBinding() override { StopOffer(); }
+
+                ShmServiceBinding(const ShmServiceBinding &) = delete;
+                ShmServiceBinding &operator=(const ShmServiceBinding &) = delete;
+
+                routing::BindingKind Kind() const override { return routing::BindingKind::kSharedMemory; }
+
+                /**
+                 * \return 其他进程已经 Offer 同一实例或槽位用完时返回 kCouldNotExecute
+                 */
+                ara::core::Result<void> Offer() override;
+
+                void StopOffer() override;
+
+                /**
+                 * \brief sameKind 里有其他实现或其他注册表的 binding 时按默认方式逐个 Offer
+                 */
+                ara::core::Result<void> OfferBatch(const std::vector<routing::IServiceBinding *> &sameKind) override;
+
+            private:
+                const std::shared_ptr<ShmServiceRegistry> registry_;
+                ServiceOfferRecord record_;
+                bool offered_;
+            };
+
+        } // namespace sd
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _SHM_SERVICE_BINDING_H_
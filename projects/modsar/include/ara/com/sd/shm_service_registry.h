@@ -0,0 +1,220 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 同主机的共享内存服务注册表 本机的 findService 直接读表 不经过守护进程
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _SHM_SERVICE_REGISTRY_H_
+#define _SHM_SERVICE_REGISTRY_H_
+
+#include <pthread.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ara/core/result.h"
+#include "ara/com/routing/binding_kind.h"
+#include "ara/com/utils/seqlock.hpp"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace sd
+        {
+            /**
+             * \brief 一条 Offer 记录 固定 64 字节 直接放在共享内存里
+             */
+            struct ServiceOfferRecord
+            {
+                uint16_t serviceId;
+                uint16_t instanceId;
+                uint32_t pid;                    ///< Offer 的进程
+                routing::BindingMask bindings;   ///< 该实例在哪些 binding 上 Offer
+                uint8_t offered;                 ///< 0 表示已经 StopOffer
+                uint8_t majorVersion;
+                uint8_t reserved;
+                uint32_t minorVersion;
+                char endpoint[48];               ///< binding 相关的地址 如共享内存通道名 以 '\0' 结尾
+            };
+
+            struct ShmRegistryConfig
+            {
+                std::string name = "/aracom_sd"; ///< 同一主机的进程使用同一个名字
+                uint32_t capacity = 1024;        ///< 槽位数 向上取 2 的幂 只有第一个创建的进程的配置生效
+            };
+
+            struct alignas(64) ShmRegistryHeader
+            {
+                char magic[8]; ///< "ARASDREG" 最后写入 读端据此判断初始化完成
+                uint32_t version;
+                uint32_t capacity;
+                uint32_t slotSize;             ///< sizeof(OfferSlot) 布局不一致时拒绝映射
+                std::atomic<uint32_t> changes; ///< 每次 Offer / StopOffer 加一 watcher 在它上面 futex 等待
+                pthread_mutex_t writeMutex;    ///< 进程间共享的 robust 锁 只串行化写端
+            };
+
+            constexpr char kShmRegistryMagic[8] = {'A', 'R', 'A', 'S', 'D', 'R', 'E', 'G'};
+            constexpr uint32_t kShmRegistryVersion = 1;
+
+            using ShmFindHandler = std::function<void(const std::vector<ServiceOfferRecord> &offers)>;
+
+            /**
+             * \brief 共享内存服务注册表
+             *
+             * 表按 service instance 的哈希开放寻址 每个槽位的记录由 seqlock 保护
+             * 写端 (Offer / StopOffer) 拿进程间的 robust 锁 写完把 changes 加一并 futex 唤醒所有等待者
+             * 读端 (Find / FindAll) 不加锁 不做系统调用 200 个 proxy 启动时的 findService 只是 200 次读内存
+             * StartFind 的 watcher 在一个线程里 futex 等待 changes 变化 只在结果变化时调用 handler
+             *
+             * 进程异常退出后 它的记录在下一个进程 Open 时按 pid 清除 锁由 robust 属性恢复
+             * 写到一半退出的槽位由读端在有限次自旋后加写锁恢复 读端不会永远自旋
+             */
+            class ShmServiceRegistry
+            {
+            public:
+                static constexpr uint16_t kAnyInstance = 0xFFFF;
+
+                /**
+                 * \brief 第一个进程创建并初始化共享内存 之后的进程直接映射
+                 * \return 共享内存创建或映射失败 或布局版本不一致时返回 kErroneousFileHandle
+                 */
+                static ara::core::Result<std::shared_ptr<ShmServiceRegistry>> Open(const ShmRegistryConfig &config);
+
+                /**
+                 * \brief 进程内共用的注册表 第一次调用时按默认配置 Open 服务发现和 binding 都用它
+                 * \return Open 失败时返回 nullptr 之后不再重试
+                 */
+                static std::shared_ptr<ShmServiceRegistry> Default();
+
+                /**
+                 * \brief 撤销本对象 Offer 的全部记录 不删除共享内存 其他进程还在使用
+                 */
+                ~ShmServiceRegistry();
+
+                ShmServiceRegistry(const ShmServiceRegistry &) = delete;
+                ShmServiceRegistry &operator=(const ShmServiceRegistry &) = delete;
+
+                /**
+                 * \brief 写入或更新一条 Offer 记录 pid 由本函数填写
+                 * \return 其他存活的进程已经 Offer 同一实例 或槽位用完时返回 kCouldNotExecute
+                 */
+                ara::core::Result<void> Offer(const ServiceOfferRecord &record);
+
+                /**
+                 * \brief 一次写入多条记录 只拿一次写锁 只唤醒一次 watcher 启动时一个进程的全部 skeleton 用它
+                 * \return 任何一条失败时撤回这一批新写入的记录 返回 kCouldNotExecute
+                 */
+                ara::core::Result<void> OfferAll(const std::vector<ServiceOfferRecord> &records);
+
+                /**
+                 * \brief 只撤销本进程的记录
+                 */
+                void StopOffer(uint16_t serviceId, uint16_t instanceId);
+
+                /**
+                 * \brief 不加锁 找到时写入 out
+                 */
+                bool Find(uint16_t serviceId, uint16_t instanceId, ServiceOfferRecord &out) const;
+
+                /**
+                 * \brief 不加锁 instanceId 为 kAnyInstance 时返回该服务的全部实例 按 instance id 排序
+                 */
+                std::vector<ServiceOfferRecord> FindAll(uint16_t serviceId, uint16_t instanceId) const;
+
+                /**
+                 * \brief 表的修改次数 和 WaitForChange 配合使用
+                 */
+                uint32_t Changes() const;
+
+                /**
+                 * \brief 等到修改次数不等于 seen 或超时 被 futex 唤醒
+                 * \return 修改次数变化时返回 true
+                 */
+                bool WaitForChange(uint32_t seen, std::chrono::nanoseconds timeout) const;
+
+                /**
+                 * \brief 立即用当前结果调用一次 handler 之后结果变化时在 watcher 线程上调用
+                 * \return 停止时传给 StopFind 的 id
+                 */
+                uint64_t StartFind(uint16_t serviceId, uint16_t instanceId, ShmFindHandler handler);
+
+                /**
+                 * \brief 返回后 handler 不会再被调用 不能在 handler 里调用
+                 */
+                void StopFind(uint64_t id);
+
+            private:
+                struct alignas(64) OfferSlot
+                {
+                    std::atomic<uint32_t> used;  ///< 写入过记录后为 1 不再清零 查找遇到 0 即停止
+                    std::atomic<uint32_t> owner; ///< Offer 的进程 0 表示空闲
+                    ara::com::utils::SeqLock<ServiceOfferRecord> record;
+                };
+
+                struct Watch
+                {
+                    uint64_t id;
+                    uint16_t serviceId;
+                    uint16_t instanceId;
+                    ShmFindHandler handler;
+                    std::vector<ServiceOfferRecord> last;
+                };
+
+                ShmServiceRegistry(void *page, size_t size);
+
+                ShmRegistryHeader *header() const { return static_cast<ShmRegistryHeader *>(page_); }
+
+                OfferSlot &slotAt(uint32_t index) const;
+
+                uint32_t indexOf(uint16_t serviceId, uint16_t instanceId) const;
+
+                // 调用前已经拿到写锁
+                void clearSlot(OfferSlot &slot) const;
+
+                // 读端用它读槽位 写端停在写入途中时恢复槽位后重读
+                ServiceOfferRecord loadSlot(OfferSlot &slot) const;
+
+                // 读端等待写入超时 拿写锁确认写端已经退出后清掉槽位
+                void recoverSlot(OfferSlot &slot) const;
+
+                // 调用前已经拿到写锁 新占用的槽位追加到 added 冲突或没有空位时返回 nullptr
+                OfferSlot *offerLocked(const ServiceOfferRecord &record, std::vector<OfferSlot *> &added);
+
+                // 清除已经退出的进程留下的记录
+                void reap();
+
+                void lockWriter() const;
+
+                void publishChange() const;
+
+                void watchLoop();
+
+                void *page_;
+                const size_t size_;
+                const uint32_t pid_;
+
+                std::vector<uint32_t> offered_; // 本对象 Offer 的实例 (service << 16 | instance) 只在写锁内修改
+
+                std::mutex watchMutex_; // 保护 watches_ 和 watcher 线程的启停
+                std::mutex handlerMutex_; // watcher 调用 handler 时持有 StopFind 据此等待正在执行的 handler
+                std::vector<Watch> watches_;
+                uint64_t nextWatchId_;
+                std::thread watcher_;
+                std::atomic<bool> stopping_;
+            };
+
+        } // namespace sd
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _SHM_SERVICE_REGISTRY_H_
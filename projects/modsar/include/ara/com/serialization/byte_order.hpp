@@ -0,0 +1,155 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 主机字节序与 SOME/IP 网络字节序 (big-endian) 之间的转换
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _BYTE_ORDER_HPP_
+#define _BYTE_ORDER_HPP_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "ara/com/serialization/byte_swap.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace serialization
+        {
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+            constexpr bool kHostIsBigEndian = true;
+#else
+            constexpr bool kHostIsBigEndian = false;
+#endif
+
+            /**
+             * \brief 按字节数选择交换字节序的实现
+             */
+            template <size_t Size>
+            struct ByteSwapper;
+
+            template <>
+            struct ByteSwapper<1>
+            {
+                using Type = uint8_t;
+                static Type Swap(Type value) { return value; }
+            };
+
+            template <>
+            struct ByteSwapper<2>
+            {
+                using Type = uint16_t;
+                static Type Swap(Type value) { return __builtin_bswap16(value); }
+            };
+
+            template <>
+            struct ByteSwapper<4>
+            {
+                using Type = uint32_t;
+                static Type Swap(Type value) { return __builtin_bswap32(value); }
+            };
+
+            template <>
+            struct ByteSwapper<8>
+            {
+                using Type = uint64_t;
+                static Type Swap(Type value) { return __builtin_bswap64(value); }
+            };
+
+            /**
+             * \brief 写一个算术类型到网络序 dst 不要求对齐
+             */
+            template <typename T>
+            inline void StoreBigEndian(T value, uint8_t *dst)
+            {
+                static_assert(std::is_arithmetic<T>::value, "StoreBigEndian requires an arithmetic type");
+                using Bits = typename ByteSwapper<sizeof(T)>::Type;
+                Bits bits;
+                std::memcpy(&bits, &value, sizeof(T));
+                if (!kHostIsBigEndian)
+                {
+                    bits = ByteSwapper<sizeof(T)>::Swap(bits);
+                }
+                std::memcpy(dst, &bits, sizeof(T));
+            }
+
+            /**
+             * \brief 从网络序读一个算术类型 src 不要求对齐
+             */
+            template <typename T>
+            inline T LoadBigEndian(const uint8_t *src)
+            {
+                static_assert(std::is_arithmetic<T>::value, "LoadBigEndian requires an arithmetic type");
+                using Bits = typename ByteSwapper<sizeof(T)>::Type;
+                Bits bits;
+                std::memcpy(&bits, src, sizeof(T));
+                if (!kHostIsBigEndian)
+                {
+                    bits = ByteSwapper<sizeof(T)>::Swap(bits);
+                }
+                T value;
+                std::memcpy(&value, &bits, sizeof(T));
+                return value;
+            }
+
+            /**
+             * \brief 把 count 个 width 字节的字在主机序和网络序之间转换 两个方向是同一个操作
+             *
+             * 字宽为 1 或主机为 big-endian 时直接 memcpy 2 4 8 走 byte_swap.h 的批量内核
+             * 其它字宽不是合法的 SOME/IP 基本类型 调试构建直接断言 发布构建逐字节翻转
+             */
+            inline void CopyWordsBigEndian(const void *src, void *dst, size_t count, size_t width)
+            {
+                // 空的 vector 和 string 的 data() 可以是 nullptr 不能交给 memcpy
+                if (count == 0)
+                {
+                    return;
+                }
+                if (kHostIsBigEndian)
+                {
+                    std::memcpy(dst, src, count * width);
+                    return;
+                }
+                switch (width)
+                {
+                case 1:
+                    std::memcpy(dst, src, count);
+                    break;
+                case 2:
+                    SwapBytes16(src, dst, count);
+                    break;
+                case 4:
+                    SwapBytes32(src, dst, count);
+                    break;
+                case 8:
+                    SwapBytes64(src, dst, count);
+                    break;
+                default:
+                {
+                    assert(false && "CopyWordsBigEndian width must be 1, 2, 4 or 8");
+                    const uint8_t *in = static_cast<const uint8_t *>(src);
+                    uint8_t *out = static_cast<uint8_t *>(dst);
+                    for (size_t i = 0; i < count; ++i, in += width, out += width)
+                    {
+                        for (size_t b = 0; b < width; ++b)
+                        {
+                            out[b] = in[width - 1 - b];
+                        }
+                    }
+                    break;
+                }
+                }
+            }
+
+        } // namespace serialization
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _BYTE_ORDER_HPP_
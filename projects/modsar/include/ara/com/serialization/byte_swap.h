@@ -0,0 +1,60 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 数组的批量字节序转换 按 CPU 能力选择 AVX2 / SSSE3 / NEON / 标量实现
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _BYTE_SWAP_H_
+#define _BYTE_SWAP_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ara
+{
+    namespace com
+    {
+        namespace serialization
+        {
+            /**
+             * \brief 批量字节序转换的实现
+             */
+            enum class ByteSwapKernel : uint8_t
+            {
+                kScalar = 0,
+                kSsse3,     ///< 128 位 pshufb
+                kAvx2,      ///< 256 位 vpshufb
+                kNeon       ///< vrev16/32/64
+            };
+
+            /**
+             * \brief 对 count 个 2/4/8 字节的字逐个反转字节序
+             *
+             * src 和 dst 不要求对齐 可以是同一块内存 但不能部分重叠
+             */
+            void SwapBytes16(const void *src, void *dst, size_t count);
+
+            void SwapBytes32(const void *src, void *dst, size_t count);
+
+            void SwapBytes64(const void *src, void *dst, size_t count);
+
+            /**
+             * \brief 当前使用的实现 第一次调用时按 CPU 能力选择最快的一种
+             */
+            ByteSwapKernel GetByteSwapKernel();
+
+            /**
+             * \brief 强制使用某种实现 用于基准测试和对比
+             * \return CPU 不支持该实现时返回 false 不做切换
+             */
+            bool SetByteSwapKernel(ByteSwapKernel kernel);
+
+            const char *ByteSwapKernelName(ByteSwapKernel kernel);
+
+        } // namespace serialization
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _BYTE_SWAP_H_
@@ -0,0 +1,276 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 同主机共享内存传输的 in-place 布局 订阅端直接从 chunk 读字段 不需要反序列化
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _INPLACE_LAYOUT_HPP_
+#define _INPLACE_LAYOUT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#include "ara/core/result.h"
+#include "ara/core/string_view.h"
+#include "ara/com/com_error_domain.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace serialization
+        {
+            /**
+             * \brief in-place 类型的公共约束 整个消息必须放在一个 chunk 里 chunk 释放时不调用析构
+             */
+            template <typename T>
+            struct IsInplaceLayout
+                : std::integral_constant<bool, std::is_standard_layout<T>::value && std::is_trivially_destructible<T>::value>
+            {
+            };
+
+            /**
+             * \brief 自相对的偏移 + 长度 偏移从本对象的地址算起
+             *
+             * chunk 在发布端和订阅端映射到不同地址也能直接使用
+             * 拷贝到 chunk 外会使偏移失效 因此禁止拷贝 只能通过 chunk 里的指针访问
+             */
+            class InplaceRange
+            {
+            public:
+                InplaceRange() : offset_(0), size_(0) {}
+
+                InplaceRange(const InplaceRange &) = delete;
+                InplaceRange &operator=(const InplaceRange &) = delete;
+
+                uint32_t size() const { return size_; }
+
+                bool empty() const { return size_ == 0; }
+
+                /**
+                 * \brief 检查引用的数据是否完整落在 chunk 里 订阅端收到不可信数据时使用
+                 * \param elementSize 每个元素的字节数
+                 * \param trailing 数据后面还需要的字节数 例如字符串的结束符
+                 */
+                bool IsWithin(const void *chunk, size_t length, size_t elementSize, size_t trailing = 0) const
+                {
+                    const uint8_t *begin = static_cast<const uint8_t *>(chunk);
+                    const uint8_t *self = reinterpret_cast<const uint8_t *>(this);
+                    if (self < begin || self + sizeof(*this) > begin + length)
+                    {
+                        return false;
+                    }
+                    const size_t position = static_cast<size_t>(self - begin) + offset_;
+                    return position <= length && static_cast<uint64_t>(size_) * elementSize + trailing <= length - position;
+                }
+
+            protected:
+                const uint8_t *address() const { return reinterpret_cast<const uint8_t *>(this) + offset_; }
+
+                uint8_t *address() { return reinterpret_cast<uint8_t *>(this) + offset_; }
+
+            private:
+                friend class InplaceBuilder;
+
+                uint32_t offset_; // 数据相对本对象的偏移 数据总是在引用它的对象之后分配
+                uint32_t size_;   // 元素个数
+            };
+
+            /**
+             * \brief chunk 内的数组 元素可以是 POD 也可以是嵌套的 in-place 类型
+             */
+            template <typename T>
+            class InplaceVector : public InplaceRange
+            {
+                static_assert(IsInplaceLayout<T>::value, "InplaceVector element must be an in-place type");
+
+            public:
+                using value_type = T;
+                using const_iterator = const T *;
+
+                const T *data() const { return reinterpret_cast<const T *>(address()); }
+
+                T *data() { return reinterpret_cast<T *>(address()); }
+
+                const T &operator[](size_t index) const { return data()[index]; }
+
+                T &operator[](size_t index) { return data()[index]; }
+
+                const_iterator begin() const { return data(); }
+
+                const_iterator end() const { return data() + size(); }
+
+                bool IsWithin(const void *chunk, size_t length) const { return InplaceRange::IsWithin(chunk, length, sizeof(T)); }
+            };
+
+            /**
+             * \brief chunk 内的字符串 以 '\0' 结尾 可以直接当 C 字符串使用
+             */
+            class InplaceString : public InplaceRange
+            {
+            public:
+                const char *data() const { return reinterpret_cast<const char *>(address()); }
+
+                const char *c_str() const { return empty() ? "" : data(); }
+
+                ara::core::StringView View() const { return ara::core::StringView(c_str(), static_cast<int>(size())); }
+
+                bool IsWithin(const void *chunk, size_t length) const
+                {
+                    return empty() || (InplaceRange::IsWithin(chunk, length, 1, 1) && data()[size()] == '\0');
+                }
+            };
+
+            /**
+             * \brief 在发布端借到的 chunk 里顺序构造一个 in-place 消息
+             *
+             * 先用 Root 在 chunk 开头放根对象 再依次给其中的 InplaceVector / InplaceString 分配数据
+             * 分配只在 chunk 内向后推进 不会 malloc 用完 chunk 返回 kSampleAllocationFailure
+             *
+             * \code
+             * InplaceBuilder builder(chunk, chunkSize);
+             * PointCloud *cloud = builder.Root<PointCloud>().Value();
+             * builder.AssignString(cloud->frameId, "lidar_front", 11);
+             * LidarPoint *points = builder.Resize(cloud->points, count).Value();
+             * \endcode
+             */
+            class InplaceBuilder
+            {
+            public:
+                InplaceBuilder(void *chunk, size_t capacity)
+                    : chunk_(static_cast<uint8_t *>(chunk)), capacity_(capacity), used_(0)
+                {
+                }
+
+                /**
+                 * \brief 在 chunk 开头构造根对象 只能调用一次
+                 */
+                template <typename T>
+                ara::core::Result<T *> Root()
+                {
+                    static_assert(IsInplaceLayout<T>::value, "in-place root must be an in-place type");
+                    if (used_ != 0 || reinterpret_cast<uintptr_t>(chunk_) % alignof(T) != 0 || sizeof(T) > capacity_)
+                    {
+                        return ara::core::Result<T *>::FromError(MakeErrorCode(ComErrc::kSampleAllocationFailure, 0));
+                    }
+                    used_ = sizeof(T);
+                    return ara::core::Result<T *>::FromValue(new (chunk_) T());
+                }
+
+                /**
+                 * \brief 给数组分配 count 个默认构造的元素 返回可写的首地址
+                 */
+                template <typename T>
+                ara::core::Result<T *> Resize(InplaceVector<T> &vector, size_t count)
+                {
+                    ara::core::Result<uint8_t *> allocated = allocate(vector, count, sizeof(T), alignof(T));
+                    if (!allocated.HasValue())
+                    {
+                        return ara::core::Result<T *>::FromError(allocated.Error());
+                    }
+                    T *elements = reinterpret_cast<T *>(allocated.Value());
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        new (elements + i) T();
+                    }
+                    return ara::core::Result<T *>::FromValue(elements);
+                }
+
+                /**
+                 * \brief 拷入 count 个 POD 元素
+                 */
+                template <typename T>
+                ara::core::Result<void> Assign(InplaceVector<T> &vector, const T *elements, size_t count)
+                {
+                    static_assert(std::is_trivially_copy_constructible<T>::value, "Assign copies elements, use Resize for nested in-place types");
+                    ara::core::Result<uint8_t *> allocated = allocate(vector, count, sizeof(T), alignof(T));
+                    if (!allocated.HasValue())
+                    {
+                        return ara::core::Result<void>::FromError(allocated.Error());
+                    }
+                    std::memcpy(allocated.Value(), elements, count * sizeof(T));
+                    return ara::core::Result<void>::FromValue();
+                }
+
+                /**
+                 * \brief 拷入字符串并补 '\0'
+                 */
+                ara::core::Result<void> AssignString(InplaceString &string, const char *value, size_t length)
+                {
+                    ara::core::Result<uint8_t *> allocated = allocate(string, length, 1, 1, 1);
+                    if (!allocated.HasValue())
+                    {
+                        return ara::core::Result<void>::FromError(allocated.Error());
+                    }
+                    std::memcpy(allocated.Value(), value, length);
+                    allocated.Value()[length] = '\0';
+                    return ara::core::Result<void>::FromValue();
+                }
+
+                /**
+                 * \brief 已使用的字节数 即发布时的 payload 长度
+                 */
+                size_t Used() const { return used_; }
+
+            private:
+                ara::core::Result<uint8_t *> allocate(InplaceRange &range, size_t count, size_t elementSize, size_t alignment,
+                                                      size_t trailing = 0)
+                {
+                    uint8_t *owner = reinterpret_cast<uint8_t *>(&range);
+                    if (owner < chunk_ || owner >= chunk_ + used_ || count > UINT32_MAX)
+                    {
+                        // range 必须是本 chunk 里已经构造好的对象
+                        return ara::core::Result<uint8_t *>::FromError(MakeErrorCode(ComErrc::kIllegalUseOfAllocate, 0));
+                    }
+                    const uintptr_t base = reinterpret_cast<uintptr_t>(chunk_);
+                    const size_t position = static_cast<size_t>(((base + used_ + alignment - 1) / alignment) * alignment - base);
+                    const size_t bytes = count * elementSize + trailing;
+                    if (count != 0 && (bytes / count < elementSize || position > capacity_ || bytes > capacity_ - position))
+                    {
+                        return ara::core::Result<uint8_t *>::FromError(MakeErrorCode(ComErrc::kSampleAllocationFailure, 0));
+                    }
+                    if (count == 0)
+                    {
+                        range.offset_ = 0;
+                        range.size_ = 0;
+                        return ara::core::Result<uint8_t *>::FromValue(owner);
+                    }
+                    uint8_t *data = chunk_ + position;
+                    range.offset_ = static_cast<uint32_t>(data - owner);
+                    range.size_ = static_cast<uint32_t>(count);
+                    used_ = position + bytes;
+                    return ara::core::Result<uint8_t *>::FromValue(data);
+                }
+
+            private:
+                uint8_t *chunk_;
+                size_t capacity_;
+                size_t used_;
+            };
+
+            /**
+             * \brief 订阅端取 chunk 里的根对象 长度不足或没有对齐时返回 nullptr
+             *
+             * 只检查根对象本身 数组和字符串可以再用 IsWithin 检查
+             */
+            template <typename T>
+            inline const T *InplaceRoot(const void *chunk, size_t length)
+            {
+                static_assert(IsInplaceLayout<T>::value, "in-place root must be an in-place type");
+                if (chunk == nullptr || length < sizeof(T) || reinterpret_cast<uintptr_t>(chunk) % alignof(T) != 0)
+                {
+                    return nullptr;
+                }
+                return static_cast<const T *>(chunk);
+            }
+
+        } // namespace serialization
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _INPLACE_LAYOUT_HPP_
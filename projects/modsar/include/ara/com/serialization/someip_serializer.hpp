@@ -0,0 +1,698 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief SOME/IP 线上格式的编译期序列化/反序列化
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _SOMEIP_SERIALIZER_HPP_
+#define _SOMEIP_SERIALIZER_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ara/core/result.h"
+#include "ara/com/com_error_domain.h"
+#include "ara/com/serialization/byte_order.hpp"
+
+/**
+ * \brief 描述结构体的成员 宏需要写在结构体所在的命名空间里 (通过 ADL 查找)
+ *
+ * 成员按宏里的顺序依次序列化 与 ARXML 中的顺序一致 不要求与声明顺序相同
+ *
+ * \code
+ * struct HelloRequest { uint32_t id; ara::core::String name; };
+ * ARA_COM_SOMEIP_STRUCT(HelloRequest, &HelloRequest::id, &HelloRequest::name)
+ * \endcode
+ */
+#define ARA_COM_SOMEIP_STRUCT(Type, ...)                                                         \
+    inline auto SomeIpMembers(const Type *) -> decltype(std::make_tuple(__VA_ARGS__))            \
+    {                                                                                            \
+        return std::make_tuple(__VA_ARGS__);                                                     \
+    }
+
+namespace ara
+{
+    namespace com
+    {
+        namespace serialization
+        {
+            /**
+             * \brief 反序列化时的读位置 越界读取返回 false 不抛异常
+             */
+            struct WireReader
+            {
+                const uint8_t *cursor;
+                const uint8_t *end;
+
+                bool Take(size_t length, const uint8_t *&data)
+                {
+                    if (static_cast<size_t>(end - cursor) < length)
+                    {
+                        return false;
+                    }
+                    data = cursor;
+                    cursor += length;
+                    return true;
+                }
+
+                size_t Remaining() const { return static_cast<size_t>(end - cursor); }
+            };
+
+            /**
+             * \brief 每种类型的线上格式
+             *
+             * kFixed / kFixedSize 编译期给出定长类型的序列化长度
+             * WordWidth() 非 0 时内存布局与线上格式只差每个 WordWidth 字节的字的字节序 可以整块转换
+             * (字宽为 1 或主机为 big-endian 时就是 memcpy) 为 0 时需要逐个成员处理
+             * Size 计算序列化长度 Write 写入已经分配好长度的缓冲区 Read 从 WireReader 读
+             * 其它类型可以直接特化本模板
+             */
+            template <typename T, typename Enable = void>
+            struct SomeIpCodec;
+
+            namespace detail
+            {
+                template <typename T>
+                using Codec = SomeIpCodec<typename std::remove_cv<T>::type>;
+
+                constexpr size_t kLengthFieldSize = 4;           // 动态数组和字符串前的长度字段 uint32
+                constexpr uint8_t kUtf8Bom[3] = {0xEF, 0xBB, 0xBF};
+
+                template <typename T>
+                struct IsBulkArithmetic
+                    : std::integral_constant<bool, std::is_arithmetic<T>::value && !std::is_same<T, bool>::value>
+                {
+                };
+
+                /**
+                 * \brief 连续存放的元素 字宽一致的 POD 整块转换字节序 其它逐个写
+                 */
+                template <typename T>
+                inline uint8_t *WriteElements(const T *elements, size_t count, uint8_t *out)
+                {
+                    const size_t width = Codec<T>::WordWidth();
+                    if (width != 0)
+                    {
+                        CopyWordsBigEndian(elements, out, count * sizeof(T) / width, width);
+                        return out + count * sizeof(T);
+                    }
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        out = Codec<T>::Write(elements[i], out);
+                    }
+                    return out;
+                }
+
+                template <typename T>
+                inline bool ReadElements(WireReader &reader, T *elements, size_t count)
+                {
+                    const size_t width = Codec<T>::WordWidth();
+                    if (width != 0)
+                    {
+                        const uint8_t *data = nullptr;
+                        if (!reader.Take(count * sizeof(T), data))
+                        {
+                            return false;
+                        }
+                        CopyWordsBigEndian(data, static_cast<void *>(elements), count * sizeof(T) / width, width);
+                        return true;
+                    }
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        if (!Codec<T>::Read(reader, elements[i]))
+                        {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+
+                template <typename T>
+                inline size_t ElementsSize(const T *elements, size_t count)
+                {
+                    if (Codec<T>::kFixed)
+                    {
+                        return count * Codec<T>::kFixedSize;
+                    }
+                    size_t size = 0;
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        size += Codec<T>::Size(elements[i]);
+                    }
+                    return size;
+                }
+
+                inline uint8_t *WriteLength(size_t length, uint8_t *out)
+                {
+                    StoreBigEndian(static_cast<uint32_t>(length), out);
+                    return out + kLengthFieldSize;
+                }
+
+                inline bool ReadLength(WireReader &reader, size_t &length)
+                {
+                    const uint8_t *data = nullptr;
+                    if (!reader.Take(kLengthFieldSize, data))
+                    {
+                        return false;
+                    }
+                    length = LoadBigEndian<uint32_t>(data);
+                    return length <= reader.Remaining();
+                }
+
+                /**
+                 * \brief 结构体成员的编译期信息
+                 */
+                template <typename MemberPointer>
+                struct MemberOf;
+
+                template <typename Class, typename Member>
+                struct MemberOf<Member Class::*>
+                {
+                    using Type = Member;
+                };
+
+                template <typename Tuple>
+                struct MembersInfo;
+
+                template <>
+                struct MembersInfo<std::tuple<>>
+                {
+                    static constexpr bool kFixed = true;
+                    static constexpr size_t kFixedSize = 0;
+                };
+
+                template <typename Head, typename... Tail>
+                struct MembersInfo<std::tuple<Head, Tail...>>
+                {
+                    using HeadCodec = Codec<typename MemberOf<Head>::Type>;
+                    static constexpr bool kFixed = HeadCodec::kFixed && MembersInfo<std::tuple<Tail...>>::kFixed;
+                    static constexpr size_t kFixedSize = kFixed ? HeadCodec::kFixedSize + MembersInfo<std::tuple<Tail...>>::kFixedSize : 0;
+                };
+
+                /**
+                 * \brief 按顺序对每个成员指针调用 f f 返回 false 时停止
+                 */
+                template <typename Tuple, typename F, size_t... I>
+                inline bool ForEachMember(const Tuple &members, F &&f, std::index_sequence<I...>)
+                {
+                    bool ok = true;
+                    int sequence[] = {0, (ok = ok && f(std::get<I>(members)), 0)...};
+                    (void)sequence;
+                    return ok;
+                }
+
+                template <typename Tuple, typename F>
+                inline bool ForEachMember(const Tuple &members, F &&f)
+                {
+                    return ForEachMember(members, std::forward<F>(f), std::make_index_sequence<std::tuple_size<Tuple>::value>());
+                }
+
+                template <typename T, typename = void>
+                struct HasSomeIpMembers : std::false_type
+                {
+                };
+
+                template <typename T>
+                struct HasSomeIpMembers<T, decltype(void(SomeIpMembers(std::declval<const T *>())))> : std::true_type
+                {
+                };
+
+            } // namespace detail
+
+            /**
+             * \brief 整数和浮点数 按 big-endian 定长写出
+             */
+            template <typename T>
+            struct SomeIpCodec<T, typename std::enable_if<detail::IsBulkArithmetic<T>::value>::type>
+            {
+                static constexpr bool kFixed = true;
+                static constexpr size_t kFixedSize = sizeof(T);
+
+                static constexpr size_t WordWidth() { return sizeof(T); }
+
+                static size_t Size(const T &) { return sizeof(T); }
+
+                static uint8_t *Write(const T &value, uint8_t *out)
+                {
+                    StoreBigEndian(value, out);
+                    return out + sizeof(T);
+                }
+
+                static bool Read(WireReader &reader, T &value)
+                {
+                    const uint8_t *data = nullptr;
+                    if (!reader.Take(sizeof(T), data))
+                    {
+                        return false;
+                    }
+                    value = LoadBigEndian<T>(data);
+                    return true;
+                }
+            };
+
+            /**
+             * \brief bool 占一个字节 读取时只接受 0 和 1
+             */
+            template <>
+            struct SomeIpCodec<bool>
+            {
+                static constexpr bool kFixed = true;
+                static constexpr size_t kFixedSize = 1;
+
+                static constexpr size_t WordWidth() { return 0; }
+
+                static size_t Size(const bool &) { return 1; }
+
+                static uint8_t *Write(const bool &value, uint8_t *out)
+                {
+                    *out = value ? 1 : 0;
+                    return out + 1;
+                }
+
+                static bool Read(WireReader &reader, bool &value)
+                {
+                    const uint8_t *data = nullptr;
+                    if (!reader.Take(1, data) || *data > 1)
+                    {
+                        return false;
+                    }
+                    value = (*data == 1);
+                    return true;
+                }
+            };
+
+            /**
+             * \brief 枚举按底层类型写出
+             */
+            template <typename T>
+            struct SomeIpCodec<T, typename std::enable_if<std::is_enum<T>::value>::type>
+            {
+                using Underlying = typename std::underlying_type<T>::type;
+
+                static constexpr bool kFixed = true;
+                static constexpr size_t kFixedSize = sizeof(Underlying);
+
+                static constexpr size_t WordWidth() { return sizeof(Underlying); }
+
+                static size_t Size(const T &) { return sizeof(Underlying); }
+
+                static uint8_t *Write(const T &value, uint8_t *out)
+                {
+                    return SomeIpCodec<Underlying>::Write(static_cast<Underlying>(value), out);
+                }
+
+                static bool Read(WireReader &reader, T &value)
+                {
+                    Underlying raw;
+                    if (!SomeIpCodec<Underlying>::Read(reader, raw))
+                    {
+                        return false;
+                    }
+                    value = static_cast<T>(raw);
+                    return true;
+                }
+            };
+
+            /**
+             * \brief 定长数组 (ara::core::Array) 没有长度字段
+             */
+            template <typename T, size_t N>
+            struct SomeIpCodec<std::array<T, N>>
+            {
+                static constexpr bool kFixed = SomeIpCodec<T>::kFixed;
+                static constexpr size_t kFixedSize = kFixed ? N * SomeIpCodec<T>::kFixedSize : 0;
+
+                static size_t WordWidth() { return sizeof(std::array<T, N>) == N * sizeof(T) ? SomeIpCodec<T>::WordWidth() : 0; }
+
+                static size_t Size(const std::array<T, N> &value) { return detail::ElementsSize(value.data(), N); }
+
+                static uint8_t *Write(const std::array<T, N> &value, uint8_t *out)
+                {
+                    return detail::WriteElements(value.data(), N, out);
+                }
+
+                static bool Read(WireReader &reader, std::array<T, N> &value)
+                {
+                    return detail::ReadElements(reader, value.data(), N);
+                }
+            };
+
+            /**
+             * \brief 结构体里的 C 数组 与 std::array 相同
+             */
+            template <typename T, size_t N>
+            struct SomeIpCodec<T[N]>
+            {
+                static constexpr bool kFixed = SomeIpCodec<T>::kFixed;
+                static constexpr size_t kFixedSize = kFixed ? N * SomeIpCodec<T>::kFixedSize : 0;
+
+                static size_t WordWidth() { return SomeIpCodec<T>::WordWidth(); }
+
+                static size_t Size(const T (&value)[N]) { return detail::ElementsSize(value, N); }
+
+                static uint8_t *Write(const T (&value)[N], uint8_t *out) { return detail::WriteElements(value, N, out); }
+
+                static bool Read(WireReader &reader, T (&value)[N]) { return detail::ReadElements(reader, value, N); }
+            };
+
+            /**
+             * \brief 动态数组 (ara::core::Vector) 前面是 uint32 的字节长度
+             */
+            template <typename T, typename Allocator>
+            struct SomeIpCodec<std::vector<T, Allocator>>
+            {
+                static constexpr bool kFixed = false;
+                static constexpr size_t kFixedSize = 0;
+
+                static constexpr size_t WordWidth() { return 0; }
+
+                static size_t Size(const std::vector<T, Allocator> &value)
+                {
+                    return detail::kLengthFieldSize + detail::ElementsSize(value.data(), value.size());
+                }
+
+                static uint8_t *Write(const std::vector<T, Allocator> &value, uint8_t *out)
+                {
+                    uint8_t *lengthField = out;
+                    out = detail::WriteElements(value.data(), value.size(), out + detail::kLengthFieldSize);
+                    detail::WriteLength(static_cast<size_t>(out - lengthField) - detail::kLengthFieldSize, lengthField);
+                    return out;
+                }
+
+                static bool Read(WireReader &reader, std::vector<T, Allocator> &value)
+                {
+                    size_t length = 0;
+                    if (!detail::ReadLength(reader, length))
+                    {
+                        return false;
+                    }
+                    if (SomeIpCodec<T>::kFixed)
+                    {
+                        // 定长元素可以先算出个数 一次分配后整块读入
+                        const size_t elementSize = SomeIpCodec<T>::kFixedSize;
+                        if (elementSize == 0)
+                        {
+                            // 空结构体在线上不占字节 个数无法还原 只接受空的数组
+                            value.clear();
+                            return length == 0;
+                        }
+                        if (length % elementSize != 0)
+                        {
+                            return false;
+                        }
+                        value.resize(length / elementSize);
+                        return detail::ReadElements(reader, value.data(), value.size());
+                    }
+                    WireReader elements{reader.cursor, reader.cursor + length};
+                    reader.cursor += length;
+                    value.clear();
+                    while (elements.Remaining() != 0)
+                    {
+                        value.emplace_back();
+                        if (!SomeIpCodec<T>::Read(elements, value.back()))
+                        {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+            };
+
+            /**
+             * \brief std::vector<bool> 不是连续存储 单独逐个处理
+             */
+            template <typename Allocator>
+            struct SomeIpCodec<std::vector<bool, Allocator>>
+            {
+                static constexpr bool kFixed = false;
+                static constexpr size_t kFixedSize = 0;
+
+                static constexpr size_t WordWidth() { return 0; }
+
+                static size_t Size(const std::vector<bool, Allocator> &value) { return detail::kLengthFieldSize + value.size(); }
+
+                static uint8_t *Write(const std::vector<bool, Allocator> &value, uint8_t *out)
+                {
+                    out = detail::WriteLength(value.size(), out);
+                    for (bool element : value)
+                    {
+                        *out++ = element ? 1 : 0;
+                    }
+                    return out;
+                }
+
+                static bool Read(WireReader &reader, std::vector<bool, Allocator> &value)
+                {
+                    size_t length = 0;
+                    if (!detail::ReadLength(reader, length))
+                    {
+                        return false;
+                    }
+                    value.resize(length);
+                    for (size_t i = 0; i < length; ++i)
+                    {
+                        bool element = false;
+                        if (!SomeIpCodec<bool>::Read(reader, element))
+                        {
+                            return false;
+                        }
+                        value[i] = element;
+                    }
+                    return true;
+                }
+            };
+
+            /**
+             * \brief 字符串 (ara::core::String) 按 UTF-8 写出
+             *
+             * 长度字段 + BOM + 内容 + '\0' 长度字段包含 BOM 和结束符
+             */
+            template <>
+            struct SomeIpCodec<std::string>
+            {
+                static constexpr bool kFixed = false;
+                static constexpr size_t kFixedSize = 0;
+
+                static constexpr size_t WordWidth() { return 0; }
+
+                static size_t Size(const std::string &value)
+                {
+                    return detail::kLengthFieldSize + sizeof(detail::kUtf8Bom) + value.size() + 1;
+                }
+
+                static uint8_t *Write(const std::string &value, uint8_t *out)
+                {
+                    out = detail::WriteLength(sizeof(detail::kUtf8Bom) + value.size() + 1, out);
+                    std::memcpy(out, detail::kUtf8Bom, sizeof(detail::kUtf8Bom));
+                    out += sizeof(detail::kUtf8Bom);
+                    std::memcpy(out, value.data(), value.size());
+                    out += value.size();
+                    *out++ = 0;
+                    return out;
+                }
+
+                static bool Read(WireReader &reader, std::string &value)
+                {
+                    size_t length = 0;
+                    const uint8_t *data = nullptr;
+                    if (!detail::ReadLength(reader, length) || length < sizeof(detail::kUtf8Bom) + 1 || !reader.Take(length, data))
+                    {
+                        return false;
+                    }
+                    if (std::memcmp(data, detail::kUtf8Bom, sizeof(detail::kUtf8Bom)) != 0 || data[length - 1] != 0)
+                    {
+                        return false;
+                    }
+                    value.assign(reinterpret_cast<const char *>(data) + sizeof(detail::kUtf8Bom), length - sizeof(detail::kUtf8Bom) - 1);
+                    return true;
+                }
+            };
+
+            /**
+             * \brief ARA_COM_SOMEIP_STRUCT 描述过的结构体 成员依次写出 没有填充
+             *
+             * 全部成员定长 字宽相同 并且内存中按宏里的顺序紧密排列时 整个结构体按字整块转换
+             * 例如 {float x, y, z, intensity} 的点云 Vector 只需要一次批量字节序转换
+             * 成员偏移在第一次使用时检查一次
+             */
+            template <typename T>
+            struct SomeIpCodec<T, typename std::enable_if<detail::HasSomeIpMembers<T>::value>::type>
+            {
+                using Members = decltype(SomeIpMembers(std::declval<const T *>()));
+
+                static constexpr bool kFixed = detail::MembersInfo<Members>::kFixed;
+                static constexpr size_t kFixedSize = detail::MembersInfo<Members>::kFixedSize;
+
+                static size_t WordWidth()
+                {
+                    static const size_t width = computeWordWidth();
+                    return width;
+                }
+
+                static size_t Size(const T &value)
+                {
+                    if (kFixed)
+                    {
+                        return kFixedSize;
+                    }
+                    size_t size = 0;
+                    detail::ForEachMember(SomeIpMembers(&value), [&value, &size](auto member)
+                                          {
+                                              size += detail::Codec<typename detail::MemberOf<decltype(member)>::Type>::Size(value.*member);
+                                              return true;
+                                          });
+                    return size;
+                }
+
+                static uint8_t *Write(const T &value, uint8_t *out)
+                {
+                    const size_t width = WordWidth();
+                    if (width != 0)
+                    {
+                        CopyWordsBigEndian(&value, out, sizeof(T) / width, width);
+                        return out + sizeof(T);
+                    }
+                    detail::ForEachMember(SomeIpMembers(&value), [&value, &out](auto member)
+                                          {
+                                              out = detail::Codec<typename detail::MemberOf<decltype(member)>::Type>::Write(value.*member, out);
+                                              return true;
+                                          });
+                    return out;
+                }
+
+                static bool Read(WireReader &reader, T &value)
+                {
+                    const size_t width = WordWidth();
+                    if (width != 0)
+                    {
+                        const uint8_t *data = nullptr;
+                        if (!reader.Take(sizeof(T), data))
+                        {
+                            return false;
+                        }
+                        CopyWordsBigEndian(data, static_cast<void *>(&value), sizeof(T) / width, width);
+                        return true;
+                    }
+                    return detail::ForEachMember(SomeIpMembers(&value), [&value, &reader](auto member)
+                                                 { return detail::Codec<typename detail::MemberOf<decltype(member)>::Type>::Read(reader, value.*member); });
+                }
+
+            private:
+                static size_t computeWordWidth()
+                {
+                    if (!kFixed || kFixedSize != sizeof(T) || !std::is_trivially_copyable<T>::value)
+                    {
+                        return 0;
+                    }
+                    // 只取成员地址 不读内容
+                    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage{};
+                    const T *object = reinterpret_cast<const T *>(&storage);
+                    const uint8_t *base = reinterpret_cast<const uint8_t *>(object);
+                    size_t expected = 0;
+                    size_t width = 0;
+                    const bool packed = detail::ForEachMember(SomeIpMembers(object), [object, base, &expected, &width](auto member)
+                                                              {
+                                                                  using Codec = detail::Codec<typename detail::MemberOf<decltype(member)>::Type>;
+                                                                  const uint8_t *address = reinterpret_cast<const uint8_t *>(&(object->*member));
+                                                                  const size_t memberWidth = Codec::WordWidth();
+                                                                  if (static_cast<size_t>(address - base) != expected || memberWidth == 0)
+                                                                  {
+                                                                      return false;
+                                                                  }
+                                                                  // big-endian 主机上不需要转换 字宽不同也可以整块拷贝
+                                                                  if (width != 0 && width != memberWidth && !kHostIsBigEndian)
+                                                                  {
+                                                                      return false;
+                                                                  }
+                                                                  width = memberWidth;
+                                                                  expected += Codec::kFixedSize;
+                                                                  return true;
+                                                              });
+                    if (!packed || width == 0)
+                    {
+                        return 0;
+                    }
+                    return kHostIsBigEndian ? 1 : width;
+                }
+            };
+
+            /**
+             * \brief 序列化后的字节数 定长类型在编译期确定
+             */
+            template <typename T>
+            inline size_t GetSerializedSize(const T &value)
+            {
+                if (detail::Codec<T>::kFixed)
+                {
+                    return detail::Codec<T>::kFixedSize;
+                }
+                return detail::Codec<T>::Size(value);
+            }
+
+            /**
+             * \brief 序列化到调用者提供的缓冲区 (例如 transport 的发送缓冲区)
+             * \return 写入的字节数 缓冲区不足时返回 kSampleAllocationFailure
+             */
+            template <typename T>
+            inline ara::core::Result<size_t> Serialize(const T &value, uint8_t *buffer, size_t capacity)
+            {
+                const size_t size = GetSerializedSize(value);
+                if (size > capacity)
+                {
+                    return ara::core::Result<size_t>::FromError(MakeErrorCode(ComErrc::kSampleAllocationFailure, 0));
+                }
+                detail::Codec<T>::Write(value, buffer);
+                return ara::core::Result<size_t>::FromValue(size);
+            }
+
+            /**
+             * \brief 反序列化 数据必须恰好被完整消费
+             * \return 长度不符或格式错误时返回 kCommunicationStackError
+             */
+            template <typename T>
+            inline ara::core::Result<void> Deserialize(const uint8_t *data, size_t length, T &value)
+            {
+                WireReader reader{data, data + length};
+                if (!detail::Codec<T>::Read(reader, value) || reader.Remaining() != 0)
+                {
+                    return ara::core::Result<void>::FromError(MakeErrorCode(ComErrc::kCommunicationStackError, 0));
+                }
+                return ara::core::Result<void>::FromValue();
+            }
+
+            /**
+             * \brief 序列化进 binding 的 payload
+             *
+             * 先按确切长度分配缓冲区 序列化直接写入 再整体移交给 payload 中间没有额外拷贝
+             */
+            template <typename T, typename PayloadType>
+            inline void SerializeToPayload(const T &value, PayloadType &payload)
+            {
+                std::vector<uint8_t> buffer(GetSerializedSize(value));
+                detail::Codec<T>::Write(value, buffer.data());
+                payload.set_data(std::move(buffer));
+            }
+
+            /**
+             * \brief 从 binding 的 payload 反序列化
+             */
+            template <typename T, typename PayloadType>
+            inline ara::core::Result<void> DeserializeFromPayload(const PayloadType &payload, T &value)
+            {
+                return Deserialize(payload.get_data(), payload.get_length(), value);
+            }
+
+        } // namespace serialization
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _SOMEIP_SERIALIZER_HPP_
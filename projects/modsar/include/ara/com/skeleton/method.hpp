@@ -1,6 +1,8 @@
 #ifndef METHOD_HPP_
 #define METHOD_HPP_
+#include <memory>
 #include "instance_identifer.h"
+#include "ara/com/serialization/someip_serializer.hpp"
 
 /***
  * 头文件保持干净 减少不必要依赖
@@ -28,14 +30,14 @@ Status CatchingFunctionHandler(Callable &&handler)
   return handler();
 }
 
-template <class ParamType, class ResponseType>
-void RunHandlerHelper(const ParamType *param,
-                      ResponseType *rsp, Status &status)
+/**
+ * 应答按 SOME/IP 格式直接序列化进发送的 payload 不经过中间的 string 也不做强转
+ */
+template <class MessageType, class ResponseType>
+void RunHandlerHelper(const std::shared_ptr<MessageType> &message,
+                      const ResponseType &rsp, Status &status)
 {
-
-  std::string str(reinterpret_cast<const char *>(rsp)); // 减少 cast的使用 容易crash
-  auto *payload = param->get_payload();
-  payload->set_data((str.begin(), str.end()));
+  ara::com::serialization::SerializeToPayload(rsp, *message->get_payload());
 }
 
 class MethodId {
@@ -0,0 +1,93 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 按 MethodCallProcessingMode 调度 Skeleton 收到的方法调用
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _METHOD_CALL_DISPATCHER_H_
+#define _METHOD_CALL_DISPATCHER_H_
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+#include "ara/core/future.h"
+#include "ara/core/result.h"
+#include "ara/com/types.h"
+#include "ara/com/skeleton/worker_pool.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace skeleton
+        {
+            /**
+             * \brief 每个 Skeleton 实例一个 决定 RunHandler 在哪个线程执行
+             *
+             * - kPoll: 调用进入本地队列 应用调用 ProcessNextMethodCall 时在应用线程执行 队列有上限 满了拒绝新的调用
+             * - kEvent: 提交到 WorkerPool 并发执行 orderPerClient 为 true 时同一客户端的调用保持顺序
+             * - kEventSingleThread: 在 WorkerPool 上串行执行 同一时刻最多一个调用
+             */
+            class MethodCallDispatcher
+            {
+            public:
+                using MethodCall = std::function<void()>;
+
+                static constexpr size_t kDefaultPollQueueLimit = 1024;
+
+                MethodCallDispatcher(MethodCallProcessingMode mode, bool orderPerClient = false,
+                                     WorkerPool &pool = WorkerPool::Default());
+
+                MethodCallDispatcher(const MethodCallDispatcher &) = delete;
+                MethodCallDispatcher &operator=(const MethodCallDispatcher &) = delete;
+
+                /**
+                 * \brief binding 收到请求后调用
+                 * \param client 发起调用的客户端 id 用于保持顺序
+                 * \param call 执行 RunHandler 并发送应答
+                 * \param ordered kEvent 模式下强制保持同一客户端的顺序 stream 方法的帧需要
+                 * \return kPoll 模式下队列已满时返回 kMaxSamplesExceeded call 不会执行 由调用方回复错误
+                 */
+                ara::core::Result<void> Dispatch(uint16_t client, MethodCall call, bool ordered = false);
+
+                /**
+                 * \brief kPoll 模式下处理下一个调用
+                 * \return 处理了一个调用时为 true 队列为空时为 false 非 kPoll 模式返回 kWrongMethodCallProcessingMode
+                 *
+                 * @ID{[SWS_CM_00199]}
+                 */
+                ara::core::Future<bool> ProcessNextMethodCall();
+
+                MethodCallProcessingMode GetMode() const { return mode_; }
+
+                /**
+                 * \brief kPoll 模式下等待处理的调用数
+                 */
+                size_t Pending() const;
+
+                /**
+                 * \brief kPoll 模式下最多等待处理的调用数 应用处理不过来时新的调用被拒绝 内存不会无限增长
+                 */
+                void SetPollQueueLimit(size_t limit);
+
+            private:
+                uint64_t strandKey(uint32_t lane) const;
+
+                const MethodCallProcessingMode mode_;
+                const bool orderPerClient_;
+                WorkerPool &pool_;
+                const uint64_t id_;                 // strand key 的高位 不同 Skeleton 之间互不阻塞
+                mutable std::mutex pollMutex_;
+                std::deque<MethodCall> pollQueue_;
+                size_t pollQueueLimit_;
+            };
+
+        } // namespace skeleton
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _METHOD_CALL_DISPATCHER_H_
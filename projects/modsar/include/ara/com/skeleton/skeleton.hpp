@@ -1,25 +1,177 @@
 #ifndef _SKELETON_HPP_
 #define _SKELETON_HPP_
 #include <memory>
+#include <unordered_map>
+#include <vector>
 #include "instance_identifer.h"
+#include "ara/com/local/local_service.hpp"
+#include "ara/com/routing/service_offer.h"
+#include "ara/com/skeleton/method_call_dispatcher.h"
+#include "ara/com/record/recorder.h"
+#include "ara/com/someip/someip_connection.h"
+#include "ara/com/someip/someip_service_binding.h"
+#include "ara/com/trace/trace_payload.hpp"
+#include "ara/com/trace/trace_registry.h"
 
 class Skeleton : public Adapter
 {
 public:
+     /**
+      * \param mode 方法调用的处理方式 每个 Skeleton 实例单独指定
+      * \param orderPerClient kEvent 模式下是否保持同一客户端的调用顺序
+      *
+      * @ID{[SWS_CM_00130]}
+      */
+     explicit Skeleton(ara::com::MethodCallProcessingMode mode = ara::com::MethodCallProcessingMode::kEvent,
+                       bool orderPerClient = false)
+         : dispatcher_(std::make_shared<ara::com::skeleton::MethodCallDispatcher>(mode, orderPerClient))
+     {
+     }
+     /**
+      * 析构时撤回全部 binding registry 不再持有实例
+      */
+     virtual ~Skeleton()
+     {
+          serviceOffer_.StopOffer();
+     }
      /**
       * OfferService 需要传入 service_ideneifer 和 methoid 不？
       * ap 规范里 OfferService(void)
-      * 具体实现可以这样
+      * 在 ServiceOffer 里的每个 binding 上 Offer 便宜的 binding 先可用
+      */
+     virtual void OfferService()
+     {
+          prepareOffer();
+          serviceOffer_.Offer();
+     }
+     /**
+      * 先撤回网络 binding 再撤回同进程 binding
+      */
+     void StopOfferService() { serviceOffer_.StopOffer(); }
+     /**
+      * 启动时一次 Offer 多个 skeleton 同一种 binding 的实例交给 IServiceBinding::OfferBatch 合并处理
+      * 已经 Offer 的 skeleton 被跳过 失败时撤回这一批 返回该错误
       */
-     virtual void OfferService();
+     static ara::core::Result<void> OfferServices(const std::vector<Skeleton *> &skeletons)
+     {
+          std::vector<ara::com::routing::ServiceOffer *> offers;
+          for (Skeleton *skeleton : skeletons)
+          {
+               skeleton->prepareOffer();
+               offers.push_back(&skeleton->serviceOffer_);
+          }
+          return ara::com::routing::OfferServices(offers);
+     }
+     /**
+      * 部署配置里的其他 binding (共享内存等) 在 OfferService 之前添加 同一种 binding 只能有一个
+      */
+     bool AddServiceBinding(std::shared_ptr<ara::com::routing::IServiceBinding> binding)
+     {
+          return serviceOffer_.AddBinding(std::move(binding));
+     }
+     /**
+      * 已经 Offer 的 binding 集合
+      */
+     ara::com::routing::BindingMask GetOfferedBindings() const { return serviceOffer_.Offered(); }
      void SendResponse(message data);
      /**
       * 类里绑定了 identifer 注册时如有需要直接使用
+      * ordered 为 true 时同一客户端的请求按到达顺序处理 (stream 方法)
+      */
+     void RegisterServiceMethod(method_t method_id, message_handler_t handler, bool ordered = false)
+     {
+          // handler 不在 binding 的接收线程执行 按 MethodCallProcessingMode 交给 dispatcher
+          std::shared_ptr<ara::com::skeleton::MethodCallDispatcher> dispatcher = dispatcher_;
+          std::shared_ptr<ara::com::trace::TraceChannel> trace = traceChannel(method_id);
+          registerTransportHandler(method_id, [dispatcher, handler, ordered, trace](const std::shared_ptr<Message> &request)
+                                   { // 没有启用追踪时也去掉客户端附上的追踪信息 否则反序列化会因为多出的字节失败
+                                     ara::com::trace::TraceContext context = ara::com::trace::ReceiveMessage(trace.get(), *request);
+                                     ara::com::record::RecordMessage(ara::com::record::RecordKind::kRequest, *request);
+                                     ara::core::Result<void> dispatched = dispatcher->Dispatch(
+                                         request->get_client(), [handler, request, context, trace]
+                                         { ara::com::trace::RunTraced(context, [&handler, &request]
+                                                                      { handler(request); }); },
+                                         ordered);
+                                     if (!dispatched.HasValue())
+                                     { // kPoll 队列已满 直接回复错误 客户端不用等到超时
+                                       ara::com::someip::SomeIpConnection::Instance().SendErrorResponse(request);
+                                     } });
+     }
+     /**
+      * 在默认统计页上启用方法的时延追踪 在 RegisterServiceMethod 之前调用
+      * 请求去掉末尾的追踪信息后交给 handler handler 里 SendResponse 时 binding 用 trace::AppendResponseTrailer 附上应答的追踪信息
+      * 返回 false 表示没有设置默认统计页或槽位用完
+      */
+     bool EnableTracing(method_t method_id, const std::string &name, uint16_t service, uint16_t instance)
+     {
+          std::shared_ptr<ara::com::trace::TraceChannel> channel =
+              ara::com::trace::CreateTraceChannel(ara::com::trace::ChannelRole::kMethodServer, name, service, instance, method_id);
+          if (!channel)
+          {
+               return false;
+          }
+          traceChannels_[method_id] = channel;
+          return true;
+     }
+     /**
+      * 没有启用追踪时返回 nullptr
+      */
+     std::shared_ptr<ara::com::trace::TraceChannel> GetTraceChannel(method_t method_id) const { return traceChannel(method_id); }
+     /**
+      * kPoll 模式下处理一个等待中的方法调用 其它模式返回 kWrongMethodCallProcessingMode
+      *
+      * @ID{[SWS_CM_00199]}
+      */
+     ara::core::Future<bool> ProcessNextMethodCall() { return dispatcher_->ProcessNextMethodCall(); }
+     ara::com::MethodCallProcessingMode GetMethodCallProcessingMode() const { return dispatcher_->GetMode(); }
+     /**
+      * 同进程 binding 用它创建 local::LocalService 本地调用和网络来的调用在同一个执行器上按相同模式处理
+      */
+     std::shared_ptr<ara::com::skeleton::MethodCallDispatcher> GetMethodCallDispatcher() const { return dispatcher_; }
+     /**
+      * 部署配置里有同进程 binding 时在注册方法和 event 之前调用 OfferService 时一并 Offer
+      * 同进程的 proxy 经 LocalServiceRegistry 找到它 EventSkeleton::Register 在上面注册 event
+      */
+     std::shared_ptr<ara::com::local::LocalService> EnableLocalBinding(uint16_t serviceId, uint16_t instanceId)
+     {
+          if (!localService_)
+          {
+               localService_ = std::make_shared<ara::com::local::LocalService>(serviceId, instanceId, dispatcher_);
+               serviceOffer_.AddBinding(std::make_shared<ara::com::routing::LocalServiceBinding>(localService_));
+          }
+          return localService_;
+     }
+     /**
+      * 没有启用同进程 binding 时返回 nullptr
+      */
+     std::shared_ptr<ara::com::local::LocalService> GetLocalService() const { return localService_; }
+
+protected:
+     /**
+      * Offer 之前调用 派生的 binding 在这里用 AddServiceBinding 添加自己 可能调用多次
       */
-     void RegisterServiceMethod(method_t method_id, message_handler_t handler);
+     virtual void prepareOffer() {}
 
 private:
+     /**
+      * binding 收到请求后直接调用 handler 具体实现在 binding 里
+      * SOME/IP binding 登记到进程共用的 someip::SomeIpConnection 不再每个 Skeleton 创建一个 vsomeip application
+      */
+     void registerTransportHandler(method_t method_id, message_handler_t handler);
+
+     std::shared_ptr<ara::com::trace::TraceChannel> traceChannel(method_t method_id) const
+     {
+          auto found = traceChannels_.find(method_id);
+          return found != traceChannels_.end() ? found->second : nullptr;
+     }
+
      std::shared_ptr<stub> stub_;
+     // binding 回调可能晚于 Skeleton 析构 用 shared_ptr 保持 dispatcher 存活
+     std::shared_ptr<ara::com::skeleton::MethodCallDispatcher> dispatcher_;
+     // 只在注册方法之前修改
+     std::unordered_map<method_t, std::shared_ptr<ara::com::trace::TraceChannel>> traceChannels_;
+     std::shared_ptr<ara::com::local::LocalService> localService_;
+     ara::com::routing::ServiceOffer serviceOffer_; // 同进程 binding 和 prepareOffer 添加的 binding
 
      InstanceIdentifer service_identifer; // skeleton 里面可以有很多Method 因此不用指定Methodid这里
 };
@@ -27,10 +179,23 @@ private:
 class VSomeipSkeleton : public Skeleton
 {
 public:
-     void OfferService()
+     InstanceIdentifer service_identifer;
+
+protected:
+     /**
+      * SOME/IP binding 排在同进程 binding 之后 本地 proxy 不用等 SD
+      * Skeleton::OfferServices 批量 Offer 时全部实例合并进同一批 SD 消息
+      */
+     void prepareOffer() override
      {
-          OfferServiceUsingVsomeip(serviceid, instanceid);
+          if (!someIpBinding_)
+          {
+               someIpBinding_ = std::make_shared<ara::com::someip::SomeIpServiceBinding>(serviceid, instanceid);
+               AddServiceBinding(someIpBinding_);
+          }
      }
-     InstanceIdentifer service_identifer;
+
+private:
+     std::shared_ptr<ara::com::someip::SomeIpServiceBinding> someIpBinding_;
 };
 #endif // _SKELETON_HPP_
\ No newline at end of file
@@ -0,0 +1,113 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 方法调用的 work-stealing 线程池
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _WORKER_POOL_H_
+#define _WORKER_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace ara
+{
+    namespace com
+    {
+        namespace skeleton
+        {
+            /**
+             * \brief work-stealing 线程池
+             *
+             * 每个 worker 有自己的任务队列 worker 内提交的任务进自己的队列 外部提交轮询分配
+             * worker 先从自己队列尾部取任务 空了再从其它 worker 队列头部偷
+             * SubmitOrdered 把相同 key 的任务串成一个 strand 同一 key 的任务按提交顺序逐个执行 不同 key 之间并行
+             */
+            class WorkerPool
+            {
+            public:
+                using Task = std::function<void()>;
+
+                /**
+                 * \param threads worker 数 0 表示取 CPU 核数
+                 */
+                explicit WorkerPool(size_t threads = 0);
+
+                /**
+                 * \brief 停止并等待所有 worker 退出 未执行的任务被丢弃
+                 */
+                ~WorkerPool();
+
+                WorkerPool(const WorkerPool &) = delete;
+                WorkerPool &operator=(const WorkerPool &) = delete;
+
+                /**
+                 * \brief 提交一个可以与其它任务并行执行的任务
+                 */
+                void Submit(Task task);
+
+                /**
+                 * \brief 提交一个与相同 key 的任务保持顺序的任务
+                 * \param key 顺序域 例如客户端 id
+                 */
+                void SubmitOrdered(uint64_t key, Task task);
+
+                size_t Size() const { return workers_.size(); }
+
+                /**
+                 * \brief 进程内共享的默认线程池
+                 */
+                static WorkerPool &Default();
+
+            private:
+                struct alignas(64) Worker
+                {
+                    std::mutex mutex;
+                    std::deque<Task> tasks;
+                    std::thread thread;
+                };
+
+                struct Strand
+                {
+                    std::deque<Task> tasks;
+                };
+
+                struct StrandShard
+                {
+                    std::mutex mutex;
+                    std::unordered_map<uint64_t, Strand> strands;
+                };
+
+                static constexpr size_t kStrandShards = 64;
+
+                void run(size_t index);
+                bool popLocal(size_t index, Task &task);
+                bool steal(size_t index, Task &task);
+                void runStrand(uint64_t key);
+
+            private:
+                std::vector<std::unique_ptr<Worker>> workers_;
+                std::atomic<size_t> nextWorker_;  // 外部提交的轮询位置
+                std::atomic<size_t> pending_;     // 所有队列中的任务总数
+                std::atomic<size_t> sleepers_;    // 正在等待的 worker 数 没有时提交不需要唤醒
+                std::atomic<bool> stop_;
+                std::mutex sleepMutex_;
+                std::condition_variable sleepCond_;
+                StrandShard strandShards_[kStrandShards];
+            };
+
+        } // namespace skeleton
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _WORKER_POOL_H_
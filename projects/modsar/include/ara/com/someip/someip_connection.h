@@ -0,0 +1,347 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 进程唯一的 vsomeip application 所有 proxy 和 skeleton 复用一次路由握手和一组线程
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _SOMEIP_CONNECTION_H_
+#define _SOMEIP_CONNECTION_H_
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "ara/core/result.h"
+#include "ara/com/someip/someip_dispatch_table.hpp"
+#include "ara/com/tp/tp_reassembler.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace someip
+        {
+            using AvailabilityHandler = std::function<void(uint16_t serviceId, uint16_t instanceId, bool available)>;
+
+            struct ServiceInstance
+            {
+                uint16_t serviceId;
+                uint16_t instanceId;
+            };
+
+            struct EventSubscription
+            {
+                uint16_t eventgroupId;
+                uint16_t eventId;
+            };
+
+            /**
+             * \brief 重组完成的大消息 直接引用重组缓冲区 见 EventProxy::EnableTp
+             */
+            using TpReassembledHandler = std::function<void(const std::shared_ptr<const tp::TpPayload> &payload)>;
+
+            struct TpSettings
+            {
+                tp::TpReassemblerConfig reassembly;
+                size_t maxSegmentLength = tp::kTpDefaultMaxSegmentLength; ///< 每条消息最多携带的数据 向下取整到 16 的倍数
+            };
+
+            /**
+             * \brief 进程唯一的 SOME/IP 连接
+             *
+             * 原来每个 Proxy 创建一个 VsomeipClientApp 每个 Skeleton 创建一个 VsomeipServerApp
+             * 每个 application 都要和路由管理器握手 还各自带 io 线程和 dispatch 线程
+             * 这里整个进程只创建一个 vsomeip::application 向 vsomeip 只注册一个通配的 message handler
+             * 收到的消息按 service instance method 查 SomeIpDispatchTable 交给对应的 proxy 或 skeleton
+             *
+             * request / offer / subscribe 按引用计数合并 最后一个使用者释放时才通知 vsomeip
+             * 一个 proxy 析构不会影响同一实例的其他 proxy
+             * handler 都在 vsomeip 的 dispatch 线程上执行 耗时的处理要转给 MethodCallDispatcher
+             *
+             * 所有 proxy 共用一个 vsomeip client id vsomeip 发送请求时还会改写 session
+             * 请求因此经 SendRequest 发出 连接记下 vsomeip 写入的 session 和发出请求的 handler
+             * 应答只交给这个 handler 交付前把 session 换回调用方自己的 session 各个 proxy 的 CallSlotTable 互不干扰
+             * vsomeip 头文件只在 cpp 里使用
+             */
+            class SomeIpConnection
+            {
+            public:
+                static constexpr uint16_t kAnyInstance = 0xFFFF;
+
+                static SomeIpConnection &Instance();
+
+                SomeIpConnection(const SomeIpConnection &) = delete;
+                SomeIpConnection &operator=(const SomeIpConnection &) = delete;
+
+                /**
+                 * \brief vsomeip 配置里的 application 名字 要在第一次 Acquire 之前设置 默认取 VSOMEIP_APPLICATION_NAME
+                 */
+                void SetApplicationName(const std::string &name);
+
+                /**
+                 * \brief proxy 或 skeleton 创建时调用 第一个使用者创建并启动 application
+                 * 启动前登记的 request offer subscribe 在启动时一并交给 vsomeip
+                 * \return application 初始化失败时返回 kNetworkBindingFailure
+                 */
+                ara::core::Result<void> Acquire();
+
+                /**
+                 * \brief 和 Acquire 成对调用 最后一个使用者释放时停止 application 并等待线程退出
+                 * 不能在 handler 里调用
+                 */
+                void Release();
+
+                bool IsRunning() const;
+
+                /**
+                 * \brief skeleton 注册请求 handler 同一个 service instance method 只能有一个
+                 * \return 已被注册时返回 kCouldNotExecute
+                 */
+                ara::core::Result<HandlerId> RegisterRequestHandler(uint16_t serviceId, uint16_t instanceId, uint16_t methodId,
+                                                                    SomeIpDispatchTable<Message>::Handler handler);
+
+                /**
+                 * \brief proxy 注册应答或事件通知的 handler methodId 为 method id 或 event id
+                 */
+                HandlerId RegisterResponseHandler(uint16_t serviceId, uint16_t instanceId, uint16_t methodId,
+                                                  SomeIpDispatchTable<Message>::Handler handler);
+
+                /**
+                 * \brief 一次注册一个 proxy 的全部应答和事件 handler 分发表只重建一次
+                 * \return 与 handlers 一一对应的 id
+                 */
+                std::vector<HandlerId> RegisterResponseHandlers(uint16_t serviceId, uint16_t instanceId,
+                                                                std::vector<std::pair<uint16_t, SomeIpDispatchTable<Message>::Handler>> handlers);
+
+                void UnregisterHandler(HandlerId id);
+
+                void UnregisterHandlers(const std::vector<HandlerId> &ids);
+
+                /**
+                 * \brief 实例可用状态变化时调用 handler 注册时已经知道状态的会立即调用一次
+                 * instanceId 为 kAnyInstance 时接收该服务全部实例的变化
+                 */
+                HandlerId RegisterAvailabilityHandler(uint16_t serviceId, uint16_t instanceId, AvailabilityHandler handler);
+
+                void UnregisterAvailabilityHandler(HandlerId id);
+
+                void RequestService(uint16_t serviceId, uint16_t instanceId);
+
+                void ReleaseService(uint16_t serviceId, uint16_t instanceId);
+
+                void OfferService(uint16_t serviceId, uint16_t instanceId) { OfferServices({ServiceInstance{serviceId, instanceId}}); }
+
+                void StopOfferService(uint16_t serviceId, uint16_t instanceId) { StopOfferServices({ServiceInstance{serviceId, instanceId}}); }
+
+                /**
+                 * \brief 启动时一次 Offer 多个 skeleton 只拿一次锁 连续交给 vsomeip
+                 * vsomeip 把同一个 SD 周期里的 Offer 条目合并进同一条 SD 消息 逐个 Offer 时条目会分散到多个周期
+                 */
+                void OfferServices(const std::vector<ServiceInstance> &services);
+
+                void StopOfferServices(const std::vector<ServiceInstance> &services);
+
+                /**
+                 * \brief 订阅 eventgroup 里的一个事件 同一事件多个 proxy 订阅时只向 vsomeip 订阅一次
+                 */
+                void SubscribeEvent(uint16_t serviceId, uint16_t instanceId, uint16_t eventgroupId, uint16_t eventId)
+                {
+                    SubscribeEvents(serviceId, instanceId, {EventSubscription{eventgroupId, eventId}});
+                }
+
+                void UnsubscribeEvent(uint16_t serviceId, uint16_t instanceId, uint16_t eventgroupId, uint16_t eventId)
+                {
+                    UnsubscribeEvents(serviceId, instanceId, {EventSubscription{eventgroupId, eventId}});
+                }
+
+                /**
+                 * \brief 一次订阅一个 proxy 的全部事件
+                 * 先 request 全部事件 再对每个 eventgroup 只 subscribe 一次 20 个事件在同一 eventgroup 时只产生一个 SubscribeEventgroup 条目
+                 */
+                void SubscribeEvents(uint16_t serviceId, uint16_t instanceId, const std::vector<EventSubscription> &events);
+
+                void UnsubscribeEvents(uint16_t serviceId, uint16_t instanceId, const std::vector<EventSubscription> &events);
+
+                /**
+                 * \brief skeleton Offer 的事件 和 OfferServices 一样按引用计数合并 在 OfferServices 之前调用
+                 */
+                void OfferEvents(uint16_t serviceId, uint16_t instanceId, const std::vector<EventSubscription> &events);
+
+                void StopOfferEvents(uint16_t serviceId, uint16_t instanceId, const std::vector<EventSubscription> &events);
+
+                /**
+                 * \brief 向事件的全部订阅者发送 data 整体移交给 payload
+                 * \return application 没有运行时返回 kServiceNotAvailable
+                 */
+                ara::core::Result<void> Notify(uint16_t serviceId, uint16_t instanceId, uint16_t eventId, std::vector<uint8_t> data);
+
+                std::shared_ptr<Message> CreateRequest(uint16_t serviceId, uint16_t instanceId, uint16_t methodId, bool reliable) const;
+
+                std::shared_ptr<Message> CreateResponse(const std::shared_ptr<Message> &request) const;
+
+                /**
+                 * \brief 请求没有交给 handler 时回复 E_NOT_OK 的错误应答 不需要应答的请求不回复
+                 * \return application 没有运行时返回 kServiceNotAvailable
+                 */
+                ara::core::Result<void> SendErrorResponse(const std::shared_ptr<Message> &request);
+
+                /**
+                 * \brief 发送需要应答的请求 应答只交给 responseHandler
+                 * 请求里的 session 是调用方自己的 session 交付应答时换回这个值 vsomeip 实际使用的 session 对调用方不可见
+                 * \param responseHandler 调用方为该 service instance method 注册的应答 handler
+                 * \return application 没有运行时返回 kServiceNotAvailable
+                 */
+                ara::core::Result<void> SendRequest(const std::shared_ptr<Message> &request, HandlerId responseHandler);
+
+                /**
+                 * \brief 一次发出 RequestPipeline 合并的一批请求 只取一次 application 的锁
+                 * 每条请求发出后立即登记应答 handler 和逐条 SendRequest 的语义相同
+                 * \param responseHandlers 与 requests 一一对应
+                 * \return application 没有运行时返回 kServiceNotAvailable 一条也不发送
+                 */
+                ara::core::Result<void> SendRequests(const std::vector<std::shared_ptr<Message>> &requests,
+                                                     const std::vector<HandlerId> &responseHandlers);
+
+                /**
+                 * \brief 发送应答 fire and forget 请求等不需要认领应答的消息
+                 * \return application 没有运行时返回 kServiceNotAvailable
+                 */
+                ara::core::Result<void> Send(const std::shared_ptr<Message> &message);
+
+                /**
+                 * \brief 按消息头的 service instance method 查分发表 vsomeip 的通配 handler 调用它
+                 * 应答和错误只交给 SendRequest 登记的 handler 没有登记的先暂存 等 SendRequest 认领
+                 * \return 执行的 handler 个数
+                 */
+                size_t Dispatch(const std::shared_ptr<Message> &message);
+
+                /**
+                 * \brief 在第一次 EnableTp 之前调用 之后的修改不生效
+                 */
+                void SetTpSettings(const TpSettings &settings);
+
+                /**
+                 * \brief 部署配置为 SOME/IP-TP 的方法或事件 两端都要配置 和 vsomeip 配置里的 someip-tp 一样按 id 约定
+                 *
+                 * 这些 id 的消息经 tp::SegmentPayload 分段 每段的 Message Type 带 tp::kTpFlag payload 以 4 字节 TP 头部开头
+                 * 一条消息的全部分段使用同一个 session 请求和事件的 session 由连接分配 应答沿用请求的 client 和 session
+                 * vsomeip 只改写不带 TP 标志的请求 分段的头部原样发出 事件分段以通知消息经 send 发出
+                 * 接收端在 Dispatch 里按 service instance method client session 和消息类型用 tp::TpReassembler 重组
+                 * 相邻消息的分段乱序到达也不会混在一起 重组完成后去掉 TP 标志再按普通消息分发
+                 * 没有启用 TP 的 id 收到带 TP 标志的消息时丢弃 启用了 TP 的 id 收到不带标志的消息时按普通消息分发
+                 * 第一次调用时才创建重组缓冲区 没有 TP 的进程不占内存
+                 * \param reassembled 不为空时重组好的 payload 直接交给它 不再拷贝成消息分发
+                 */
+                void EnableTp(uint16_t serviceId, uint16_t instanceId, uint16_t methodId, TpReassembledHandler reassembled = nullptr);
+
+                void DisableTp(uint16_t serviceId, uint16_t instanceId, uint16_t methodId);
+
+                /**
+                 * \brief 重组的统计 没有启用 TP 时全为 0
+                 */
+                tp::TpStatistics GetTpStatistics() const;
+
+                size_t HandlerCount() const { return handlers_.Size(); }
+
+            private:
+                struct PendingCall
+                {
+                    HandlerId handler;
+                    uint16_t session; // 调用方自己的 session
+                };
+
+                // SendRequest 登记之前到达的应答最多暂存的条数 超出时丢弃最早的 调用方的超时负责收尾
+                static constexpr size_t kMaxEarlyResponses = 64;
+
+                struct Availability
+                {
+                    HandlerId id;
+                    uint16_t serviceId;
+                    uint16_t instanceId;
+                    AvailabilityHandler handler;
+                };
+
+                SomeIpConnection();
+                ~SomeIpConnection();
+
+                static uint64_t keyOf(uint16_t serviceId, uint16_t instanceId, uint16_t id = 0)
+                {
+                    return (static_cast<uint64_t>(serviceId) << 32) | (static_cast<uint64_t>(instanceId) << 16) | id;
+                }
+
+                void onAvailability(uint16_t serviceId, uint16_t instanceId, bool available);
+
+                struct Application; // 包装 vsomeip::application 只在 cpp 里定义
+
+                // 发出请求并登记应答 handler 应答在 send 返回前已经到达时在调用线程上交付
+                void sendRequest(Application &application, const std::shared_ptr<Message> &request, HandlerId responseHandler);
+
+                // 交给发出请求的 handler 交付前换回调用方的 session handler 已经注销时返回 false
+                bool deliver(const std::shared_ptr<Message> &response, const PendingCall &call);
+
+                // 撤销这些 handler 还在等待的请求
+                void forgetCalls(const std::vector<HandlerId> &ids);
+
+                // 引用计数从 0 变为 1 时返回 true
+                static bool retain(std::unordered_map<uint64_t, uint32_t> &counts, uint64_t key);
+
+                // 引用计数变为 0 时返回 true 没有记录时返回 false
+                static bool releaseCount(std::unordered_map<uint64_t, uint32_t> &counts, uint64_t key);
+
+                // 启用了 TP 时返回 true reassembled 不为空时取出重组 handler
+                bool tpRouteOf(uint16_t serviceId, uint16_t instanceId, uint16_t methodId, TpReassembledHandler *reassembled) const;
+
+                // 分段发送 请求的 client 和 session 写回 message 调用方据此登记应答
+                void sendSegmented(Application &application, const std::shared_ptr<Message> &message);
+
+                void notifySegmented(Application &application, uint16_t serviceId, uint16_t instanceId, uint16_t eventId,
+                                     const std::vector<uint8_t> &data);
+
+                uint16_t nextTpSession();
+
+                // 重组 TP 分段 消息完整时把 payload 换成重组结果
+                // 返回 false 时消息已经处理完 (还不完整 被丢弃 或已交给 reassembled) delivered 为交给 reassembled 的次数
+                bool reassemble(const std::shared_ptr<Message> &message, size_t &delivered);
+
+                mutable std::mutex mutex_; // 保护下面的引用计数和可用状态 不保护分发表
+                std::string name_;
+                std::shared_ptr<Application> application_;
+                std::thread thread_; // 运行 application::start
+                uint32_t users_;
+                std::unordered_map<uint64_t, uint32_t> requested_;
+                std::unordered_map<uint64_t, uint32_t> offered_;
+                std::unordered_map<uint64_t, uint32_t> offeredEvents_;    // 键同 subscribedEvents_
+                std::unordered_map<uint64_t, uint32_t> subscribedEvents_; // 键为 service instance eventgroup event
+                std::unordered_map<uint64_t, uint32_t> subscribedGroups_; // 键的 id 部分为 eventgroup id
+                std::unordered_map<uint64_t, bool> available_; // 键的 id 部分为 0
+                std::vector<Availability> availabilityHandlers_;
+                HandlerId nextAvailabilityId_;
+
+                std::mutex callsMutex_; // 保护 calls_ 和 early_ 不和 mutex_ 嵌套
+                std::unordered_map<uint64_t, PendingCall> calls_; // 键为 service instance method 和 vsomeip 写入的 session
+                std::deque<std::pair<uint64_t, std::shared_ptr<Message>>> early_; // 在 SendRequest 登记前到达的应答
+
+                mutable std::mutex tpMutex_; // 保护 tpSettings_ tpRoutes_ reassembler_ 只在启用了 TP 时使用
+                std::atomic<uint32_t> tpSession_; // 分段发出的请求和事件的 session
+                std::atomic<bool> tpEnabled_; // 没有启用 TP 时收发都不加锁
+                TpSettings tpSettings_;
+                std::unordered_map<uint64_t, TpReassembledHandler> tpRoutes_; // 键为 service instance method
+                std::unique_ptr<tp::TpReassembler> reassembler_;
+
+                SomeIpDispatchTable<Message> handlers_;
+            };
+
+        } // namespace someip
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _SOMEIP_CONNECTION_H_
@@ -0,0 +1,370 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 进程内所有 proxy 和 skeleton 共用的 SOME/IP 消息分发表 按 service instance method 找 handler
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _SOMEIP_DISPATCH_TABLE_HPP_
+#define _SOMEIP_DISPATCH_TABLE_HPP_
+
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "ara/com/utils/rcu.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace someip
+        {
+            using HandlerId = uint64_t;
+
+            constexpr HandlerId kInvalidHandlerId = 0;
+
+            /**
+             * \brief handler 接收哪一方向的消息
+             * 同进程里同一个服务可能既有 skeleton 又有 proxy 请求和应答的 method id 相同 需要分开
+             */
+            enum class HandlerRole : uint8_t
+            {
+                kServer = 0, // 请求 交给 skeleton
+                kClient = 1  // 应答 错误和通知 交给 proxy
+            };
+
+            /**
+             * \brief 分发表的键 role 占第 48 位 其余依次为 service instance method
+             */
+            inline uint64_t DispatchKeyOf(HandlerRole role, uint16_t serviceId, uint16_t instanceId, uint16_t methodId)
+            {
+                return (static_cast<uint64_t>(role) << 48) | (static_cast<uint64_t>(serviceId) << 32) |
+                       (static_cast<uint64_t>(instanceId) << 16) | methodId;
+            }
+
+            /**
+             * \brief 扁平的分发表
+             *
+             * 注册和注销在 offer / subscribe 时发生 这时按全部注册重建一张开放寻址的表 经 RCU 换上
+             * 接收路径只在 RCU 读区里按键的哈希找到 cache line 对齐的桶 比较桶里的 4 个键 不加锁
+             * 表的负载不超过一半 绝大多数查找只碰一条 cache line
+             * 同一个键的 handler 在表里连续存放 分发时顺序执行
+             *
+             * 一个键可以有多个 handler 同一实例的多个 proxy 都会收到通知
+             * 应答只属于发出请求的那个 proxy 由 DispatchTo 按 handler id 交给它
+             * exclusive 的注册独占一个键 skeleton 的请求 handler 用它 防止两个 skeleton 抢同一个方法
+             */
+            template <typename MessageType>
+            class SomeIpDispatchTable
+            {
+            public:
+                using Handler = std::function<void(const std::shared_ptr<MessageType> &)>;
+
+                SomeIpDispatchTable() : table_(build(Registrations())), nextId_(kInvalidHandlerId + 1) {}
+
+                SomeIpDispatchTable(const SomeIpDispatchTable &) = delete;
+                SomeIpDispatchTable &operator=(const SomeIpDispatchTable &) = delete;
+
+                /**
+                 * \return 与已有的注册冲突时返回 kInvalidHandlerId
+                 */
+                HandlerId Add(uint64_t key, Handler handler, bool exclusive)
+                {
+                    std::vector<std::pair<uint64_t, Handler>> entries;
+                    entries.emplace_back(key, std::move(handler));
+                    const std::vector<HandlerId> ids = AddBatch(std::move(entries), exclusive);
+                    return ids.empty() ? kInvalidHandlerId : ids.front();
+                }
+
+                /**
+                 * \brief 一次注册多个 handler 只重建一次表 启动时一个 proxy 的全部事件用它注册
+                 * \return 与 entries 一一对应的 id 任何一个冲突时都不注册 返回空
+                 */
+                std::vector<HandlerId> AddBatch(std::vector<std::pair<uint64_t, Handler>> entries, bool exclusive)
+                {
+                    std::lock_guard<std::mutex> lock(writeMutex_);
+                    std::unordered_set<uint64_t> batch; // 同一批里的重复键按 exclusive 规则同样冲突
+                    for (const std::pair<uint64_t, Handler> &entry : entries)
+                    {
+                        auto existing = registrations_.find(entry.first);
+                        if ((existing != registrations_.end() && (exclusive || existing->second.front().exclusive)) ||
+                            (!batch.insert(entry.first).second && exclusive))
+                        {
+                            return std::vector<HandlerId>();
+                        }
+                    }
+                    std::vector<HandlerId> ids;
+                    ids.reserve(entries.size());
+                    for (std::pair<uint64_t, Handler> &entry : entries)
+                    {
+                        const HandlerId id = nextId_++;
+                        registrations_[entry.first].push_back(Registration{id, exclusive, std::make_shared<const Handler>(std::move(entry.second))});
+                        keys_.emplace(id, entry.first);
+                        ids.push_back(id);
+                    }
+                    if (!ids.empty())
+                    {
+                        table_.Store(build(registrations_));
+                    }
+                    return ids;
+                }
+
+                /**
+                 * \brief 注销后正在进行的分发仍可能调用一次该 handler handler 在旧表释放时析构
+                 * \return id 不存在时返回 false
+                 */
+                bool Remove(HandlerId id)
+                {
+                    return RemoveBatch(std::vector<HandlerId>{id}) != 0;
+                }
+
+                /**
+                 * \brief 一次注销多个 handler 只重建一次表
+                 * \return 实际注销的个数
+                 */
+                size_t RemoveBatch(const std::vector<HandlerId> &ids)
+                {
+                    std::lock_guard<std::mutex> lock(writeMutex_);
+                    size_t removed = 0;
+                    for (HandlerId id : ids)
+                    {
+                        auto key = keys_.find(id);
+                        if (key == keys_.end())
+                        {
+                            continue;
+                        }
+                        std::vector<Registration> &entries = registrations_[key->second];
+                        for (auto entry = entries.begin(); entry != entries.end(); ++entry)
+                        {
+                            if (entry->id == id)
+                            {
+                                entries.erase(entry);
+                                break;
+                            }
+                        }
+                        if (entries.empty())
+                        {
+                            registrations_.erase(key->second);
+                        }
+                        keys_.erase(key);
+                        ++removed;
+                    }
+                    if (removed != 0)
+                    {
+                        table_.Store(build(registrations_));
+                    }
+                    return removed;
+                }
+
+                /**
+                 * \brief 在调用线程上依次执行该键的全部 handler handler 里可以注册和注销
+                 * \return 执行的 handler 个数 0 表示没有注册 消息被丢弃
+                 */
+                size_t Dispatch(uint64_t key, const std::shared_ptr<MessageType> &message) const
+                {
+                    ara::com::utils::RcuDomain::ReadGuard guard;
+                    const FlatTable *table = table_.Load();
+                    const Slot slot = table->Find(key);
+                    const Handler *const *handler = table->handlers.data() + slot.first;
+                    for (uint32_t i = 0; i < slot.count; ++i)
+                    {
+                        (*handler[i])(message);
+                    }
+                    return slot.count;
+                }
+
+                /**
+                 * \brief 只执行该键下 id 对应的 handler
+                 * \return handler 已经注销时返回 false 消息被丢弃
+                 */
+                bool DispatchTo(uint64_t key, HandlerId id, const std::shared_ptr<MessageType> &message) const
+                {
+                    ara::com::utils::RcuDomain::ReadGuard guard;
+                    const FlatTable *table = table_.Load();
+                    const Slot slot = table->Find(key);
+                    for (uint32_t i = slot.first; i < slot.first + slot.count; ++i)
+                    {
+                        if (table->ids[i] == id)
+                        {
+                            (*table->handlers[i])(message);
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+
+                size_t HandlerCount(uint64_t key) const
+                {
+                    ara::com::utils::RcuDomain::ReadGuard guard;
+                    return table_.Load()->Find(key).count;
+                }
+
+                size_t Size() const
+                {
+                    std::lock_guard<std::mutex> lock(writeMutex_);
+                    return keys_.size();
+                }
+
+                /**
+                 * \brief 当前表的桶数 每个桶一条 cache line
+                 */
+                size_t BucketCount() const
+                {
+                    ara::com::utils::RcuDomain::ReadGuard guard;
+                    return table_.Load()->mask + 1;
+                }
+
+                void Clear()
+                {
+                    std::lock_guard<std::mutex> lock(writeMutex_);
+                    registrations_.clear();
+                    keys_.clear();
+                    table_.Store(build(registrations_));
+                }
+
+            private:
+                static constexpr uint64_t kEmptyKey = UINT64_MAX; // role 只用到第 48 位 合法的键不会是全 1
+                static constexpr size_t kWays = 4;
+
+                struct Registration
+                {
+                    HandlerId id;
+                    bool exclusive;
+                    std::shared_ptr<const Handler> handler;
+                };
+
+                // 按键排序 重建出的表和注册顺序无关
+                using Registrations = std::map<uint64_t, std::vector<Registration>>;
+
+                struct Slot
+                {
+                    uint32_t first;
+                    uint32_t count;
+                };
+
+                struct alignas(64) Bucket
+                {
+                    uint64_t keys[kWays];
+                    Slot slots[kWays];
+                };
+
+                struct BucketDeleter
+                {
+                    void operator()(Bucket *buckets) const { std::free(buckets); }
+                };
+
+                struct FlatTable
+                {
+                    std::unique_ptr<Bucket, BucketDeleter> buckets;
+                    size_t mask;
+                    std::vector<const Handler *> handlers;              // 同一键的 handler 连续存放
+                    std::vector<HandlerId> ids;                         // 与 handlers 一一对应
+                    std::vector<std::shared_ptr<const Handler>> owners; // 旧表释放前 handler 保持存活
+
+                    static size_t indexOf(uint64_t key, size_t mask)
+                    {
+                        uint64_t hash = key * 0x9E3779B97F4A7C15ULL;
+                        hash ^= hash >> 32;
+                        return static_cast<size_t>(hash) & mask;
+                    }
+
+                    /**
+                     * \brief 负载不超过一半 总能遇到空位 插入按顺序填桶 遇到空位即可判定不存在
+                     */
+                    Slot Find(uint64_t key) const
+                    {
+                        for (size_t index = indexOf(key, mask);; index = (index + 1) & mask)
+                        {
+                            const Bucket &bucket = buckets.get()[index];
+                            for (size_t way = 0; way < kWays; ++way)
+                            {
+                                if (bucket.keys[way] == key)
+                                {
+                                    return bucket.slots[way];
+                                }
+                                if (bucket.keys[way] == kEmptyKey)
+                                {
+                                    return Slot{0, 0};
+                                }
+                            }
+                        }
+                    }
+
+                    void Insert(uint64_t key, Slot slot)
+                    {
+                        for (size_t index = indexOf(key, mask);; index = (index + 1) & mask)
+                        {
+                            Bucket &bucket = buckets.get()[index];
+                            for (size_t way = 0; way < kWays; ++way)
+                            {
+                                if (bucket.keys[way] == kEmptyKey)
+                                {
+                                    bucket.keys[way] = key;
+                                    bucket.slots[way] = slot;
+                                    return;
+                                }
+                            }
+                        }
+                    }
+                };
+
+                static std::unique_ptr<const FlatTable> build(const Registrations &registrations)
+                {
+                    size_t bucketCount = 1;
+                    while (bucketCount * kWays < registrations.size() * 2)
+                    {
+                        bucketCount <<= 1;
+                    }
+                    void *memory = nullptr;
+                    if (posix_memalign(&memory, alignof(Bucket), bucketCount * sizeof(Bucket)) != 0)
+                    {
+                        throw std::bad_alloc();
+                    }
+                    std::unique_ptr<FlatTable> table(new FlatTable());
+                    table->buckets.reset(static_cast<Bucket *>(memory));
+                    table->mask = bucketCount - 1;
+                    for (size_t index = 0; index < bucketCount; ++index)
+                    {
+                        Bucket &bucket = table->buckets.get()[index];
+                        for (size_t way = 0; way < kWays; ++way)
+                        {
+                            bucket.keys[way] = kEmptyKey;
+                            bucket.slots[way] = Slot{0, 0};
+                        }
+                    }
+                    for (const auto &entry : registrations)
+                    {
+                        const Slot slot{static_cast<uint32_t>(table->handlers.size()), static_cast<uint32_t>(entry.second.size())};
+                        for (const Registration &registration : entry.second)
+                        {
+                            table->handlers.push_back(registration.handler.get());
+                            table->ids.push_back(registration.id);
+                            table->owners.push_back(registration.handler);
+                        }
+                        table->Insert(entry.first, slot);
+                    }
+                    return std::unique_ptr<const FlatTable>(std::move(table));
+                }
+
+                mutable std::mutex writeMutex_; // 串行化注册和换表
+                ara::com::utils::RcuPointer<FlatTable> table_;
+                Registrations registrations_;                  // 只在锁内访问
+                std::unordered_map<HandlerId, uint64_t> keys_; // 注销时按 id 找键 只在锁内访问
+                HandlerId nextId_;
+            };
+
+        } // namespace someip
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _SOMEIP_DISPATCH_TABLE_HPP_
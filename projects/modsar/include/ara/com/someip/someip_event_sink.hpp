@@ -0,0 +1,85 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief EventSkeleton 在 SOME/IP binding 上的发送端 经 SomeIpConnection 通知
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _SOMEIP_EVENT_SINK_HPP_
+#define _SOMEIP_EVENT_SINK_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "ara/core/result.h"
+#include "ara/com/routing/multi_binding_event.hpp"
+#include "ara/com/someip/someip_connection.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace someip
+        {
+            /**
+             * \brief 创建时取得连接并 Offer 该 event 析构时撤回并释放连接
+             * 远端订阅者由 vsomeip 管理 连接运行时都交给 vsomeip 没有订阅者时 vsomeip 不发送
+             */
+            template <typename T>
+            class SomeIpEventSink : public routing::EventSink<T>
+            {
+            public:
+                /**
+                 * \return 连接启动失败时返回 Acquire 的错误
+                 */
+                static ara::core::Result<std::shared_ptr<SomeIpEventSink>> Create(uint16_t serviceId, uint16_t instanceId, uint16_t eventgroupId,
+                                                                                  uint16_t eventId)
+                {
+                    ara::core::Result<void> acquired = SomeIpConnection::Instance().Acquire();
+                    if (!acquired.HasValue())
+                    {
+                        return ara::core::Result<std::shared_ptr<SomeIpEventSink>>::FromError(acquired.Error());
+                    }
+                    return ara::core::Result<std::shared_ptr<SomeIpEventSink>>::FromValue(
+                        std::shared_ptr<SomeIpEventSink>(new SomeIpEventSink(serviceId, instanceId, eventgroupId, eventId)));
+                }
+
+                ~SomeIpEventSink() override
+                {
+                    SomeIpConnection &connection = SomeIpConnection::Instance();
+                    connection.StopOfferEvents(serviceId_, instanceId_, {EventSubscription{eventgroupId_, eventId_}});
+                    connection.Release();
+                }
+
+                SomeIpEventSink(const SomeIpEventSink &) = delete;
+                SomeIpEventSink &operator=(const SomeIpEventSink &) = delete;
+
+                routing::BindingKind Kind() const override { return routing::BindingKind::kSomeIp; }
+
+                bool HasSubscribers() const override { return SomeIpConnection::Instance().IsRunning(); }
+
+                void Deliver(const std::shared_ptr<T> &, const routing::SerializedSample &serialized) override
+                {
+                    SomeIpConnection::Instance().Notify(serviceId_, instanceId_, eventId_, std::vector<uint8_t>(*serialized));
+                }
+
+            private:
+                SomeIpEventSink(uint16_t serviceId, uint16_t instanceId, uint16_t eventgroupId, uint16_t eventId)
+                    : serviceId_(serviceId), instanceId_(instanceId), eventgroupId_(eventgroupId), eventId_(eventId)
+                {
+                    SomeIpConnection::Instance().OfferEvents(serviceId_, instanceId_, {EventSubscription{eventgroupId_, eventId_}});
+                }
+
+                const uint16_t serviceId_;
+                const uint16_t instanceId_;
+                const uint16_t eventgroupId_;
+                const uint16_t eventId_;
+            };
+
+        } // namespace someip
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _SOMEIP_EVENT_SINK_HPP_
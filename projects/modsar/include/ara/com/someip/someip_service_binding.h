@@ -0,0 +1,65 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief skeleton 在 SOME/IP binding 上的 Offer 经 SomeIpConnection 交给 vsomeip
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _SOMEIP_SERVICE_BINDING_H_
+#define _SOMEIP_SERVICE_BINDING_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "ara/core/result.h"
+#include "ara/com/routing/service_offer.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace someip
+        {
+            /**
+             * \brief Offer 时取得连接 StopOffer 时释放 析构时还在 Offer 则撤回
+             * 批量 Offer 时全部实例一次交给 SomeIpConnection::OfferServices 合并进同一批 SD 消息
+             */
+            class SomeIpServiceBinding : public routing::IServiceBinding
+            {
+            public:
+                SomeIpServiceBinding(uint16_t serviceId, uint16_t instanceId)
+                    : serviceId_(serviceId), instanceId_(instanceId), offered_(false)
+                {
+                }
+
+                ~SomeIpServiceBinding() override { StopOffer(); }
+
+                SomeIpServiceBinding(const SomeIpServiceBinding &) = delete;
+                SomeIpServiceBinding &operator=(const SomeIpServiceBinding &) = delete;
+
+                routing::BindingKind Kind() const override { return routing::BindingKind::kSomeIp; }
+
+                /**
+                 * \return 连接启动失败时返回 Acquire 的错误
+                 */
+                ara::core::Result<void> Offer() override;
+
+                void StopOffer() override;
+
+                /**
+                 * \brief sameKind 里有其他实现的 SOME/IP binding 时按默认方式逐个 Offer
+                 */
+                ara::core::Result<void> OfferBatch(const std::vector<routing::IServiceBinding *> &sameKind) override;
+
+            private:
+                const uint16_t serviceId_;
+                const uint16_t instanceId_;
+                bool offered_;
+            };
+
+        } // namespace someip
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _SOMEIP_SERVICE_BINDING_H_
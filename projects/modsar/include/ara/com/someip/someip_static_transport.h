@@ -0,0 +1,133 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief aragen 生成代码的 SOME/IP transport 经 SomeIpConnection 收发
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _SOMEIP_STATIC_TRANSPORT_H_
+#define _SOMEIP_STATIC_TRANSPORT_H_
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ara/core/result.h"
+#include "ara/com/codegen/static_service.hpp"
+#include "ara/com/someip/someip_connection.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace someip
+        {
+            /**
+             * \brief 满足 codegen 的 Transport 要求
+             *
+             * 发送时按序列化后的确切长度分配一次缓冲区 Writer 直接写入 再整体移交给 vsomeip 的 payload
+             * 接收时每个 proxy 或 skeleton 在分发表里按 method id 注册 handler 直接调用生成代码的 InboundHandler
+             * 分发表本身的 std::function 是 SomeIpConnection 的边界 生成代码内部没有虚调用和 std::function
+             * 所有 proxy 和 skeleton 可以共用一个实例 方法线程安全
+             */
+            class SomeIpStaticTransport
+            {
+            public:
+                explicit SomeIpStaticTransport(SomeIpConnection &connection = SomeIpConnection::Instance());
+
+                /**
+                 * \brief 注销还在接收的 handler
+                 */
+                ~SomeIpStaticTransport();
+
+                SomeIpStaticTransport(const SomeIpStaticTransport &) = delete;
+                SomeIpStaticTransport &operator=(const SomeIpStaticTransport &) = delete;
+
+                /**
+                 * \brief kClient 时同时 RequestService kServer 时某个 method 已被注册则全部回滚
+                 * \return 失败时返回 codegen::kInvalidListenId
+                 */
+                uint64_t Listen(codegen::Role role, const codegen::Endpoint &endpoint, const uint16_t *ids, size_t count,
+                                codegen::InboundHandler handler, void *target);
+
+                /**
+                 * \brief 等正在执行的 handler 返回后才返回 不能在 handler 里调用
+                 */
+                void Unlisten(uint64_t listenId);
+
+                /**
+                 * \brief 需要应答时经 SomeIpConnection::SendRequest 发出 应答只交给 listenId 为这个方法注册的 handler
+                 * \return listenId 没有接收这个方法的应答时返回 kServiceNotAvailable
+                 */
+                template <typename Writer>
+                ara::core::Result<void> SendRequest(uint64_t listenId, const codegen::Endpoint &endpoint, uint16_t methodId, uint16_t session,
+                                                    bool expectResponse, size_t size, Writer &&write)
+                {
+                    std::vector<uint8_t> data(size);
+                    write(data.data());
+                    return sendRequest(listenId, endpoint, methodId, session, expectResponse, std::move(data));
+                }
+
+                /**
+                 * \param request 只能在 handler 执行期间使用
+                 */
+                template <typename Writer>
+                ara::core::Result<void> SendResponse(const codegen::InboundMessage &request, bool ok, size_t size, Writer &&write)
+                {
+                    std::vector<uint8_t> data(size);
+                    write(data.data());
+                    return sendResponse(request, ok, std::move(data));
+                }
+
+                template <typename Writer>
+                ara::core::Result<void> Notify(const codegen::Endpoint &endpoint, uint16_t eventId, size_t size, Writer &&write)
+                {
+                    std::vector<uint8_t> data(size);
+                    write(data.data());
+                    return connection_.Notify(endpoint.serviceId, endpoint.instanceId, eventId, std::move(data));
+                }
+
+                void OfferService(const codegen::Endpoint &endpoint, const codegen::EventAddress *events, size_t count);
+
+                void StopOfferService(const codegen::Endpoint &endpoint, const codegen::EventAddress *events, size_t count);
+
+                void Subscribe(const codegen::Endpoint &endpoint, const codegen::EventAddress *events, size_t count);
+
+                void Unsubscribe(const codegen::Endpoint &endpoint, const codegen::EventAddress *events, size_t count);
+
+            private:
+                struct Listening
+                {
+                    codegen::Role role;
+                    codegen::Endpoint endpoint;
+                    std::vector<HandlerId> handlers;
+                    std::vector<uint16_t> ids; // 与 handlers 一一对应
+                };
+
+                static std::vector<EventSubscription> subscriptionsOf(const codegen::EventAddress *events, size_t count);
+
+                ara::core::Result<void> sendRequest(uint64_t listenId, const codegen::Endpoint &endpoint, uint16_t methodId, uint16_t session,
+                                                    bool expectResponse, std::vector<uint8_t> data);
+
+                // listenId 为 methodId 注册的应答 handler 没有时返回 kInvalidHandlerId
+                HandlerId responseHandlerOf(uint64_t listenId, uint16_t methodId);
+
+                ara::core::Result<void> sendResponse(const codegen::InboundMessage &request, bool ok, std::vector<uint8_t> data);
+
+                // 从 listening_ 里移除后调用 不持有 mutex_
+                void release(const Listening &listening);
+
+                SomeIpConnection &connection_;
+                std::mutex mutex_; // 保护 listening_ 和 nextListenId_
+                std::unordered_map<uint64_t, Listening> listening_;
+                uint64_t nextListenId_;
+            };
+
+        } // namespace someip
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _SOMEIP_STATIC_TRANSPORT_H_
@@ -0,0 +1,82 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief SOME/IP-TP 分段头部和发送端分段
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _SOMEIP_TP_H_
+#define _SOMEIP_TP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace ara
+{
+    namespace com
+    {
+        namespace tp
+        {
+            /**
+             * \brief SOME/IP 头部 Message Type 里的 TP 标志位
+             */
+            constexpr uint8_t kTpFlag = 0x20;
+
+            /**
+             * \brief TP 头部长度 紧跟在 16 字节 SOME/IP 头部之后
+             */
+            constexpr size_t kTpHeaderSize = 4;
+
+            /**
+             * \brief 除最后一段外 每段数据长度必须是 16 的整数倍 offset 也以 16 字节为单位
+             */
+            constexpr size_t kTpAlignment = 16;
+
+            /**
+             * \brief UDP 不分片时每段最多 1392 字节数据 (87 * 16)
+             */
+            constexpr size_t kTpDefaultMaxSegmentLength = 1392;
+
+            /**
+             * \brief TP 头部 | Offset 28 位 | Reserved 3 位 | More Segments 1 位 | 大端
+             *
+             * @ID{[PRS_SOMEIP_00724]}
+             */
+            struct TpHeader
+            {
+                uint32_t offset;   ///< 本段数据在完整 payload 中的字节偏移 是 16 的整数倍
+                bool moreSegments; ///< 后面还有分段
+            };
+
+            /**
+             * \brief 解析 TP 头部
+             * \return 长度不足 4 字节时返回 false
+             */
+            bool ParseTpHeader(const uint8_t *data, size_t length, TpHeader &header);
+
+            /**
+             * \brief 写 4 字节 TP 头部 offset 必须是 16 的整数倍
+             */
+            void WriteTpHeader(const TpHeader &header, uint8_t *out);
+
+            /**
+             * \brief 分段回调 tpHeader 是本段的 4 字节 TP 头部 data 指向原始 payload 内部 不拷贝
+             *
+             * binding 用 sendmsg 的 iovec 把 SOME/IP 头部 TP 头部 和 data 组成一个 UDP 报文
+             */
+            using TpSegmentCallback = std::function<bool(const uint8_t *tpHeader, const uint8_t *data, size_t length)>;
+
+            /**
+             * \brief 把 payload 切成 SOME/IP-TP 分段 按 offset 递增顺序回调
+             * \param maxSegmentLength 每段最大数据长度 向下取整到 16 的倍数 小于 16 时按 16 处理
+             * \return 分段个数 回调返回 false 时停止并返回 0
+             */
+            size_t SegmentPayload(const uint8_t *payload, size_t length, size_t maxSegmentLength, const TpSegmentCallback &callback);
+
+        } // namespace tp
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _SOMEIP_TP_H_
@@ -0,0 +1,194 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief SOME/IP-TP 接收端重组 缓冲区来自预分配的分级内存池
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _TP_REASSEMBLER_H_
+#define _TP_REASSEMBLER_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "ara/com/rpc/chunk_pool.h"
+#include "ara/com/tp/someip_tp.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace tp
+        {
+            /**
+             * \brief 一级缓冲区 bufferSize 字节的缓冲区预分配 count 个
+             */
+            struct TpSizeClass
+            {
+                size_t bufferSize;
+                size_t count;
+            };
+
+            /**
+             * \brief 重组配置 由部署配置生成
+             */
+            struct TpReassemblerConfig
+            {
+                /**
+                 * \brief 从小到大排列 重组开始时取能放下已收数据的最小一级 超出后换到更大一级
+                 * 默认最大 1 MiB 共 2.5 MiB 更大的消息由部署配置加一级 不要按最坏情况给每个进程预分配
+                 */
+                std::vector<TpSizeClass> sizeClasses{{64 * 1024, 8}, {1024 * 1024, 2}};
+                size_t maxPending = 8;                         ///< 同时重组的消息数
+                std::chrono::milliseconds timeout{500};        ///< 超过该时间没有新分段的消息被丢弃
+            };
+
+            /**
+             * \brief 区分同时重组的消息 对应 SOME/IP 头部的字段加上发送端地址
+             */
+            struct TpMessageKey
+            {
+                uint64_t source;          ///< 发送端 IP + 端口 由 binding 组合
+                uint16_t service;
+                uint16_t method;          ///< method id 或 event id
+                uint16_t client;
+                uint16_t session;
+                uint8_t interfaceVersion;
+                uint8_t messageType;      ///< 去掉 TP 标志位后的 Message Type
+
+                bool operator==(const TpMessageKey &other) const
+                {
+                    return source == other.source && service == other.service && method == other.method && client == other.client &&
+                           session == other.session && interfaceVersion == other.interfaceVersion && messageType == other.messageType;
+                }
+            };
+
+            /**
+             * \brief 重组完成的 payload 直接引用池中的缓冲区 最后一个引用释放时归还内存池
+             *
+             * EventProxy 拿到的就是这块内存 不再拷贝
+             */
+            class TpPayload
+            {
+            public:
+                explicit TpPayload(rpc::ChunkPtr chunk) : chunk_(std::move(chunk)) {}
+
+                const uint8_t *data() const { return chunk_->data; }
+
+                size_t size() const { return chunk_->length; }
+
+            private:
+                rpc::ChunkPtr chunk_;
+            };
+
+            /**
+             * \brief 单个分段的处理结果
+             */
+            enum class TpSegmentResult : uint8_t
+            {
+                kIncomplete = 0, ///< 已接收 等待其余分段
+                kComplete,       ///< 消息重组完成
+                kDropped         ///< 分段不合法或缓冲区不足 该消息已放弃
+            };
+
+            /**
+             * \brief 统计计数 用于诊断
+             */
+            struct TpStatistics
+            {
+                uint64_t completed = 0;        ///< 重组完成的消息数
+                uint64_t malformed = 0;        ///< 长度 offset 不合法的分段
+                uint64_t timedOut = 0;         ///< 超时丢弃的消息
+                uint64_t poolExhausted = 0;    ///< 没有可用缓冲区而丢弃的消息
+                uint64_t tooManyGaps = 0;      ///< 乱序空洞过多而丢弃的消息
+                uint64_t resized = 0;          ///< 换到更大一级缓冲区的次数
+            };
+
+            /**
+             * \brief 按消息重组 SOME/IP-TP 分段 允许乱序和重复的分段
+             *
+             * 所有缓冲区在构造时分配 收包路径上只有完成时为 TpPayload 的一次小对象分配
+             * 只能在 binding 的接收线程里调用 TpPayload 可以在任意线程释放
+             */
+            class TpReassembler
+            {
+            public:
+                using Clock = std::chrono::steady_clock;
+
+                /**
+                 * \brief 每条消息最多记录的已收区间数 顺序到达时始终只有一个 UDP 的乱序一般只在相邻几个报文之间
+                 */
+                static constexpr size_t kMaxIntervals = 32;
+
+                explicit TpReassembler(const TpReassemblerConfig &config);
+
+                TpReassembler(const TpReassembler &) = delete;
+                TpReassembler &operator=(const TpReassembler &) = delete;
+
+                /**
+                 * \brief 处理一个分段
+                 * \param segment SOME/IP 头部之后的数据 以 TP 头部开头
+                 * \param completed 返回 kComplete 时为重组好的 payload 不含 TP 头部
+                 */
+                TpSegmentResult OnSegment(const TpMessageKey &key, const uint8_t *segment, size_t length, Clock::time_point now,
+                                          std::shared_ptr<const TpPayload> &completed);
+
+                /**
+                 * \brief 丢弃超时的消息 binding 的定时器周期调用
+                 * \return 丢弃的消息数
+                 */
+                size_t Expire(Clock::time_point now);
+
+                /**
+                 * \brief 正在重组的消息数
+                 */
+                size_t Pending() const;
+
+                const TpStatistics &GetStatistics() const { return statistics_; }
+
+            private:
+                struct Interval
+                {
+                    size_t begin;
+                    size_t end;
+                };
+
+                struct Reassembly
+                {
+                    bool active = false;
+                    TpMessageKey key{};
+                    rpc::ChunkPtr buffer;
+                    Interval intervals[kMaxIntervals];
+                    size_t intervalCount = 0;
+                    size_t totalLength = 0;     // 收到最后一段之前为 0
+                    Clock::time_point lastUpdate;
+                };
+
+                Reassembly *find(const TpMessageKey &key);
+
+                Reassembly *start(const TpMessageKey &key, Clock::time_point now);
+
+                bool ensureCapacity(Reassembly &reassembly, size_t required);
+
+                bool addInterval(Reassembly &reassembly, size_t begin, size_t end);
+
+                rpc::ChunkPtr allocate(size_t required);
+
+                void drop(Reassembly &reassembly);
+
+            private:
+                const TpReassemblerConfig config_;
+                std::vector<std::unique_ptr<rpc::ChunkPool>> pools_;
+                std::vector<Reassembly> reassemblies_;
+                TpStatistics statistics_;
+            };
+
+        } // namespace tp
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _TP_REASSEMBLER_H_
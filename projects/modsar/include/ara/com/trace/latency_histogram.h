@@ -0,0 +1,103 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief HDR 风格的时延直方图 固定大小 可以直接放在共享内存里
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _LATENCY_HISTOGRAM_H_
+#define _LATENCY_HISTOGRAM_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace ara
+{
+    namespace com
+    {
+        namespace trace
+        {
+            /**
+             * \brief 直方图的摘要 单位 ns
+             */
+            struct LatencySummary
+            {
+                uint64_t count = 0;
+                uint64_t min = 0;
+                uint64_t max = 0;
+                uint64_t mean = 0;
+                uint64_t p50 = 0;
+                uint64_t p90 = 0;
+                uint64_t p99 = 0;
+                uint64_t p999 = 0;
+            };
+
+            /**
+             * \brief 对数线性分桶的直方图 (HdrHistogram 的布局)
+             *
+             * 小于 128 ns 的值一个桶一个值 之后每翻一倍分 64 个桶 相对误差不超过 1/64
+             * 上限约 68 s 超出的值记在最后一个桶
+             * 计数器都是原子量 多个线程可以同时 Record 读端不加锁 读到的是近似一致的快照
+             * 没有指针和堆内存 可以 placement new 在共享内存里 由其他进程读取
+             */
+            class LatencyHistogram
+            {
+            public:
+                static constexpr uint32_t kSubBucketBits = 7;
+                static constexpr uint32_t kHalfBucketCount = 1U << (kSubBucketBits - 1);
+                static constexpr uint32_t kMaxValueBits = 36;
+                static constexpr uint64_t kMaxValue = (1ULL << kMaxValueBits) - 1;
+                static constexpr size_t kBucketCount = (kMaxValueBits - kSubBucketBits + 2) * kHalfBucketCount;
+
+                LatencyHistogram();
+
+                LatencyHistogram(const LatencyHistogram &) = delete;
+                LatencyHistogram &operator=(const LatencyHistogram &) = delete;
+
+                void Record(uint64_t valueNs);
+
+                /**
+                 * \brief 清空 和 Record 并发时会丢掉少量计数
+                 */
+                void Reset();
+
+                /**
+                 * \brief 分位数对应的值 返回所在桶的上界 没有数据时为 0
+                 * \param percentile 0 ~ 100
+                 */
+                uint64_t ValueAtPercentile(double percentile) const;
+
+                LatencySummary Summarize() const;
+
+                uint64_t Count() const { return count_.load(std::memory_order_relaxed); }
+
+                /**
+                 * \brief 一个桶的计数 和 BucketUpperBound 一起导出完整分布
+                 */
+                uint64_t BucketValueCount(size_t index) const { return buckets_[index].load(std::memory_order_relaxed); }
+
+                /**
+                 * \brief 值所在的桶
+                 */
+                static size_t BucketIndex(uint64_t valueNs);
+
+                /**
+                 * \brief 桶内最大的值
+                 */
+                static uint64_t BucketUpperBound(size_t index);
+
+            private:
+                std::atomic<uint64_t> count_;
+                std::atomic<uint64_t> sum_;
+                std::atomic<uint64_t> min_;
+                std::atomic<uint64_t> max_;
+                std::atomic<uint64_t> buckets_[kBucketCount];
+            };
+
+        } // namespace trace
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _LATENCY_HISTOGRAM_H_
@@ -0,0 +1,155 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 每个 event / method 一个追踪 channel 发送端打时间戳 接收端统计时延和丢包乱序
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _TRACE_CHANNEL_H_
+#define _TRACE_CHANNEL_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "ara/com/trace/latency_histogram.h"
+#include "ara/com/trace/trace_types.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace trace
+        {
+            /**
+             * \brief channel 属于哪个服务实例的哪个 event / method
+             */
+            struct ChannelDescriptor
+            {
+                char name[48];
+                uint16_t service;
+                uint16_t instance;
+                uint16_t id; ///< event id 或 method id
+                ChannelRole role;
+                uint8_t reserved;
+            };
+
+            /**
+             * \brief 统计页里一个 channel 的计数器和直方图 由 TraceRegistry 分配
+             *
+             * 时延分阶段记录 定位尖刺出在哪一段:
+             * - serialize: 发送端序列化
+             * - transport: 发送到接收 两端时钟一致时才统计
+             * - queue: 收到到 handler 开始执行
+             * - handler: handler 执行
+             * - roundTrip: 客户端发出请求到收到应答
+             */
+            struct alignas(64) ChannelStats
+            {
+                std::atomic<uint32_t> ready; ///< 描述写完后置 1 读端跳过为 0 的 channel
+                uint32_t reserved;
+                ChannelDescriptor descriptor;
+                std::atomic<uint64_t> sent;
+                std::atomic<uint64_t> received;
+                std::atomic<uint64_t> untraced;   ///< 没有追踪信息或格式不对的消息
+                std::atomic<uint64_t> gaps;       ///< 序号跳过的消息数 丢包或仍在路上
+                std::atomic<uint64_t> reordered;  ///< 序号比已收到的小
+                std::atomic<uint64_t> duplicates; ///< 序号和上一条相同
+                std::atomic<uint64_t> restarts;   ///< 发送端 senderId 变化
+                LatencyHistogram serialize;
+                LatencyHistogram transport;
+                LatencyHistogram queue;
+                LatencyHistogram handler;
+                LatencyHistogram roundTrip;
+
+                ChannelStats();
+            };
+
+            /**
+             * \brief ChannelStats 的快照
+             */
+            struct TraceStatistics
+            {
+                ChannelDescriptor descriptor;
+                uint64_t sent = 0;
+                uint64_t received = 0;
+                uint64_t untraced = 0;
+                uint64_t gaps = 0;
+                uint64_t reordered = 0;
+                uint64_t duplicates = 0;
+                uint64_t restarts = 0;
+                LatencySummary serialize;
+                LatencySummary transport;
+                LatencySummary queue;
+                LatencySummary handler;
+                LatencySummary roundTrip;
+            };
+
+            TraceStatistics Summarize(const ChannelStats &stats);
+
+            /**
+             * \brief 追踪 channel 由 TraceRegistry::CreateChannel 创建
+             *
+             * 发送端在序列化前取 Now 序列化后 Stamp 得到追踪信息附在 payload 末尾
+             * 接收端 Receive 按消息头部的标记解析末尾的追踪信息 返回去掉它之后的长度
+             * 全部计数都是原子量 可以在多个 binding 线程上同时使用
+             */
+            class TraceChannel
+            {
+            public:
+                /**
+                 * \param owner 保持统计页映射的对象 channel 存活期间不能释放
+                 */
+                TraceChannel(ChannelStats &stats, TraceClock clock, std::shared_ptr<const void> owner);
+
+                TraceChannel(const TraceChannel &) = delete;
+                TraceChannel &operator=(const TraceChannel &) = delete;
+
+                uint64_t Now() const { return TraceClockNs(clock_); }
+
+                /**
+                 * \brief 为一条新消息生成追踪信息 当前线程在 handler 里时沿用上游的 traceId
+                 * \param serializeStartNs 序列化开始时 Now 的值 为 0 时不统计序列化耗时
+                 */
+                TraceTrailer Stamp(uint64_t serializeStartNs);
+
+                /**
+                 * \brief 为应答生成追踪信息 带回请求的 traceId / sequence / senderId 和发送时间
+                 */
+                TraceTrailer StampResponse(const TraceContext &request, uint64_t serializeStartNs);
+
+                /**
+                 * \brief 解析 data 末尾的追踪信息并统计传输时延 往返时延 序号
+                 * \param traced 消息头部带 kTraceInterfaceVersionFlag 为 false 时不看 data 的内容
+                 * \param context 解析成功时填入 交给 handler 用 失败时 channel 为空
+                 * \return 去掉追踪信息后的长度 traced 为 false 时原样返回 length
+                 * 版本不认识的追踪信息也去掉 只是不统计
+                 */
+                size_t Receive(const uint8_t *data, size_t length, bool traced, TraceContext &context);
+
+                /**
+                 * \brief handler 执行完后记录排队和执行耗时
+                 */
+                void RecordHandler(uint64_t queueNs, uint64_t handlerNs);
+
+                TraceStatistics GetStatistics() const { return Summarize(stats_); }
+
+                const ChannelDescriptor &Descriptor() const { return stats_.descriptor; }
+
+            private:
+                void trackSequence(uint32_t senderId, uint32_t sequence);
+
+            private:
+                ChannelStats &stats_;
+                const TraceClock clock_;
+                const std::shared_ptr<const void> owner_;
+                std::atomic<uint32_t> sequence_;
+                std::atomic<uint64_t> lastSeen_; // senderId << 32 | sequence 为 0 表示还没收到过
+            };
+
+        } // namespace trace
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _TRACE_CHANNEL_H_
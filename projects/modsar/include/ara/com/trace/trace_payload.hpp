@@ -0,0 +1,179 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief binding 收发时附加和去掉追踪信息
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _TRACE_PAYLOAD_HPP_
+#define _TRACE_PAYLOAD_HPP_
+
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "ara/com/trace/trace_channel.h"
+#include "ara/com/serialization/someip_serializer.hpp"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace trace
+        {
+            namespace detail
+            {
+                template <typename PayloadType>
+                void appendTrailer(const TraceTrailer &trailer, PayloadType &payload)
+                {
+                    const size_t length = payload.get_length();
+                    std::vector<uint8_t> buffer(length + kTraceTrailerSize);
+                    if (length != 0)
+                    {
+                        std::memcpy(buffer.data(), payload.get_data(), length);
+                    }
+                    EncodeTrailer(trailer, buffer.data() + length);
+                    payload.set_data(std::move(buffer));
+                }
+
+                template <typename MessageType>
+                void markTraced(MessageType &message)
+                {
+                    message.set_interface_version(static_cast<uint8_t>(message.get_interface_version() | kTraceInterfaceVersionFlag));
+                }
+            } // namespace detail
+
+            /**
+             * \brief 消息头部是否标记了 payload 末尾带追踪信息
+             */
+            template <typename MessageType>
+            bool HasTrailer(const MessageType &message)
+            {
+                return (message.get_interface_version() & kTraceInterfaceVersionFlag) != 0;
+            }
+
+            /**
+             * \brief 序列化并在末尾附上追踪信息 只分配一次 EventSkeleton::Send 使用
+             *
+             * vsomeip 的 notify 只接收 payload 通知没有可以逐条标记的头部字段
+             * event 两端按部署配置同时启用追踪 EventProxy 启用追踪时按带追踪信息接收
+             */
+            template <typename T, typename PayloadType>
+            ara::core::Result<void> SerializeTraced(const T &value, TraceChannel &channel, PayloadType &payload)
+            {
+                const uint64_t start = channel.Now();
+                const size_t bodySize = serialization::GetSerializedSize(value);
+                std::vector<uint8_t> buffer(bodySize + kTraceTrailerSize);
+                ara::core::Result<size_t> written = serialization::Serialize(value, buffer.data(), bodySize);
+                if (!written.HasValue())
+                {
+                    return ara::core::Result<void>::FromError(written.Error());
+                }
+                EncodeTrailer(channel.Stamp(start), buffer.data() + bodySize);
+                payload.set_data(std::move(buffer));
+                return ara::core::Result<void>::FromValue();
+            }
+
+            /**
+             * \brief 在已经写好的 payload 末尾附上追踪信息 有 E2E 头部或已录制的 event 用 多一次拷贝
+             * \param serializeStartNs 序列化开始时 channel.Now() 的值
+             */
+            template <typename PayloadType>
+            void AppendTrailer(TraceChannel &channel, uint64_t serializeStartNs, PayloadType &payload)
+            {
+                detail::appendTrailer(channel.Stamp(serializeStartNs), payload);
+            }
+
+            /**
+             * \brief 请求用 附上追踪信息并在头部的接口版本上标记 对端没有启用追踪时也能据此去掉它
+             */
+            template <typename MessageType>
+            void AppendRequestTrailer(TraceChannel &channel, uint64_t serializeStartNs, MessageType &message)
+            {
+                detail::appendTrailer(channel.Stamp(serializeStartNs), *message.get_payload());
+                detail::markTraced(message);
+            }
+
+            /**
+             * \brief binding 的 Skeleton::SendResponse 调用 当前线程在带追踪信息的请求的 handler 里时附上应答的追踪信息
+             *
+             * handler 在其他线程异步应答时没有上下文 应答不带追踪信息 客户端记为 untraced
+             */
+            template <typename MessageType>
+            void AppendResponseTrailer(MessageType &response)
+            {
+                const TraceContext *request = GetCurrentTraceContext();
+                if (request == nullptr || request->channel == nullptr)
+                {
+                    return;
+                }
+                detail::appendTrailer(request->channel->StampResponse(*request, 0), *response.get_payload());
+                detail::markTraced(response);
+            }
+
+            /**
+             * \brief 按头部的标记处理末尾的追踪信息 清除标记 不改动 payload
+             * \param channel 没有启用追踪时为空 带追踪信息的消息照样去掉它 context 的 channel 为空
+             * \return 去掉追踪信息后的 body 长度
+             */
+            template <typename MessageType>
+            size_t ReceiveTrailer(TraceChannel *channel, MessageType &message, TraceContext &context)
+            {
+                const size_t length = message.get_payload()->get_length();
+                const bool traced = HasTrailer(message);
+                if (traced)
+                {
+                    message.set_interface_version(static_cast<uint8_t>(message.get_interface_version() & ~kTraceInterfaceVersionFlag));
+                }
+                if (channel != nullptr)
+                {
+                    return channel->Receive(message.get_payload()->get_data(), length, traced, context);
+                }
+                context = TraceContext();
+                return traced && length >= kTraceTrailerSize ? length - kTraceTrailerSize : length;
+            }
+
+            /**
+             * \brief 去掉请求末尾的追踪信息 handler 看到的 payload 和接口版本都和没有追踪时一样
+             */
+            template <typename MessageType>
+            TraceContext ReceiveMessage(TraceChannel *channel, MessageType &message)
+            {
+                TraceContext context;
+                const size_t length = message.get_payload()->get_length();
+                const size_t bodyLength = ReceiveTrailer(channel, message, context);
+                if (bodyLength != length)
+                {
+                    const uint8_t *data = message.get_payload()->get_data();
+                    std::vector<uint8_t> body(data, data + bodyLength);
+                    message.get_payload()->set_data(std::move(body));
+                }
+                return context;
+            }
+
+            /**
+             * \brief 在上下文里执行 handler 并记录排队和执行耗时 消息没有追踪信息时直接执行
+             */
+            template <typename Handler>
+            void RunTraced(const TraceContext &context, Handler &&handler)
+            {
+                if (context.channel == nullptr)
+                {
+                    handler();
+                    return;
+                }
+                const uint64_t start = context.channel->Now();
+                {
+                    ScopedTraceContext scope(context);
+                    handler();
+                }
+                const uint64_t end = context.channel->Now();
+                context.channel->RecordHandler(start > context.receiveTimeNs ? start - context.receiveTimeNs : 0, end - start);
+            }
+
+        } // namespace trace
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _TRACE_PAYLOAD_HPP_
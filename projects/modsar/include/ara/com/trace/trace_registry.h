@@ -0,0 +1,140 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 追踪统计页 进程内分配 channel 其他进程可以只读映射查看
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _TRACE_REGISTRY_H_
+#define _TRACE_REGISTRY_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "ara/core/result.h"
+#include "ara/com/trace/trace_channel.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace trace
+        {
+            struct TraceRegistryConfig
+            {
+                std::string pageName;                         ///< 共享内存名 如 "/aracom_trace.camera" 为空时只在进程内
+                size_t maxChannels = 128;                     ///< 每个 channel 约 80 KB 共享内存按页实际使用
+                TraceClock clock = TraceClock::kMonotonic;    ///< 跨 ECU 追踪时改为 kRealtime
+            };
+
+            /**
+             * \brief 统计页开头的 64 字节
+             */
+            struct alignas(64) TracePageHeader
+            {
+                char magic[8]; ///< "ARATRACE"
+                uint32_t version;
+                uint32_t headerSize;  ///< 第一个 channel 的偏移
+                uint32_t channelSize; ///< sizeof(ChannelStats) 读端据此判断布局是否一致
+                uint32_t capacity;
+                std::atomic<uint32_t> count; ///< 已分配的 channel 数 可能超过 capacity
+                uint32_t pid;
+                TraceClock clock;
+            };
+
+            constexpr char kTracePageMagic[8] = {'A', 'R', 'A', 'T', 'R', 'A', 'C', 'E'};
+            constexpr uint32_t kTracePageVersion = 1;
+
+            using TraceStatisticsVisitor = std::function<void(const TraceStatistics &statistics)>;
+
+            /**
+             * \brief 追踪统计页的所有者
+             *
+             * 统计页是一块 mmap 的内存 配置了 pageName 时放在 POSIX 共享内存里 析构时删除
+             * channel 的槽位只分配不回收 和进程同生命周期
+             */
+            class TraceRegistry : public std::enable_shared_from_this<TraceRegistry>
+            {
+            public:
+                /**
+                 * \return 共享内存创建或映射失败时返回 kErroneousFileHandle
+                 */
+                static ara::core::Result<std::shared_ptr<TraceRegistry>> Create(const TraceRegistryConfig &config);
+
+                ~TraceRegistry();
+
+                TraceRegistry(const TraceRegistry &) = delete;
+                TraceRegistry &operator=(const TraceRegistry &) = delete;
+
+                /**
+                 * \brief 分配一个 channel name 超过 47 字节时截断
+                 * \return 槽位用完时返回 nullptr
+                 */
+                std::shared_ptr<TraceChannel> CreateChannel(ChannelRole role, const std::string &name, uint16_t service,
+                                                            uint16_t instance, uint16_t id);
+
+                void ForEachChannel(const TraceStatisticsVisitor &visitor) const;
+
+                TraceClock Clock() const { return config_.clock; }
+
+            private:
+                TraceRegistry(const TraceRegistryConfig &config, void *page, size_t size);
+
+            private:
+                const TraceRegistryConfig config_;
+                void *page_;
+                const size_t size_;
+            };
+
+            /**
+             * \brief 进程内的默认统计页 EventSkeleton / EventProxy / NonBlockingCall / Skeleton 的 EnableTracing 使用
+             */
+            void SetDefaultTraceRegistry(std::shared_ptr<TraceRegistry> registry);
+
+            std::shared_ptr<TraceRegistry> GetDefaultTraceRegistry();
+
+            /**
+             * \brief 在默认统计页上分配 channel 没有设置默认统计页时返回 nullptr
+             */
+            std::shared_ptr<TraceChannel> CreateTraceChannel(ChannelRole role, const std::string &name, uint16_t service,
+                                                             uint16_t instance, uint16_t id);
+
+            /**
+             * \brief 在其他进程里只读映射统计页 用于监控工具
+             */
+            class TraceStatsReader
+            {
+            public:
+                explicit TraceStatsReader(const std::string &pageName);
+                ~TraceStatsReader();
+
+                TraceStatsReader(const TraceStatsReader &) = delete;
+                TraceStatsReader &operator=(const TraceStatsReader &) = delete;
+
+                /**
+                 * \return 共享内存不存在或布局版本不一致时返回 kErroneousFileHandle
+                 */
+                ara::core::Result<void> Open();
+
+                void ForEachChannel(const TraceStatisticsVisitor &visitor) const;
+
+                /**
+                 * \brief 发布统计页的进程 未打开时为 0
+                 */
+                uint32_t PublisherPid() const;
+
+            private:
+                const std::string pageName_;
+                void *page_;
+                size_t size_;
+            };
+
+        } // namespace trace
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _TRACE_REGISTRY_H_
@@ -0,0 +1,140 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 端到端时延追踪 附在 payload 末尾的追踪信息和线程上的追踪上下文
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _TRACE_TYPES_H_
+#define _TRACE_TYPES_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ara
+{
+    namespace com
+    {
+        namespace trace
+        {
+            class TraceChannel;
+
+            /**
+             * \brief 时间戳使用的时钟
+             *
+             * 同一主机内用 kMonotonic 跨 ECU 时两端都要用 kRealtime 并由 gPTP / chrony 同步
+             * 两端时钟不同时不统计传输时延 往返时延只用本端时钟 不受影响
+             */
+            enum class TraceClock : uint8_t
+            {
+                kMonotonic = 0,
+                kRealtime
+            };
+
+            /**
+             * \brief channel 在本进程里的角色 决定统计哪些阶段
+             */
+            enum class ChannelRole : uint8_t
+            {
+                kEventSender = 0, ///< EventSkeleton 统计序列化耗时
+                kEventReceiver,   ///< EventProxy 统计传输 排队 handler 以及丢包和乱序
+                kMethodClient,    ///< NonBlockingCall 统计请求序列化 应答传输和往返时延
+                kMethodServer     ///< Skeleton 的方法 统计请求传输 排队和 handler
+            };
+
+            /**
+             * \brief 附在 payload 末尾的追踪信息 线上按大端编码 固定 40 字节
+             *
+             * 放在末尾而不是开头 不影响 E2E 头部的 offset 接收端先去掉它再做 E2E 检查和反序列化
+             * 有没有追踪信息由 SOME/IP 头部接口版本的 kTraceInterfaceVersionFlag 位表示 不靠末尾的内容判断
+             * 没有启用追踪的接收端也据此去掉它 payload 恰好以 magic 结尾也不会被误认
+             * 应答原样带回请求的 traceId / sequence / senderId 并把请求的 sendTimeNs 写进 originTimeNs
+             */
+            struct TraceTrailer
+            {
+                uint64_t traceId;      ///< 一次调用链的标识 handler 里再发出的消息沿用它
+                uint64_t sendTimeNs;   ///< 序列化完成 交给 transport 的时间
+                uint64_t originTimeNs; ///< 应答里为请求的发送时间 其余为 0
+                uint32_t sequence;     ///< 发送端按 channel 递增 从 1 开始
+                uint32_t senderId;     ///< 发送进程的随机标识 变化说明对端重启
+                uint32_t serializeNs;  ///< 发送端的序列化耗时
+                uint8_t flags;
+                uint8_t version;
+                uint16_t magic;
+            };
+
+            constexpr size_t kTraceTrailerSize = 40;
+            constexpr uint16_t kTraceMagic = 0x5452; // "TR"
+            constexpr uint8_t kTraceVersion = 1;
+            constexpr uint8_t kTraceFlagRealtime = 0x01;
+
+            /**
+             * \brief 接口版本的最高位 置位表示 payload 末尾带追踪信息 服务的主版本号因此不超过 0x7F
+             * 接收端去掉追踪信息时清除这一位 handler 看到的是原来的接口版本
+             */
+            constexpr uint8_t kTraceInterfaceVersionFlag = 0x80;
+
+            /**
+             * \brief 接收到一条带追踪信息的消息后 交给 handler 的上下文
+             *
+             * handler 执行期间安装在当前线程上 binding 发送应答时据此回填
+             */
+            struct TraceContext
+            {
+                uint64_t traceId = 0;
+                uint64_t originTimeNs = 0;  ///< 对端的发送时间
+                uint64_t receiveTimeNs = 0; ///< 本端收到的时间 用于计算排队时延
+                uint32_t sequence = 0;
+                uint32_t senderId = 0;
+                TraceChannel *channel = nullptr; ///< 为空表示消息没有追踪信息
+            };
+
+            /**
+             * \brief 按大端写入 kTraceTrailerSize 个字节
+             */
+            void EncodeTrailer(const TraceTrailer &trailer, uint8_t *out);
+
+            /**
+             * \brief 解析末尾的追踪信息 magic 或版本不对时返回 false (只用于检查 是否带追踪信息由接口版本决定)
+             */
+            bool DecodeTrailer(const uint8_t *in, TraceTrailer &trailer);
+
+            uint64_t TraceClockNs(TraceClock clock);
+
+            /**
+             * \brief 本进程作为发送端的标识 进程内固定
+             */
+            uint32_t LocalSenderId();
+
+            /**
+             * \brief 新的 traceId 高 32 位为 LocalSenderId
+             */
+            uint64_t NewTraceId();
+
+            /**
+             * \brief 当前线程正在处理的消息的上下文 不在 handler 里时返回 nullptr
+             */
+            const TraceContext *GetCurrentTraceContext();
+
+            /**
+             * \brief 在作用域内把上下文安装到当前线程 可以嵌套
+             */
+            class ScopedTraceContext
+            {
+            public:
+                explicit ScopedTraceContext(const TraceContext &context);
+                ~ScopedTraceContext();
+
+                ScopedTraceContext(const ScopedTraceContext &) = delete;
+                ScopedTraceContext &operator=(const ScopedTraceContext &) = delete;
+
+            private:
+                const TraceContext *previous_;
+            };
+
+        } // namespace trace
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _TRACE_TYPES_H_
@@ -7,9 +7,14 @@
 #ifndef _ARA_COM_TYPES_H
 #define _ARA_COM_TYPES_H
 
+#include <cstdint>
 #include <string>
 #include <functional>
 
+#include "ara/core/intern_table.h"
+#include "ara/core/result.h"
+#include "ara/core/string_view.h"
+
 namespace ara
 {
     namespace com
@@ -42,14 +47,62 @@ namespace ara
         class InstanceIdentifier
         {
         public:
-        private:
             /**
-             * @brief The (legacy) string value.
+             * \brief 数字形式的实例 id 不存在时的值
+             */
+            static constexpr uint32_t kInvalidId = 0xFFFFFFFF;
+
+            /**
+             * \brief 字符串格式错误时抛出 ComException
              *
-             * @remark
-             * We have to keep this as long as users don't directly deliver the right serialized string view in all cases.
+             * @ID{[SWS_CM_00302]}
+             */
+            explicit InstanceIdentifier(ara::core::StringView value) : InstanceIdentifier(Create(value).ValueOrThrow()) {}
+
+            /**
+             * \brief 字符串不能为空 不能含空白和控制字符
+             * \return 格式错误时返回 kInvalidInstanceIdentifierString
+             */
+            static ara::core::Result<InstanceIdentifier> Create(ara::core::StringView serializedFormat);
+
+            /**
+             * \brief 返回的字符串在进程内一直有效 不分配内存
+             */
+            ara::core::StringView ToString() const noexcept { return ara::core::InternTable::Instance().Lookup(handle_); }
+
+            /**
+             * \brief 字符串为十进制数字 或最后一个 ':' 之后为十进制数字时取该数字 例如 "42" "SomeIp:42"
+             * 否则为 kInvalidId 生成代码据此得到 binding 的实例 id
+             */
+            uint32_t Id() const noexcept { return id_; }
+
+            /**
+             * \brief SOME/IP 等 binding 使用的 16 位实例 id 不要直接截断 Id()
+             * \return 没有数字 id 或超出 0x0001..0xFFFE (0xFFFF 是通配的 any instance) 时返回 kInvalidInstanceIdentifierString
+             */
+            ara::core::Result<uint16_t> BindingId() const noexcept;
+
+            /**
+             * \brief 驻留表的句柄 可以直接作为 handle 容器和注册表的整数键
+             */
+            ara::core::InternHandle Handle() const noexcept { return handle_; }
+
+            bool operator==(const InstanceIdentifier &other) const noexcept { return handle_ == other.handle_; }
+
+            bool operator!=(const InstanceIdentifier &other) const noexcept { return handle_ != other.handle_; }
+
+            /**
+             * \brief 按句柄排序 只保证在进程内稳定 不是字典序
              */
-            std::string idString_;
+            bool operator<(const InstanceIdentifier &other) const noexcept { return handle_ < other.handle_; }
+
+        private:
+            InstanceIdentifier(ara::core::InternHandle handle, uint32_t id) noexcept : handle_(handle), id_(id) {}
+
+            /**
+             * @brief 字符串形式在驻留表里 拷贝标识只拷贝句柄 不分配内存
+             */
+            ara::core::InternHandle handle_;
 
             /** @brief The instance id. */
             uint32_t id_;
@@ -79,6 +132,20 @@ namespace ara
         template <typename HandleType>
         using FindServiceHandler = std::function<void(ServiceHandleContainer<HandleType>, FindServiceHandle)>;
 
+        /**
+         * \brief Definition of the method processing modes, that control, how the
+         * skeleton processes incoming method calls.
+         *
+         * \remark
+         * @ID{[SWS_CM_00301]}
+         */
+        enum class MethodCallProcessingMode : uint8_t
+        {
+            kPoll,             ///< 应用通过 ProcessNextMethodCall 显式处理
+            kEvent,            ///< 在 worker 线程池上并发处理
+            kEventSingleThread ///< 事件驱动 但同一时刻最多处理一个调用
+        };
+
         /**
          * \brief Receive handler method, which is semantically a void(void) function.
          *
@@ -93,4 +160,17 @@ namespace ara
 
 } // namespace ara
 
+namespace std
+{
+    template <>
+    struct hash<ara::com::InstanceIdentifier>
+    {
+        size_t operator()(const ara::com::InstanceIdentifier &identifier) const noexcept
+        {
+            return static_cast<size_t>(identifier.Handle());
+        }
+    };
+
+} // namespace std
+
 #endif // _ARA_COM_TYPES_H
\ No newline at end of file
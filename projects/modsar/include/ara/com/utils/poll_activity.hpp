@@ -0,0 +1,61 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 把 kPoll 的方法处理和 event 轮询包装成 TimeTriggeredExecutor 的 activity
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _POLL_ACTIVITY_HPP_
+#define _POLL_ACTIVITY_HPP_
+
+#include <memory>
+#include <utility>
+
+#include "ara/core/time_triggered_executor.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace utils
+        {
+            /**
+             * \brief 每个周期最多处理 maxCallsPerCycle 个排队的方法调用 队列空时提前结束
+             *
+             * skeleton 需要以 MethodCallProcessingMode::kPoll 创建 调用在 activity 所在线程上执行
+             * 限制个数让一个周期的执行时间有上界 剩余的调用留到下一个周期
+             */
+            template <typename SkeletonType>
+            ara::core::TimeTriggeredExecutor::Activity MakeMethodPollActivity(std::shared_ptr<SkeletonType> skeleton, size_t maxCallsPerCycle)
+            {
+                return [skeleton, maxCallsPerCycle]()
+                {
+                    for (size_t i = 0; i < maxCallsPerCycle; ++i)
+                    {
+                        if (!skeleton->ProcessNextMethodCall().GetResult().ValueOr(false))
+                        {
+                            break;
+                        }
+                    }
+                };
+            }
+
+            /**
+             * \brief 每个周期从 event 的订阅队列取出最多 maxSamplesPerCycle 个 sample 交给 handler
+             * event 的生命周期要长于执行器
+             */
+            template <typename EventProxyType, typename Handler>
+            ara::core::TimeTriggeredExecutor::Activity MakeEventPollActivity(EventProxyType &event, Handler handler, size_t maxSamplesPerCycle)
+            {
+                return [&event, handler, maxSamplesPerCycle]()
+                {
+                    event.GetNewSamples(handler, maxSamplesPerCycle);
+                };
+            }
+
+        } // namespace utils
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _POLL_ACTIVITY_HPP_
@@ -0,0 +1,146 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 基于 epoch 的 RCU 读端无锁 写端换指针后延迟释放旧对象
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _RCU_H_
+#define _RCU_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ara
+{
+    namespace com
+    {
+        namespace utils
+        {
+            /**
+             * \brief 进程唯一的 RCU 域
+             *
+             * 每个读线程占一条 cache line 对齐的记录 进入读区时写入当前 epoch 离开时清零
+             * 写端换掉指针后把旧对象连同新的 epoch 交给 Retire
+             * 所有记录都为 0 或不小于该 epoch 时 不会再有读者持有旧对象 这时才释放
+             * Retire 不等待 读区里调用 Retire 不会死锁 没到期的对象在之后的 Retire 或 Synchronize 时释放
+             */
+            class RcuDomain
+            {
+            public:
+                static RcuDomain &Instance();
+
+                RcuDomain(const RcuDomain &) = delete;
+                RcuDomain &operator=(const RcuDomain &) = delete;
+
+                /**
+                 * \brief 读区 同一线程可以嵌套
+                 */
+                class ReadGuard
+                {
+                public:
+                    ReadGuard() noexcept;
+                    ~ReadGuard();
+
+                    ReadGuard(const ReadGuard &) = delete;
+                    ReadGuard &operator=(const ReadGuard &) = delete;
+                };
+
+                /**
+                 * \brief 旧对象已经不可达 在宽限期后调用 deleter
+                 */
+                void Retire(std::function<void()> deleter);
+
+                /**
+                 * \brief 等待当前全部读区结束并释放到期的对象 不能在读区里调用
+                 */
+                void Synchronize();
+
+                /**
+                 * \brief 还没有释放的对象个数
+                 */
+                size_t PendingCount() const;
+
+            private:
+                struct alignas(64) Reader
+                {
+                    std::atomic<uint64_t> epoch{0}; // 0 表示不在读区
+                    std::atomic<bool> used{false};
+                    uint32_t depth = 0; // 只由占用的线程访问
+                    Reader *next = nullptr;
+                };
+
+                struct Retired
+                {
+                    uint64_t epoch;
+                    std::function<void()> deleter;
+                };
+
+                // 线程退出时放开占用的记录
+                struct ThreadReader
+                {
+                    Reader *reader = nullptr;
+                    ~ThreadReader();
+                };
+
+                RcuDomain();
+
+                static Reader *threadReader();
+
+                Reader *acquireReader();
+
+                // 在读区里的读者中最小的 epoch 没有读者时返回 UINT64_MAX
+                uint64_t oldestReader() const;
+
+                // 取出到期的对象 在锁外释放
+                std::vector<std::function<void()>> collect();
+
+                alignas(64) std::atomic<uint64_t> epoch_;
+                std::atomic<Reader *> readers_; // 只增不减 线程退出后记录留给新线程复用
+                mutable std::mutex retiredMutex_;
+                std::vector<Retired> retired_;
+            };
+
+            /**
+             * \brief RCU 保护的只读对象指针
+             *
+             * 读端在 ReadGuard 内 Load 拿到的指针在读区结束前有效
+             * Store 用新对象替换 旧对象交给 RcuDomain 延迟释放 多个写者需要在外部串行化
+             */
+            template <typename T>
+            class RcuPointer
+            {
+            public:
+                explicit RcuPointer(std::unique_ptr<const T> initial) : current_(initial.release()) {}
+
+                /**
+                 * \brief 析构时不能再有读者
+                 */
+                ~RcuPointer() { delete current_.load(std::memory_order_relaxed); }
+
+                RcuPointer(const RcuPointer &) = delete;
+                RcuPointer &operator=(const RcuPointer &) = delete;
+
+                const T *Load() const noexcept { return current_.load(std::memory_order_seq_cst); }
+
+                void Store(std::unique_ptr<const T> next)
+                {
+                    const T *previous = current_.exchange(next.release(), std::memory_order_seq_cst);
+                    RcuDomain::Instance().Retire([previous]
+                                                 { delete previous; });
+                }
+
+            private:
+                std::atomic<const T *> current_;
+            };
+
+        } // namespace utils
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _RCU_H_
@@ -0,0 +1,158 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 单写多读的顺序锁 读端无锁
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _SEQLOCK_HPP_
+#define _SEQLOCK_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace ara
+{
+    namespace com
+    {
+        namespace utils
+        {
+            /**
+             * \brief 自旋等待时让出流水线
+             */
+            inline void CpuRelax() noexcept
+            {
+#if defined(__x86_64__) || defined(__i386__)
+                _mm_pause();
+#elif defined(__aarch64__)
+                asm volatile("yield" ::: "memory");
+#endif
+            }
+
+            /**
+             * \brief 顺序锁 (seqlock)
+             *
+             * 写端每次写入前后各递增一次序号 序号为奇数代表正在写
+             * 读端拷贝数据后校验序号未变化 否则重读 读端不会阻塞写端
+             * 只支持单个写者 多写者需要在外部串行化
+             *
+             * \tparam T 必须是 trivially copyable 的类型
+             */
+            template <typename T>
+            class SeqLock
+            {
+                static_assert(std::is_trivially_copyable<T>::value, "SeqLock requires a trivially copyable type");
+
+            public:
+                SeqLock() noexcept : seq_(0), value_() {}
+
+                explicit SeqLock(const T &value) noexcept : seq_(0), value_(value) {}
+
+                SeqLock(const SeqLock &) = delete;
+                SeqLock &operator=(const SeqLock &) = delete;
+
+                /**
+                 * \brief 写入新值 只允许一个写者
+                 * \param value 新值
+                 */
+                void Store(const T &value) noexcept
+                {
+                    const uint32_t seq = seq_.load(std::memory_order_relaxed);
+                    seq_.store(seq + 1, std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_release);
+                    std::memcpy(static_cast<void *>(&value_), &value, sizeof(T));
+                    seq_.store(seq + 2, std::memory_order_release);
+                }
+
+                /**
+                 * \brief 写者在写入中途退出 (如共享内存里的写端进程崩溃) 后由新的写者调用 用 value 完成这次写入
+                 *
+                 * 序号为偶数时等同于 Store
+                 */
+                void Recover(const T &value) noexcept
+                {
+                    const uint32_t seq = seq_.load(std::memory_order_relaxed);
+                    if ((seq & 1U) == 0)
+                    {
+                        Store(value);
+                        return;
+                    }
+                    std::memcpy(static_cast<void *>(&value_), &value, sizeof(T));
+                    seq_.store(seq + 1, std::memory_order_release);
+                }
+
+                /**
+                 * \brief 读取一致的快照 写端在写入途中退出时一直自旋 跨进程共享时用 TryLoad
+                 * \return T 最近一次完整写入的值
+                 */
+                T Load() const noexcept
+                {
+                    T out;
+                    uint32_t begin;
+                    uint32_t end;
+                    do
+                    {
+                        begin = seq_.load(std::memory_order_acquire);
+                        while (begin & 1U)
+                        {
+                            CpuRelax();
+                            begin = seq_.load(std::memory_order_acquire);
+                        }
+                        std::memcpy(static_cast<void *>(&out), &value_, sizeof(T));
+                        std::atomic_thread_fence(std::memory_order_acquire);
+                        end = seq_.load(std::memory_order_relaxed);
+                    } while (begin != end);
+                    return out;
+                }
+
+                /**
+                 * \brief 和 Load 一样读取一致的快照 但序号持续为奇数超过 maxSpins 次时放弃
+                 * 写端可能在别的进程里写到一半退出了 调用方据此加写锁后 Recover
+                 * \return 放弃时返回 false out 的内容无效
+                 */
+                bool TryLoad(T &out, uint32_t maxSpins) const noexcept
+                {
+                    uint32_t spins = 0;
+                    uint32_t begin;
+                    uint32_t end;
+                    do
+                    {
+                        begin = seq_.load(std::memory_order_acquire);
+                        while (begin & 1U)
+                        {
+                            if (spins++ == maxSpins)
+                            {
+                                return false;
+                            }
+                            CpuRelax();
+                            begin = seq_.load(std::memory_order_acquire);
+                        }
+                        std::memcpy(static_cast<void *>(&out), &value_, sizeof(T));
+                        std::atomic_thread_fence(std::memory_order_acquire);
+                        end = seq_.load(std::memory_order_relaxed);
+                    } while (begin != end);
+                    return true;
+                }
+
+                /**
+                 * \brief 当前序号 每完成一次写入增加 2
+                 */
+                uint32_t Sequence() const noexcept { return seq_.load(std::memory_order_acquire); }
+
+            private:
+                alignas(64) std::atomic<uint32_t> seq_;
+                T value_;
+            };
+
+        } // namespace utils
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _SEQLOCK_HPP_
@@ -0,0 +1,88 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 进程共用的定时任务线程
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _TASK_SCHEDULER_H_
+#define _TASK_SCHEDULER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+namespace ara
+{
+    namespace com
+    {
+        namespace utils
+        {
+            /**
+             * \brief 进程唯一的定时任务线程
+             *
+             * FindServiceAsync 的超时 在 binding 回调之外停止查找 (binding 的查找回调里通常不能停止自己)
+             * 以及方法调用的超时清理都在这一个线程上执行 任务应当很短 不能阻塞
+             */
+            class TaskScheduler
+            {
+            public:
+                using Clock = std::chrono::steady_clock;
+                using Task = std::function<void()>;
+
+                static TaskScheduler &Instance();
+
+                TaskScheduler(const TaskScheduler &) = delete;
+                TaskScheduler &operator=(const TaskScheduler &) = delete;
+
+                /**
+                 * \brief deadline 到达后在调度线程上执行
+                 * \return 传给 Cancel 的 id 从 1 开始
+                 */
+                uint64_t At(Clock::time_point deadline, Task task);
+
+                /**
+                 * \brief 尽快在调度线程上执行
+                 */
+                void Post(Task task) { At(Clock::now(), std::move(task)); }
+
+                /**
+                 * \return 任务还没开始执行并被移除时返回 true
+                 */
+                bool Cancel(uint64_t id);
+
+                /**
+                 * \brief 等待中的任务数
+                 */
+                size_t Pending() const;
+
+            private:
+                using TaskKey = std::pair<Clock::time_point, uint64_t>;
+
+                TaskScheduler();
+
+                ~TaskScheduler();
+
+                void run();
+
+                mutable std::mutex mutex_;
+                std::condition_variable wakeup_;
+                std::map<TaskKey, Task> tasks_;                         // 按 deadline 排序 同一时刻按提交顺序
+                std::unordered_map<uint64_t, Clock::time_point> index_; // id -> deadline 用于 Cancel
+                uint64_t nextId_;
+                bool stopping_;
+                std::thread thread_;
+            };
+
+        } // namespace utils
+
+    } // namespace com
+
+} // namespace ara
+
+#endif // _TASK_SCHEDULER_H_
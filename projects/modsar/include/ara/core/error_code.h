@@ -6,6 +6,8 @@
 #ifndef ARA_CORE_ERROR_CODE_H_
 #define ARA_CORE_ERROR_CODE_H_
 
+#include <ostream>
+
 #include "ara/core/error_domain.h"
 #include "ara/core/string_view.h"
 
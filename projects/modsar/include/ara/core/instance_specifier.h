@@ -0,0 +1,95 @@
+/**
+ * \copyright BCSC all rights resvered
+ * \brief 模型元素路径 只保存驻留表的句柄 拷贝和比较都是整数操作
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _ARA_CORE_INSTANCE_SPECIFIER_H_
+#define _ARA_CORE_INSTANCE_SPECIFIER_H_
+
+#include <functional>
+
+#include "ara/core/core_error_domain.h"
+#include "ara/core/intern_table.h"
+#include "ara/core/result.h"
+#include "ara/core/string_view.h"
+
+namespace ara
+{
+    namespace core
+    {
+        /**
+         * \brief 标识一个 AUTOSAR 模型元素 形如 "Executable/RootComponent/Port"
+         *
+         * @traceid{SWS_CORE_08001}
+         */
+        class InstanceSpecifier final
+        {
+        public:
+            /**
+             * \brief 路径不合法时抛出 CoreException
+             *
+             * @traceid{SWS_CORE_08021}
+             */
+            explicit InstanceSpecifier(StringView metaModelIdentifier)
+                : handle_(Create(metaModelIdentifier).ValueOrThrow().handle_)
+            {
+            }
+
+            /**
+             * \brief 每一段都必须是 shortname 以字母开头 只含字母 数字和下划线 段之间用 '/' 分隔
+             * \return 某一段含非法字符时返回 kInvalidMetaModelShortname 路径为空或有空段时返回 kInvalidMetaModelPath
+             *
+             * @traceid{SWS_CORE_08032}
+             */
+            static Result<InstanceSpecifier> Create(StringView metaModelIdentifier);
+
+            /**
+             * \brief 返回的字符串在进程内一直有效
+             *
+             * @traceid{SWS_CORE_08041}
+             */
+            StringView ToString() const noexcept { return InternTable::Instance().Lookup(handle_); }
+
+            /**
+             * \brief 驻留表的句柄 可以直接作为 map 的键
+             */
+            InternHandle Handle() const noexcept { return handle_; }
+
+            bool operator==(const InstanceSpecifier &other) const noexcept { return handle_ == other.handle_; }
+
+            bool operator!=(const InstanceSpecifier &other) const noexcept { return handle_ != other.handle_; }
+
+            /**
+             * \brief 按句柄排序 只保证在进程内稳定 不是字典序
+             */
+            bool operator<(const InstanceSpecifier &other) const noexcept { return handle_ < other.handle_; }
+
+        private:
+            struct Interned
+            {
+            };
+
+            InstanceSpecifier(Interned, InternHandle handle) noexcept : handle_(handle) {}
+
+            InternHandle handle_;
+        };
+
+    } // namespace core
+
+} // namespace ara
+
+namespace std
+{
+    template <>
+    struct hash<ara::core::InstanceSpecifier>
+    {
+        size_t operator()(const ara::core::InstanceSpecifier &specifier) const noexcept
+        {
+            return static_cast<size_t>(specifier.Handle());
+        }
+    };
+
+} // namespace std
+
+#endif // _ARA_CORE_INSTANCE_SPECIFIER_H_
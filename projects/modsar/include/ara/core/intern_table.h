@@ -0,0 +1,102 @@
+/**
+ * \copyright BCSC all rights resvered
+ * \brief 进程唯一的字符串驻留表 相同的字符串得到相同的 64 位句柄
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _ARA_CORE_INTERN_TABLE_H_
+#define _ARA_CORE_INTERN_TABLE_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "ara/core/string_view.h"
+
+namespace ara
+{
+    namespace core
+    {
+        /**
+         * \brief 驻留字符串的句柄 低 32 位为表内序号 高 32 位为字符串的哈希
+         * 同一进程内句柄相等当且仅当字符串相等 句柄本身可以直接作为哈希值和 map 的键
+         */
+        using InternHandle = uint64_t;
+
+        constexpr InternHandle kEmptyInternHandle = 0; ///< 空字符串的句柄
+
+        /**
+         * \brief 字符串驻留表
+         *
+         * InstanceIdentifier 和 InstanceSpecifier 只保存句柄 拷贝和比较不再分配内存 不再逐字节比较
+         * 驻留的字符串不释放 地址不变 Lookup 返回的 StringView 在进程内一直有效
+         * Intern 加锁 只在构造标识时调用 Lookup 不加锁 按序号找到分块里的字符串
+         */
+        class InternTable
+        {
+        public:
+            static constexpr size_t kChunkSize = 1024;
+            static constexpr size_t kMaxChunks = 4096; ///< 最多驻留 kChunkSize * kMaxChunks 个字符串
+
+            static InternTable &Instance();
+
+            InternTable(const InternTable &) = delete;
+            InternTable &operator=(const InternTable &) = delete;
+
+            /**
+             * \brief 已经驻留时返回原来的句柄 表满时终止进程
+             */
+            InternHandle Intern(StringView value);
+
+            /**
+             * \brief 不加锁 序号超出已驻留的范围时返回空字符串
+             */
+            StringView Lookup(InternHandle handle) const noexcept;
+
+            /**
+             * \brief 已驻留的字符串个数 包括空字符串
+             */
+            size_t Size() const noexcept { return size_.load(std::memory_order_acquire); }
+
+            static uint32_t IndexOf(InternHandle handle) noexcept { return static_cast<uint32_t>(handle); }
+
+        private:
+            using Chunk = std::array<const std::string *, kChunkSize>;
+
+            // 指向驻留字符串的键 用于查重 不拷贝字符串
+            struct Key
+            {
+                const char *data;
+                size_t size;
+                uint32_t hash;
+
+                bool operator==(const Key &other) const noexcept
+                {
+                    return size == other.size && std::char_traits<char>::compare(data, other.data, size) == 0;
+                }
+            };
+
+            struct KeyHash
+            {
+                size_t operator()(const Key &key) const noexcept { return key.hash; }
+            };
+
+            InternTable();
+
+            static uint32_t hashOf(const char *data, size_t size) noexcept;
+
+            std::mutex mutex_; // 串行化 Intern
+            std::unordered_map<Key, InternHandle, KeyHash> handles_;
+            std::array<std::atomic<Chunk *>, kMaxChunks> chunks_;
+            std::atomic<uint32_t> size_; // 先写入字符串再增加 Lookup 据此判断序号是否有效
+        };
+
+    } // namespace core
+
+} // namespace ara
+
+#endif // _ARA_CORE_INTERN_TABLE_H_
@@ -141,7 +141,7 @@ namespace ara {
          * \param e 左值实例
          * @traceid{SWS_CORE_00725}
          */
-        Result(Result const& oth   er) = default;
+        Result(Result const& other) = default;
         
         /**
          * \brief 移动构造函数
@@ -443,7 +443,7 @@ namespace ara {
         template <typename U>
         using result_of_t = typename std::result_of<U>::type;
 
-        *  \brief Trait that detects whether a type is a Result<...>
+        //  \brief Trait that detects whether a type is a Result<...>
         template <typename U>
         struct is_result : std::false_type { };
 
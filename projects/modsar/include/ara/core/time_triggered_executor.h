@@ -0,0 +1,146 @@
+/**
+ * \copyright BCSC all rights resvered
+ * \brief 时间触发的确定性执行器 按固定周期表执行注册的 activity
+ * \author ZYL
+ * \date 2026/10/18
+ */
+#ifndef _ARA_CORE_TIME_TRIGGERED_EXECUTOR_H_
+#define _ARA_CORE_TIME_TRIGGERED_EXECUTOR_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ara/core/core_error_domain.h"
+#include "ara/core/result.h"
+
+namespace ara
+{
+    namespace core
+    {
+        /**
+         * \brief activity 执行超过周期 错过了下一次释放时间时的处理
+         */
+        enum class OverrunPolicy : uint8_t
+        {
+            kSkip = 0, ///< 跳过错过的释放 对齐到下一个未来的周期 计入 skipped
+            kCatchUp   ///< 立即补执行 直到追上周期表
+        };
+
+        /**
+         * \brief 一个 activity 的调度参数
+         *
+         * 第 n 次释放时间是 start + offset + n * period 全部是绝对时间 不会累积漂移
+         */
+        struct ActivityConfig
+        {
+            std::string name;
+            std::chrono::nanoseconds period{0};  ///< 周期 必须大于 0
+            std::chrono::nanoseconds offset{0};  ///< 相对执行器启动时间的相位 小于 period
+            std::chrono::nanoseconds budget{0};  ///< 从释放时间算起的截止时间 为 0 时取 period 超过即为 overrun
+            int cpu = -1;                        ///< 绑定的 CPU 核 -1 表示不绑定 同一个核上的 activity 在同一个线程里串行
+            int priority = 0;                    ///< SCHED_FIFO 优先级 1 ~ 99 为 0 时保持默认调度
+            OverrunPolicy overrunPolicy = OverrunPolicy::kSkip;
+        };
+
+        /**
+         * \brief 一个 activity 的执行统计 单位 ns
+         */
+        struct ActivityStatistics
+        {
+            uint64_t runs = 0;
+            uint64_t overruns = 0;       ///< 执行结束晚于截止时间的次数
+            uint64_t skipped = 0;        ///< kSkip 下跳过的释放次数
+            uint64_t maxJitterNs = 0;    ///< 实际开始时间相对释放时间的最大延迟
+            uint64_t meanJitterNs = 0;
+            uint64_t maxExecutionNs = 0;
+            uint64_t lastExecutionNs = 0;
+            bool priorityApplied = false; ///< 配置了优先级但没有权限设置 SCHED_FIFO 时为 false
+        };
+
+        /**
+         * \brief 时间触发执行器
+         *
+         * 每个绑定的 CPU 核一个线程 不绑定的 activity 共用一个线程
+         * 线程用 clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME) 睡到下一个释放时间
+         * 同一时刻释放的 activity 按注册顺序执行 执行结束晚于截止时间时记为 overrun 并回调 OverrunHandler
+         * 所有线程共用同一个启动时间 不同核上的 activity 之间相位确定
+         *
+         * 典型用法是在一个周期里依次 ProcessNextMethodCall 轮询 EventProxy 发送 event
+         * 见 ara/com/utils/poll_activity.hpp
+         */
+        class TimeTriggeredExecutor
+        {
+        public:
+            using Activity = std::function<void()>;
+
+            /**
+             * \brief overrun 回调 在 activity 所在线程上调用 需要尽快返回
+             * \param name activity 的名字
+             * \param execution 本次执行耗时
+             * \param lateness 结束时间超出截止时间的量
+             */
+            using OverrunHandler = std::function<void(const std::string &name, std::chrono::nanoseconds execution,
+                                                      std::chrono::nanoseconds lateness)>;
+
+            TimeTriggeredExecutor();
+
+            /**
+             * \brief 停止并等待线程退出
+             */
+            ~TimeTriggeredExecutor();
+
+            TimeTriggeredExecutor(const TimeTriggeredExecutor &) = delete;
+            TimeTriggeredExecutor &operator=(const TimeTriggeredExecutor &) = delete;
+
+            /**
+             * \brief 注册 activity 只能在 Start 之前调用
+             * \return activity 的编号 参数不合法或已经启动时返回 CoreErrc::kInvalidArgument
+             */
+            Result<size_t> AddActivity(const ActivityConfig &config, Activity activity);
+
+            void SetOverrunHandler(OverrunHandler handler);
+
+            /**
+             * \brief 启动全部线程 第一个周期从 startDelay 之后开始
+             * \return 没有 activity 已经启动或绑核失败时返回 CoreErrc::kInvalidArgument
+             */
+            Result<void> Start(std::chrono::nanoseconds startDelay = std::chrono::milliseconds(1));
+
+            /**
+             * \brief 停止 正在睡眠的线程在下一个释放时间醒来后退出 最长等待一个周期
+             */
+            void Stop();
+
+            bool IsRunning() const { return running_.load(std::memory_order_acquire); }
+
+            size_t ActivityCount() const { return activities_.size(); }
+
+            ActivityStatistics GetStatistics(size_t id) const;
+
+        private:
+            struct ActivityState;
+            struct Lane;
+
+            void runLane(Lane &lane, int64_t startNs);
+
+            void runActivity(ActivityState &activity);
+
+        private:
+            std::vector<std::unique_ptr<ActivityState>> activities_;
+            std::vector<std::unique_ptr<Lane>> lanes_;
+            OverrunHandler overrunHandler_;
+            std::atomic<bool> running_;
+            std::mutex startMutex_; // 串行化 Start 和 Stop
+        };
+
+    } // namespace core
+
+} // namespace ara
+
+#endif // _ARA_CORE_TIME_TRIGGERED_EXECUTOR_H_
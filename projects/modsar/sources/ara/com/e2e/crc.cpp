@@ -0,0 +1,339 @@
+#include <cstring>
+
+#include "ara/com/e2e/crc.h"
+#include "ara/com/serialization/byte_order.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define ARA_COM_CRC_PCLMUL 1
+#endif
+
+namespace ara
+{
+    namespace com
+    {
+        namespace e2e
+        {
+            namespace
+            {
+                /**
+                 * \brief 按小端读 8 个字节 slicing-by-8 按内存顺序取字节
+                 */
+                inline uint64_t loadLittle64(const uint8_t *data)
+                {
+                    uint64_t value;
+                    std::memcpy(&value, data, sizeof(value));
+                    if (serialization::kHostIsBigEndian)
+                    {
+                        value = serialization::ByteSwapper<8>::Swap(value);
+                    }
+                    return value;
+                }
+
+                /**
+                 * \brief 反射 (LSB first) CRC 的 slicing-by-8 表 用于 CRC32P4 和 CRC64
+                 *
+                 * table_[k][b] 为字节 b 后面再跟 k 个 0 字节时对 CRC 状态的贡献
+                 */
+                template <typename W>
+                class ReflectedTable
+                {
+                public:
+                    explicit ReflectedTable(W reflectedPoly)
+                    {
+                        for (uint32_t b = 0; b < 256; ++b)
+                        {
+                            W crc = b;
+                            for (int bit = 0; bit < 8; ++bit)
+                            {
+                                crc = (crc & 1) ? static_cast<W>((crc >> 1) ^ reflectedPoly) : static_cast<W>(crc >> 1);
+                            }
+                            table_[0][b] = crc;
+                        }
+                        for (int k = 1; k < 8; ++k)
+                        {
+                            for (uint32_t b = 0; b < 256; ++b)
+                            {
+                                const W previous = table_[k - 1][b];
+                                table_[k][b] = static_cast<W>((previous >> 8) ^ table_[0][previous & 0xFF]);
+                            }
+                        }
+                    }
+
+                    /**
+                     * \brief 在内部状态上继续计算 不做初值和结果异或
+                     */
+                    W Update(W state, const uint8_t *data, size_t length) const
+                    {
+                        while (length >= 8)
+                        {
+                            const uint64_t block = loadLittle64(data) ^ static_cast<uint64_t>(state);
+                            state = static_cast<W>(table_[7][block & 0xFF] ^ table_[6][(block >> 8) & 0xFF] ^
+                                                   table_[5][(block >> 16) & 0xFF] ^ table_[4][(block >> 24) & 0xFF] ^
+                                                   table_[3][(block >> 32) & 0xFF] ^ table_[2][(block >> 40) & 0xFF] ^
+                                                   table_[1][(block >> 48) & 0xFF] ^ table_[0][block >> 56]);
+                            data += 8;
+                            length -= 8;
+                        }
+                        while (length-- != 0)
+                        {
+                            state = static_cast<W>((state >> 8) ^ table_[0][(state ^ *data++) & 0xFF]);
+                        }
+                        return state;
+                    }
+
+                private:
+                    W table_[8][256];
+                };
+
+                /**
+                 * \brief 非反射 (MSB first) CRC 的 slicing-by-8 表 用于 CRC8H2F 和 CRC16
+                 */
+                template <typename W>
+                class NormalTable
+                {
+                public:
+                    static constexpr uint32_t kWidth = sizeof(W) * 8;
+
+                    explicit NormalTable(W poly)
+                    {
+                        const uint32_t top = 1U << (kWidth - 1);
+                        for (uint32_t b = 0; b < 256; ++b)
+                        {
+                            uint32_t crc = b << (kWidth - 8);
+                            for (int bit = 0; bit < 8; ++bit)
+                            {
+                                crc = (crc & top) ? ((crc << 1) ^ poly) : (crc << 1);
+                            }
+                            table_[0][b] = static_cast<W>(crc);
+                        }
+                        for (int k = 1; k < 8; ++k)
+                        {
+                            for (uint32_t b = 0; b < 256; ++b)
+                            {
+                                const uint32_t previous = table_[k - 1][b];
+                                table_[k][b] = static_cast<W>((previous << 8) ^ table_[0][(previous >> (kWidth - 8)) & 0xFF]);
+                            }
+                        }
+                    }
+
+                    W Update(W state, const uint8_t *data, size_t length) const
+                    {
+                        uint32_t crc = state;
+                        while (length >= 8)
+                        {
+                            uint8_t block[8];
+                            std::memcpy(block, data, sizeof(block));
+                            // 状态按高字节在前异或进前 kWidth / 8 个字节
+                            for (uint32_t i = 0; i < kWidth / 8; ++i)
+                            {
+                                block[i] ^= static_cast<uint8_t>(crc >> (kWidth - 8 * (i + 1)));
+                            }
+                            crc = table_[7][block[0]] ^ table_[6][block[1]] ^ table_[5][block[2]] ^ table_[4][block[3]] ^
+                                  table_[3][block[4]] ^ table_[2][block[5]] ^ table_[1][block[6]] ^ table_[0][block[7]];
+                            data += 8;
+                            length -= 8;
+                        }
+                        while (length-- != 0)
+                        {
+                            crc = (crc << 8) ^ table_[0][((crc >> (kWidth - 8)) ^ *data++) & 0xFF];
+                        }
+                        return static_cast<W>(crc);
+                    }
+
+                private:
+                    W table_[8][256];
+                };
+
+                const NormalTable<uint8_t> g_crc8H2F(0x2F);
+                const NormalTable<uint16_t> g_crc16(0x1021);
+                const ReflectedTable<uint32_t> g_crc32P4(0xC8DF352FU);
+                const ReflectedTable<uint64_t> g_crc64(0xC96C5795D7870F42ULL);
+
+#if defined(ARA_COM_CRC_PCLMUL)
+                /**
+                 * \brief x^n mod P 的值 P 为 width 位的正常 (非反射) 多项式 省略最高位
+                 */
+                uint64_t powerModulo(uint32_t n, uint64_t poly, uint32_t width)
+                {
+                    const uint64_t mask = (width == 64) ? ~0ULL : ((1ULL << width) - 1);
+                    uint64_t remainder = 1;
+                    for (uint32_t i = 0; i < n; ++i)
+                    {
+                        const bool carry = ((remainder >> (width - 1)) & 1) != 0;
+                        remainder = (remainder << 1) & mask;
+                        if (carry)
+                        {
+                            remainder ^= poly;
+                        }
+                    }
+                    return remainder;
+                }
+
+                uint64_t reverse64(uint64_t value)
+                {
+                    uint64_t result = 0;
+                    for (int bit = 0; bit < 64; ++bit)
+                    {
+                        result = (result << 1) | ((value >> bit) & 1);
+                    }
+                    return result;
+                }
+
+                /**
+                 * \brief 反射 CRC 的折叠常数
+                 *
+                 * 16 字节块按小端读入后 第 j 位对应 x^(127 - j) 低 64 位是高次部分 H 高 64 位是低次部分 L
+                 * 向后折叠 D 位时需要 H * x^(D + 64) 和 L * x^D 两个 64 位反射表示的乘积 clmul 的结果自带一个 x
+                 * 因此常数取 x^(D + 63) mod P 和 x^(D - 1) mod P 再按 64 位反射
+                 */
+                struct FoldConstants
+                {
+                    FoldConstants(uint64_t poly, uint32_t width)
+                        : fold128Low(reverse64(powerModulo(128 + 63, poly, width))),
+                          fold128High(reverse64(powerModulo(128 - 1, poly, width))),
+                          fold512Low(reverse64(powerModulo(512 + 63, poly, width))),
+                          fold512High(reverse64(powerModulo(512 - 1, poly, width)))
+                    {
+                    }
+
+                    uint64_t fold128Low;
+                    uint64_t fold128High;
+                    uint64_t fold512Low;
+                    uint64_t fold512High;
+                };
+
+                const FoldConstants g_fold32P4(0xF4ACFB13ULL, 32);
+                const FoldConstants g_fold64(0x42F0E1EBA9EA3693ULL, 64);
+
+                constexpr size_t kFoldThreshold = 128; // 短数据查表更快
+
+                __attribute__((target("pclmul,sse2"))) inline __m128i fold(__m128i value, __m128i constants)
+                {
+                    return _mm_xor_si128(_mm_clmulepi64_si128(value, constants, 0x00),
+                                         _mm_clmulepi64_si128(value, constants, 0x11));
+                }
+
+                /**
+                 * \brief 4 路并行折叠到剩余不足 16 字节 再对 16 字节余式和尾部查表
+                 */
+                template <typename W>
+                __attribute__((target("pclmul,sse2"))) W foldReflected(const ReflectedTable<W> &table, const FoldConstants &constants,
+                                                                      W state, const uint8_t *data, size_t length)
+                {
+                    const __m128i k128 = _mm_set_epi64x(static_cast<long long>(constants.fold128High), static_cast<long long>(constants.fold128Low));
+                    const __m128i k512 = _mm_set_epi64x(static_cast<long long>(constants.fold512High), static_cast<long long>(constants.fold512Low));
+
+                    // 初始状态等价于异或进报文的前 W 位
+                    __m128i x0 = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data)),
+                                               _mm_set_epi64x(0, static_cast<long long>(state)));
+                    __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 16));
+                    __m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 32));
+                    __m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 48));
+                    data += 64;
+                    length -= 64;
+                    while (length >= 64)
+                    {
+                        x0 = _mm_xor_si128(fold(x0, k512), _mm_loadu_si128(reinterpret_cast<const __m128i *>(data)));
+                        x1 = _mm_xor_si128(fold(x1, k512), _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 16)));
+                        x2 = _mm_xor_si128(fold(x2, k512), _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 32)));
+                        x3 = _mm_xor_si128(fold(x3, k512), _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 48)));
+                        data += 64;
+                        length -= 64;
+                    }
+                    x1 = _mm_xor_si128(fold(x0, k128), x1);
+                    x2 = _mm_xor_si128(fold(x1, k128), x2);
+                    x3 = _mm_xor_si128(fold(x2, k128), x3);
+                    while (length >= 16)
+                    {
+                        x3 = _mm_xor_si128(fold(x3, k128), _mm_loadu_si128(reinterpret_cast<const __m128i *>(data)));
+                        data += 16;
+                        length -= 16;
+                    }
+                    alignas(16) uint8_t remainder[16];
+                    _mm_store_si128(reinterpret_cast<__m128i *>(remainder), x3);
+                    state = table.Update(0, remainder, sizeof(remainder));
+                    return table.Update(state, data, length);
+                }
+
+                bool hasPclmul()
+                {
+                    static const bool supported = []
+                    {
+                        __builtin_cpu_init();
+                        return __builtin_cpu_supports("pclmul") != 0;
+                    }();
+                    return supported;
+                }
+#endif // ARA_COM_CRC_PCLMUL
+
+                template <typename W>
+                W updateReflected(const ReflectedTable<W> &table, const void *constants, W state, const uint8_t *data, size_t length)
+                {
+#if defined(ARA_COM_CRC_PCLMUL)
+                    if (length >= kFoldThreshold && !serialization::kHostIsBigEndian && hasPclmul())
+                    {
+                        return foldReflected(table, *static_cast<const FoldConstants *>(constants), state, data, length);
+                    }
+#endif
+                    (void)constants;
+                    return table.Update(state, data, length);
+                }
+
+                const void *constants32P4()
+                {
+#if defined(ARA_COM_CRC_PCLMUL)
+                    return &g_fold32P4;
+#else
+                    return nullptr;
+#endif
+                }
+
+                const void *constants64()
+                {
+#if defined(ARA_COM_CRC_PCLMUL)
+                    return &g_fold64;
+#else
+                    return nullptr;
+#endif
+                }
+            } // namespace
+
+            uint8_t CalculateCrc8H2F(const uint8_t *data, size_t length, uint8_t startValue, bool isFirstCall)
+            {
+                const uint8_t state = isFirstCall ? 0xFF : static_cast<uint8_t>(startValue ^ 0xFF);
+                return static_cast<uint8_t>(g_crc8H2F.Update(state, data, length) ^ 0xFF);
+            }
+
+            uint16_t CalculateCrc16(const uint8_t *data, size_t length, uint16_t startValue, bool isFirstCall)
+            {
+                const uint16_t state = isFirstCall ? 0xFFFF : startValue;
+                return g_crc16.Update(state, data, length);
+            }
+
+            uint32_t CalculateCrc32P4(const uint8_t *data, size_t length, uint32_t startValue, bool isFirstCall)
+            {
+                const uint32_t state = isFirstCall ? 0xFFFFFFFFU : (startValue ^ 0xFFFFFFFFU);
+                return updateReflected(g_crc32P4, constants32P4(), state, data, length) ^ 0xFFFFFFFFU;
+            }
+
+            uint64_t CalculateCrc64(const uint8_t *data, size_t length, uint64_t startValue, bool isFirstCall)
+            {
+                const uint64_t state = isFirstCall ? ~0ULL : ~startValue;
+                return ~updateReflected(g_crc64, constants64(), state, data, length);
+            }
+
+            bool IsCrcAccelerated()
+            {
+#if defined(ARA_COM_CRC_PCLMUL)
+                return hasPclmul();
+#else
+                return false;
+#endif
+            }
+
+        } // namespace e2e
+
+    } // namespace com
+
+} // namespace ara
@@ -0,0 +1,331 @@
+#include <cstdint>
+
+#include "ara/com/e2e/e2e_profiles.h"
+#include "ara/com/e2e/crc.h"
+#include "ara/com/serialization/byte_order.hpp"
+
+using ara::com::serialization::LoadBigEndian;
+using ara::com::serialization::StoreBigEndian;
+
+namespace ara
+{
+    namespace com
+    {
+        namespace e2e
+        {
+            bool IE2EProfile::AcceptsLength(size_t length) const
+            {
+                if (length < config_.offset + HeaderSize() || length < config_.minDataLength || length > config_.maxDataLength ||
+                    length > MaxLength())
+                {
+                    return false;
+                }
+                return config_.dataLength == 0 || length == config_.dataLength;
+            }
+
+            namespace
+            {
+                /**
+                 * \brief 跳过 CRC 字段分两段计算 CRC 计算函数的签名与 crc.h 相同
+                 *
+                 * 第一段为空时返回 初值 ^ 结果异或 第二段以 isFirstCall = false 继续时还原成初值 结果不变
+                 */
+                template <typename W, typename Function>
+                W crcSkippingField(Function function, const uint8_t *data, size_t length, size_t offset, size_t crcSize)
+                {
+                    W crc = function(data, offset, 0, true);
+                    return function(data + offset + crcSize, length - offset - crcSize, crc, false);
+                }
+
+                /**
+                 * \brief profile 4: | Length16 | Counter16 | DataID32 | CRC32 | 全部大端
+                 *
+                 * @ID{[PRS_E2E_00372]}
+                 */
+                class Profile04 : public IE2EProfile
+                {
+                public:
+                    explicit Profile04(const E2EProfileConfig &config) : IE2EProfile(config) {}
+
+                    size_t HeaderSize() const override { return 12; }
+
+                    uint64_t CounterRange() const override { return 0x10000; }
+
+                    uint64_t MaxLength() const override { return 0xFFFF; }
+
+                    bool Protect(uint8_t *data, size_t length, uint32_t counter) const override
+                    {
+                        if (!AcceptsLength(length))
+                        {
+                            return false;
+                        }
+                        uint8_t *header = data + config_.offset;
+                        StoreBigEndian(static_cast<uint16_t>(length), header);
+                        StoreBigEndian(static_cast<uint16_t>(counter), header + 2);
+                        StoreBigEndian(config_.dataId, header + 4);
+                        StoreBigEndian(crc(data, length), header + 8);
+                        return true;
+                    }
+
+                    ProfileCheckStatus Check(const uint8_t *data, size_t length, uint32_t &counter) const override
+                    {
+                        if (!AcceptsLength(length))
+                        {
+                            return ProfileCheckStatus::kError;
+                        }
+                        const uint8_t *header = data + config_.offset;
+                        if (LoadBigEndian<uint16_t>(header) != length || LoadBigEndian<uint32_t>(header + 4) != config_.dataId ||
+                            LoadBigEndian<uint32_t>(header + 8) != crc(data, length))
+                        {
+                            return ProfileCheckStatus::kError;
+                        }
+                        counter = LoadBigEndian<uint16_t>(header + 2);
+                        return ProfileCheckStatus::kOk;
+                    }
+
+                private:
+                    uint32_t crc(const uint8_t *data, size_t length) const
+                    {
+                        // CRC 覆盖头部 CRC 字段前的 8 个字节
+                        return crcSkippingField<uint32_t>(&CalculateCrc32P4, data, length, config_.offset + 8, 4);
+                    }
+                };
+
+                /**
+                 * \brief profile 5: | CRC16 (小端) | Counter8 | DataID 不发送 低字节在前追加到 CRC
+                 *
+                 * @ID{[PRS_E2E_00399]}
+                 */
+                class Profile05 : public IE2EProfile
+                {
+                public:
+                    explicit Profile05(const E2EProfileConfig &config) : IE2EProfile(config) {}
+
+                    size_t HeaderSize() const override { return 3; }
+
+                    uint64_t CounterRange() const override { return 0x100; }
+
+                    uint64_t MaxLength() const override { return UINT64_MAX; }
+
+                    bool Protect(uint8_t *data, size_t length, uint32_t counter) const override
+                    {
+                        if (!AcceptsLength(length))
+                        {
+                            return false;
+                        }
+                        uint8_t *header = data + config_.offset;
+                        header[2] = static_cast<uint8_t>(counter);
+                        const uint16_t value = crc(data, length);
+                        header[0] = static_cast<uint8_t>(value);
+                        header[1] = static_cast<uint8_t>(value >> 8);
+                        return true;
+                    }
+
+                    ProfileCheckStatus Check(const uint8_t *data, size_t length, uint32_t &counter) const override
+                    {
+                        if (!AcceptsLength(length))
+                        {
+                            return ProfileCheckStatus::kError;
+                        }
+                        const uint8_t *header = data + config_.offset;
+                        const uint16_t received = static_cast<uint16_t>(header[0] | (header[1] << 8));
+                        if (received != crc(data, length))
+                        {
+                            return ProfileCheckStatus::kError;
+                        }
+                        counter = header[2];
+                        return ProfileCheckStatus::kOk;
+                    }
+
+                private:
+                    uint16_t crc(const uint8_t *data, size_t length) const
+                    {
+                        const uint8_t dataId[2] = {static_cast<uint8_t>(config_.dataId), static_cast<uint8_t>(config_.dataId >> 8)};
+                        const uint16_t value = crcSkippingField<uint16_t>(&CalculateCrc16, data, length, config_.offset, 2);
+                        return CalculateCrc16(dataId, sizeof(dataId), value, false);
+                    }
+                };
+
+                /**
+                 * \brief profile 6: | CRC16 | Length16 | Counter8 | 大端 DataID 不发送 高字节在前追加到 CRC
+                 *
+                 * @ID{[PRS_E2E_00479]}
+                 */
+                class Profile06 : public IE2EProfile
+                {
+                public:
+                    explicit Profile06(const E2EProfileConfig &config) : IE2EProfile(config) {}
+
+                    size_t HeaderSize() const override { return 5; }
+
+                    uint64_t CounterRange() const override { return 0x100; }
+
+                    uint64_t MaxLength() const override { return 0xFFFF; }
+
+                    bool Protect(uint8_t *data, size_t length, uint32_t counter) const override
+                    {
+                        if (!AcceptsLength(length))
+                        {
+                            return false;
+                        }
+                        uint8_t *header = data + config_.offset;
+                        StoreBigEndian(static_cast<uint16_t>(length), header + 2);
+                        header[4] = static_cast<uint8_t>(counter);
+                        StoreBigEndian(crc(data, length), header);
+                        return true;
+                    }
+
+                    ProfileCheckStatus Check(const uint8_t *data, size_t length, uint32_t &counter) const override
+                    {
+                        if (!AcceptsLength(length))
+                        {
+                            return ProfileCheckStatus::kError;
+                        }
+                        const uint8_t *header = data + config_.offset;
+                        if (LoadBigEndian<uint16_t>(header + 2) != length || LoadBigEndian<uint16_t>(header) != crc(data, length))
+                        {
+                            return ProfileCheckStatus::kError;
+                        }
+                        counter = header[4];
+                        return ProfileCheckStatus::kOk;
+                    }
+
+                private:
+                    uint16_t crc(const uint8_t *data, size_t length) const
+                    {
+                        const uint8_t dataId[2] = {static_cast<uint8_t>(config_.dataId >> 8), static_cast<uint8_t>(config_.dataId)};
+                        const uint16_t value = crcSkippingField<uint16_t>(&CalculateCrc16, data, length, config_.offset, 2);
+                        return CalculateCrc16(dataId, sizeof(dataId), value, false);
+                    }
+                };
+
+                /**
+                 * \brief profile 7: | CRC64 | Length32 | Counter32 | DataID32 | 全部大端 用于大数据量
+                 *
+                 * @ID{[PRS_E2E_00545]}
+                 */
+                class Profile07 : public IE2EProfile
+                {
+                public:
+                    explicit Profile07(const E2EProfileConfig &config) : IE2EProfile(config) {}
+
+                    size_t HeaderSize() const override { return 20; }
+
+                    uint64_t CounterRange() const override { return 0x100000000ULL; }
+
+                    uint64_t MaxLength() const override { return 0xFFFFFFFFULL; }
+
+                    bool Protect(uint8_t *data, size_t length, uint32_t counter) const override
+                    {
+                        if (!AcceptsLength(length))
+                        {
+                            return false;
+                        }
+                        uint8_t *header = data + config_.offset;
+                        StoreBigEndian(static_cast<uint32_t>(length), header + 8);
+                        StoreBigEndian(counter, header + 12);
+                        StoreBigEndian(config_.dataId, header + 16);
+                        StoreBigEndian(crc(data, length), header);
+                        return true;
+                    }
+
+                    ProfileCheckStatus Check(const uint8_t *data, size_t length, uint32_t &counter) const override
+                    {
+                        if (!AcceptsLength(length))
+                        {
+                            return ProfileCheckStatus::kError;
+                        }
+                        const uint8_t *header = data + config_.offset;
+                        if (LoadBigEndian<uint32_t>(header + 8) != length || LoadBigEndian<uint32_t>(header + 16) != config_.dataId ||
+                            LoadBigEndian<uint64_t>(header) != crc(data, length))
+                        {
+                            return ProfileCheckStatus::kError;
+                        }
+                        counter = LoadBigEndian<uint32_t>(header + 12);
+                        return ProfileCheckStatus::kOk;
+                    }
+
+                private:
+                    uint64_t crc(const uint8_t *data, size_t length) const
+                    {
+                        return crcSkippingField<uint64_t>(&CalculateCrc64, data, length, config_.offset, 8);
+                    }
+                };
+
+                /**
+                 * \brief profile 22: | CRC8H2F | Counter4 (低 4 位) | DataIDList[Counter] 追加到 CRC
+                 *
+                 * @ID{[PRS_E2E_00599]}
+                 */
+                class Profile22 : public IE2EProfile
+                {
+                public:
+                    explicit Profile22(const E2EProfileConfig &config) : IE2EProfile(config) {}
+
+                    size_t HeaderSize() const override { return 2; }
+
+                    uint64_t CounterRange() const override { return 16; }
+
+                    uint64_t MaxLength() const override { return UINT64_MAX; }
+
+                    bool Protect(uint8_t *data, size_t length, uint32_t counter) const override
+                    {
+                        if (!AcceptsLength(length))
+                        {
+                            return false;
+                        }
+                        uint8_t *header = data + config_.offset;
+                        header[1] = static_cast<uint8_t>((header[1] & 0xF0) | (counter & 0x0F));
+                        header[0] = crc(data, length, counter & 0x0F);
+                        return true;
+                    }
+
+                    ProfileCheckStatus Check(const uint8_t *data, size_t length, uint32_t &counter) const override
+                    {
+                        if (!AcceptsLength(length))
+                        {
+                            return ProfileCheckStatus::kError;
+                        }
+                        const uint8_t *header = data + config_.offset;
+                        const uint32_t received = header[1] & 0x0F;
+                        if (header[0] != crc(data, length, received))
+                        {
+                            return ProfileCheckStatus::kError;
+                        }
+                        counter = received;
+                        return ProfileCheckStatus::kOk;
+                    }
+
+                private:
+                    uint8_t crc(const uint8_t *data, size_t length, uint32_t counter) const
+                    {
+                        const uint8_t value = crcSkippingField<uint8_t>(&CalculateCrc8H2F, data, length, config_.offset, 1);
+                        return CalculateCrc8H2F(&config_.dataIdList[counter], 1, value, false);
+                    }
+                };
+            } // namespace
+
+            std::unique_ptr<IE2EProfile> CreateE2EProfile(const E2EProfileConfig &config)
+            {
+                switch (config.profile)
+                {
+                case E2EProfile::kProfile04:
+                    return std::unique_ptr<IE2EProfile>(new Profile04(config));
+                case E2EProfile::kProfile05:
+                    return std::unique_ptr<IE2EProfile>(new Profile05(config));
+                case E2EProfile::kProfile06:
+                    return std::unique_ptr<IE2EProfile>(new Profile06(config));
+                case E2EProfile::kProfile07:
+                    return std::unique_ptr<IE2EProfile>(new Profile07(config));
+                case E2EProfile::kProfile22:
+                    return std::unique_ptr<IE2EProfile>(new Profile22(config));
+                default:
+                    return nullptr;
+                }
+            }
+
+        } // namespace e2e
+
+    } // namespace com
+
+} // namespace ara
@@ -0,0 +1,65 @@
+#include "ara/com/e2e/e2e_protector.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace e2e
+        {
+            E2EProtector::E2EProtector(const E2EProfileConfig &config)
+                : profile_(CreateE2EProfile(config)), counter_(0)
+            {
+            }
+
+            bool E2EProtector::Protect(uint8_t *data, size_t length)
+            {
+                if (!profile_ || !profile_->AcceptsLength(length))
+                {
+                    return false;
+                }
+                // 并发发送时 counter 只保证唯一 不保证按发送顺序到达
+                const uint32_t counter = counter_.fetch_add(1, std::memory_order_relaxed);
+                return profile_->Protect(data, length, static_cast<uint32_t>(counter % profile_->CounterRange()));
+            }
+
+            E2EChecker::E2EChecker(const E2EProfileConfig &config)
+                : profile_(CreateE2EProfile(config)), lastCounter_(0), hasLastCounter_(false)
+            {
+            }
+
+            ProfileCheckStatus E2EChecker::Check(const uint8_t *data, size_t length)
+            {
+                if (!profile_)
+                {
+                    return ProfileCheckStatus::kCheckDisabled;
+                }
+                uint32_t counter = 0;
+                if (profile_->Check(data, length, counter) != ProfileCheckStatus::kOk)
+                {
+                    return ProfileCheckStatus::kError;
+                }
+                if (!hasLastCounter_)
+                {
+                    hasLastCounter_ = true;
+                    lastCounter_ = counter;
+                    return ProfileCheckStatus::kOk;
+                }
+                const uint64_t range = profile_->CounterRange();
+                const uint64_t delta = (static_cast<uint64_t>(counter) + range - lastCounter_) % range;
+                lastCounter_ = counter;
+                if (delta == 0)
+                {
+                    return ProfileCheckStatus::kRepeated;
+                }
+                if (delta <= profile_->GetConfig().maxDeltaCounter)
+                {
+                    return ProfileCheckStatus::kOk;
+                }
+                return ProfileCheckStatus::kWrongSequence;
+            }
+
+        } // namespace e2e
+
+    } // namespace com
+
+} // namespace ara
@@ -0,0 +1,120 @@
+#include <algorithm>
+
+#include "ara/com/e2e/e2e_state_machine.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace e2e
+        {
+            constexpr uint8_t E2EStateMachine::kMaxWindowSize;
+
+            E2EStateMachine::E2EStateMachine(const E2EStateMachineConfig &config)
+                : config_(config), state_(SMState::kNoData)
+            {
+                config_.windowSizeInit = std::min(std::max(config_.windowSizeInit, uint8_t(1)), kMaxWindowSize);
+                config_.windowSizeValid = std::min(std::max(config_.windowSizeValid, uint8_t(1)), kMaxWindowSize);
+                config_.windowSizeInvalid = std::min(std::max(config_.windowSizeInvalid, uint8_t(1)), kMaxWindowSize);
+                clearWindow();
+            }
+
+            void E2EStateMachine::Reset()
+            {
+                state_ = SMState::kNoData;
+                clearWindow();
+            }
+
+            SMState E2EStateMachine::Update(ProfileCheckStatus status)
+            {
+                if (status == ProfileCheckStatus::kCheckDisabled)
+                {
+                    return state_;
+                }
+                // 窗口按当前状态的大小滑动 挤出的结果从计数里减掉
+                const uint8_t size = windowSize();
+                while (filled_ >= size)
+                {
+                    const uint8_t oldest = static_cast<uint8_t>((next_ + kMaxWindowSize - filled_) % kMaxWindowSize);
+                    okCount_ -= (window_[oldest] == ProfileCheckStatus::kOk) ? 1 : 0;
+                    errorCount_ -= (window_[oldest] == ProfileCheckStatus::kError) ? 1 : 0;
+                    --filled_;
+                }
+                window_[next_] = status;
+                next_ = static_cast<uint8_t>((next_ + 1) % kMaxWindowSize);
+                ++filled_;
+                okCount_ += (status == ProfileCheckStatus::kOk) ? 1 : 0;
+                errorCount_ += (status == ProfileCheckStatus::kError) ? 1 : 0;
+
+                const SMState previous = state_;
+                switch (state_)
+                {
+                case SMState::kNoData:
+                    if (status != ProfileCheckStatus::kError && status != ProfileCheckStatus::kNoNewData)
+                    {
+                        state_ = SMState::kInit;
+                    }
+                    break;
+                case SMState::kInit:
+                    if (accepted(config_.minOkStateInit, config_.maxErrorStateInit))
+                    {
+                        state_ = SMState::kValid;
+                    }
+                    else if (errorCount_ > config_.maxErrorStateInit)
+                    {
+                        state_ = SMState::kInvalid;
+                    }
+                    break;
+                case SMState::kValid:
+                    if (!accepted(config_.minOkStateValid, config_.maxErrorStateValid))
+                    {
+                        state_ = SMState::kInvalid;
+                    }
+                    break;
+                case SMState::kInvalid:
+                    if (accepted(config_.minOkStateInvalid, config_.maxErrorStateInvalid))
+                    {
+                        state_ = SMState::kValid;
+                    }
+                    break;
+                default:
+                    break;
+                }
+                if (previous != SMState::kInvalid && state_ == SMState::kInvalid && config_.clearToInvalid)
+                {
+                    clearWindow();
+                }
+                return state_;
+            }
+
+            uint8_t E2EStateMachine::windowSize() const
+            {
+                switch (state_)
+                {
+                case SMState::kValid:
+                    return config_.windowSizeValid;
+                case SMState::kInvalid:
+                    return config_.windowSizeInvalid;
+                default:
+                    return config_.windowSizeInit;
+                }
+            }
+
+            void E2EStateMachine::clearWindow()
+            {
+                next_ = 0;
+                filled_ = 0;
+                okCount_ = 0;
+                errorCount_ = 0;
+            }
+
+            bool E2EStateMachine::accepted(uint8_t minOk, uint8_t maxError) const
+            {
+                return okCount_ >= minOk && errorCount_ <= maxError;
+            }
+
+        } // namespace e2e
+
+    } // namespace com
+
+} // namespace ara
@@ -0,0 +1,69 @@
+#include <chrono>
+
+#include "ara/com/event/token_bucket.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace event
+        {
+            namespace
+            {
+                int64_t intervalOf(const RateLimitConfig &config)
+                {
+                    if (config.samplesPerSecond <= 0.0)
+                    {
+                        return 0;
+                    }
+                    const int64_t interval = static_cast<int64_t>(1e9 / config.samplesPerSecond);
+                    return interval > 0 ? interval : 1;
+                }
+            } // namespace
+
+            TokenBucket::TokenBucket(const RateLimitConfig &config)
+                : intervalNs_(intervalOf(config)),
+                  toleranceNs_(intervalOf(config) * static_cast<int64_t>(config.burst > 1 ? config.burst - 1 : 0)),
+                  theoreticalArrival_(0), accepted_(0), rejected_(0)
+            {
+            }
+
+            bool TokenBucket::TryAcquire()
+            {
+                if (intervalNs_ == 0)
+                {
+                    accepted_.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+                return TryAcquire(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+            }
+
+            bool TokenBucket::TryAcquire(int64_t nowNs)
+            {
+                if (intervalNs_ == 0)
+                {
+                    accepted_.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+                int64_t arrival = theoreticalArrival_.load(std::memory_order_relaxed);
+                for (;;)
+                {
+                    const int64_t start = arrival > nowNs ? arrival : nowNs;
+                    if (start - nowNs > toleranceNs_)
+                    {
+                        rejected_.fetch_add(1, std::memory_order_relaxed);
+                        return false;
+                    }
+                    if (theoreticalArrival_.compare_exchange_weak(arrival, start + intervalNs_, std::memory_order_relaxed))
+                    {
+                        accepted_.fetch_add(1, std::memory_order_relaxed);
+                        return true;
+                    }
+                }
+            }
+
+        } // namespace event
+
+    } // namespace com
+
+} // namespace ara
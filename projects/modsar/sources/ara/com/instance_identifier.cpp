@@ -0,0 +1,68 @@
+#include "ara/com/com_error_domain.h"
+#include "ara/com/types.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace
+        {
+            // 十进制数字 超过 32 位或不是数字时返回 kInvalidId
+            uint32_t parseId(const char *data, int size)
+            {
+                if (size == 0 || size > 10)
+                {
+                    return InstanceIdentifier::kInvalidId;
+                }
+                uint64_t value = 0;
+                for (int i = 0; i < size; ++i)
+                {
+                    if (data[i] < '0' || data[i] > '9')
+                    {
+                        return InstanceIdentifier::kInvalidId;
+                    }
+                    value = value * 10 + static_cast<uint64_t>(data[i] - '0');
+                }
+                return value < InstanceIdentifier::kInvalidId ? static_cast<uint32_t>(value) : InstanceIdentifier::kInvalidId;
+            }
+        } // namespace
+
+        constexpr uint32_t InstanceIdentifier::kInvalidId;
+
+        ara::core::Result<InstanceIdentifier> InstanceIdentifier::Create(ara::core::StringView serializedFormat)
+        {
+            const char *data = serializedFormat.data();
+            const int size = serializedFormat.size();
+            if (size == 0)
+            {
+                return ara::core::Result<InstanceIdentifier>::FromError(MakeErrorCode(ComErrc::kInvalidInstanceIdentifierString, 0));
+            }
+            int idStart = 0;
+            for (int i = 0; i < size; ++i)
+            {
+                const unsigned char c = static_cast<unsigned char>(data[i]);
+                if (c <= ' ' || c == 0x7F)
+                {
+                    return ara::core::Result<InstanceIdentifier>::FromError(MakeErrorCode(ComErrc::kInvalidInstanceIdentifierString, 0));
+                }
+                if (c == ':')
+                {
+                    idStart = i + 1;
+                }
+            }
+            return ara::core::Result<InstanceIdentifier>::FromValue(
+                InstanceIdentifier(ara::core::InternTable::Instance().Intern(serializedFormat), parseId(data + idStart, size - idStart)));
+        }
+
+        ara::core::Result<uint16_t> InstanceIdentifier::BindingId() const noexcept
+        {
+            if (id_ == 0 || id_ >= 0xFFFF)
+            {
+                return ara::core::Result<uint16_t>::FromError(MakeErrorCode(ComErrc::kInvalidInstanceIdentifierString, 0));
+            }
+            return ara::core::Result<uint16_t>::FromValue(static_cast<uint16_t>(id_));
+        }
+
+    } // namespace com
+
+} // namespace ara
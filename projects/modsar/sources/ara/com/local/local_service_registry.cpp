@@ -0,0 +1,162 @@
+#include <algorithm>
+
+#include "ara/com/com_error_domain.h"
+#include "ara/com/local/local_service.hpp"
+#include "ara/com/local/local_service_registry.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace local
+        {
+            constexpr uint16_t LocalServiceRegistry::kAnyInstance;
+
+            LocalServiceRegistry &LocalServiceRegistry::Instance()
+            {
+                static LocalServiceRegistry registry;
+                return registry;
+            }
+
+            LocalServiceRegistry::LocalServiceRegistry() : table_(std::make_shared<const Table>()), nextClient_(0), nextWatchId_(1)
+            {
+            }
+
+            ara::core::Result<void> LocalServiceRegistry::Offer(std::shared_ptr<LocalService> service)
+            {
+                const uint32_t key = keyOf(service->ServiceId(), service->InstanceId());
+                {
+                    std::lock_guard<std::mutex> lock(writeMutex_);
+                    std::shared_ptr<const Table> current = std::atomic_load(&table_);
+                    if (current->count(key) != 0)
+                    {
+                        return ara::core::Result<void>::FromError(MakeErrorCode(ComErrc::kCouldNotExecute, 0));
+                    }
+                    std::shared_ptr<Table> next = std::make_shared<Table>(*current);
+                    next->emplace(key, std::move(service));
+                    std::atomic_store(&table_, std::shared_ptr<const Table>(std::move(next)));
+                }
+                notifyWatches();
+                return ara::core::Result<void>::FromValue();
+            }
+
+            void LocalServiceRegistry::StopOffer(uint16_t serviceId, uint16_t instanceId, const LocalService *owner)
+            {
+                const uint32_t key = keyOf(serviceId, instanceId);
+                std::shared_ptr<const Table> previous; // 最后一个引用在锁外释放
+                {
+                    std::lock_guard<std::mutex> lock(writeMutex_);
+                    std::shared_ptr<const Table> current = std::atomic_load(&table_);
+                    auto found = current->find(key);
+                    if (found == current->end() || found->second.get() != owner)
+                    {
+                        return;
+                    }
+                    std::shared_ptr<Table> next = std::make_shared<Table>(*current);
+                    next->erase(key);
+                    previous = std::atomic_exchange(&table_, std::shared_ptr<const Table>(std::move(next)));
+                }
+                notifyWatches();
+            }
+
+            std::shared_ptr<LocalService> LocalServiceRegistry::Find(uint16_t serviceId, uint16_t instanceId) const
+            {
+                const std::shared_ptr<const Table> table = std::atomic_load(&table_);
+                if (instanceId != kAnyInstance)
+                {
+                    auto found = table->find(keyOf(serviceId, instanceId));
+                    return found != table->end() ? found->second : nullptr;
+                }
+                for (const auto &entry : *table)
+                {
+                    if (entry.second->ServiceId() == serviceId)
+                    {
+                        return entry.second;
+                    }
+                }
+                return nullptr;
+            }
+
+            std::vector<std::shared_ptr<LocalService>> LocalServiceRegistry::FindAll(uint16_t serviceId, uint16_t instanceId) const
+            {
+                std::vector<std::shared_ptr<LocalService>> services;
+                const std::shared_ptr<const Table> table = std::atomic_load(&table_);
+                for (const auto &entry : *table)
+                {
+                    if (entry.second->ServiceId() == serviceId && (instanceId == kAnyInstance || entry.second->InstanceId() == instanceId))
+                    {
+                        services.push_back(entry.second);
+                    }
+                }
+                std::sort(services.begin(), services.end(), [](const std::shared_ptr<LocalService> &left, const std::shared_ptr<LocalService> &right)
+                          { return left->InstanceId() < right->InstanceId(); });
+                return services;
+            }
+
+            uint16_t LocalServiceRegistry::NextClientId()
+            {
+                return static_cast<uint16_t>(0x8000 | (nextClient_.fetch_add(1, std::memory_order_relaxed) & 0x7FFF));
+            }
+
+            uint64_t LocalServiceRegistry::StartFind(uint16_t serviceId, uint16_t instanceId, LocalFindHandler handler)
+            {
+                std::lock_guard<std::recursive_mutex> notifying(handlerMutex_);
+                std::shared_ptr<Watch> watch = std::make_shared<Watch>();
+                watch->serviceId = serviceId;
+                watch->instanceId = instanceId;
+                watch->handler = std::move(handler);
+                watch->last = FindAll(serviceId, instanceId);
+                {
+                    std::lock_guard<std::mutex> lock(watchMutex_);
+                    watch->id = nextWatchId_++;
+                    watches_.push_back(watch);
+                }
+                watch->handler(watch->last);
+                return watch->id;
+            }
+
+            void LocalServiceRegistry::StopFind(uint64_t id)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(watchMutex_);
+                    watches_.erase(std::remove_if(watches_.begin(), watches_.end(), [id](const std::shared_ptr<Watch> &watch)
+                                                  { return watch->id == id; }),
+                                   watches_.end());
+                }
+                // 等待正在执行的通知 在 handler 里调用时是同一线程 递归锁直接返回
+                std::lock_guard<std::recursive_mutex> notifying(handlerMutex_);
+            }
+
+            void LocalServiceRegistry::notifyWatches()
+            {
+                std::lock_guard<std::recursive_mutex> notifying(handlerMutex_);
+                std::vector<std::shared_ptr<Watch>> watches;
+                {
+                    std::lock_guard<std::mutex> lock(watchMutex_);
+                    watches = watches_;
+                }
+                for (const std::shared_ptr<Watch> &watch : watches)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(watchMutex_);
+                        if (std::find(watches_.begin(), watches_.end(), watch) == watches_.end())
+                        {
+                            continue; // 前一个 handler 里被 StopFind
+                        }
+                    }
+                    // 并发的 Offer 串行通知 每次都读最新的表 last 只在 handlerMutex_ 内访问
+                    std::vector<std::shared_ptr<LocalService>> current = FindAll(watch->serviceId, watch->instanceId);
+                    if (current == watch->last)
+                    {
+                        continue;
+                    }
+                    watch->last = current;
+                    watch->handler(current);
+                }
+            }
+
+        } // namespace local
+
+    } // namespace com
+
+} // namespace ara
@@ -0,0 +1,414 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "ara/com/com_error_domain.h"
+#include "ara/com/record/recorder.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace record
+        {
+            namespace
+            {
+                std::atomic<uint64_t> g_nextRecorderId{1};
+                std::atomic<uint32_t> g_nextThreadIndex{0};
+                std::atomic<Recorder *> g_activeRecorder{nullptr};
+
+                size_t roundUpPowerOfTwo(size_t value)
+                {
+                    size_t result = 64;
+                    while (result < value)
+                    {
+                        result <<= 1;
+                    }
+                    return result;
+                }
+
+                uint64_t nowNs()
+                {
+                    return static_cast<uint64_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+                }
+            } // namespace
+
+            /**
+             * \brief 单生产者单消费者的字节环 生产者是录制线程 消费者是写线程
+             *
+             * head_ / tail_ 是单调递增的字节位置 取模后才是下标 记录可以跨越环尾
+             */
+            class Recorder::ThreadBuffer
+            {
+            public:
+                ThreadBuffer(size_t capacity, uint32_t index)
+                    : storage_(new uint8_t[capacity]), capacity_(capacity), index_(index), head_(0), tail_(0)
+                {
+                }
+
+                bool Push(RecordHeader &header, const uint8_t *payload, size_t length)
+                {
+                    const size_t size = RecordSize(length);
+                    const uint64_t tail = tail_.load(std::memory_order_relaxed);
+                    const uint64_t head = head_.load(std::memory_order_acquire);
+                    if (size > capacity_ - static_cast<size_t>(tail - head))
+                    {
+                        return false;
+                    }
+                    header.threadIndex = index_;
+                    copyIn(tail, &header, sizeof(header));
+                    copyIn(tail + sizeof(header), payload, length);
+                    tail_.store(tail + size, std::memory_order_release);
+                    return true;
+                }
+
+                /**
+                 * \brief 取出最早一条记录的头部 不出队
+                 */
+                bool Peek(RecordHeader &header) const
+                {
+                    const uint64_t head = head_.load(std::memory_order_relaxed);
+                    if (head == tail_.load(std::memory_order_acquire))
+                    {
+                        return false;
+                    }
+                    copyOut(head, &header, sizeof(header));
+                    return true;
+                }
+
+                void CopyPayload(uint8_t *dst, size_t length) const
+                {
+                    copyOut(head_.load(std::memory_order_relaxed) + sizeof(RecordHeader), dst, length);
+                }
+
+                void Pop(size_t length)
+                {
+                    head_.store(head_.load(std::memory_order_relaxed) + RecordSize(length), std::memory_order_release);
+                }
+
+            private:
+                void copyIn(uint64_t position, const void *src, size_t length)
+                {
+                    const size_t index = static_cast<size_t>(position & (capacity_ - 1));
+                    const size_t first = std::min(length, capacity_ - index);
+                    std::memcpy(storage_.get() + index, src, first);
+                    std::memcpy(storage_.get(), static_cast<const uint8_t *>(src) + first, length - first);
+                }
+
+                void copyOut(uint64_t position, void *dst, size_t length) const
+                {
+                    const size_t index = static_cast<size_t>(position & (capacity_ - 1));
+                    const size_t first = std::min(length, capacity_ - index);
+                    std::memcpy(dst, storage_.get() + index, first);
+                    std::memcpy(static_cast<uint8_t *>(dst) + first, storage_.get(), length - first);
+                }
+
+            private:
+                std::unique_ptr<uint8_t[]> storage_;
+                const size_t capacity_;
+                const uint32_t index_;
+                alignas(64) std::atomic<uint64_t> head_; // 消费者和生产者的位置放在不同的 cache line
+                alignas(64) std::atomic<uint64_t> tail_;
+            };
+
+            /**
+             * \brief 当前分段文件 只在写线程里使用
+             */
+            class Recorder::SegmentWriter
+            {
+            public:
+                explicit SegmentWriter(const RecorderConfig &config)
+                    : config_(config), index_(0), fd_(-1), base_(nullptr), used_(0), opened_(0)
+                {
+                }
+
+                ~SegmentWriter() { Close(); }
+
+                ara::core::Result<void> Open()
+                {
+                    if (index_ == 0)
+                    {
+                        // 同名的旧录制 回放按编号连续读取 留下的后续分段会混进新录制
+                        for (uint64_t stale = 1; ::unlink(pathOf(stale).c_str()) == 0; ++stale)
+                        {
+                        }
+                    }
+                    const std::string path = pathOf(index_);
+                    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+                    if (fd_ < 0)
+                    {
+                        return ara::core::Result<void>::FromError(MakeErrorCode(ComErrc::kErroneousFileHandle, 0));
+                    }
+                    void *mapped = MAP_FAILED;
+                    if (::ftruncate(fd_, static_cast<off_t>(config_.segmentSize)) == 0)
+                    {
+                        mapped = ::mmap(nullptr, config_.segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+                    }
+                    if (mapped == MAP_FAILED)
+                    {
+                        ::close(fd_);
+                        fd_ = -1;
+                        return ara::core::Result<void>::FromError(MakeErrorCode(ComErrc::kErroneousFileHandle, 0));
+                    }
+                    base_ = static_cast<uint8_t *>(mapped);
+                    SegmentHeader *header = segmentHeader();
+                    std::memcpy(header->magic, kRecordMagic, sizeof(header->magic));
+                    header->version = kRecordVersion;
+                    header->headerSize = sizeof(SegmentHeader);
+                    header->segmentIndex = index_;
+                    used_ = sizeof(SegmentHeader);
+                    header->usedBytes = used_;
+                    opened_.fetch_add(1, std::memory_order_relaxed);
+                    return ara::core::Result<void>::FromValue();
+                }
+
+                /**
+                 * \brief 在当前分段里预留 size 字节 放不下时切换到下一个分段
+                 * \return 记录大于整个分段或打开文件失败时返回 nullptr
+                 */
+                uint8_t *Reserve(size_t size)
+                {
+                    if (size > config_.segmentSize - sizeof(SegmentHeader))
+                    {
+                        return nullptr;
+                    }
+                    if (base_ == nullptr || used_ + size > config_.segmentSize)
+                    {
+                        Close();
+                        if (!Open().HasValue())
+                        {
+                            return nullptr;
+                        }
+                    }
+                    return base_ + used_;
+                }
+
+                void Commit(size_t size) { used_ += size; }
+
+                /**
+                 * \brief 更新文件头里的已写入长度 页面由内核异步写回
+                 */
+                void Sync()
+                {
+                    if (base_ != nullptr)
+                    {
+                        segmentHeader()->usedBytes = used_;
+                    }
+                }
+
+                void Close()
+                {
+                    if (base_ == nullptr)
+                    {
+                        return;
+                    }
+                    Sync();
+                    ::munmap(base_, config_.segmentSize);
+                    // 截掉预先扩展但没有用到的部分
+                    if (::ftruncate(fd_, static_cast<off_t>(used_)) != 0)
+                    {
+                        // usedBytes 已经写入 回放不依赖文件长度
+                    }
+                    ::close(fd_);
+                    base_ = nullptr;
+                    fd_ = -1;
+                    ++index_; // 再次 Start 时接着编号 不覆盖已关闭的分段
+                }
+
+                uint64_t Opened() const { return opened_.load(std::memory_order_relaxed); }
+
+            private:
+                SegmentHeader *segmentHeader() { return reinterpret_cast<SegmentHeader *>(base_); }
+
+                std::string pathOf(uint64_t index) const
+                {
+                    char name[32];
+                    std::snprintf(name, sizeof(name), ".%06llu.arcrec", static_cast<unsigned long long>(index));
+                    return config_.directory + "/" + config_.prefix + name;
+                }
+
+            private:
+                const RecorderConfig &config_;
+                uint64_t index_;
+                int fd_;
+                uint8_t *base_;
+                size_t used_;
+                std::atomic<uint64_t> opened_; // GetStatistics 在其他线程读
+            };
+
+            Recorder::Recorder(const RecorderConfig &config)
+                : config_(config),
+                  id_(g_nextRecorderId.fetch_add(1, std::memory_order_relaxed)),
+                  running_(false),
+                  writer_(new SegmentWriter(config_)),
+                  recorded_(0),
+                  dropped_(0),
+                  bytes_(0)
+            {
+            }
+
+            Recorder::~Recorder()
+            {
+                Recorder *self = this;
+                g_activeRecorder.compare_exchange_strong(self, nullptr);
+                // 已经读到本录制器的 binding 线程还在 RecordPayload 的读区里
+                utils::RcuDomain::Instance().Synchronize();
+                Stop();
+            }
+
+            ara::core::Result<void> Recorder::Start()
+            {
+                if (running_.load())
+                {
+                    return ara::core::Result<void>::FromValue();
+                }
+                ara::core::Result<void> opened = writer_->Open();
+                if (!opened.HasValue())
+                {
+                    return opened;
+                }
+                running_.store(true);
+                thread_ = std::thread(&Recorder::writerLoop, this);
+                return ara::core::Result<void>::FromValue();
+            }
+
+            void Recorder::Stop()
+            {
+                if (!running_.exchange(false))
+                {
+                    return;
+                }
+                {
+                    std::lock_guard<std::mutex> lock(wakeMutex_);
+                }
+                wake_.notify_one();
+                thread_.join();
+            }
+
+            bool Recorder::Record(RecordKind kind, const RecordKey &key, const uint8_t *payload, size_t length)
+            {
+                if (!running_.load(std::memory_order_relaxed) || length > UINT32_MAX)
+                {
+                    return false;
+                }
+                RecordHeader header{};
+                header.payloadLength = static_cast<uint32_t>(length);
+                header.kind = kind;
+                header.client = key.client;
+                header.timestampNs = nowNs();
+                header.service = key.service;
+                header.instance = key.instance;
+                header.id = key.id;
+                header.session = key.session;
+                if (!threadBuffer()->Push(header, payload, length))
+                {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                return true;
+            }
+
+            RecorderStatistics Recorder::GetStatistics() const
+            {
+                RecorderStatistics statistics;
+                statistics.recorded = recorded_.load(std::memory_order_relaxed);
+                statistics.dropped = dropped_.load(std::memory_order_relaxed);
+                statistics.bytes = bytes_.load(std::memory_order_relaxed);
+                statistics.segments = writer_->Opened();
+                return statistics;
+            }
+
+            Recorder::ThreadBuffer *Recorder::threadBuffer()
+            {
+                // 按录制器 id 缓存 录制器换了之后重新注册 旧的指针不会再被使用
+                thread_local uint64_t cachedOwner = 0;
+                thread_local ThreadBuffer *cachedBuffer = nullptr;
+                if (cachedOwner == id_)
+                {
+                    return cachedBuffer;
+                }
+                std::shared_ptr<ThreadBuffer> buffer = std::make_shared<ThreadBuffer>(
+                    roundUpPowerOfTwo(config_.threadBufferSize), g_nextThreadIndex.fetch_add(1, std::memory_order_relaxed));
+                {
+                    std::lock_guard<std::mutex> lock(buffersMutex_);
+                    buffers_.push_back(buffer);
+                }
+                cachedOwner = id_;
+                cachedBuffer = buffer.get();
+                return cachedBuffer;
+            }
+
+            void Recorder::writerLoop()
+            {
+                while (running_.load())
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(wakeMutex_);
+                        wake_.wait_for(lock, config_.flushInterval, [this]
+                                       { return !running_.load(); });
+                    }
+                    drainAll();
+                }
+                drainAll();
+                writer_->Close();
+            }
+
+            void Recorder::drainAll()
+            {
+                std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+                {
+                    std::lock_guard<std::mutex> lock(buffersMutex_);
+                    buffers = buffers_;
+                }
+                uint64_t recorded = 0;
+                uint64_t bytes = 0;
+                uint64_t dropped = 0;
+                for (const std::shared_ptr<ThreadBuffer> &buffer : buffers)
+                {
+                    RecordHeader header;
+                    while (buffer->Peek(header))
+                    {
+                        const size_t size = RecordSize(header.payloadLength);
+                        uint8_t *dst = writer_->Reserve(size);
+                        if (dst == nullptr)
+                        {
+                            ++dropped;
+                        }
+                        else
+                        {
+                            std::memcpy(dst, &header, sizeof(header));
+                            buffer->CopyPayload(dst + sizeof(header), header.payloadLength);
+                            std::memset(dst + sizeof(header) + header.payloadLength, 0, size - sizeof(header) - header.payloadLength);
+                            writer_->Commit(size);
+                            ++recorded;
+                            bytes += size;
+                        }
+                        buffer->Pop(header.payloadLength);
+                    }
+                }
+                writer_->Sync();
+                recorded_.fetch_add(recorded, std::memory_order_relaxed);
+                bytes_.fetch_add(bytes, std::memory_order_relaxed);
+                dropped_.fetch_add(dropped, std::memory_order_relaxed);
+            }
+
+            void SetActiveRecorder(Recorder *recorder)
+            {
+                g_activeRecorder.store(recorder, std::memory_order_seq_cst);
+            }
+
+            Recorder *GetActiveRecorder()
+            {
+                return g_activeRecorder.load(std::memory_order_seq_cst); // 和 RCU 的 epoch 一样用 seq_cst
+            }
+
+        } // namespace record
+
+    } // namespace com
+
+} // namespace ara
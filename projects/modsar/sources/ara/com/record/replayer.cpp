@@ -0,0 +1,174 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#include "ara/com/com_error_domain.h"
+#include "ara/com/record/replayer.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace record
+        {
+            Replayer::Replayer(const std::string &directory, const std::string &prefix)
+                : directory_(directory), prefix_(prefix), stopped_(false)
+            {
+            }
+
+            Replayer::~Replayer()
+            {
+                close();
+            }
+
+            ara::core::Result<void> Replayer::Open()
+            {
+                close();
+                for (uint64_t segmentIndex = 0;; ++segmentIndex)
+                {
+                    char name[32];
+                    std::snprintf(name, sizeof(name), ".%06llu.arcrec", static_cast<unsigned long long>(segmentIndex));
+                    const std::string path = directory_ + "/" + prefix_ + name;
+                    const int fd = ::open(path.c_str(), O_RDONLY);
+                    if (fd < 0)
+                    {
+                        break;
+                    }
+                    struct stat status;
+                    void *mapped = MAP_FAILED;
+                    if (::fstat(fd, &status) == 0 && static_cast<size_t>(status.st_size) >= sizeof(SegmentHeader))
+                    {
+                        mapped = ::mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+                    }
+                    ::close(fd);
+                    if (mapped == MAP_FAILED)
+                    {
+                        break;
+                    }
+                    Segment segment{mapped, static_cast<size_t>(status.st_size)};
+                    segments_.push_back(segment);
+                    if (!index(segment))
+                    {
+                        if (segmentIndex == 0)
+                        {
+                            close();
+                            return ara::core::Result<void>::FromError(MakeErrorCode(ComErrc::kErroneousFileHandle, 0));
+                        }
+                        break;
+                    }
+                }
+                if (segments_.empty())
+                {
+                    return ara::core::Result<void>::FromError(MakeErrorCode(ComErrc::kErroneousFileHandle, 0));
+                }
+                // 各线程的记录在文件里只是大致有序 稳定排序保证同一线程内的先后不变
+                std::stable_sort(records_.begin(), records_.end(), [](const RecordHeader *left, const RecordHeader *right)
+                                 { return left->timestampNs < right->timestampNs; });
+                return ara::core::Result<void>::FromValue();
+            }
+
+            void Replayer::RegisterSink(RecordKind kind, uint16_t service, uint16_t instance, uint16_t id, ReplaySink sink)
+            {
+                sinks_[sinkKey(kind, service, instance, id)] = std::move(sink);
+            }
+
+            ReplayStatistics Replayer::Run(ReplayMode mode, double speed)
+            {
+                using Clock = std::chrono::steady_clock;
+                ReplayStatistics statistics;
+                stopped_.store(false, std::memory_order_relaxed);
+                if (records_.empty())
+                {
+                    return statistics;
+                }
+                if (speed <= 0.0)
+                {
+                    speed = 1.0;
+                }
+                const uint64_t firstNs = records_.front()->timestampNs;
+                const Clock::time_point start = Clock::now();
+                for (const RecordHeader *record : records_)
+                {
+                    if (stopped_.load(std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                    if (mode == ReplayMode::kOriginalTiming)
+                    {
+                        const Clock::time_point due =
+                            start + std::chrono::duration_cast<Clock::duration>(
+                                        std::chrono::nanoseconds(static_cast<int64_t>((record->timestampNs - firstNs) / speed)));
+                        std::this_thread::sleep_until(due);
+                        const Clock::duration lateness = Clock::now() - due;
+                        if (lateness > statistics.maxLateness)
+                        {
+                            statistics.maxLateness = std::chrono::duration_cast<std::chrono::nanoseconds>(lateness);
+                        }
+                    }
+                    std::unordered_map<uint64_t, ReplaySink>::const_iterator sink =
+                        sinks_.find(sinkKey(record->kind, record->service, record->instance, record->id));
+                    if (sink == sinks_.end())
+                    {
+                        ++statistics.skipped;
+                        continue;
+                    }
+                    sink->second(*record, reinterpret_cast<const uint8_t *>(record + 1));
+                    ++statistics.replayed;
+                    statistics.bytes += record->payloadLength;
+                }
+                statistics.duration = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+                return statistics;
+            }
+
+            uint64_t Replayer::sinkKey(RecordKind kind, uint16_t service, uint16_t instance, uint16_t id)
+            {
+                return (static_cast<uint64_t>(kind) << 48) | (static_cast<uint64_t>(service) << 32) | (static_cast<uint64_t>(instance) << 16) | id;
+            }
+
+            bool Replayer::index(const Segment &segment)
+            {
+                const uint8_t *base = static_cast<const uint8_t *>(segment.base);
+                const SegmentHeader *header = reinterpret_cast<const SegmentHeader *>(base);
+                if (std::memcmp(header->magic, kRecordMagic, sizeof(kRecordMagic)) != 0 || header->version != kRecordVersion ||
+                    header->headerSize < sizeof(SegmentHeader))
+                {
+                    return false;
+                }
+                // 录制进程异常退出时文件可能没有截断 以 usedBytes 为准
+                const size_t used = std::min<size_t>(header->usedBytes, segment.size);
+                size_t position = header->headerSize;
+                while (position + sizeof(RecordHeader) <= used)
+                {
+                    const RecordHeader *record = reinterpret_cast<const RecordHeader *>(base + position);
+                    const size_t size = RecordSize(record->payloadLength);
+                    if (size > used - position)
+                    {
+                        break;
+                    }
+                    records_.push_back(record);
+                    position += size;
+                }
+                return true;
+            }
+
+            void Replayer::close()
+            {
+                for (const Segment &segment : segments_)
+                {
+                    ::munmap(segment.base, segment.size);
+                }
+                segments_.clear();
+                records_.clear();
+            }
+
+        } // namespace record
+
+    } // namespace com
+
+} // namespace ara
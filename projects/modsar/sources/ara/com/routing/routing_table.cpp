@@ -0,0 +1,101 @@
+#include <unistd.h>
+
+#include "ara/com/com_error_domain.h"
+#include "ara/com/local/local_service_registry.h"
+#include "ara/com/routing/routing_table.h"
+#include "ara/com/sd/shm_service_registry.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace routing
+        {
+            const char *ToString(BindingKind kind)
+            {
+                switch (kind)
+                {
+                case BindingKind::kInProcess:
+                    return "in-process";
+                case BindingKind::kSharedMemory:
+                    return "shared-memory";
+                case BindingKind::kSomeIp:
+                    return "someip";
+                case BindingKind::kDds:
+                    return "dds";
+                }
+                return "unknown";
+            }
+
+            RoutingTable &RoutingTable::Instance()
+            {
+                static RoutingTable table;
+                return table;
+            }
+
+            void RoutingTable::ReportOffer(uint16_t serviceId, uint16_t instanceId, BindingKind kind)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                routes_[keyOf(serviceId, instanceId)].offered |= MaskOf(kind);
+            }
+
+            void RoutingTable::ReportStopOffer(uint16_t serviceId, uint16_t instanceId, BindingKind kind)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                auto found = routes_.find(keyOf(serviceId, instanceId));
+                if (found != routes_.end())
+                {
+                    found->second.offered &= static_cast<BindingMask>(~MaskOf(kind));
+                }
+            }
+
+            void RoutingTable::SetAllowedBindings(uint16_t serviceId, uint16_t instanceId, BindingMask allowed)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                routes_[keyOf(serviceId, instanceId)].allowed = allowed;
+            }
+
+            BindingMask RoutingTable::Available(uint16_t serviceId, uint16_t instanceId) const
+            {
+                Route route;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    auto found = routes_.find(keyOf(serviceId, instanceId));
+                    if (found != routes_.end())
+                    {
+                        route = found->second;
+                    }
+                }
+                if (local::LocalServiceRegistry::Instance().IsOffered(serviceId, instanceId))
+                {
+                    route.offered |= MaskOf(BindingKind::kInProcess);
+                }
+                // 同主机其他进程的 Offer 直接读共享内存注册表 不加锁 本进程的由上面的 LocalServiceRegistry 找到
+                const std::shared_ptr<sd::ShmServiceRegistry> registry = sd::ShmServiceRegistry::Default();
+                sd::ServiceOfferRecord record;
+                if (registry && registry->Find(serviceId, instanceId, record) && record.pid != static_cast<uint32_t>(::getpid()) &&
+                    (record.bindings & MaskOf(BindingKind::kSharedMemory)) != 0)
+                {
+                    route.offered |= MaskOf(BindingKind::kSharedMemory);
+                }
+                return route.offered & route.allowed;
+            }
+
+            ara::core::Result<BindingKind> RoutingTable::Select(uint16_t serviceId, uint16_t instanceId) const
+            {
+                const BindingMask available = Available(serviceId, instanceId);
+                for (uint8_t kind = 0; kind < kBindingKindCount; ++kind)
+                {
+                    if ((available & (1U << kind)) != 0)
+                    {
+                        return ara::core::Result<BindingKind>::FromValue(static_cast<BindingKind>(kind));
+                    }
+                }
+                return ara::core::Result<BindingKind>::FromError(MakeErrorCode(ComErrc::kServiceNotAvailable, 0));
+            }
+
+        } // namespace routing
+
+    } // namespace com
+
+} // namespace ara
@@ -0,0 +1,159 @@
+#include <algorithm>
+
+#include "ara/com/local/local_service.hpp"
+#include "ara/com/routing/routing_table.h"
+#include "ara/com/routing/service_offer.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace routing
+        {
+            ara::core::Result<void> LocalServiceBinding::Offer()
+            {
+                return service_->Offer();
+            }
+
+            void LocalServiceBinding::StopOffer()
+            {
+                service_->StopOffer();
+            }
+
+            ara::core::Result<void> IServiceBinding::OfferBatch(const std::vector<IServiceBinding *> &sameKind)
+            {
+                for (size_t i = 0; i < sameKind.size(); ++i)
+                {
+                    ara::core::Result<void> offered = sameKind[i]->Offer();
+                    if (!offered.HasValue())
+                    {
+                        while (i-- > 0)
+                        {
+                            sameKind[i]->StopOffer();
+                        }
+                        return offered;
+                    }
+                }
+                return ara::core::Result<void>::FromValue();
+            }
+
+            bool ServiceOffer::AddBinding(std::shared_ptr<IServiceBinding> binding)
+            {
+                const BindingKind kind = binding->Kind();
+                if (offered_ || std::any_of(bindings_.begin(), bindings_.end(), [kind](const std::shared_ptr<IServiceBinding> &existing)
+                                            { return existing->Kind() == kind; }))
+                {
+                    return false;
+                }
+                // 按开销排序 Offer 时便宜的 binding 先可用
+                bindings_.insert(std::upper_bound(bindings_.begin(), bindings_.end(), kind,
+                                                  [](BindingKind value, const std::shared_ptr<IServiceBinding> &existing)
+                                                  { return value < existing->Kind(); }),
+                                 std::move(binding));
+                return true;
+            }
+
+            ara::core::Result<void> ServiceOffer::Offer()
+            {
+                if (offered_)
+                {
+                    return ara::core::Result<void>::FromValue();
+                }
+                for (size_t i = 0; i < bindings_.size(); ++i)
+                {
+                    ara::core::Result<void> offered = bindings_[i]->Offer();
+                    if (!offered.HasValue())
+                    {
+                        while (i-- > 0)
+                        {
+                            bindings_[i]->StopOffer();
+                        }
+                        return offered;
+                    }
+                }
+                offered_ = true;
+                return ara::core::Result<void>::FromValue();
+            }
+
+            void ServiceOffer::StopOffer()
+            {
+                if (!offered_)
+                {
+                    return;
+                }
+                offered_ = false;
+                // 先撤回网络 binding 再撤回本地的 正在切换的 proxy 最后才失去同进程路径
+                for (auto binding = bindings_.rbegin(); binding != bindings_.rend(); ++binding)
+                {
+                    (*binding)->StopOffer();
+                }
+            }
+
+            BindingMask ServiceOffer::Offered() const
+            {
+                BindingMask mask = 0;
+                if (offered_)
+                {
+                    for (const std::shared_ptr<IServiceBinding> &binding : bindings_)
+                    {
+                        mask |= MaskOf(binding->Kind());
+                    }
+                }
+                return mask;
+            }
+
+            ara::core::Result<void> OfferServices(const std::vector<ServiceOffer *> &offers)
+            {
+                std::vector<ServiceOffer *> pending;
+                for (ServiceOffer *offer : offers)
+                {
+                    if (!offer->offered_)
+                    {
+                        pending.push_back(offer);
+                    }
+                }
+                std::vector<std::vector<IServiceBinding *>> done;
+                for (size_t kind = 0; kind < kBindingKindCount; ++kind)
+                {
+                    std::vector<IServiceBinding *> sameKind;
+                    for (ServiceOffer *offer : pending)
+                    {
+                        for (const std::shared_ptr<IServiceBinding> &binding : offer->bindings_)
+                        {
+                            if (static_cast<size_t>(binding->Kind()) == kind)
+                            {
+                                sameKind.push_back(binding.get());
+                            }
+                        }
+                    }
+                    if (sameKind.empty())
+                    {
+                        continue;
+                    }
+                    ara::core::Result<void> offered = sameKind.front()->OfferBatch(sameKind);
+                    if (!offered.HasValue())
+                    {
+                        // 和 ServiceOffer::StopOffer 一样 先撤回网络 binding
+                        for (auto batch = done.rbegin(); batch != done.rend(); ++batch)
+                        {
+                            for (IServiceBinding *binding : *batch)
+                            {
+                                binding->StopOffer();
+                            }
+                        }
+                        return offered;
+                    }
+                    done.push_back(std::move(sameKind));
+                }
+                for (ServiceOffer *offer : pending)
+                {
+                    offer->offered_ = true;
+                }
+                return ara::core::Result<void>::FromValue();
+            }
+
+        } // namespace routing
+
+    } // namespace com
+
+} // namespace ara
@@ -0,0 +1,109 @@
+#include "ara/com/rpc/chunk_pool.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace rpc
+        {
+            namespace
+            {
+                inline uint64_t pack(uint32_t tag, uint32_t index) { return (static_cast<uint64_t>(tag) << 32) | index; }
+
+                inline uint32_t indexOf(uint64_t head) { return static_cast<uint32_t>(head & 0xFFFFFFFFU); }
+
+                inline uint32_t tagOf(uint64_t head) { return static_cast<uint32_t>(head >> 32); }
+            } // namespace
+
+            void ChunkDeleter::operator()(Chunk *chunk) const noexcept
+            {
+                if (chunk != nullptr)
+                {
+                    chunk->pool->release(chunk);
+                }
+            }
+
+            ChunkPool::ChunkPool(size_t chunkSize, size_t chunkCount)
+                : chunkSize_(chunkSize),
+                  chunkCount_(chunkCount),
+                  memory_(new uint8_t[chunkSize * chunkCount]),
+                  chunks_(new Chunk[chunkCount]),
+                  next_(new std::atomic<uint32_t>[chunkCount]),
+                  head_(pack(0, chunkCount == 0 ? kNil : 0)),
+                  available_(chunkCount),
+                  reserved_(0)
+            {
+                for (size_t i = 0; i < chunkCount_; ++i)
+                {
+                    chunks_[i].data = memory_.get() + i * chunkSize_;
+                    chunks_[i].capacity = chunkSize_;
+                    chunks_[i].length = 0;
+                    chunks_[i].pool = this;
+                    chunks_[i].index = static_cast<uint32_t>(i);
+                    next_[i].store(i + 1 < chunkCount_ ? static_cast<uint32_t>(i + 1) : kNil, std::memory_order_relaxed);
+                }
+            }
+
+            ChunkPool::~ChunkPool() {}
+
+            ChunkPtr ChunkPool::Allocate() noexcept
+            {
+                uint64_t head = head_.load(std::memory_order_acquire);
+                for (;;)
+                {
+                    const uint32_t index = indexOf(head);
+                    if (index == kNil)
+                    {
+                        return ChunkPtr();
+                    }
+                    const uint32_t next = next_[index].load(std::memory_order_relaxed);
+                    if (head_.compare_exchange_weak(head, pack(tagOf(head) + 1, next), std::memory_order_acq_rel,
+                                                    std::memory_order_acquire))
+                    {
+                        available_.fetch_sub(1, std::memory_order_relaxed);
+                        Chunk *chunk = &chunks_[index];
+                        chunk->length = 0;
+                        return ChunkPtr(chunk);
+                    }
+                }
+            }
+
+            bool ChunkPool::Reserve(size_t count) noexcept
+            {
+                size_t reserved = reserved_.load(std::memory_order_relaxed);
+                do
+                {
+                    if (count > chunkCount_ - reserved)
+                    {
+                        return false;
+                    }
+                } while (!reserved_.compare_exchange_weak(reserved, reserved + count, std::memory_order_relaxed));
+                return true;
+            }
+
+            void ChunkPool::Unreserve(size_t count) noexcept
+            {
+                reserved_.fetch_sub(count, std::memory_order_relaxed);
+            }
+
+            void ChunkPool::release(Chunk *chunk) noexcept
+            {
+                const uint32_t index = chunk->index;
+                uint64_t head = head_.load(std::memory_order_relaxed);
+                for (;;)
+                {
+                    next_[index].store(indexOf(head), std::memory_order_relaxed);
+                    if (head_.compare_exchange_weak(head, pack(tagOf(head) + 1, index), std::memory_order_release,
+                                                    std::memory_order_relaxed))
+                    {
+                        available_.fetch_add(1, std::memory_order_relaxed);
+                        return;
+                    }
+                }
+            }
+
+        } // namespace rpc
+
+    } // namespace com
+
+} // namespace ara
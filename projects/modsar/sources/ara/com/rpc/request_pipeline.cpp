@@ -0,0 +1,196 @@
+#include "ara/com/rpc/request_pipeline.h"
+#include "ara/com/com_error_domain.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace rpc
+        {
+            namespace
+            {
+                /**
+                 * \brief counter < limit 时加一 否则失败
+                 */
+                bool tryIncrement(std::atomic<size_t> &counter, size_t limit)
+                {
+                    size_t current = counter.load(std::memory_order_relaxed);
+                    while (current < limit)
+                    {
+                        if (counter.compare_exchange_weak(current, current + 1, std::memory_order_acquire,
+                                                          std::memory_order_relaxed))
+                        {
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+            } // namespace
+
+            RequestPipeline::RequestPipeline(const PipelineConfig &config, BatchSender sender)
+                : config_(config), sender_(std::move(sender)), inFlight_(0), queued_(0), flushing_(false)
+            {
+            }
+
+            ara::core::Result<void> RequestPipeline::Submit(MethodWindow &window, const Request &request)
+            {
+                // 有排队时新请求也要排队 否则会越过先到的请求
+                if (queued_.load(std::memory_order_acquire) == 0 && tryAcquire(window))
+                {
+                    std::vector<Request> single{request};
+                    write(single);
+                    return ara::core::Result<void>::FromValue();
+                }
+                if (config_.policy == OverflowPolicy::kFailFast)
+                {
+                    return ara::core::Result<void>::FromError(MakeErrorCode(ComErrc::kCommunicationStackError, 0));
+                }
+                {
+                    std::lock_guard<std::mutex> lock(queueMutex_);
+                    if (queue_.size() >= config_.maxQueued)
+                    {
+                        return ara::core::Result<void>::FromError(MakeErrorCode(ComErrc::kCommunicationStackError, 0));
+                    }
+                    queue_.push_back(Pending{&window, request});
+                    queued_.fetch_add(1, std::memory_order_release);
+                }
+                // 入队前窗口可能刚好被释放 这里补一次 避免请求滞留
+                drainQueue();
+                return ara::core::Result<void>::FromValue();
+            }
+
+            void RequestPipeline::OnResponse(MethodWindow &window)
+            {
+                release(window, 1);
+                if (queued_.load(std::memory_order_acquire) != 0)
+                {
+                    drainQueue();
+                }
+            }
+
+            void RequestPipeline::Reset(MethodWindow &window)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(queueMutex_);
+                    for (auto it = queue_.begin(); it != queue_.end();)
+                    {
+                        if (it->window == &window)
+                        {
+                            it = queue_.erase(it);
+                            queued_.fetch_sub(1, std::memory_order_release);
+                        }
+                        else
+                        {
+                            ++it;
+                        }
+                    }
+                }
+                const size_t stale = window.inFlight_.exchange(0, std::memory_order_acq_rel);
+                inFlight_.fetch_sub(stale, std::memory_order_release);
+                if (stale != 0 && queued_.load(std::memory_order_acquire) != 0)
+                {
+                    drainQueue();
+                }
+            }
+
+            void RequestPipeline::Withdraw(MethodWindow &window, uint16_t session)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(queueMutex_);
+                    for (auto it = queue_.begin(); it != queue_.end(); ++it)
+                    {
+                        if (it->window == &window && it->request->get_session() == session)
+                        {
+                            // 还没有占用窗口
+                            queue_.erase(it);
+                            queued_.fetch_sub(1, std::memory_order_release);
+                            return;
+                        }
+                    }
+                }
+                OnResponse(window);
+            }
+
+            bool RequestPipeline::tryAcquire(MethodWindow &window)
+            {
+                if (!tryIncrement(window.inFlight_, window.limit_))
+                {
+                    return false;
+                }
+                if (!tryIncrement(inFlight_, config_.maxInFlightPerProxy))
+                {
+                    window.inFlight_.fetch_sub(1, std::memory_order_release);
+                    return false;
+                }
+                return true;
+            }
+
+            void RequestPipeline::release(MethodWindow &window, size_t count)
+            {
+                window.inFlight_.fetch_sub(count, std::memory_order_release);
+                inFlight_.fetch_sub(count, std::memory_order_release);
+            }
+
+            void RequestPipeline::drainQueue()
+            {
+                std::vector<Request> ready;
+                {
+                    std::lock_guard<std::mutex> lock(queueMutex_);
+                    for (auto it = queue_.begin(); it != queue_.end();)
+                    {
+                        if (inFlight_.load(std::memory_order_relaxed) >= config_.maxInFlightPerProxy)
+                        {
+                            break;
+                        }
+                        if (tryAcquire(*it->window))
+                        {
+                            ready.push_back(std::move(it->request));
+                            it = queue_.erase(it);
+                            queued_.fetch_sub(1, std::memory_order_release);
+                        }
+                        else
+                        {
+                            ++it;
+                        }
+                    }
+                }
+                if (!ready.empty())
+                {
+                    write(ready);
+                }
+            }
+
+            void RequestPipeline::write(std::vector<Request> &requests)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(batchMutex_);
+                    batch_.insert(batch_.end(), requests.begin(), requests.end());
+                    if (flushing_)
+                    {
+                        // 正在 flush 的线程会把这些请求并入下一次写
+                        return;
+                    }
+                    flushing_ = true;
+                }
+                std::vector<Request> out;
+                for (;;)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(batchMutex_);
+                        if (batch_.empty())
+                        {
+                            flushing_ = false;
+                            return;
+                        }
+                        out.swap(batch_);
+                    }
+                    sender_(out);
+                    out.clear();
+                }
+            }
+
+        } // namespace rpc
+
+    } // namespace com
+
+} // namespace ara
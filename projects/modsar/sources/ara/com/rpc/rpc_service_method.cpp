@@ -1,4 +1,6 @@
 #include "include/ara/com/rpc/rpc_service_method.hpp"
+#include "ara/com/serialization/someip_serializer.hpp"
+#include "ara/com/someip/someip_connection.h"
 namespace ara
 {
     namespace com
@@ -8,13 +10,20 @@ namespace ara
             void RpcServiceMethod::RunHandler(const Method &param)
             {
                 // move to cpp file to implemate this
+                RequestType request;
                 ResponseType result;
-                std::shared_ptr<vsomeip::message> resp = Getinstance()->create_message(param);
-                std::shared_ptr<vsomeip::payload> pl = param->get_payload();
-                Status status = CatchingFunctionHandler([this, param, &result]
-                                                        { return func_(static_cast<RequestType *>(pl->get_data()), &result); });
+                std::shared_ptr<vsomeip::message> resp = ara::com::someip::SomeIpConnection::Instance().CreateResponse(param);
+                // payload 按 SOME/IP 格式反序列化 不再把原始字节强转成 RequestType
+                if (!ara::com::serialization::DeserializeFromPayload(*param->get_payload(), request).HasValue())
+                {
+                    resp->set_return_code(vsomeip::return_code_e::E_MALFORMED_MESSAGE);
+                    host_->SendResponse(resp);
+                    return;
+                }
+                Status status = CatchingFunctionHandler([this, &request, &result]
+                                                        { return func_(&request, &result); });
 
-                RunHandlerHelper<vsomeip::message, ResponseType>(resp, static_cast<ResponseType *>(&result), status);
+                RunHandlerHelper<vsomeip::message, ResponseType>(resp, result, status);
                 host_->SendResponse(resp);
             }
 
@@ -0,0 +1,345 @@
+#include <cstring>
+
+#include "ara/com/rpc/stream_endpoint.h"
+#include "ara/com/com_error_domain.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace rpc
+        {
+            StreamEndpoint::StreamEndpoint(uint32_t streamId, const StreamConfig &config, std::shared_ptr<ChunkPool> pool,
+                                           FrameSender sender)
+                : streamId_(streamId),
+                  config_(config),
+                  pool_(pool),
+                  sender_(std::move(sender)),
+                  sendCredits_(0),
+                  consumed_(0),
+                  localFinished_(false),
+                  remoteFinished_(false),
+                  peerCancelled_(false),
+                  reserved_(false),
+                  failed_(false),
+                  error_(MakeErrorCode(ComErrc::kCommunicationLinkError, 0))
+            {
+            }
+
+            StreamEndpoint::~StreamEndpoint()
+            {
+                if (reserved_)
+                {
+                    pool_->Unreserve(ChunksPerStream(config_));
+                }
+            }
+
+            ara::core::Result<void> StreamEndpoint::Open()
+            {
+                if (!reserveChunks())
+                {
+                    return ara::core::Result<void>::FromError(MakeErrorCode(ComErrc::kSampleAllocationFailure, 0));
+                }
+                if (!sendControl(StreamFrameType::kOpen, config_.window))
+                {
+                    return ara::core::Result<void>::FromError(MakeErrorCode(ComErrc::kCommunicationLinkError, 0));
+                }
+                return ara::core::Result<void>::FromValue();
+            }
+
+            ara::core::Result<void> StreamEndpoint::Accept(uint32_t peerWindow)
+            {
+                if (!reserveChunks())
+                {
+                    // 客户端在等 credit 不通知的话要等到写超时
+                    Abort(MakeErrorCode(ComErrc::kSampleAllocationFailure, 0));
+                    return ara::core::Result<void>::FromError(MakeErrorCode(ComErrc::kSampleAllocationFailure, 0));
+                }
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    sendCredits_ = peerWindow;
+                }
+                cond_.notify_all();
+                if (!sendControl(StreamFrameType::kCredit, config_.window))
+                {
+                    return ara::core::Result<void>::FromError(MakeErrorCode(ComErrc::kCommunicationLinkError, 0));
+                }
+                return ara::core::Result<void>::FromValue();
+            }
+
+            ara::core::Result<ChunkPtr> StreamEndpoint::AcquireChunk()
+            {
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    const bool ready = cond_.wait_for(lock, config_.writeTimeout, [this]
+                                                      { return failed_ || peerCancelled_ || sendCredits_ > 0; });
+                    if (failed_)
+                    {
+                        return ara::core::Result<ChunkPtr>::FromError(error_);
+                    }
+                    if (peerCancelled_)
+                    {
+                        return ara::core::Result<ChunkPtr>::FromError(MakeErrorCode(ComErrc::kCommunicationLinkError, 0));
+                    }
+                    if (localFinished_)
+                    {
+                        return ara::core::Result<ChunkPtr>::FromError(MakeErrorCode(ComErrc::kCommunicationStackError, 0));
+                    }
+                    if (!ready)
+                    {
+                        return ara::core::Result<ChunkPtr>::FromError(MakeErrorCode(ComErrc::kCommunicationLinkError, 0));
+                    }
+                    --sendCredits_;
+                }
+                ChunkPtr chunk = pool_->Allocate();
+                if (!chunk)
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    ++sendCredits_;
+                    return ara::core::Result<ChunkPtr>::FromError(MakeErrorCode(ComErrc::kSampleAllocationFailure, 0));
+                }
+                return ara::core::Result<ChunkPtr>::FromValue(std::move(chunk));
+            }
+
+            ara::core::Result<void> StreamEndpoint::Commit(ChunkPtr chunk, size_t payloadLength)
+            {
+                StreamFrameHeader header{};
+                header.streamId = streamId_;
+                header.value = static_cast<uint32_t>(payloadLength);
+                header.type = static_cast<uint8_t>(StreamFrameType::kData);
+                std::memcpy(chunk->data, &header, sizeof(header));
+                chunk->length = sizeof(header) + payloadLength;
+                if (!sender_(chunk->data, chunk->length))
+                {
+                    Abort(MakeErrorCode(ComErrc::kCommunicationLinkError, 0));
+                    return ara::core::Result<void>::FromError(MakeErrorCode(ComErrc::kCommunicationLinkError, 0));
+                }
+                return ara::core::Result<void>::FromValue();
+            }
+
+            ara::core::Result<void> StreamEndpoint::Finish()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (failed_)
+                    {
+                        return ara::core::Result<void>::FromError(error_);
+                    }
+                    if (localFinished_)
+                    {
+                        return ara::core::Result<void>::FromValue();
+                    }
+                    localFinished_ = true;
+                }
+                if (!sendControl(StreamFrameType::kEnd, 0))
+                {
+                    return ara::core::Result<void>::FromError(MakeErrorCode(ComErrc::kCommunicationLinkError, 0));
+                }
+                return ara::core::Result<void>::FromValue();
+            }
+
+            void StreamEndpoint::Abort(const ara::core::ErrorCode &error)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (failed_)
+                    {
+                        return;
+                    }
+                    failLocked(error);
+                }
+                cond_.notify_all();
+                sendControl(StreamFrameType::kError, static_cast<uint32_t>(error.Value()));
+            }
+
+            void StreamEndpoint::Close()
+            {
+                bool finished;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (failed_ || (localFinished_ && remoteFinished_))
+                    {
+                        return;
+                    }
+                    finished = localFinished_;
+                }
+                if (!finished)
+                {
+                    Abort(MakeErrorCode(ComErrc::kCommunicationLinkError, 0));
+                    return;
+                }
+                // 本端的数据和 kEnd 都已经发出 不能用 kError 否则对端会丢掉还没读的数据
+                sendControl(StreamFrameType::kCancel, 0);
+            }
+
+            ara::core::Result<ChunkPtr> StreamEndpoint::Receive()
+            {
+                ChunkPtr chunk;
+                uint32_t grant = 0;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    cond_.wait(lock, [this]
+                               { return failed_ || remoteFinished_ || !inbound_.empty(); });
+                    if (!inbound_.empty())
+                    {
+                        chunk = std::move(inbound_.front());
+                        inbound_.pop_front();
+                        // 消费满半个窗口后一次性归还 减少 credit 帧的数量
+                        if (++consumed_ >= (config_.window + 1) / 2)
+                        {
+                            grant = consumed_;
+                            consumed_ = 0;
+                        }
+                    }
+                    else if (failed_)
+                    {
+                        return ara::core::Result<ChunkPtr>::FromError(error_);
+                    }
+                }
+                if (grant != 0)
+                {
+                    sendControl(StreamFrameType::kCredit, grant);
+                }
+                return ara::core::Result<ChunkPtr>::FromValue(std::move(chunk));
+            }
+
+            void StreamEndpoint::OnFrame(const uint8_t *data, size_t length)
+            {
+                if (length < sizeof(StreamFrameHeader))
+                {
+                    return;
+                }
+                StreamFrameHeader header;
+                std::memcpy(&header, data, sizeof(header));
+                const uint8_t *payload = data + sizeof(header);
+                const size_t payloadLength = length - sizeof(header);
+
+                switch (static_cast<StreamFrameType>(header.type))
+                {
+                case StreamFrameType::kData:
+                {
+                    ChunkPtr chunk = pool_->Allocate();
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    if (failed_)
+                    {
+                        return;
+                    }
+                    if (inbound_.size() >= config_.window || !chunk || payloadLength > chunk->capacity)
+                    {
+                        // 对端超出 credit 按协议错误结束 预留保证不超出窗口时内存池不会不足
+                        lock.unlock();
+                        Abort(MakeErrorCode(ComErrc::kMaxSamplesExceeded, 0));
+                        return;
+                    }
+                    std::memcpy(chunk->data, payload, payloadLength);
+                    chunk->length = payloadLength;
+                    inbound_.push_back(std::move(chunk));
+                    break;
+                }
+                case StreamFrameType::kCredit:
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    sendCredits_ += header.value;
+                    break;
+                }
+                case StreamFrameType::kEnd:
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    remoteFinished_ = true;
+                    break;
+                }
+                case StreamFrameType::kCancel:
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    peerCancelled_ = true;
+                    break;
+                }
+                case StreamFrameType::kError:
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    failLocked(MakeErrorCode(static_cast<ComErrc>(header.value), 0));
+                    break;
+                }
+                default:
+                    return;
+                }
+                cond_.notify_all();
+            }
+
+            bool StreamEndpoint::IsClosed() const
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return failed_ || (localFinished_ && remoteFinished_ && inbound_.empty());
+            }
+
+            bool StreamEndpoint::reserveChunks()
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!reserved_)
+                {
+                    reserved_ = pool_->Reserve(ChunksPerStream(config_));
+                }
+                return reserved_;
+            }
+
+            bool StreamEndpoint::sendControl(StreamFrameType type, uint32_t value)
+            {
+                StreamFrameHeader header{};
+                header.streamId = streamId_;
+                header.value = value;
+                header.type = static_cast<uint8_t>(type);
+                return sender_(reinterpret_cast<const uint8_t *>(&header), sizeof(header));
+            }
+
+            void StreamEndpoint::failLocked(const ara::core::ErrorCode &error)
+            {
+                failed_ = true;
+                error_ = error;
+                inbound_.clear();
+            }
+
+            void StreamRegistry::Add(uint32_t scope, const std::shared_ptr<StreamEndpoint> &endpoint)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                endpoints_[keyOf(scope, endpoint->StreamId())] = endpoint;
+            }
+
+            void StreamRegistry::Remove(uint32_t scope, uint32_t streamId)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                endpoints_.erase(keyOf(scope, streamId));
+            }
+
+            bool StreamRegistry::Dispatch(uint32_t scope, const uint8_t *data, size_t length)
+            {
+                if (length < sizeof(StreamFrameHeader))
+                {
+                    return false;
+                }
+                StreamFrameHeader header;
+                std::memcpy(&header, data, sizeof(header));
+                std::shared_ptr<StreamEndpoint> endpoint;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    auto it = endpoints_.find(keyOf(scope, header.streamId));
+                    if (it == endpoints_.end())
+                    {
+                        return false;
+                    }
+                    endpoint = it->second;
+                }
+                endpoint->OnFrame(data, length);
+                return true;
+            }
+
+            size_t StreamRegistry::Size() const
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return endpoints_.size();
+            }
+
+        } // namespace rpc
+
+    } // namespace com
+
+} // namespace ara
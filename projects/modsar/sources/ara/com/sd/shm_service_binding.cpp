@@ -0,0 +1,71 @@
+#include "ara/com/sd/shm_service_binding.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace sd
+        {
+            ShmServiceBinding::ShmServiceBinding(std::shared_ptr<ShmServiceRegistry> registry, const ServiceOfferRecord &record)
+                : registry_(std::move(registry)), record_(record), offered_(false)
+            {
+                record_.bindings |= routing::MaskOf(routing::BindingKind::kSharedMemory);
+            }
+
+            ara::core::Result<void> ShmServiceBinding::Offer()
+            {
+                if (offered_)
+                {
+                    return ara::core::Result<void>::FromValue();
+                }
+                ara::core::Result<void> offered = registry_->Offer(record_);
+                offered_ = offered.HasValue();
+                return offered;
+            }
+
+            void ShmServiceBinding::StopOffer()
+            {
+                if (offered_)
+                {
+                    offered_ = false;
+                    registry_->StopOffer(record_.serviceId, record_.instanceId);
+                }
+            }
+
+            ara::core::Result<void> ShmServiceBinding::OfferBatch(const std::vector<routing::IServiceBinding *> &sameKind)
+            {
+                std::vector<ShmServiceBinding *> bindings;
+                for (routing::IServiceBinding *binding : sameKind)
+                {
+                    ShmServiceBinding *shm = dynamic_cast<ShmServiceBinding *>(binding);
+                    if (shm == nullptr || shm->registry_ != registry_)
+                    {
+                        return routing::IServiceBinding::OfferBatch(sameKind);
+                    }
+                    if (!shm->offered_)
+                    {
+                        bindings.push_back(shm);
+                    }
+                }
+                std::vector<ServiceOfferRecord> records;
+                for (const ShmServiceBinding *binding : bindings)
+                {
+                    records.push_back(binding->record_);
+                }
+                ara::core::Result<void> offered = registry_->OfferAll(records);
+                if (!offered.HasValue())
+                {
+                    return offered;
+                }
+                for (ShmServiceBinding *binding : bindings)
+                {
+                    binding->offered_ = true;
+                }
+                return ara::core::Result<void>::FromValue();
+            }
+
+        } // namespace sd
+
+    } // namespace com
+
+} // namespace ara
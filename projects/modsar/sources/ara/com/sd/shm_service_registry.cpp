@@ -0,0 +1,552 @@
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <new>
+
+#include "ara/com/com_error_domain.h"
+#include "ara/com/sd/shm_service_registry.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace sd
+        {
+            namespace
+            {
+                uint32_t roundUpPowerOfTwo(uint32_t value)
+                {
+                    uint32_t rounded = 1;
+                    while (rounded < value)
+                    {
+                        rounded <<= 1;
+                    }
+                    return rounded;
+                }
+
+                size_t headerSize()
+                {
+                    return (sizeof(ShmRegistryHeader) + 63) / 64 * 64;
+                }
+
+                // 正常的写入只是拷贝 64 字节 自旋这么多次还没写完说明写端停在了写入途中
+                constexpr uint32_t kReadSpins = 1U << 16;
+
+                bool processAlive(uint32_t pid)
+                {
+                    return ::kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM;
+                }
+
+                // 共享内存里的 futex 不能用 FUTEX_PRIVATE_FLAG
+                long futexWait(std::atomic<uint32_t> &word, uint32_t expected, const struct timespec *timeout)
+                {
+                    return ::syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAIT, expected, timeout, nullptr, 0);
+                }
+
+                void futexWakeAll(std::atomic<uint32_t> &word)
+                {
+                    ::syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+                }
+
+                bool sameOffers(const std::vector<ServiceOfferRecord> &left, const std::vector<ServiceOfferRecord> &right)
+                {
+                    return left.size() == right.size() &&
+                           std::equal(left.begin(), left.end(), right.begin(), [](const ServiceOfferRecord &a, const ServiceOfferRecord &b)
+                                      { return std::memcmp(&a, &b, sizeof(ServiceOfferRecord)) == 0; });
+                }
+            } // namespace
+
+            constexpr uint16_t ShmServiceRegistry::kAnyInstance;
+
+            std::shared_ptr<ShmServiceRegistry> ShmServiceRegistry::Default()
+            {
+                static const std::shared_ptr<ShmServiceRegistry> registry = []
+                {
+                    ara::core::Result<std::shared_ptr<ShmServiceRegistry>> opened = Open(ShmRegistryConfig());
+                    return opened.HasValue() ? opened.Value() : nullptr;
+                }();
+                return registry;
+            }
+
+            ara::core::Result<std::shared_ptr<ShmServiceRegistry>> ShmServiceRegistry::Open(const ShmRegistryConfig &config)
+            {
+                using ResultType = ara::core::Result<std::shared_ptr<ShmServiceRegistry>>;
+                const ResultType failed = ResultType::FromError(MakeErrorCode(ComErrc::kErroneousFileHandle, 0));
+                int fd = ::shm_open(config.name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0666);
+                if (fd >= 0)
+                {
+                    const uint32_t capacity = roundUpPowerOfTwo(std::max<uint32_t>(config.capacity, 1));
+                    const size_t size = headerSize() + capacity * sizeof(OfferSlot);
+                    void *page = MAP_FAILED;
+                    if (::ftruncate(fd, static_cast<off_t>(size)) == 0)
+                    {
+                        page = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                    }
+                    ::close(fd);
+                    if (page == MAP_FAILED)
+                    {
+                        ::shm_unlink(config.name.c_str());
+                        return failed;
+                    }
+                    // ftruncate 后内存全为 0 槽位的原子变量和 seqlock 都以 0 为初值
+                    ShmRegistryHeader *header = new (page) ShmRegistryHeader();
+                    header->version = kShmRegistryVersion;
+                    header->capacity = capacity;
+                    header->slotSize = static_cast<uint32_t>(sizeof(OfferSlot));
+                    header->changes.store(0, std::memory_order_relaxed);
+                    pthread_mutexattr_t attributes;
+                    pthread_mutexattr_init(&attributes);
+                    pthread_mutexattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+                    pthread_mutexattr_setrobust(&attributes, PTHREAD_MUTEX_ROBUST);
+                    pthread_mutex_init(&header->writeMutex, &attributes);
+                    pthread_mutexattr_destroy(&attributes);
+                    // 其他进程先校验 magic 所以 magic 最后写入
+                    std::atomic_thread_fence(std::memory_order_release);
+                    std::memcpy(header->magic, kShmRegistryMagic, sizeof(kShmRegistryMagic));
+                    return ResultType::FromValue(std::shared_ptr<ShmServiceRegistry>(new ShmServiceRegistry(page, size)));
+                }
+                if (errno != EEXIST)
+                {
+                    return failed;
+                }
+                fd = ::shm_open(config.name.c_str(), O_RDWR, 0);
+                if (fd < 0)
+                {
+                    return failed;
+                }
+                // 创建者可能还在初始化 最多等 1 秒
+                void *page = MAP_FAILED;
+                size_t size = 0;
+                for (int attempt = 0; attempt < 1000 && page == MAP_FAILED; ++attempt)
+                {
+                    struct stat status;
+                    if (::fstat(fd, &status) == 0 && static_cast<size_t>(status.st_size) >= headerSize())
+                    {
+                        void *mapped = ::mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                        if (mapped != MAP_FAILED)
+                        {
+                            const ShmRegistryHeader *header = static_cast<const ShmRegistryHeader *>(mapped);
+                            if (std::memcmp(header->magic, kShmRegistryMagic, sizeof(kShmRegistryMagic)) == 0)
+                            {
+                                std::atomic_thread_fence(std::memory_order_acquire);
+                                page = mapped;
+                                size = static_cast<size_t>(status.st_size);
+                                break;
+                            }
+                            ::munmap(mapped, static_cast<size_t>(status.st_size));
+                        }
+                    }
+                    ::usleep(1000);
+                }
+                ::close(fd);
+                if (page == MAP_FAILED)
+                {
+                    return failed;
+                }
+                const ShmRegistryHeader *header = static_cast<const ShmRegistryHeader *>(page);
+                if (header->version != kShmRegistryVersion || header->slotSize != sizeof(OfferSlot) ||
+                    size < headerSize() + header->capacity * sizeof(OfferSlot))
+                {
+                    ::munmap(page, size);
+                    return failed;
+                }
+                std::shared_ptr<ShmServiceRegistry> registry(new ShmServiceRegistry(page, size));
+                registry->reap();
+                return ResultType::FromValue(registry);
+            }
+
+            ShmServiceRegistry::ShmServiceRegistry(void *page, size_t size)
+                : page_(page), size_(size), pid_(static_cast<uint32_t>(::getpid())), nextWatchId_(1), stopping_(false)
+            {
+            }
+
+            ShmServiceRegistry::~ShmServiceRegistry()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(watchMutex_);
+                    stopping_.store(true, std::memory_order_release);
+                }
+                if (watcher_.joinable())
+                {
+                    futexWakeAll(header()->changes);
+                    watcher_.join();
+                }
+                const std::vector<uint32_t> offered = offered_;
+                for (uint32_t key : offered)
+                {
+                    StopOffer(static_cast<uint16_t>(key >> 16), static_cast<uint16_t>(key));
+                }
+                ::munmap(page_, size_);
+            }
+
+            ShmServiceRegistry::OfferSlot &ShmServiceRegistry::slotAt(uint32_t index) const
+            {
+                return reinterpret_cast<OfferSlot *>(static_cast<uint8_t *>(page_) + headerSize())[index];
+            }
+
+            uint32_t ShmServiceRegistry::indexOf(uint16_t serviceId, uint16_t instanceId) const
+            {
+                uint32_t hash = ((static_cast<uint32_t>(serviceId) << 16) | instanceId) * 0x9E3779B1U;
+                hash ^= hash >> 16;
+                return hash & (header()->capacity - 1);
+            }
+
+            void ShmServiceRegistry::lockWriter() const
+            {
+                if (pthread_mutex_lock(&header()->writeMutex) != EOWNERDEAD)
+                {
+                    return;
+                }
+                // 持锁的进程在写记录时退出 写了一半的槽位 seqlock 序号停在奇数 读端会一直自旋 先把它清掉
+                for (uint32_t index = 0; index < header()->capacity; ++index)
+                {
+                    OfferSlot &slot = slotAt(index);
+                    if ((slot.record.Sequence() & 1U) != 0)
+                    {
+                        clearSlot(slot);
+                    }
+                }
+                pthread_mutex_consistent(&header()->writeMutex);
+            }
+
+            void ShmServiceRegistry::publishChange() const
+            {
+                header()->changes.fetch_add(1, std::memory_order_release);
+                futexWakeAll(header()->changes);
+            }
+
+            void ShmServiceRegistry::clearSlot(OfferSlot &slot) const
+            {
+                ServiceOfferRecord empty;
+                std::memset(&empty, 0, sizeof(empty));
+                slot.record.Recover(empty);
+                slot.owner.store(0, std::memory_order_release);
+            }
+
+            ServiceOfferRecord ShmServiceRegistry::loadSlot(OfferSlot &slot) const
+            {
+                ServiceOfferRecord record;
+                while (!slot.record.TryLoad(record, kReadSpins))
+                {
+                    recoverSlot(slot);
+                }
+                return record;
+            }
+
+            void ShmServiceRegistry::recoverSlot(OfferSlot &slot) const
+            {
+                // 写端还活着时在这里等它写完 已经退出时 lockWriter 收到 EOWNERDEAD 并清掉写了一半的槽位
+                lockWriter();
+                const bool torn = (slot.record.Sequence() & 1U) != 0;
+                if (torn)
+                {
+                    // 持有写锁时不会有写者 序号还是奇数说明写端退出后锁已经被恢复过
+                    clearSlot(slot);
+                }
+                pthread_mutex_unlock(&header()->writeMutex);
+                if (torn)
+                {
+                    publishChange();
+                }
+            }
+
+            void ShmServiceRegistry::reap()
+            {
+                bool changed = false;
+                lockWriter();
+                for (uint32_t index = 0; index < header()->capacity; ++index)
+                {
+                    OfferSlot &slot = slotAt(index);
+                    const uint32_t owner = slot.owner.load(std::memory_order_acquire);
+                    if (owner != 0 && !processAlive(owner))
+                    {
+                        clearSlot(slot);
+                        changed = true;
+                    }
+                }
+                pthread_mutex_unlock(&header()->writeMutex);
+                if (changed)
+                {
+                    publishChange();
+                }
+            }
+
+            ara::core::Result<void> ShmServiceRegistry::Offer(const ServiceOfferRecord &record)
+            {
+                return OfferAll(std::vector<ServiceOfferRecord>{record});
+            }
+
+            ara::core::Result<void> ShmServiceRegistry::OfferAll(const std::vector<ServiceOfferRecord> &records)
+            {
+                std::vector<OfferSlot *> added; // 这一批新占用的槽位 失败时撤回
+                lockWriter();
+                for (const ServiceOfferRecord &record : records)
+                {
+                    OfferSlot *slot = offerLocked(record, added);
+                    if (slot == nullptr)
+                    {
+                        for (OfferSlot *written : added)
+                        {
+                            const ServiceOfferRecord rolledBack = written->record.Load();
+                            const uint32_t key = (static_cast<uint32_t>(rolledBack.serviceId) << 16) | rolledBack.instanceId;
+                            offered_.erase(std::remove(offered_.begin(), offered_.end(), key), offered_.end());
+                            clearSlot(*written);
+                        }
+                        pthread_mutex_unlock(&header()->writeMutex);
+                        if (!added.empty())
+                        {
+                            publishChange();
+                        }
+                        return ara::core::Result<void>::FromError(MakeErrorCode(ComErrc::kCouldNotExecute, 0));
+                    }
+                }
+                pthread_mutex_unlock(&header()->writeMutex);
+                if (!records.empty())
+                {
+                    publishChange();
+                }
+                return ara::core::Result<void>::FromValue();
+            }
+
+            ShmServiceRegistry::OfferSlot *ShmServiceRegistry::offerLocked(const ServiceOfferRecord &record, std::vector<OfferSlot *> &added)
+            {
+                const uint32_t capacity = header()->capacity;
+                const uint32_t start = indexOf(record.serviceId, record.instanceId);
+                OfferSlot *target = nullptr;
+                OfferSlot *free = nullptr;
+                for (uint32_t probe = 0; probe < capacity; ++probe)
+                {
+                    OfferSlot &slot = slotAt((start + probe) & (capacity - 1));
+                    if (slot.used.load(std::memory_order_acquire) == 0)
+                    {
+                        free = free != nullptr ? free : &slot;
+                        break;
+                    }
+                    const uint32_t owner = slot.owner.load(std::memory_order_relaxed);
+                    if (owner == 0)
+                    {
+                        free = free != nullptr ? free : &slot;
+                        continue;
+                    }
+                    const ServiceOfferRecord existing = slot.record.Load();
+                    if (existing.serviceId == record.serviceId && existing.instanceId == record.instanceId)
+                    {
+                        if (owner != pid_ && processAlive(owner))
+                        {
+                            return nullptr;
+                        }
+                        target = &slot;
+                        break;
+                    }
+                }
+                const uint32_t key = (static_cast<uint32_t>(record.serviceId) << 16) | record.instanceId;
+                if (target == nullptr || target->owner.load(std::memory_order_relaxed) != pid_)
+                {
+                    // 新 Offer 或接管已退出进程的槽位
+                    target = target != nullptr ? target : free;
+                    if (target == nullptr)
+                    {
+                        return nullptr;
+                    }
+                    added.push_back(target);
+                }
+                ServiceOfferRecord written = record;
+                written.pid = pid_;
+                written.offered = 1;
+                written.endpoint[sizeof(written.endpoint) - 1] = '\0';
+                target->owner.store(pid_, std::memory_order_relaxed);
+                target->record.Store(written);
+                target->used.store(1, std::memory_order_release);
+                if (std::find(offered_.begin(), offered_.end(), key) == offered_.end())
+                {
+                    offered_.push_back(key);
+                }
+                return target;
+            }
+
+            void ShmServiceRegistry::StopOffer(uint16_t serviceId, uint16_t instanceId)
+            {
+                const uint32_t capacity = header()->capacity;
+                const uint32_t start = indexOf(serviceId, instanceId);
+                bool changed = false;
+                lockWriter();
+                for (uint32_t probe = 0; probe < capacity; ++probe)
+                {
+                    OfferSlot &slot = slotAt((start + probe) & (capacity - 1));
+                    if (slot.used.load(std::memory_order_acquire) == 0)
+                    {
+                        break;
+                    }
+                    if (slot.owner.load(std::memory_order_relaxed) != pid_)
+                    {
+                        continue;
+                    }
+                    const ServiceOfferRecord existing = slot.record.Load();
+                    if (existing.serviceId == serviceId && existing.instanceId == instanceId)
+                    {
+                        clearSlot(slot);
+                        changed = true;
+                        break;
+                    }
+                }
+                const uint32_t key = (static_cast<uint32_t>(serviceId) << 16) | instanceId;
+                offered_.erase(std::remove(offered_.begin(), offered_.end(), key), offered_.end());
+                pthread_mutex_unlock(&header()->writeMutex);
+                if (changed)
+                {
+                    publishChange();
+                }
+            }
+
+            bool ShmServiceRegistry::Find(uint16_t serviceId, uint16_t instanceId, ServiceOfferRecord &out) const
+            {
+                const uint32_t capacity = header()->capacity;
+                const uint32_t start = indexOf(serviceId, instanceId);
+                for (uint32_t probe = 0; probe < capacity; ++probe)
+                {
+                    OfferSlot &slot = slotAt((start + probe) & (capacity - 1));
+                    if (slot.used.load(std::memory_order_acquire) == 0)
+                    {
+                        return false;
+                    }
+                    const ServiceOfferRecord record = loadSlot(slot);
+                    if (record.offered != 0 && record.serviceId == serviceId && record.instanceId == instanceId)
+                    {
+                        out = record;
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            std::vector<ServiceOfferRecord> ShmServiceRegistry::FindAll(uint16_t serviceId, uint16_t instanceId) const
+            {
+                std::vector<ServiceOfferRecord> offers;
+                if (instanceId != kAnyInstance)
+                {
+                    ServiceOfferRecord record;
+                    if (Find(serviceId, instanceId, record))
+                    {
+                        offers.push_back(record);
+                    }
+                    return offers;
+                }
+                for (uint32_t index = 0; index < header()->capacity; ++index)
+                {
+                    OfferSlot &slot = slotAt(index);
+                    if (slot.used.load(std::memory_order_acquire) == 0)
+                    {
+                        continue;
+                    }
+                    const ServiceOfferRecord record = loadSlot(slot);
+                    if (record.offered != 0 && record.serviceId == serviceId)
+                    {
+                        offers.push_back(record);
+                    }
+                }
+                std::sort(offers.begin(), offers.end(), [](const ServiceOfferRecord &left, const ServiceOfferRecord &right)
+                          { return left.instanceId < right.instanceId; });
+                return offers;
+            }
+
+            uint32_t ShmServiceRegistry::Changes() const
+            {
+                return header()->changes.load(std::memory_order_acquire);
+            }
+
+            bool ShmServiceRegistry::WaitForChange(uint32_t seen, std::chrono::nanoseconds timeout) const
+            {
+                const auto deadline = std::chrono::steady_clock::now() + timeout;
+                while (Changes() == seen)
+                {
+                    const std::chrono::nanoseconds left = deadline - std::chrono::steady_clock::now();
+                    if (left.count() <= 0)
+                    {
+                        return false;
+                    }
+                    struct timespec relative;
+                    relative.tv_sec = static_cast<time_t>(left.count() / 1000000000);
+                    relative.tv_nsec = static_cast<long>(left.count() % 1000000000);
+                    futexWait(header()->changes, seen, &relative);
+                }
+                return true;
+            }
+
+            uint64_t ShmServiceRegistry::StartFind(uint16_t serviceId, uint16_t instanceId, ShmFindHandler handler)
+            {
+                std::vector<ServiceOfferRecord> current = FindAll(serviceId, instanceId);
+                handler(current);
+                std::lock_guard<std::mutex> lock(watchMutex_);
+                const uint64_t id = nextWatchId_++;
+                watches_.push_back(Watch{id, serviceId, instanceId, std::move(handler), std::move(current)});
+                if (!watcher_.joinable())
+                {
+                    watcher_ = std::thread([this]
+                                           { watchLoop(); });
+                }
+                return id;
+            }
+
+            void ShmServiceRegistry::StopFind(uint64_t id)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(watchMutex_);
+                    watches_.erase(std::remove_if(watches_.begin(), watches_.end(), [id](const Watch &watch)
+                                                  { return watch.id == id; }),
+                                   watches_.end());
+                }
+                // 等待 watcher 线程上正在执行的 handler
+                std::lock_guard<std::mutex> lock(handlerMutex_);
+            }
+
+            void ShmServiceRegistry::watchLoop()
+            {
+                while (!stopping_.load(std::memory_order_acquire))
+                {
+                    // 先记下修改次数再扫描 扫描期间的修改会让下面的等待立即返回
+                    const uint32_t seen = Changes();
+                    std::vector<std::pair<uint64_t, std::pair<uint16_t, uint16_t>>> keys;
+                    {
+                        std::lock_guard<std::mutex> lock(watchMutex_);
+                        for (const Watch &watch : watches_)
+                        {
+                            keys.push_back(std::make_pair(watch.id, std::make_pair(watch.serviceId, watch.instanceId)));
+                        }
+                    }
+                    for (const auto &key : keys)
+                    {
+                        std::vector<ServiceOfferRecord> offers = FindAll(key.second.first, key.second.second);
+                        std::lock_guard<std::mutex> running(handlerMutex_);
+                        ShmFindHandler handler;
+                        {
+                            std::lock_guard<std::mutex> lock(watchMutex_);
+                            auto watch = std::find_if(watches_.begin(), watches_.end(), [&key](const Watch &candidate)
+                                                      { return candidate.id == key.first; });
+                            if (watch == watches_.end() || sameOffers(watch->last, offers))
+                            {
+                                continue;
+                            }
+                            watch->last = offers;
+                            handler = watch->handler;
+                        }
+                        handler(offers);
+                    }
+                    // 超时只是兜底 正常由 publishChange 的 futex 唤醒
+                    WaitForChange(seen, std::chrono::milliseconds(500));
+                }
+            }
+
+        } // namespace sd
+
+    } // namespace com
+
+} // namespace ara
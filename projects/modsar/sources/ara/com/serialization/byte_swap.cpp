@@ -0,0 +1,277 @@
+#include <atomic>
+#include <cstring>
+
+#include "ara/com/serialization/byte_swap.h"
+#include "ara/com/serialization/byte_order.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define ARA_COM_BYTE_SWAP_X86 1
+#endif
+
+#if defined(__aarch64__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define ARA_COM_BYTE_SWAP_NEON 1
+#endif
+
+namespace ara
+{
+    namespace com
+    {
+        namespace serialization
+        {
+            namespace
+            {
+                using SwapFunction = void (*)(const uint8_t *src, uint8_t *dst, size_t count);
+
+                struct KernelTable
+                {
+                    ByteSwapKernel kernel;
+                    SwapFunction swap16;
+                    SwapFunction swap32;
+                    SwapFunction swap64;
+                };
+
+                template <size_t Width>
+                void swapScalar(const uint8_t *src, uint8_t *dst, size_t count)
+                {
+                    using Bits = typename ByteSwapper<Width>::Type;
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        Bits bits;
+                        std::memcpy(&bits, src + i * Width, Width);
+                        bits = ByteSwapper<Width>::Swap(bits);
+                        std::memcpy(dst + i * Width, &bits, Width);
+                    }
+                }
+
+#if defined(ARA_COM_BYTE_SWAP_X86)
+                /**
+                 * \brief pshufb 的控制字 结果的第 j 个字节取自 (j / Width) * Width + (Width - 1 - j % Width)
+                 * 256 位版本两个 128 位 lane 各用一份相同的控制字
+                 */
+                template <size_t Width>
+                struct ShuffleMask
+                {
+                    ShuffleMask()
+                    {
+                        for (size_t j = 0; j < sizeof(bytes); ++j)
+                        {
+                            bytes[j] = static_cast<uint8_t>((j % 16) / Width * Width + (Width - 1 - j % Width));
+                        }
+                    }
+                    alignas(32) uint8_t bytes[32];
+                };
+
+                template <size_t Width>
+                const uint8_t *shuffleMask()
+                {
+                    static const ShuffleMask<Width> mask;
+                    return mask.bytes;
+                }
+
+                template <size_t Width>
+                __attribute__((target("ssse3"))) void swapSsse3(const uint8_t *src, uint8_t *dst, size_t count)
+                {
+                    const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i *>(shuffleMask<Width>()));
+                    const size_t bytes = count * Width;
+                    size_t i = 0;
+                    for (; i + 64 <= bytes; i += 64)
+                    {
+                        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+                        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 16));
+                        const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 32));
+                        const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 48));
+                        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_shuffle_epi8(a, mask));
+                        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + 16), _mm_shuffle_epi8(b, mask));
+                        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + 32), _mm_shuffle_epi8(c, mask));
+                        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + 48), _mm_shuffle_epi8(d, mask));
+                    }
+                    for (; i + 16 <= bytes; i += 16)
+                    {
+                        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+                        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_shuffle_epi8(a, mask));
+                    }
+                    swapScalar<Width>(src + i, dst + i, (bytes - i) / Width);
+                }
+
+                template <size_t Width>
+                __attribute__((target("avx2"))) void swapAvx2(const uint8_t *src, uint8_t *dst, size_t count)
+                {
+                    const __m256i mask = _mm256_load_si256(reinterpret_cast<const __m256i *>(shuffleMask<Width>()));
+                    const size_t bytes = count * Width;
+                    size_t i = 0;
+                    for (; i + 128 <= bytes; i += 128)
+                    {
+                        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+                        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i + 32));
+                        const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i + 64));
+                        const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i + 96));
+                        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_shuffle_epi8(a, mask));
+                        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i + 32), _mm256_shuffle_epi8(b, mask));
+                        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i + 64), _mm256_shuffle_epi8(c, mask));
+                        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i + 96), _mm256_shuffle_epi8(d, mask));
+                    }
+                    for (; i + 32 <= bytes; i += 32)
+                    {
+                        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+                        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_shuffle_epi8(a, mask));
+                    }
+                    swapScalar<Width>(src + i, dst + i, (bytes - i) / Width);
+                }
+#endif // ARA_COM_BYTE_SWAP_X86
+
+#if defined(ARA_COM_BYTE_SWAP_NEON)
+                template <size_t Width>
+                uint8x16_t reverseNeon(uint8x16_t value);
+
+                template <>
+                uint8x16_t reverseNeon<2>(uint8x16_t value) { return vrev16q_u8(value); }
+
+                template <>
+                uint8x16_t reverseNeon<4>(uint8x16_t value) { return vrev32q_u8(value); }
+
+                template <>
+                uint8x16_t reverseNeon<8>(uint8x16_t value) { return vrev64q_u8(value); }
+
+                template <size_t Width>
+                void swapNeon(const uint8_t *src, uint8_t *dst, size_t count)
+                {
+                    const size_t bytes = count * Width;
+                    size_t i = 0;
+                    for (; i + 64 <= bytes; i += 64)
+                    {
+                        const uint8x16_t a = vld1q_u8(src + i);
+                        const uint8x16_t b = vld1q_u8(src + i + 16);
+                        const uint8x16_t c = vld1q_u8(src + i + 32);
+                        const uint8x16_t d = vld1q_u8(src + i + 48);
+                        vst1q_u8(dst + i, reverseNeon<Width>(a));
+                        vst1q_u8(dst + i + 16, reverseNeon<Width>(b));
+                        vst1q_u8(dst + i + 32, reverseNeon<Width>(c));
+                        vst1q_u8(dst + i + 48, reverseNeon<Width>(d));
+                    }
+                    for (; i + 16 <= bytes; i += 16)
+                    {
+                        vst1q_u8(dst + i, reverseNeon<Width>(vld1q_u8(src + i)));
+                    }
+                    swapScalar<Width>(src + i, dst + i, (bytes - i) / Width);
+                }
+#endif // ARA_COM_BYTE_SWAP_NEON
+
+                const KernelTable kScalarTable = {ByteSwapKernel::kScalar, &swapScalar<2>, &swapScalar<4>, &swapScalar<8>};
+#if defined(ARA_COM_BYTE_SWAP_X86)
+                const KernelTable kSsse3Table = {ByteSwapKernel::kSsse3, &swapSsse3<2>, &swapSsse3<4>, &swapSsse3<8>};
+                const KernelTable kAvx2Table = {ByteSwapKernel::kAvx2, &swapAvx2<2>, &swapAvx2<4>, &swapAvx2<8>};
+#endif
+#if defined(ARA_COM_BYTE_SWAP_NEON)
+                const KernelTable kNeonTable = {ByteSwapKernel::kNeon, &swapNeon<2>, &swapNeon<4>, &swapNeon<8>};
+#endif
+
+                /**
+                 * \brief CPU 不支持时返回 nullptr
+                 */
+                const KernelTable *tableOf(ByteSwapKernel kernel)
+                {
+                    switch (kernel)
+                    {
+                    case ByteSwapKernel::kScalar:
+                        return &kScalarTable;
+#if defined(ARA_COM_BYTE_SWAP_X86)
+                    case ByteSwapKernel::kSsse3:
+                        __builtin_cpu_init();
+                        return __builtin_cpu_supports("ssse3") ? &kSsse3Table : nullptr;
+                    case ByteSwapKernel::kAvx2:
+                        __builtin_cpu_init();
+                        return __builtin_cpu_supports("avx2") ? &kAvx2Table : nullptr;
+#endif
+#if defined(ARA_COM_BYTE_SWAP_NEON)
+                    case ByteSwapKernel::kNeon:
+                        return &kNeonTable;
+#endif
+                    default:
+                        return nullptr;
+                    }
+                }
+
+                const KernelTable *selectBest()
+                {
+                    const ByteSwapKernel preferred[] = {ByteSwapKernel::kAvx2, ByteSwapKernel::kNeon, ByteSwapKernel::kSsse3};
+                    for (ByteSwapKernel kernel : preferred)
+                    {
+                        const KernelTable *table = tableOf(kernel);
+                        if (table != nullptr)
+                        {
+                            return table;
+                        }
+                    }
+                    return &kScalarTable;
+                }
+
+                std::atomic<const KernelTable *> g_activeTable{nullptr};
+
+                const KernelTable &activeTable()
+                {
+                    const KernelTable *table = g_activeTable.load(std::memory_order_acquire);
+                    if (table == nullptr)
+                    {
+                        // 多个线程同时初始化时结果相同 谁写入都可以
+                        table = selectBest();
+                        g_activeTable.store(table, std::memory_order_release);
+                    }
+                    return *table;
+                }
+            } // namespace
+
+            void SwapBytes16(const void *src, void *dst, size_t count)
+            {
+                activeTable().swap16(static_cast<const uint8_t *>(src), static_cast<uint8_t *>(dst), count);
+            }
+
+            void SwapBytes32(const void *src, void *dst, size_t count)
+            {
+                activeTable().swap32(static_cast<const uint8_t *>(src), static_cast<uint8_t *>(dst), count);
+            }
+
+            void SwapBytes64(const void *src, void *dst, size_t count)
+            {
+                activeTable().swap64(static_cast<const uint8_t *>(src), static_cast<uint8_t *>(dst), count);
+            }
+
+            ByteSwapKernel GetByteSwapKernel()
+            {
+                return activeTable().kernel;
+            }
+
+            bool SetByteSwapKernel(ByteSwapKernel kernel)
+            {
+                const KernelTable *table = tableOf(kernel);
+                if (table == nullptr)
+                {
+                    return false;
+                }
+                g_activeTable.store(table, std::memory_order_release);
+                return true;
+            }
+
+            const char *ByteSwapKernelName(ByteSwapKernel kernel)
+            {
+                switch (kernel)
+                {
+                case ByteSwapKernel::kScalar:
+                    return "scalar";
+                case ByteSwapKernel::kSsse3:
+                    return "ssse3";
+                case ByteSwapKernel::kAvx2:
+                    return "avx2";
+                case ByteSwapKernel::kNeon:
+                    return "neon";
+                default:
+                    return "unknown";
+                }
+            }
+
+        } // namespace serialization
+
+    } // namespace com
+
+} // namespace ara
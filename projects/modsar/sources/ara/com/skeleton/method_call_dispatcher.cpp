@@ -0,0 +1,112 @@
+#include <atomic>
+
+#include "ara/com/skeleton/method_call_dispatcher.h"
+#include "ara/core/promise.h"
+#include "ara/com/com_error_domain.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace skeleton
+        {
+            namespace
+            {
+                // 客户端 id 只有 16 位 kEventSingleThread 的 strand 用第 16 位 不会和任何客户端的 strand 相同
+                const uint32_t kSerialStrand = 0x10000U;
+
+                std::atomic<uint64_t> g_nextDispatcherId(1);
+            } // namespace
+
+            MethodCallDispatcher::MethodCallDispatcher(MethodCallProcessingMode mode, bool orderPerClient, WorkerPool &pool)
+                : mode_(mode), orderPerClient_(orderPerClient), pool_(pool),
+                  id_(g_nextDispatcherId.fetch_add(1, std::memory_order_relaxed)), pollQueueLimit_(kDefaultPollQueueLimit)
+            {
+            }
+
+            /**
+             * \brief 高 32 位放 dispatcher 的序号 低 32 位放客户端 id 两部分不重叠 不同 dispatcher 和客户端的 key 不会相同
+             * 序号不复用 析构后新建的 dispatcher 不会接上旧 strand 里剩下的任务
+             */
+            uint64_t MethodCallDispatcher::strandKey(uint32_t lane) const
+            {
+                return (id_ << 32) | lane;
+            }
+
+            ara::core::Result<void> MethodCallDispatcher::Dispatch(uint16_t client, MethodCall call, bool ordered)
+            {
+                switch (mode_)
+                {
+                case MethodCallProcessingMode::kPoll:
+                {
+                    std::lock_guard<std::mutex> lock(pollMutex_);
+                    if (pollQueue_.size() >= pollQueueLimit_)
+                    {
+                        return ara::core::Result<void>::FromError(MakeErrorCode(ComErrc::kMaxSamplesExceeded, 0));
+                    }
+                    pollQueue_.push_back(std::move(call));
+                    break;
+                }
+                case MethodCallProcessingMode::kEventSingleThread:
+                    pool_.SubmitOrdered(strandKey(kSerialStrand), std::move(call));
+                    break;
+                case MethodCallProcessingMode::kEvent:
+                default:
+                    if (orderPerClient_ || ordered)
+                    {
+                        pool_.SubmitOrdered(strandKey(client), std::move(call));
+                    }
+                    else
+                    {
+                        pool_.Submit(std::move(call));
+                    }
+                    break;
+                }
+                return ara::core::Result<void>::FromValue();
+            }
+
+            ara::core::Future<bool> MethodCallDispatcher::ProcessNextMethodCall()
+            {
+                ara::core::Promise<bool> promise;
+                ara::core::Future<bool> future = promise.get_future();
+                if (mode_ != MethodCallProcessingMode::kPoll)
+                {
+                    promise.SetError(MakeErrorCode(ComErrc::kWrongMethodCallProcessingMode, 0));
+                    return future;
+                }
+                MethodCall call;
+                {
+                    std::lock_guard<std::mutex> lock(pollMutex_);
+                    if (!pollQueue_.empty())
+                    {
+                        call = std::move(pollQueue_.front());
+                        pollQueue_.pop_front();
+                    }
+                }
+                if (!call)
+                {
+                    promise.set_value(false);
+                    return future;
+                }
+                call();
+                promise.set_value(true);
+                return future;
+            }
+
+            size_t MethodCallDispatcher::Pending() const
+            {
+                std::lock_guard<std::mutex> lock(pollMutex_);
+                return pollQueue_.size();
+            }
+
+            void MethodCallDispatcher::SetPollQueueLimit(size_t limit)
+            {
+                std::lock_guard<std::mutex> lock(pollMutex_);
+                pollQueueLimit_ = limit;
+            }
+
+        } // namespace skeleton
+
+    } // namespace com
+
+} // namespace ara
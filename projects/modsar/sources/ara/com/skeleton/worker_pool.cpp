@@ -0,0 +1,180 @@
+#include "ara/com/skeleton/worker_pool.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace skeleton
+        {
+            namespace
+            {
+                // 当前线程所属的线程池和 worker 下标 用于 worker 内提交时进入自己的队列
+                thread_local WorkerPool *t_pool = nullptr;
+                thread_local size_t t_index = 0;
+            } // namespace
+
+            WorkerPool::WorkerPool(size_t threads)
+                : nextWorker_(0), pending_(0), sleepers_(0), stop_(false)
+            {
+                if (threads == 0)
+                {
+                    threads = std::thread::hardware_concurrency();
+                    if (threads == 0)
+                    {
+                        threads = 1;
+                    }
+                }
+                workers_.reserve(threads);
+                for (size_t i = 0; i < threads; ++i)
+                {
+                    workers_.emplace_back(new Worker());
+                }
+                for (size_t i = 0; i < threads; ++i)
+                {
+                    workers_[i]->thread = std::thread(&WorkerPool::run, this, i);
+                }
+            }
+
+            WorkerPool::~WorkerPool()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(sleepMutex_);
+                    stop_.store(true, std::memory_order_release);
+                }
+                sleepCond_.notify_all();
+                for (auto &worker : workers_)
+                {
+                    if (worker->thread.joinable())
+                    {
+                        worker->thread.join();
+                    }
+                }
+            }
+
+            void WorkerPool::Submit(Task task)
+            {
+                const size_t index = (t_pool == this) ? t_index
+                                                      : nextWorker_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+                {
+                    std::lock_guard<std::mutex> lock(workers_[index]->mutex);
+                    workers_[index]->tasks.push_back(std::move(task));
+                }
+                // pending_ 与 sleepers_ 的读写需要 seq_cst 保证不会漏掉正在入睡的 worker
+                pending_.fetch_add(1);
+                if (sleepers_.load() != 0)
+                {
+                    std::lock_guard<std::mutex> lock(sleepMutex_);
+                    sleepCond_.notify_one();
+                }
+            }
+
+            void WorkerPool::SubmitOrdered(uint64_t key, Task task)
+            {
+                StrandShard &shard = strandShards_[key % kStrandShards];
+                bool schedule = false;
+                {
+                    std::lock_guard<std::mutex> lock(shard.mutex);
+                    Strand &strand = shard.strands[key];
+                    // 队列为空说明没有调度中的 strand 需要新调度一次
+                    schedule = strand.tasks.empty();
+                    strand.tasks.push_back(std::move(task));
+                }
+                if (schedule)
+                {
+                    Submit([this, key]
+                           { runStrand(key); });
+                }
+            }
+
+            WorkerPool &WorkerPool::Default()
+            {
+                static WorkerPool pool;
+                return pool;
+            }
+
+            void WorkerPool::run(size_t index)
+            {
+                t_pool = this;
+                t_index = index;
+                Task task;
+                while (!stop_.load(std::memory_order_acquire))
+                {
+                    if (popLocal(index, task) || steal(index, task))
+                    {
+                        pending_.fetch_sub(1, std::memory_order_relaxed);
+                        task();
+                        task = nullptr;
+                        continue;
+                    }
+                    std::unique_lock<std::mutex> lock(sleepMutex_);
+                    sleepers_.fetch_add(1);
+                    sleepCond_.wait(lock, [this]
+                                    { return stop_.load() || pending_.load() != 0; });
+                    sleepers_.fetch_sub(1);
+                }
+            }
+
+            bool WorkerPool::popLocal(size_t index, Task &task)
+            {
+                Worker &worker = *workers_[index];
+                std::lock_guard<std::mutex> lock(worker.mutex);
+                if (worker.tasks.empty())
+                {
+                    return false;
+                }
+                task = std::move(worker.tasks.back());
+                worker.tasks.pop_back();
+                return true;
+            }
+
+            bool WorkerPool::steal(size_t index, Task &task)
+            {
+                const size_t count = workers_.size();
+                for (size_t offset = 1; offset < count; ++offset)
+                {
+                    Worker &victim = *workers_[(index + offset) % count];
+                    std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+                    if (!lock.owns_lock() || victim.tasks.empty())
+                    {
+                        continue;
+                    }
+                    task = std::move(victim.tasks.front());
+                    victim.tasks.pop_front();
+                    return true;
+                }
+                return false;
+            }
+
+            void WorkerPool::runStrand(uint64_t key)
+            {
+                StrandShard &shard = strandShards_[key % kStrandShards];
+                Task task;
+                {
+                    std::lock_guard<std::mutex> lock(shard.mutex);
+                    task = std::move(shard.strands[key].tasks.front());
+                }
+                task();
+                bool more = false;
+                {
+                    std::lock_guard<std::mutex> lock(shard.mutex);
+                    auto it = shard.strands.find(key);
+                    it->second.tasks.pop_front();
+                    more = !it->second.tasks.empty();
+                    if (!more)
+                    {
+                        shard.strands.erase(it);
+                    }
+                }
+                // 每次只执行一个任务后重新排队 避免一个客户端长期占用 worker
+                if (more)
+                {
+                    Submit([this, key]
+                           { runStrand(key); });
+                }
+            }
+
+        } // namespace skeleton
+
+    } // namespace com
+
+} // namespace ara
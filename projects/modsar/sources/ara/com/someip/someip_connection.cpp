@@ -0,0 +1,807 @@
+#include <algorithm>
+#include <set>
+
+#include <vsomeip/vsomeip.hpp>
+
+#include "ara/com/com_error_domain.h"
+#include "ara/com/routing/routing_table.h"
+#include "ara/com/someip/someip_connection.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace someip
+        {
+            namespace
+            {
+                HandlerRole roleOf(const Message &message)
+                {
+                    switch (message.get_message_type())
+                    {
+                    case vsomeip::message_type_e::MT_REQUEST:
+                    case vsomeip::message_type_e::MT_REQUEST_NO_RETURN:
+                        return HandlerRole::kServer;
+                    default:
+                        return HandlerRole::kClient;
+                    }
+                }
+
+                uint16_t serviceOf(uint64_t key) { return static_cast<uint16_t>(key >> 32); }
+
+                uint16_t instanceOf(uint64_t key) { return static_cast<uint16_t>(key >> 16); }
+
+                uint16_t idOf(uint64_t key) { return static_cast<uint16_t>(key); }
+
+                // 事件的键 比实例的键多一个 eventgroup 重新启动时按它恢复订阅
+                uint64_t eventKeyOf(uint16_t serviceId, uint16_t instanceId, uint16_t eventgroupId, uint16_t eventId)
+                {
+                    return (static_cast<uint64_t>(serviceId) << 48) | (static_cast<uint64_t>(instanceId) << 32) |
+                           (static_cast<uint64_t>(eventgroupId) << 16) | eventId;
+                }
+
+                // 在途请求的键 应答带着和请求相同的 service instance method session
+                uint64_t callKeyOf(const Message &message)
+                {
+                    return (static_cast<uint64_t>(message.get_service()) << 48) | (static_cast<uint64_t>(message.get_instance()) << 32) |
+                           (static_cast<uint64_t>(message.get_method()) << 16) | message.get_session();
+                }
+
+                bool isResponse(const Message &message)
+                {
+                    return message.get_message_type() == vsomeip::message_type_e::MT_RESPONSE ||
+                           message.get_message_type() == vsomeip::message_type_e::MT_ERROR;
+                }
+
+                // TP 分段用 除 payload 外和 message 相同
+                std::shared_ptr<Message> copyHeader(const Message &message)
+                {
+                    std::shared_ptr<Message> copy = vsomeip::runtime::get()->create_message(message.is_reliable());
+                    copy->set_service(message.get_service());
+                    copy->set_instance(message.get_instance());
+                    copy->set_method(message.get_method());
+                    copy->set_client(message.get_client());
+                    copy->set_session(message.get_session());
+                    copy->set_interface_version(message.get_interface_version());
+                    copy->set_message_type(message.get_message_type());
+                    copy->set_return_code(message.get_return_code());
+                    return copy;
+                }
+
+                bool hasTpFlag(const Message &message)
+                {
+                    return (static_cast<uint8_t>(message.get_message_type()) & tp::kTpFlag) != 0;
+                }
+
+                vsomeip::message_type_e withTpFlag(vsomeip::message_type_e type)
+                {
+                    return static_cast<vsomeip::message_type_e>(static_cast<uint8_t>(type) | tp::kTpFlag);
+                }
+
+                vsomeip::message_type_e withoutTpFlag(vsomeip::message_type_e type)
+                {
+                    return static_cast<vsomeip::message_type_e>(static_cast<uint8_t>(type) & ~tp::kTpFlag);
+                }
+
+                std::vector<vsomeip::byte_t> segmentBytes(const uint8_t *tpHeader, const uint8_t *data, size_t length)
+                {
+                    std::vector<vsomeip::byte_t> bytes;
+                    bytes.reserve(tp::kTpHeaderSize + length);
+                    bytes.insert(bytes.end(), tpHeader, tpHeader + tp::kTpHeaderSize);
+                    bytes.insert(bytes.end(), data, data + length);
+                    return bytes;
+                }
+            } // namespace
+
+            struct SomeIpConnection::Application
+            {
+                std::shared_ptr<vsomeip::application> app;
+            };
+
+            constexpr uint16_t SomeIpConnection::kAnyInstance;
+            constexpr size_t SomeIpConnection::kMaxEarlyResponses;
+
+            SomeIpConnection &SomeIpConnection::Instance()
+            {
+                static SomeIpConnection connection;
+                return connection;
+            }
+
+            SomeIpConnection::SomeIpConnection() : users_(0), nextAvailabilityId_(kInvalidHandlerId + 1), tpSession_(0), tpEnabled_(false)
+            {
+            }
+
+            SomeIpConnection::~SomeIpConnection()
+            {
+                // 进程退出时还有使用者 不等它们 Release
+                if (application_)
+                {
+                    application_->app->clear_all_handler();
+                    application_->app->stop();
+                }
+                if (thread_.joinable())
+                {
+                    thread_.join();
+                }
+            }
+
+            void SomeIpConnection::SetApplicationName(const std::string &name)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                name_ = name;
+            }
+
+            ara::core::Result<void> SomeIpConnection::Acquire()
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (users_ != 0)
+                {
+                    ++users_;
+                    return ara::core::Result<void>::FromValue();
+                }
+                // 名字为空时 vsomeip 从 VSOMEIP_APPLICATION_NAME 环境变量取
+                std::shared_ptr<vsomeip::application> app = vsomeip::runtime::get()->create_application(name_);
+                if (!app || !app->init())
+                {
+                    return ara::core::Result<void>::FromError(MakeErrorCode(ComErrc::kNetworkBindingFailure, 0));
+                }
+                app->register_message_handler(vsomeip::ANY_SERVICE, vsomeip::ANY_INSTANCE, vsomeip::ANY_METHOD,
+                                              [this](const std::shared_ptr<vsomeip::message> &message)
+                                              { Dispatch(message); });
+                app->register_availability_handler(vsomeip::ANY_SERVICE, vsomeip::ANY_INSTANCE,
+                                                   [this](vsomeip::service_t serviceId, vsomeip::instance_t instanceId, bool available)
+                                                   { onAvailability(serviceId, instanceId, available); });
+                // vsomeip 在注册到路由管理器之前缓存这些请求 握手完成后一起发出
+                for (const auto &entry : offeredEvents_)
+                {
+                    const uint64_t key = entry.first;
+                    app->offer_event(static_cast<uint16_t>(key >> 48), static_cast<uint16_t>(key >> 32), idOf(key),
+                                     std::set<vsomeip::eventgroup_t>{static_cast<uint16_t>(key >> 16)}, vsomeip::event_type_e::ET_EVENT);
+                }
+                for (const auto &entry : offered_)
+                {
+                    app->offer_service(serviceOf(entry.first), instanceOf(entry.first));
+                }
+                for (const auto &entry : requested_)
+                {
+                    app->request_service(serviceOf(entry.first), instanceOf(entry.first));
+                }
+                for (const auto &entry : subscribedEvents_)
+                {
+                    const uint64_t key = entry.first;
+                    app->request_event(static_cast<uint16_t>(key >> 48), static_cast<uint16_t>(key >> 32), idOf(key),
+                                       std::set<vsomeip::eventgroup_t>{static_cast<uint16_t>(key >> 16)}, vsomeip::event_type_e::ET_EVENT);
+                }
+                for (const auto &entry : subscribedGroups_)
+                {
+                    app->subscribe(serviceOf(entry.first), instanceOf(entry.first), idOf(entry.first));
+                }
+                application_ = std::make_shared<Application>(Application{app});
+                thread_ = std::thread([app]
+                                      { app->start(); });
+                users_ = 1;
+                return ara::core::Result<void>::FromValue();
+            }
+
+            void SomeIpConnection::Release()
+            {
+                std::shared_ptr<Application> application;
+                std::thread thread;
+                std::unordered_map<uint64_t, bool> available;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (users_ == 0 || --users_ != 0)
+                    {
+                        return;
+                    }
+                    application = std::move(application_);
+                    thread = std::move(thread_);
+                    requested_.clear();
+                    offered_.clear();
+                    offeredEvents_.clear();
+                    subscribedEvents_.clear();
+                    subscribedGroups_.clear();
+                    available.swap(available_);
+                }
+                // stop 会等 dispatch 线程上正在执行的 handler 返回 不能持有 mutex_
+                application->app->clear_all_handler();
+                application->app->stop();
+                thread.join();
+                // 停止后收不到 StopOffer 不再经 SOME/IP 路由
+                for (const auto &entry : available)
+                {
+                    if (entry.second)
+                    {
+                        ara::com::routing::RoutingTable::Instance().ReportStopOffer(serviceOf(entry.first), instanceOf(entry.first),
+                                                                                    ara::com::routing::BindingKind::kSomeIp);
+                    }
+                }
+                std::lock_guard<std::mutex> lock(callsMutex_);
+                calls_.clear();
+                early_.clear();
+            }
+
+            bool SomeIpConnection::IsRunning() const
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return application_ != nullptr;
+            }
+
+            ara::core::Result<HandlerId> SomeIpConnection::RegisterRequestHandler(uint16_t serviceId, uint16_t instanceId, uint16_t methodId,
+                                                                                   SomeIpDispatchTable<Message>::Handler handler)
+            {
+                const HandlerId id = handlers_.Add(DispatchKeyOf(HandlerRole::kServer, serviceId, instanceId, methodId), std::move(handler), true);
+                if (id == kInvalidHandlerId)
+                {
+                    return ara::core::Result<HandlerId>::FromError(MakeErrorCode(ComErrc::kCouldNotExecute, 0));
+                }
+                return ara::core::Result<HandlerId>::FromValue(id);
+            }
+
+            HandlerId SomeIpConnection::RegisterResponseHandler(uint16_t serviceId, uint16_t instanceId, uint16_t methodId,
+                                                                SomeIpDispatchTable<Message>::Handler handler)
+            {
+                return handlers_.Add(DispatchKeyOf(HandlerRole::kClient, serviceId, instanceId, methodId), std::move(handler), false);
+            }
+
+            std::vector<HandlerId> SomeIpConnection::RegisterResponseHandlers(uint16_t serviceId, uint16_t instanceId,
+                                                                              std::vector<std::pair<uint16_t, SomeIpDispatchTable<Message>::Handler>> handlers)
+            {
+                std::vector<std::pair<uint64_t, SomeIpDispatchTable<Message>::Handler>> entries;
+                entries.reserve(handlers.size());
+                for (auto &handler : handlers)
+                {
+                    entries.emplace_back(DispatchKeyOf(HandlerRole::kClient, serviceId, instanceId, handler.first), std::move(handler.second));
+                }
+                return handlers_.AddBatch(std::move(entries), false);
+            }
+
+            void SomeIpConnection::UnregisterHandler(HandlerId id)
+            {
+                handlers_.Remove(id);
+                forgetCalls({id});
+            }
+
+            void SomeIpConnection::UnregisterHandlers(const std::vector<HandlerId> &ids)
+            {
+                handlers_.RemoveBatch(ids);
+                forgetCalls(ids);
+            }
+
+            void SomeIpConnection::forgetCalls(const std::vector<HandlerId> &ids)
+            {
+                std::lock_guard<std::mutex> lock(callsMutex_);
+                for (auto call = calls_.begin(); call != calls_.end();)
+                {
+                    if (std::find(ids.begin(), ids.end(), call->second.handler) != ids.end())
+                    {
+                        call = calls_.erase(call);
+                    }
+                    else
+                    {
+                        ++call;
+                    }
+                }
+            }
+
+            HandlerId SomeIpConnection::RegisterAvailabilityHandler(uint16_t serviceId, uint16_t instanceId, AvailabilityHandler handler)
+            {
+                HandlerId id;
+                std::vector<std::pair<uint16_t, bool>> known; // 已经知道状态的实例 在锁外通知
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    id = nextAvailabilityId_++;
+                    availabilityHandlers_.push_back(Availability{id, serviceId, instanceId, handler});
+                    for (const auto &entry : available_)
+                    {
+                        if (serviceOf(entry.first) == serviceId && (instanceId == kAnyInstance || instanceOf(entry.first) == instanceId))
+                        {
+                            known.emplace_back(instanceOf(entry.first), entry.second);
+                        }
+                    }
+                }
+                for (const auto &state : known)
+                {
+                    handler(serviceId, state.first, state.second);
+                }
+                return id;
+            }
+
+            void SomeIpConnection::UnregisterAvailabilityHandler(HandlerId id)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                for (auto entry = availabilityHandlers_.begin(); entry != availabilityHandlers_.end(); ++entry)
+                {
+                    if (entry->id == id)
+                    {
+                        availabilityHandlers_.erase(entry);
+                        return;
+                    }
+                }
+            }
+
+            void SomeIpConnection::onAvailability(uint16_t serviceId, uint16_t instanceId, bool available)
+            {
+                std::vector<AvailabilityHandler> handlers;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    available_[keyOf(serviceId, instanceId)] = available;
+                    for (const Availability &entry : availabilityHandlers_)
+                    {
+                        if (entry.serviceId == serviceId && (entry.instanceId == kAnyInstance || entry.instanceId == instanceId))
+                        {
+                            handlers.push_back(entry.handler);
+                        }
+                    }
+                }
+                // SOME/IP 的可用状态就是这个 binding 的 Offer 上报给路由表 FindService 据此选择 binding
+                if (available)
+                {
+                    ara::com::routing::RoutingTable::Instance().ReportOffer(serviceId, instanceId, ara::com::routing::BindingKind::kSomeIp);
+                }
+                else
+                {
+                    ara::com::routing::RoutingTable::Instance().ReportStopOffer(serviceId, instanceId, ara::com::routing::BindingKind::kSomeIp);
+                }
+                for (const AvailabilityHandler &handler : handlers)
+                {
+                    handler(serviceId, instanceId, available);
+                }
+            }
+
+            bool SomeIpConnection::retain(std::unordered_map<uint64_t, uint32_t> &counts, uint64_t key)
+            {
+                return ++counts[key] == 1;
+            }
+
+            bool SomeIpConnection::releaseCount(std::unordered_map<uint64_t, uint32_t> &counts, uint64_t key)
+            {
+                auto found = counts.find(key);
+                if (found == counts.end() || --found->second != 0)
+                {
+                    return false;
+                }
+                counts.erase(found);
+                return true;
+            }
+
+            void SomeIpConnection::RequestService(uint16_t serviceId, uint16_t instanceId)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (retain(requested_, keyOf(serviceId, instanceId)) && application_)
+                {
+                    application_->app->request_service(serviceId, instanceId);
+                }
+            }
+
+            void SomeIpConnection::ReleaseService(uint16_t serviceId, uint16_t instanceId)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (releaseCount(requested_, keyOf(serviceId, instanceId)) && application_)
+                {
+                    application_->app->release_service(serviceId, instanceId);
+                }
+            }
+
+            void SomeIpConnection::OfferServices(const std::vector<ServiceInstance> &services)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                for (const ServiceInstance &service : services)
+                {
+                    if (retain(offered_, keyOf(service.serviceId, service.instanceId)) && application_)
+                    {
+                        application_->app->offer_service(service.serviceId, service.instanceId);
+                    }
+                }
+            }
+
+            void SomeIpConnection::StopOfferServices(const std::vector<ServiceInstance> &services)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                for (const ServiceInstance &service : services)
+                {
+                    if (releaseCount(offered_, keyOf(service.serviceId, service.instanceId)) && application_)
+                    {
+                        application_->app->stop_offer_service(service.serviceId, service.instanceId);
+                    }
+                }
+            }
+
+            void SomeIpConnection::SubscribeEvents(uint16_t serviceId, uint16_t instanceId, const std::vector<EventSubscription> &events)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                std::vector<uint16_t> groups; // 这一批里新订阅的 eventgroup 全部事件 request 之后再 subscribe
+                for (const EventSubscription &event : events)
+                {
+                    if (retain(subscribedEvents_, eventKeyOf(serviceId, instanceId, event.eventgroupId, event.eventId)) && application_)
+                    {
+                        application_->app->request_event(serviceId, instanceId, event.eventId, std::set<vsomeip::eventgroup_t>{event.eventgroupId},
+                                                         vsomeip::event_type_e::ET_EVENT);
+                    }
+                    if (retain(subscribedGroups_, keyOf(serviceId, instanceId, event.eventgroupId)))
+                    {
+                        groups.push_back(event.eventgroupId);
+                    }
+                }
+                if (application_)
+                {
+                    for (uint16_t eventgroupId : groups)
+                    {
+                        application_->app->subscribe(serviceId, instanceId, eventgroupId);
+                    }
+                }
+            }
+
+            void SomeIpConnection::UnsubscribeEvents(uint16_t serviceId, uint16_t instanceId, const std::vector<EventSubscription> &events)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                for (const EventSubscription &event : events)
+                {
+                    if (releaseCount(subscribedGroups_, keyOf(serviceId, instanceId, event.eventgroupId)) && application_)
+                    {
+                        application_->app->unsubscribe(serviceId, instanceId, event.eventgroupId);
+                    }
+                    if (releaseCount(subscribedEvents_, eventKeyOf(serviceId, instanceId, event.eventgroupId, event.eventId)) && application_)
+                    {
+                        application_->app->release_event(serviceId, instanceId, event.eventId);
+                    }
+                }
+            }
+
+            void SomeIpConnection::OfferEvents(uint16_t serviceId, uint16_t instanceId, const std::vector<EventSubscription> &events)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                for (const EventSubscription &event : events)
+                {
+                    if (retain(offeredEvents_, eventKeyOf(serviceId, instanceId, event.eventgroupId, event.eventId)) && application_)
+                    {
+                        application_->app->offer_event(serviceId, instanceId, event.eventId, std::set<vsomeip::eventgroup_t>{event.eventgroupId},
+                                                       vsomeip::event_type_e::ET_EVENT);
+                    }
+                }
+            }
+
+            void SomeIpConnection::StopOfferEvents(uint16_t serviceId, uint16_t instanceId, const std::vector<EventSubscription> &events)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                for (const EventSubscription &event : events)
+                {
+                    if (releaseCount(offeredEvents_, eventKeyOf(serviceId, instanceId, event.eventgroupId, event.eventId)) && application_)
+                    {
+                        application_->app->stop_offer_event(serviceId, instanceId, event.eventId);
+                    }
+                }
+            }
+
+            ara::core::Result<void> SomeIpConnection::Notify(uint16_t serviceId, uint16_t instanceId, uint16_t eventId, std::vector<uint8_t> data)
+            {
+                std::shared_ptr<Application> application;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    application = application_;
+                }
+                if (!application)
+                {
+                    return ara::core::Result<void>::FromError(MakeErrorCode(ComErrc::kServiceNotAvailable, 0));
+                }
+                if (tpRouteOf(serviceId, instanceId, eventId, nullptr))
+                {
+                    notifySegmented(*application, serviceId, instanceId, eventId, data);
+                    return ara::core::Result<void>::FromValue();
+                }
+                std::shared_ptr<vsomeip::payload> payload = vsomeip::runtime::get()->create_payload();
+                payload->set_data(std::move(data));
+                application->app->notify(serviceId, instanceId, eventId, payload);
+                return ara::core::Result<void>::FromValue();
+            }
+
+            std::shared_ptr<Message> SomeIpConnection::CreateRequest(uint16_t serviceId, uint16_t instanceId, uint16_t methodId, bool reliable) const
+            {
+                std::shared_ptr<Message> request = vsomeip::runtime::get()->create_request(reliable);
+                request->set_service(serviceId);
+                request->set_instance(instanceId);
+                request->set_method(methodId);
+                return request;
+            }
+
+            std::shared_ptr<Message> SomeIpConnection::CreateResponse(const std::shared_ptr<Message> &request) const
+            {
+                return vsomeip::runtime::get()->create_response(request);
+            }
+
+            ara::core::Result<void> SomeIpConnection::SendErrorResponse(const std::shared_ptr<Message> &request)
+            {
+                if (request->get_message_type() != vsomeip::message_type_e::MT_REQUEST)
+                {
+                    return ara::core::Result<void>::FromValue();
+                }
+                std::shared_ptr<Message> response = CreateResponse(request);
+                response->set_message_type(vsomeip::message_type_e::MT_ERROR);
+                response->set_return_code(vsomeip::return_code_e::E_NOT_OK);
+                return Send(response);
+            }
+
+            ara::core::Result<void> SomeIpConnection::SendRequest(const std::shared_ptr<Message> &request, HandlerId responseHandler)
+            {
+                std::shared_ptr<Application> application;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    application = application_;
+                }
+                if (!application)
+                {
+                    return ara::core::Result<void>::FromError(MakeErrorCode(ComErrc::kServiceNotAvailable, 0));
+                }
+                sendRequest(*application, request, responseHandler);
+                return ara::core::Result<void>::FromValue();
+            }
+
+            ara::core::Result<void> SomeIpConnection::SendRequests(const std::vector<std::shared_ptr<Message>> &requests,
+                                                                   const std::vector<HandlerId> &responseHandlers)
+            {
+                std::shared_ptr<Application> application;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    application = application_;
+                }
+                if (!application)
+                {
+                    return ara::core::Result<void>::FromError(MakeErrorCode(ComErrc::kServiceNotAvailable, 0));
+                }
+                // 不能在发送期间持有 callsMutex_ 本地投递会在 send 里重入 Dispatch
+                for (size_t i = 0; i < requests.size(); ++i)
+                {
+                    sendRequest(*application, requests[i], responseHandlers[i]);
+                }
+                return ara::core::Result<void>::FromValue();
+            }
+
+            void SomeIpConnection::sendRequest(Application &application, const std::shared_ptr<Message> &request, HandlerId responseHandler)
+            {
+                const PendingCall call{responseHandler, request->get_session()};
+                // send 把本进程的 client id 和 vsomeip 自己分配的 session 写回 request 应答带的是这个 session
+                // 分段发送时服务端按最后一段的头部应答 最后一段就是 request 本身
+                if (tpRouteOf(request->get_service(), request->get_instance(), request->get_method(), nullptr))
+                {
+                    sendSegmented(application, request);
+                }
+                else
+                {
+                    application.app->send(request);
+                }
+                const uint64_t key = callKeyOf(*request);
+                std::shared_ptr<Message> response;
+                {
+                    std::lock_guard<std::mutex> lock(callsMutex_);
+                    for (auto early = early_.begin(); early != early_.end(); ++early)
+                    {
+                        if (early->first == key)
+                        {
+                            response = std::move(early->second);
+                            early_.erase(early);
+                            break;
+                        }
+                    }
+                    if (!response)
+                    {
+                        calls_[key] = call;
+                    }
+                }
+                // 应答在 send 返回前已经到达 在调用线程上交付
+                if (response)
+                {
+                    deliver(response, call);
+                }
+            }
+
+            bool SomeIpConnection::deliver(const std::shared_ptr<Message> &response, const PendingCall &call)
+            {
+                response->set_session(call.session);
+                return handlers_.DispatchTo(DispatchKeyOf(HandlerRole::kClient, response->get_service(), response->get_instance(), response->get_method()),
+                                     call.handler, response);
+            }
+
+            ara::core::Result<void> SomeIpConnection::Send(const std::shared_ptr<Message> &message)
+            {
+                std::shared_ptr<Application> application;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    application = application_;
+                }
+                if (!application)
+                {
+                    return ara::core::Result<void>::FromError(MakeErrorCode(ComErrc::kServiceNotAvailable, 0));
+                }
+                if (tpRouteOf(message->get_service(), message->get_instance(), message->get_method(), nullptr))
+                {
+                    sendSegmented(*application, message);
+                }
+                else
+                {
+                    application->app->send(message);
+                }
+                return ara::core::Result<void>::FromValue();
+            }
+
+            size_t SomeIpConnection::Dispatch(const std::shared_ptr<Message> &message)
+            {
+                size_t delivered = 0;
+                if (!reassemble(message, delivered))
+                {
+                    return delivered;
+                }
+                if (isResponse(*message))
+                {
+                    const uint64_t key = callKeyOf(*message);
+                    PendingCall call{kInvalidHandlerId, 0};
+                    {
+                        std::lock_guard<std::mutex> lock(callsMutex_);
+                        auto found = calls_.find(key);
+                        if (found == calls_.end())
+                        {
+                            if (early_.size() == kMaxEarlyResponses)
+                            {
+                                early_.pop_front();
+                            }
+                            early_.emplace_back(key, message);
+                            return 0;
+                        }
+                        call = found->second;
+                        calls_.erase(found);
+                    }
+                    return deliver(message, call) ? 1 : 0;
+                }
+                return handlers_.Dispatch(DispatchKeyOf(roleOf(*message), message->get_service(), message->get_instance(), message->get_method()),
+                                          message);
+            }
+
+            void SomeIpConnection::SetTpSettings(const TpSettings &settings)
+            {
+                std::lock_guard<std::mutex> lock(tpMutex_);
+                if (!reassembler_)
+                {
+                    tpSettings_ = settings;
+                }
+            }
+
+            void SomeIpConnection::EnableTp(uint16_t serviceId, uint16_t instanceId, uint16_t methodId, TpReassembledHandler reassembled)
+            {
+                std::lock_guard<std::mutex> lock(tpMutex_);
+                if (!reassembler_)
+                {
+                    reassembler_.reset(new tp::TpReassembler(tpSettings_.reassembly));
+                }
+                tpRoutes_[keyOf(serviceId, instanceId, methodId)] = std::move(reassembled);
+                tpEnabled_.store(true, std::memory_order_release);
+            }
+
+            void SomeIpConnection::DisableTp(uint16_t serviceId, uint16_t instanceId, uint16_t methodId)
+            {
+                std::lock_guard<std::mutex> lock(tpMutex_);
+                tpRoutes_.erase(keyOf(serviceId, instanceId, methodId));
+            }
+
+            tp::TpStatistics SomeIpConnection::GetTpStatistics() const
+            {
+                std::lock_guard<std::mutex> lock(tpMutex_);
+                return reassembler_ ? reassembler_->GetStatistics() : tp::TpStatistics();
+            }
+
+            bool SomeIpConnection::tpRouteOf(uint16_t serviceId, uint16_t instanceId, uint16_t methodId, TpReassembledHandler *reassembled) const
+            {
+                if (!tpEnabled_.load(std::memory_order_acquire))
+                {
+                    return false;
+                }
+                std::lock_guard<std::mutex> lock(tpMutex_);
+                auto found = tpRoutes_.find(keyOf(serviceId, instanceId, methodId));
+                if (found == tpRoutes_.end())
+                {
+                    return false;
+                }
+                if (reassembled != nullptr)
+                {
+                    *reassembled = found->second;
+                }
+                return true;
+            }
+
+            void SomeIpConnection::sendSegmented(Application &application, const std::shared_ptr<Message> &message)
+            {
+                const std::shared_ptr<vsomeip::payload> payload = message->get_payload();
+                const std::vector<uint8_t> data(payload->get_data(), payload->get_data() + payload->get_length());
+                size_t maxSegmentLength;
+                {
+                    std::lock_guard<std::mutex> lock(tpMutex_);
+                    maxSegmentLength = tpSettings_.maxSegmentLength;
+                }
+                // vsomeip 不给带 TP 标志的请求分配 session 这里代它写入 全部分段共用 应答沿用请求的 client 和 session
+                if (roleOf(*message) == HandlerRole::kServer)
+                {
+                    message->set_client(application.app->get_client());
+                    message->set_session(nextTpSession());
+                }
+                const vsomeip::message_type_e type = withTpFlag(message->get_message_type());
+                tp::SegmentPayload(data.data(), data.size(), maxSegmentLength, [&](const uint8_t *tpHeader, const uint8_t *segment, size_t length)
+                                   {
+                                       std::shared_ptr<Message> part = copyHeader(*message);
+                                       part->set_message_type(type);
+                                       part->get_payload()->set_data(segmentBytes(tpHeader, segment, length));
+                                       application.app->send(part);
+                                       return true; });
+            }
+
+            void SomeIpConnection::notifySegmented(Application &application, uint16_t serviceId, uint16_t instanceId, uint16_t eventId,
+                                                   const std::vector<uint8_t> &data)
+            {
+                size_t maxSegmentLength;
+                {
+                    std::lock_guard<std::mutex> lock(tpMutex_);
+                    maxSegmentLength = tpSettings_.maxSegmentLength;
+                }
+                // notify 每次都由 vsomeip 重新编号 session 分段改为自己填头部的通知消息 经 send 交给订阅者
+                std::shared_ptr<Message> notification = vsomeip::runtime::get()->create_notification(false);
+                notification->set_service(serviceId);
+                notification->set_instance(instanceId);
+                notification->set_method(eventId);
+                notification->set_session(nextTpSession());
+                notification->set_message_type(withTpFlag(vsomeip::message_type_e::MT_NOTIFICATION));
+                tp::SegmentPayload(data.data(), data.size(), maxSegmentLength, [&](const uint8_t *tpHeader, const uint8_t *segment, size_t length)
+                                   {
+                                       std::shared_ptr<Message> part = copyHeader(*notification);
+                                       part->get_payload()->set_data(segmentBytes(tpHeader, segment, length));
+                                       application.app->send(part);
+                                       return true; });
+            }
+
+            uint16_t SomeIpConnection::nextTpSession()
+            {
+                // session 0 表示不使用 session 在 1..0xFFFF 内循环
+                const uint32_t n = tpSession_.fetch_add(1, std::memory_order_relaxed);
+                return static_cast<uint16_t>(n % 0xFFFFU + 1U);
+            }
+
+            bool SomeIpConnection::reassemble(const std::shared_ptr<Message> &message, size_t &delivered)
+            {
+                TpReassembledHandler reassembled;
+                const bool segmented = hasTpFlag(*message);
+                if (!tpRouteOf(message->get_service(), message->get_instance(), message->get_method(), &reassembled))
+                {
+                    // 没有按 TP 部署的 id 不接受分段
+                    return !segmented;
+                }
+                if (!segmented)
+                {
+                    return true;
+                }
+                const vsomeip::message_type_e type = withoutTpFlag(message->get_message_type());
+                // vsomeip 不提供发送端地址 用 instance id 填 source
+                const tp::TpMessageKey key{message->get_instance(), message->get_service(), message->get_method(), message->get_client(),
+                                           message->get_session(), message->get_interface_version(), static_cast<uint8_t>(type)};
+                std::shared_ptr<const tp::TpPayload> completed;
+                {
+                    std::lock_guard<std::mutex> lock(tpMutex_);
+                    const tp::TpReassembler::Clock::time_point now = tp::TpReassembler::Clock::now();
+                    reassembler_->Expire(now);
+                    const std::shared_ptr<vsomeip::payload> payload = message->get_payload();
+                    if (reassembler_->OnSegment(key, payload->get_data(), payload->get_length(), now, completed) != tp::TpSegmentResult::kComplete)
+                    {
+                        return false;
+                    }
+                }
+                if (reassembled)
+                {
+                    reassembled(completed);
+                    delivered = 1;
+                    return false;
+                }
+                message->set_message_type(type);
+                message->get_payload()->set_data(completed->data(), static_cast<vsomeip::length_t>(completed->size()));
+                return true;
+            }
+
+        } // namespace someip
+
+    } // namespace com
+
+} // namespace ara
@@ -0,0 +1,84 @@
+#include <vsomeip/vsomeip.hpp>
+
+#include "ara/com/someip/someip_connection.h"
+#include "ara/com/someip/someip_service_binding.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace someip
+        {
+            ara::core::Result<void> SomeIpServiceBinding::Offer()
+            {
+                if (offered_)
+                {
+                    return ara::core::Result<void>::FromValue();
+                }
+                SomeIpConnection &connection = SomeIpConnection::Instance();
+                ara::core::Result<void> acquired = connection.Acquire();
+                if (!acquired.HasValue())
+                {
+                    return acquired;
+                }
+                connection.OfferService(serviceId_, instanceId_);
+                offered_ = true;
+                return ara::core::Result<void>::FromValue();
+            }
+
+            void SomeIpServiceBinding::StopOffer()
+            {
+                if (!offered_)
+                {
+                    return;
+                }
+                offered_ = false;
+                SomeIpConnection &connection = SomeIpConnection::Instance();
+                connection.StopOfferService(serviceId_, instanceId_);
+                connection.Release();
+            }
+
+            ara::core::Result<void> SomeIpServiceBinding::OfferBatch(const std::vector<routing::IServiceBinding *> &sameKind)
+            {
+                std::vector<SomeIpServiceBinding *> bindings;
+                for (routing::IServiceBinding *binding : sameKind)
+                {
+                    SomeIpServiceBinding *someIp = dynamic_cast<SomeIpServiceBinding *>(binding);
+                    if (someIp == nullptr)
+                    {
+                        return routing::IServiceBinding::OfferBatch(sameKind);
+                    }
+                    if (!someIp->offered_)
+                    {
+                        bindings.push_back(someIp);
+                    }
+                }
+                SomeIpConnection &connection = SomeIpConnection::Instance();
+                std::vector<ServiceInstance> services;
+                for (size_t i = 0; i < bindings.size(); ++i)
+                {
+                    // 每个 binding 各持有一次连接 StopOffer 时各自释放
+                    ara::core::Result<void> acquired = connection.Acquire();
+                    if (!acquired.HasValue())
+                    {
+                        while (i-- > 0)
+                        {
+                            connection.Release();
+                        }
+                        return acquired;
+                    }
+                    services.push_back(ServiceInstance{bindings[i]->serviceId_, bindings[i]->instanceId_});
+                }
+                connection.OfferServices(services);
+                for (SomeIpServiceBinding *binding : bindings)
+                {
+                    binding->offered_ = true;
+                }
+                return ara::core::Result<void>::FromValue();
+            }
+
+        } // namespace someip
+
+    } // namespace com
+
+} // namespace ara
@@ -0,0 +1,201 @@
+#include <vsomeip/vsomeip.hpp>
+
+#include "ara/com/com_error_domain.h"
+#include "ara/com/someip/someip_static_transport.h"
+#include "ara/com/utils/rcu.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace someip
+        {
+            namespace
+            {
+                /**
+                 * \brief 把 vsomeip 消息转成 InboundMessage 交给生成代码 context 指向消息本身 用于创建应答
+                 */
+                SomeIpDispatchTable<Message>::Handler inboundOf(codegen::InboundHandler handler, void *target)
+                {
+                    return [handler, target](const std::shared_ptr<Message> &message)
+                    {
+                        const std::shared_ptr<vsomeip::payload> payload = message->get_payload();
+                        codegen::InboundMessage inbound{message->get_method(),
+                                                        message->get_session(),
+                                                        message->get_message_type() == vsomeip::message_type_e::MT_ERROR,
+                                                        payload ? payload->get_data() : nullptr,
+                                                        payload ? static_cast<size_t>(payload->get_length()) : 0,
+                                                        &message};
+                        handler(target, inbound);
+                    };
+                }
+            } // namespace
+
+            SomeIpStaticTransport::SomeIpStaticTransport(SomeIpConnection &connection) : connection_(connection), nextListenId_(1)
+            {
+            }
+
+            SomeIpStaticTransport::~SomeIpStaticTransport()
+            {
+                std::unordered_map<uint64_t, Listening> listening;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    listening.swap(listening_);
+                }
+                for (const auto &entry : listening)
+                {
+                    release(entry.second);
+                }
+            }
+
+            uint64_t SomeIpStaticTransport::Listen(codegen::Role role, const codegen::Endpoint &endpoint, const uint16_t *ids, size_t count,
+                                                   codegen::InboundHandler handler, void *target)
+            {
+                Listening listening{role, endpoint, {}, std::vector<uint16_t>(ids, ids + count)};
+                if (role == codegen::Role::kServer)
+                {
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        ara::core::Result<HandlerId> registered =
+                            connection_.RegisterRequestHandler(endpoint.serviceId, endpoint.instanceId, ids[i], inboundOf(handler, target));
+                        if (!registered.HasValue())
+                        {
+                            connection_.UnregisterHandlers(listening.handlers);
+                            return codegen::kInvalidListenId;
+                        }
+                        listening.handlers.push_back(registered.Value());
+                    }
+                }
+                else
+                {
+                    std::vector<std::pair<uint16_t, SomeIpDispatchTable<Message>::Handler>> handlers;
+                    handlers.reserve(count);
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        handlers.emplace_back(ids[i], inboundOf(handler, target));
+                    }
+                    listening.handlers = connection_.RegisterResponseHandlers(endpoint.serviceId, endpoint.instanceId, std::move(handlers));
+                    connection_.RequestService(endpoint.serviceId, endpoint.instanceId);
+                }
+                std::lock_guard<std::mutex> lock(mutex_);
+                const uint64_t id = nextListenId_++;
+                listening_.emplace(id, std::move(listening));
+                return id;
+            }
+
+            void SomeIpStaticTransport::Unlisten(uint64_t listenId)
+            {
+                Listening listening;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    auto found = listening_.find(listenId);
+                    if (found == listening_.end())
+                    {
+                        return;
+                    }
+                    listening = std::move(found->second);
+                    listening_.erase(found);
+                }
+                release(listening);
+            }
+
+            void SomeIpStaticTransport::release(const Listening &listening)
+            {
+                connection_.UnregisterHandlers(listening.handlers);
+                // 分发在 RCU 读区里执行 等正在进行的分发结束 返回后生成代码的对象可以析构
+                ara::com::utils::RcuDomain::Instance().Synchronize();
+                if (listening.role == codegen::Role::kClient)
+                {
+                    connection_.ReleaseService(listening.endpoint.serviceId, listening.endpoint.instanceId);
+                }
+            }
+
+            std::vector<EventSubscription> SomeIpStaticTransport::subscriptionsOf(const codegen::EventAddress *events, size_t count)
+            {
+                std::vector<EventSubscription> subscriptions;
+                subscriptions.reserve(count);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    subscriptions.push_back(EventSubscription{events[i].eventgroupId, events[i].eventId});
+                }
+                return subscriptions;
+            }
+
+            void SomeIpStaticTransport::OfferService(const codegen::Endpoint &endpoint, const codegen::EventAddress *events, size_t count)
+            {
+                connection_.OfferEvents(endpoint.serviceId, endpoint.instanceId, subscriptionsOf(events, count));
+                connection_.OfferService(endpoint.serviceId, endpoint.instanceId);
+            }
+
+            void SomeIpStaticTransport::StopOfferService(const codegen::Endpoint &endpoint, const codegen::EventAddress *events, size_t count)
+            {
+                connection_.StopOfferService(endpoint.serviceId, endpoint.instanceId);
+                connection_.StopOfferEvents(endpoint.serviceId, endpoint.instanceId, subscriptionsOf(events, count));
+            }
+
+            void SomeIpStaticTransport::Subscribe(const codegen::Endpoint &endpoint, const codegen::EventAddress *events, size_t count)
+            {
+                connection_.SubscribeEvents(endpoint.serviceId, endpoint.instanceId, subscriptionsOf(events, count));
+            }
+
+            void SomeIpStaticTransport::Unsubscribe(const codegen::Endpoint &endpoint, const codegen::EventAddress *events, size_t count)
+            {
+                connection_.UnsubscribeEvents(endpoint.serviceId, endpoint.instanceId, subscriptionsOf(events, count));
+            }
+
+            HandlerId SomeIpStaticTransport::responseHandlerOf(uint64_t listenId, uint16_t methodId)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                auto found = listening_.find(listenId);
+                if (found == listening_.end() || found->second.role != codegen::Role::kClient)
+                {
+                    return kInvalidHandlerId;
+                }
+                const Listening &listening = found->second;
+                for (size_t i = 0; i < listening.ids.size() && i < listening.handlers.size(); ++i)
+                {
+                    if (listening.ids[i] == methodId)
+                    {
+                        return listening.handlers[i];
+                    }
+                }
+                return kInvalidHandlerId;
+            }
+
+            ara::core::Result<void> SomeIpStaticTransport::sendRequest(uint64_t listenId, const codegen::Endpoint &endpoint, uint16_t methodId,
+                                                                       uint16_t session, bool expectResponse, std::vector<uint8_t> data)
+            {
+                std::shared_ptr<Message> request = connection_.CreateRequest(endpoint.serviceId, endpoint.instanceId, methodId, true);
+                request->set_session(session);
+                request->get_payload()->set_data(std::move(data));
+                if (!expectResponse)
+                {
+                    request->set_message_type(vsomeip::message_type_e::MT_REQUEST_NO_RETURN);
+                    return connection_.Send(request);
+                }
+                const HandlerId handler = responseHandlerOf(listenId, methodId);
+                if (handler == kInvalidHandlerId)
+                {
+                    return ara::core::Result<void>::FromError(MakeErrorCode(ComErrc::kServiceNotAvailable, 0));
+                }
+                return connection_.SendRequest(request, handler);
+            }
+
+            ara::core::Result<void> SomeIpStaticTransport::sendResponse(const codegen::InboundMessage &request, bool ok, std::vector<uint8_t> data)
+            {
+                const std::shared_ptr<Message> &origin = *static_cast<const std::shared_ptr<Message> *>(request.context);
+                std::shared_ptr<Message> response = connection_.CreateResponse(origin);
+                if (!ok)
+                {
+                    response->set_message_type(vsomeip::message_type_e::MT_ERROR);
+                    response->set_return_code(vsomeip::return_code_e::E_NOT_OK);
+                }
+                response->get_payload()->set_data(std::move(data));
+                return connection_.Send(response);
+            }
+
+        } // namespace someip
+
+    } // namespace com
+
+} // namespace ara
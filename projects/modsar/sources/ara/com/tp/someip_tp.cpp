@@ -0,0 +1,56 @@
+#include "ara/com/tp/someip_tp.h"
+#include "ara/com/serialization/byte_order.hpp"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace tp
+        {
+            bool ParseTpHeader(const uint8_t *data, size_t length, TpHeader &header)
+            {
+                if (length < kTpHeaderSize)
+                {
+                    return false;
+                }
+                const uint32_t word = serialization::LoadBigEndian<uint32_t>(data);
+                header.offset = word & 0xFFFFFFF0U;
+                header.moreSegments = (word & 0x1U) != 0;
+                return true;
+            }
+
+            void WriteTpHeader(const TpHeader &header, uint8_t *out)
+            {
+                const uint32_t word = (header.offset & 0xFFFFFFF0U) | (header.moreSegments ? 0x1U : 0x0U);
+                serialization::StoreBigEndian(word, out);
+            }
+
+            size_t SegmentPayload(const uint8_t *payload, size_t length, size_t maxSegmentLength, const TpSegmentCallback &callback)
+            {
+                size_t segmentLength = maxSegmentLength / kTpAlignment * kTpAlignment;
+                if (segmentLength == 0)
+                {
+                    segmentLength = kTpAlignment;
+                }
+                size_t count = 0;
+                size_t offset = 0;
+                do
+                {
+                    const size_t chunk = (length - offset > segmentLength) ? segmentLength : length - offset;
+                    uint8_t header[kTpHeaderSize];
+                    WriteTpHeader(TpHeader{static_cast<uint32_t>(offset), offset + chunk < length}, header);
+                    if (!callback(header, payload + offset, chunk))
+                    {
+                        return 0;
+                    }
+                    offset += chunk;
+                    ++count;
+                } while (offset < length);
+                return count;
+            }
+
+        } // namespace tp
+
+    } // namespace com
+
+} // namespace ara
@@ -0,0 +1,250 @@
+#include <algorithm>
+#include <cstring>
+
+#include "ara/com/tp/tp_reassembler.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace tp
+        {
+            constexpr size_t TpReassembler::kMaxIntervals;
+
+            TpReassembler::TpReassembler(const TpReassemblerConfig &config)
+                : config_(config), reassemblies_(config.maxPending)
+            {
+                for (const TpSizeClass &sizeClass : config_.sizeClasses)
+                {
+                    pools_.emplace_back(new rpc::ChunkPool(sizeClass.bufferSize, sizeClass.count));
+                }
+            }
+
+            TpSegmentResult TpReassembler::OnSegment(const TpMessageKey &key, const uint8_t *segment, size_t length, Clock::time_point now,
+                                                     std::shared_ptr<const TpPayload> &completed)
+            {
+                TpHeader header;
+                if (!ParseTpHeader(segment, length, header))
+                {
+                    ++statistics_.malformed;
+                    return TpSegmentResult::kDropped;
+                }
+                const uint8_t *data = segment + kTpHeaderSize;
+                const size_t dataLength = length - kTpHeaderSize;
+                const size_t begin = header.offset;
+                const size_t end = begin + dataLength;
+
+                Reassembly *reassembly = find(key);
+                if (reassembly != nullptr && now - reassembly->lastUpdate > config_.timeout)
+                {
+                    // 同一个 session 的旧消息没等到结束 按超时处理后重新开始
+                    ++statistics_.timedOut;
+                    drop(*reassembly);
+                    reassembly = nullptr;
+                }
+                // 中间分段必须是 16 的整数倍且不能为空
+                if (header.moreSegments && (dataLength == 0 || dataLength % kTpAlignment != 0))
+                {
+                    ++statistics_.malformed;
+                    if (reassembly != nullptr)
+                    {
+                        drop(*reassembly);
+                    }
+                    return TpSegmentResult::kDropped;
+                }
+                if (reassembly == nullptr)
+                {
+                    reassembly = start(key, now);
+                    if (reassembly == nullptr)
+                    {
+                        ++statistics_.poolExhausted;
+                        return TpSegmentResult::kDropped;
+                    }
+                }
+
+                // 总长度只能由最后一段确定一次 之后所有分段都不能越过它
+                bool consistent = true;
+                if (!header.moreSegments)
+                {
+                    consistent = reassembly->totalLength == 0 || reassembly->totalLength == end;
+                    reassembly->totalLength = end;
+                    if (reassembly->intervalCount != 0 && reassembly->intervals[reassembly->intervalCount - 1].end > end)
+                    {
+                        consistent = false;
+                    }
+                }
+                else if (reassembly->totalLength != 0 && end > reassembly->totalLength)
+                {
+                    consistent = false;
+                }
+                if (!consistent)
+                {
+                    ++statistics_.malformed;
+                    drop(*reassembly);
+                    return TpSegmentResult::kDropped;
+                }
+
+                if (!ensureCapacity(*reassembly, std::max(end, reassembly->totalLength)))
+                {
+                    ++statistics_.poolExhausted;
+                    drop(*reassembly);
+                    return TpSegmentResult::kDropped;
+                }
+                if (!addInterval(*reassembly, begin, end))
+                {
+                    ++statistics_.tooManyGaps;
+                    drop(*reassembly);
+                    return TpSegmentResult::kDropped;
+                }
+                std::memcpy(reassembly->buffer->data + begin, data, dataLength);
+                reassembly->buffer->length = std::max(reassembly->buffer->length, end);
+                reassembly->lastUpdate = now;
+
+                if (reassembly->totalLength == 0 || reassembly->intervalCount != 1 || reassembly->intervals[0].begin != 0 ||
+                    reassembly->intervals[0].end != reassembly->totalLength)
+                {
+                    return TpSegmentResult::kIncomplete;
+                }
+                reassembly->buffer->length = reassembly->totalLength;
+                completed = std::make_shared<const TpPayload>(std::move(reassembly->buffer));
+                reassembly->active = false;
+                ++statistics_.completed;
+                return TpSegmentResult::kComplete;
+            }
+
+            size_t TpReassembler::Expire(Clock::time_point now)
+            {
+                size_t expired = 0;
+                for (Reassembly &reassembly : reassemblies_)
+                {
+                    if (reassembly.active && now - reassembly.lastUpdate > config_.timeout)
+                    {
+                        drop(reassembly);
+                        ++expired;
+                    }
+                }
+                statistics_.timedOut += expired;
+                return expired;
+            }
+
+            size_t TpReassembler::Pending() const
+            {
+                return static_cast<size_t>(std::count_if(reassemblies_.begin(), reassemblies_.end(),
+                                                         [](const Reassembly &reassembly)
+                                                         { return reassembly.active; }));
+            }
+
+            TpReassembler::Reassembly *TpReassembler::find(const TpMessageKey &key)
+            {
+                for (Reassembly &reassembly : reassemblies_)
+                {
+                    if (reassembly.active && reassembly.key == key)
+                    {
+                        return &reassembly;
+                    }
+                }
+                return nullptr;
+            }
+
+            TpReassembler::Reassembly *TpReassembler::start(const TpMessageKey &key, Clock::time_point now)
+            {
+                for (Reassembly &reassembly : reassemblies_)
+                {
+                    if (!reassembly.active)
+                    {
+                        reassembly.active = true;
+                        reassembly.key = key;
+                        reassembly.intervalCount = 0;
+                        reassembly.totalLength = 0;
+                        reassembly.lastUpdate = now;
+                        return &reassembly;
+                    }
+                }
+                return nullptr;
+            }
+
+            bool TpReassembler::ensureCapacity(Reassembly &reassembly, size_t required)
+            {
+                if (reassembly.buffer && reassembly.buffer->capacity >= required)
+                {
+                    return true;
+                }
+                rpc::ChunkPtr larger = allocate(required);
+                if (!larger)
+                {
+                    return false;
+                }
+                if (reassembly.buffer)
+                {
+                    // 分级大小按倍数增长 换级时的拷贝总量不超过最终长度
+                    std::memcpy(larger->data, reassembly.buffer->data, reassembly.buffer->length);
+                    larger->length = reassembly.buffer->length;
+                    ++statistics_.resized;
+                }
+                reassembly.buffer = std::move(larger);
+                return true;
+            }
+
+            bool TpReassembler::addInterval(Reassembly &reassembly, size_t begin, size_t end)
+            {
+                Interval *intervals = reassembly.intervals;
+                size_t &count = reassembly.intervalCount;
+                // 区间按 begin 有序且互不相接 找到第一个可能与 [begin, end) 合并的区间
+                size_t first = 0;
+                while (first < count && intervals[first].end < begin)
+                {
+                    ++first;
+                }
+                size_t last = first;
+                while (last < count && intervals[last].begin <= end)
+                {
+                    begin = std::min(begin, intervals[last].begin);
+                    end = std::max(end, intervals[last].end);
+                    ++last;
+                }
+                if (first == last)
+                {
+                    // 不与任何区间相接 插入新区间
+                    if (count == kMaxIntervals)
+                    {
+                        return false;
+                    }
+                    std::move_backward(intervals + first, intervals + count, intervals + count + 1);
+                    ++count;
+                }
+                else
+                {
+                    std::move(intervals + last, intervals + count, intervals + first + 1);
+                    count -= last - first - 1;
+                }
+                intervals[first] = Interval{begin, end};
+                return true;
+            }
+
+            rpc::ChunkPtr TpReassembler::allocate(size_t required)
+            {
+                for (const std::unique_ptr<rpc::ChunkPool> &pool : pools_)
+                {
+                    if (pool->ChunkSize() >= required)
+                    {
+                        rpc::ChunkPtr chunk = pool->Allocate();
+                        if (chunk)
+                        {
+                            return chunk;
+                        }
+                    }
+                }
+                return rpc::ChunkPtr();
+            }
+
+            void TpReassembler::drop(Reassembly &reassembly)
+            {
+                reassembly.buffer.reset();
+                reassembly.active = false;
+            }
+
+        } // namespace tp
+
+    } // namespace com
+
+} // namespace ara
@@ -0,0 +1,168 @@
+#include <limits>
+
+#include "ara/com/trace/latency_histogram.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace trace
+        {
+            constexpr uint32_t LatencyHistogram::kSubBucketBits;
+            constexpr uint32_t LatencyHistogram::kHalfBucketCount;
+            constexpr uint32_t LatencyHistogram::kMaxValueBits;
+            constexpr uint64_t LatencyHistogram::kMaxValue;
+            constexpr size_t LatencyHistogram::kBucketCount;
+
+            namespace
+            {
+                /**
+                 * \brief 第一个累计计数达到 percentile 的桶
+                 */
+                uint64_t rankOf(uint64_t count, double percentile)
+                {
+                    if (percentile >= 100.0)
+                    {
+                        return count;
+                    }
+                    const uint64_t rank = static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(count) + 0.5);
+                    return rank == 0 ? 1 : rank;
+                }
+            } // namespace
+
+            LatencyHistogram::LatencyHistogram()
+                : count_(0), sum_(0), min_(std::numeric_limits<uint64_t>::max()), max_(0)
+            {
+                for (size_t i = 0; i < kBucketCount; ++i)
+                {
+                    buckets_[i].store(0, std::memory_order_relaxed);
+                }
+            }
+
+            void LatencyHistogram::Record(uint64_t valueNs)
+            {
+                if (valueNs > kMaxValue)
+                {
+                    valueNs = kMaxValue;
+                }
+                buckets_[BucketIndex(valueNs)].fetch_add(1, std::memory_order_relaxed);
+                sum_.fetch_add(valueNs, std::memory_order_relaxed);
+                uint64_t current = min_.load(std::memory_order_relaxed);
+                while (valueNs < current && !min_.compare_exchange_weak(current, valueNs, std::memory_order_relaxed))
+                {
+                }
+                current = max_.load(std::memory_order_relaxed);
+                while (valueNs > current && !max_.compare_exchange_weak(current, valueNs, std::memory_order_relaxed))
+                {
+                }
+                // count 最后递增 读端按 count 判断有没有数据
+                count_.fetch_add(1, std::memory_order_release);
+            }
+
+            void LatencyHistogram::Reset()
+            {
+                count_.store(0, std::memory_order_relaxed);
+                for (size_t i = 0; i < kBucketCount; ++i)
+                {
+                    buckets_[i].store(0, std::memory_order_relaxed);
+                }
+                sum_.store(0, std::memory_order_relaxed);
+                min_.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+                max_.store(0, std::memory_order_relaxed);
+            }
+
+            uint64_t LatencyHistogram::ValueAtPercentile(double percentile) const
+            {
+                uint64_t total = 0;
+                for (size_t i = 0; i < kBucketCount; ++i)
+                {
+                    total += buckets_[i].load(std::memory_order_relaxed);
+                }
+                if (total == 0)
+                {
+                    return 0;
+                }
+                const uint64_t rank = rankOf(total, percentile);
+                uint64_t seen = 0;
+                for (size_t i = 0; i < kBucketCount; ++i)
+                {
+                    seen += buckets_[i].load(std::memory_order_relaxed);
+                    if (seen >= rank)
+                    {
+                        const uint64_t upper = BucketUpperBound(i);
+                        const uint64_t max = max_.load(std::memory_order_relaxed);
+                        return upper < max ? upper : max;
+                    }
+                }
+                return max_.load(std::memory_order_relaxed);
+            }
+
+            LatencySummary LatencyHistogram::Summarize() const
+            {
+                LatencySummary summary;
+                if (count_.load(std::memory_order_acquire) == 0)
+                {
+                    return summary;
+                }
+                // 桶计数可能和 count 差几个 分位数以桶的合计为准
+                uint64_t counts[kBucketCount];
+                uint64_t total = 0;
+                for (size_t i = 0; i < kBucketCount; ++i)
+                {
+                    counts[i] = buckets_[i].load(std::memory_order_relaxed);
+                    total += counts[i];
+                }
+                if (total == 0)
+                {
+                    return summary;
+                }
+                summary.count = total;
+                summary.min = min_.load(std::memory_order_relaxed);
+                summary.max = max_.load(std::memory_order_relaxed);
+                summary.mean = sum_.load(std::memory_order_relaxed) / total;
+
+                const double percentiles[] = {50.0, 90.0, 99.0, 99.9};
+                uint64_t *outputs[] = {&summary.p50, &summary.p90, &summary.p99, &summary.p999};
+                size_t next = 0;
+                uint64_t seen = 0;
+                for (size_t i = 0; i < kBucketCount && next < 4; ++i)
+                {
+                    seen += counts[i];
+                    while (next < 4 && seen >= rankOf(total, percentiles[next]))
+                    {
+                        const uint64_t upper = BucketUpperBound(i);
+                        *outputs[next] = upper < summary.max ? upper : summary.max;
+                        ++next;
+                    }
+                }
+                return summary;
+            }
+
+            size_t LatencyHistogram::BucketIndex(uint64_t valueNs)
+            {
+                if (valueNs < 2 * kHalfBucketCount)
+                {
+                    return static_cast<size_t>(valueNs);
+                }
+                // 最高位为 msb 时桶宽为 2^shift 同一量级内有 kHalfBucketCount 个桶
+                const uint32_t msb = 63U - static_cast<uint32_t>(__builtin_clzll(valueNs));
+                const uint32_t shift = msb - (kSubBucketBits - 1);
+                return static_cast<size_t>(shift) * kHalfBucketCount + static_cast<size_t>(valueNs >> shift);
+            }
+
+            uint64_t LatencyHistogram::BucketUpperBound(size_t index)
+            {
+                if (index < 2 * kHalfBucketCount)
+                {
+                    return index;
+                }
+                const uint64_t shift = index / kHalfBucketCount - 1;
+                const uint64_t mantissa = index - shift * kHalfBucketCount;
+                return ((mantissa + 1) << shift) - 1;
+            }
+
+        } // namespace trace
+
+    } // namespace com
+
+} // namespace ara
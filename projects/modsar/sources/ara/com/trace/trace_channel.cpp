@@ -0,0 +1,170 @@
+#include "ara/com/trace/trace_channel.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace trace
+        {
+            namespace
+            {
+                uint64_t elapsed(uint64_t from, uint64_t to)
+                {
+                    // 跨主机时钟有偏差时可能为负 记为 0
+                    return to > from ? to - from : 0;
+                }
+            } // namespace
+
+            ChannelStats::ChannelStats()
+                : ready(0), reserved(0), descriptor(), sent(0), received(0), untraced(0), gaps(0), reordered(0), duplicates(0),
+                  restarts(0)
+            {
+            }
+
+            TraceStatistics Summarize(const ChannelStats &stats)
+            {
+                TraceStatistics statistics;
+                statistics.descriptor = stats.descriptor;
+                statistics.sent = stats.sent.load(std::memory_order_relaxed);
+                statistics.received = stats.received.load(std::memory_order_relaxed);
+                statistics.untraced = stats.untraced.load(std::memory_order_relaxed);
+                statistics.gaps = stats.gaps.load(std::memory_order_relaxed);
+                statistics.reordered = stats.reordered.load(std::memory_order_relaxed);
+                statistics.duplicates = stats.duplicates.load(std::memory_order_relaxed);
+                statistics.restarts = stats.restarts.load(std::memory_order_relaxed);
+                statistics.serialize = stats.serialize.Summarize();
+                statistics.transport = stats.transport.Summarize();
+                statistics.queue = stats.queue.Summarize();
+                statistics.handler = stats.handler.Summarize();
+                statistics.roundTrip = stats.roundTrip.Summarize();
+                return statistics;
+            }
+
+            TraceChannel::TraceChannel(ChannelStats &stats, TraceClock clock, std::shared_ptr<const void> owner)
+                : stats_(stats), clock_(clock), owner_(std::move(owner)), sequence_(0), lastSeen_(0)
+            {
+            }
+
+            TraceTrailer TraceChannel::Stamp(uint64_t serializeStartNs)
+            {
+                const TraceContext *upstream = GetCurrentTraceContext();
+                TraceTrailer trailer;
+                trailer.traceId = upstream != nullptr ? upstream->traceId : NewTraceId();
+                trailer.sendTimeNs = Now();
+                trailer.originTimeNs = 0;
+                trailer.sequence = sequence_.fetch_add(1, std::memory_order_relaxed) + 1;
+                trailer.senderId = LocalSenderId();
+                trailer.serializeNs = serializeStartNs != 0 ? static_cast<uint32_t>(elapsed(serializeStartNs, trailer.sendTimeNs)) : 0;
+                trailer.flags = clock_ == TraceClock::kRealtime ? kTraceFlagRealtime : 0;
+                trailer.version = kTraceVersion;
+                trailer.magic = kTraceMagic;
+                if (serializeStartNs != 0)
+                {
+                    stats_.serialize.Record(trailer.serializeNs);
+                }
+                stats_.sent.fetch_add(1, std::memory_order_relaxed);
+                return trailer;
+            }
+
+            TraceTrailer TraceChannel::StampResponse(const TraceContext &request, uint64_t serializeStartNs)
+            {
+                TraceTrailer trailer = Stamp(serializeStartNs);
+                trailer.traceId = request.traceId;
+                trailer.originTimeNs = request.originTimeNs;
+                trailer.sequence = request.sequence;
+                trailer.senderId = request.senderId;
+                return trailer;
+            }
+
+            size_t TraceChannel::Receive(const uint8_t *data, size_t length, bool traced, TraceContext &context)
+            {
+                const uint64_t now = Now();
+                context = TraceContext();
+                TraceTrailer trailer;
+                if (!traced || length < kTraceTrailerSize)
+                {
+                    stats_.untraced.fetch_add(1, std::memory_order_relaxed);
+                    return length;
+                }
+                if (!DecodeTrailer(data + length - kTraceTrailerSize, trailer))
+                {
+                    // 对端的追踪版本不同 body 仍然要去掉追踪信息才能反序列化
+                    stats_.untraced.fetch_add(1, std::memory_order_relaxed);
+                    return length - kTraceTrailerSize;
+                }
+                stats_.received.fetch_add(1, std::memory_order_relaxed);
+                const bool sameClock = ((trailer.flags & kTraceFlagRealtime) != 0) == (clock_ == TraceClock::kRealtime);
+                if (sameClock)
+                {
+                    stats_.transport.Record(elapsed(trailer.sendTimeNs, now));
+                }
+                if (stats_.descriptor.role == ChannelRole::kMethodClient)
+                {
+                    // originTimeNs 是本端发请求时的时间 不受对端时钟影响
+                    if (trailer.originTimeNs != 0)
+                    {
+                        stats_.roundTrip.Record(elapsed(trailer.originTimeNs, now));
+                    }
+                }
+                if (stats_.descriptor.role != ChannelRole::kMethodServer)
+                {
+                    // 服务端的请求来自多个客户端 序号没有可比性
+                    trackSequence(trailer.senderId, trailer.sequence);
+                }
+                context.traceId = trailer.traceId;
+                context.originTimeNs = trailer.sendTimeNs;
+                context.receiveTimeNs = now;
+                context.sequence = trailer.sequence;
+                context.senderId = trailer.senderId;
+                context.channel = this;
+                return length - kTraceTrailerSize;
+            }
+
+            void TraceChannel::RecordHandler(uint64_t queueNs, uint64_t handlerNs)
+            {
+                stats_.queue.Record(queueNs);
+                stats_.handler.Record(handlerNs);
+            }
+
+            void TraceChannel::trackSequence(uint32_t senderId, uint32_t sequence)
+            {
+                const uint64_t current = (static_cast<uint64_t>(senderId) << 32) | sequence;
+                uint64_t last = lastSeen_.load(std::memory_order_relaxed);
+                for (;;)
+                {
+                    if (last == 0 || static_cast<uint32_t>(last >> 32) != senderId)
+                    {
+                        const bool restarted = last != 0;
+                        if (lastSeen_.compare_exchange_weak(last, current, std::memory_order_relaxed))
+                        {
+                            if (restarted)
+                            {
+                                stats_.restarts.fetch_add(1, std::memory_order_relaxed);
+                            }
+                            return;
+                        }
+                        continue;
+                    }
+                    // 按 32 位回绕比较
+                    const int32_t delta = static_cast<int32_t>(sequence - static_cast<uint32_t>(last));
+                    if (delta <= 0)
+                    {
+                        (delta == 0 ? stats_.duplicates : stats_.reordered).fetch_add(1, std::memory_order_relaxed);
+                        return;
+                    }
+                    if (lastSeen_.compare_exchange_weak(last, current, std::memory_order_relaxed))
+                    {
+                        if (delta > 1)
+                        {
+                            stats_.gaps.fetch_add(static_cast<uint64_t>(delta - 1), std::memory_order_relaxed);
+                        }
+                        return;
+                    }
+                }
+            }
+
+        } // namespace trace
+
+    } // namespace com
+
+} // namespace ara
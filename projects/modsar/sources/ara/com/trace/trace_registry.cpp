@@ -0,0 +1,229 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+#include "ara/com/com_error_domain.h"
+#include "ara/com/trace/trace_registry.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace trace
+        {
+            namespace
+            {
+                std::mutex g_defaultMutex;
+                std::shared_ptr<TraceRegistry> g_defaultRegistry;
+
+                size_t headerSize()
+                {
+                    return (sizeof(TracePageHeader) + alignof(ChannelStats) - 1) / alignof(ChannelStats) * alignof(ChannelStats);
+                }
+
+                size_t pageSize(size_t capacity)
+                {
+                    return headerSize() + capacity * sizeof(ChannelStats);
+                }
+
+                ChannelStats *channelAt(void *page, size_t index)
+                {
+                    const TracePageHeader *header = static_cast<const TracePageHeader *>(page);
+                    return reinterpret_cast<ChannelStats *>(static_cast<uint8_t *>(page) + header->headerSize + index * header->channelSize);
+                }
+
+                void visitPage(void *page, const TraceStatisticsVisitor &visitor)
+                {
+                    const TracePageHeader *header = static_cast<const TracePageHeader *>(page);
+                    uint32_t count = header->count.load(std::memory_order_acquire);
+                    if (count > header->capacity)
+                    {
+                        count = header->capacity;
+                    }
+                    for (uint32_t i = 0; i < count; ++i)
+                    {
+                        const ChannelStats *stats = channelAt(page, i);
+                        if (stats->ready.load(std::memory_order_acquire) != 0)
+                        {
+                            visitor(Summarize(*stats));
+                        }
+                    }
+                }
+            } // namespace
+
+            ara::core::Result<std::shared_ptr<TraceRegistry>> TraceRegistry::Create(const TraceRegistryConfig &config)
+            {
+                using ResultType = ara::core::Result<std::shared_ptr<TraceRegistry>>;
+                const size_t size = pageSize(config.maxChannels);
+                void *page = MAP_FAILED;
+                if (config.pageName.empty())
+                {
+                    page = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                }
+                else
+                {
+                    const int fd = ::shm_open(config.pageName.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+                    if (fd < 0)
+                    {
+                        return ResultType::FromError(MakeErrorCode(ComErrc::kErroneousFileHandle, 0));
+                    }
+                    if (::ftruncate(fd, static_cast<off_t>(size)) == 0)
+                    {
+                        page = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                    }
+                    ::close(fd);
+                    if (page == MAP_FAILED)
+                    {
+                        ::shm_unlink(config.pageName.c_str());
+                    }
+                }
+                if (page == MAP_FAILED)
+                {
+                    return ResultType::FromError(MakeErrorCode(ComErrc::kErroneousFileHandle, 0));
+                }
+                // 读端先校验 magic 所以 magic 最后写入
+                TracePageHeader *header = new (page) TracePageHeader();
+                header->version = kTracePageVersion;
+                header->headerSize = static_cast<uint32_t>(headerSize());
+                header->channelSize = static_cast<uint32_t>(sizeof(ChannelStats));
+                header->capacity = static_cast<uint32_t>(config.maxChannels);
+                header->count.store(0, std::memory_order_relaxed);
+                header->pid = static_cast<uint32_t>(::getpid());
+                header->clock = config.clock;
+                std::atomic_thread_fence(std::memory_order_release);
+                std::memcpy(header->magic, kTracePageMagic, sizeof(kTracePageMagic));
+                return ResultType::FromValue(std::shared_ptr<TraceRegistry>(new TraceRegistry(config, page, size)));
+            }
+
+            TraceRegistry::TraceRegistry(const TraceRegistryConfig &config, void *page, size_t size)
+                : config_(config), page_(page), size_(size)
+            {
+            }
+
+            TraceRegistry::~TraceRegistry()
+            {
+                ::munmap(page_, size_);
+                if (!config_.pageName.empty())
+                {
+                    ::shm_unlink(config_.pageName.c_str());
+                }
+            }
+
+            std::shared_ptr<TraceChannel> TraceRegistry::CreateChannel(ChannelRole role, const std::string &name, uint16_t service,
+                                                                       uint16_t instance, uint16_t id)
+            {
+                TracePageHeader *header = static_cast<TracePageHeader *>(page_);
+                const uint32_t index = header->count.fetch_add(1, std::memory_order_relaxed);
+                if (index >= header->capacity)
+                {
+                    return nullptr;
+                }
+                ChannelStats *stats = new (channelAt(page_, index)) ChannelStats();
+                const size_t length = std::min(name.size(), sizeof(stats->descriptor.name) - 1);
+                std::memcpy(stats->descriptor.name, name.data(), length);
+                stats->descriptor.name[length] = '\0';
+                stats->descriptor.service = service;
+                stats->descriptor.instance = instance;
+                stats->descriptor.id = id;
+                stats->descriptor.role = role;
+                stats->ready.store(1, std::memory_order_release);
+                return std::make_shared<TraceChannel>(*stats, config_.clock, shared_from_this());
+            }
+
+            void TraceRegistry::ForEachChannel(const TraceStatisticsVisitor &visitor) const
+            {
+                visitPage(page_, visitor);
+            }
+
+            void SetDefaultTraceRegistry(std::shared_ptr<TraceRegistry> registry)
+            {
+                std::lock_guard<std::mutex> lock(g_defaultMutex);
+                g_defaultRegistry = std::move(registry);
+            }
+
+            std::shared_ptr<TraceRegistry> GetDefaultTraceRegistry()
+            {
+                std::lock_guard<std::mutex> lock(g_defaultMutex);
+                return g_defaultRegistry;
+            }
+
+            std::shared_ptr<TraceChannel> CreateTraceChannel(ChannelRole role, const std::string &name, uint16_t service,
+                                                             uint16_t instance, uint16_t id)
+            {
+                std::shared_ptr<TraceRegistry> registry = GetDefaultTraceRegistry();
+                return registry ? registry->CreateChannel(role, name, service, instance, id) : nullptr;
+            }
+
+            TraceStatsReader::TraceStatsReader(const std::string &pageName) : pageName_(pageName), page_(nullptr), size_(0)
+            {
+            }
+
+            TraceStatsReader::~TraceStatsReader()
+            {
+                if (page_ != nullptr)
+                {
+                    ::munmap(page_, size_);
+                }
+            }
+
+            ara::core::Result<void> TraceStatsReader::Open()
+            {
+                if (page_ != nullptr)
+                {
+                    ::munmap(page_, size_);
+                    page_ = nullptr;
+                }
+                const int fd = ::shm_open(pageName_.c_str(), O_RDONLY, 0);
+                if (fd < 0)
+                {
+                    return ara::core::Result<void>::FromError(MakeErrorCode(ComErrc::kErroneousFileHandle, 0));
+                }
+                struct stat status;
+                void *mapped = MAP_FAILED;
+                if (::fstat(fd, &status) == 0 && static_cast<size_t>(status.st_size) >= sizeof(TracePageHeader))
+                {
+                    mapped = ::mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_SHARED, fd, 0);
+                }
+                ::close(fd);
+                if (mapped == MAP_FAILED)
+                {
+                    return ara::core::Result<void>::FromError(MakeErrorCode(ComErrc::kErroneousFileHandle, 0));
+                }
+                const TracePageHeader *header = static_cast<const TracePageHeader *>(mapped);
+                const size_t size = static_cast<size_t>(status.st_size);
+                if (std::memcmp(header->magic, kTracePageMagic, sizeof(kTracePageMagic)) != 0 || header->version != kTracePageVersion ||
+                    header->channelSize != sizeof(ChannelStats) ||
+                    static_cast<size_t>(header->headerSize) + static_cast<size_t>(header->capacity) * header->channelSize > size)
+                {
+                    ::munmap(mapped, size);
+                    return ara::core::Result<void>::FromError(MakeErrorCode(ComErrc::kErroneousFileHandle, 0));
+                }
+                page_ = mapped;
+                size_ = size;
+                return ara::core::Result<void>::FromValue();
+            }
+
+            void TraceStatsReader::ForEachChannel(const TraceStatisticsVisitor &visitor) const
+            {
+                if (page_ != nullptr)
+                {
+                    visitPage(page_, visitor);
+                }
+            }
+
+            uint32_t TraceStatsReader::PublisherPid() const
+            {
+                return page_ != nullptr ? static_cast<const TracePageHeader *>(page_)->pid : 0;
+            }
+
+        } // namespace trace
+
+    } // namespace com
+
+} // namespace ara
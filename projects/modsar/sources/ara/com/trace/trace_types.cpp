@@ -0,0 +1,141 @@
+#include <time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+
+#include "ara/com/trace/trace_types.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace trace
+        {
+            namespace
+            {
+                thread_local const TraceContext *t_currentContext = nullptr;
+                std::atomic<uint32_t> g_nextTraceId{1};
+
+                void put64(uint8_t *out, uint64_t value)
+                {
+                    for (int i = 7; i >= 0; --i)
+                    {
+                        out[i] = static_cast<uint8_t>(value);
+                        value >>= 8;
+                    }
+                }
+
+                void put32(uint8_t *out, uint32_t value)
+                {
+                    for (int i = 3; i >= 0; --i)
+                    {
+                        out[i] = static_cast<uint8_t>(value);
+                        value >>= 8;
+                    }
+                }
+
+                uint64_t get64(const uint8_t *in)
+                {
+                    uint64_t value = 0;
+                    for (int i = 0; i < 8; ++i)
+                    {
+                        value = (value << 8) | in[i];
+                    }
+                    return value;
+                }
+
+                uint32_t get32(const uint8_t *in)
+                {
+                    uint32_t value = 0;
+                    for (int i = 0; i < 4; ++i)
+                    {
+                        value = (value << 8) | in[i];
+                    }
+                    return value;
+                }
+
+                uint32_t makeSenderId()
+                {
+                    // pid 和启动时间混合 同一 pid 重启后也能区分
+                    uint64_t seed = static_cast<uint64_t>(::getpid()) * 0x9E3779B97F4A7C15ULL ^
+                                    static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count());
+                    seed ^= seed >> 33;
+                    seed *= 0xFF51AFD7ED558CCDULL;
+                    seed ^= seed >> 33;
+                    const uint32_t id = static_cast<uint32_t>(seed);
+                    return id == 0 ? 1 : id;
+                }
+            } // namespace
+
+            void EncodeTrailer(const TraceTrailer &trailer, uint8_t *out)
+            {
+                put64(out, trailer.traceId);
+                put64(out + 8, trailer.sendTimeNs);
+                put64(out + 16, trailer.originTimeNs);
+                put32(out + 24, trailer.sequence);
+                put32(out + 28, trailer.senderId);
+                put32(out + 32, trailer.serializeNs);
+                out[36] = trailer.flags;
+                out[37] = kTraceVersion;
+                out[38] = static_cast<uint8_t>(kTraceMagic >> 8);
+                out[39] = static_cast<uint8_t>(kTraceMagic);
+            }
+
+            bool DecodeTrailer(const uint8_t *in, TraceTrailer &trailer)
+            {
+                const uint16_t magic = static_cast<uint16_t>((in[38] << 8) | in[39]);
+                if (magic != kTraceMagic || in[37] != kTraceVersion)
+                {
+                    return false;
+                }
+                trailer.traceId = get64(in);
+                trailer.sendTimeNs = get64(in + 8);
+                trailer.originTimeNs = get64(in + 16);
+                trailer.sequence = get32(in + 24);
+                trailer.senderId = get32(in + 28);
+                trailer.serializeNs = get32(in + 32);
+                trailer.flags = in[36];
+                trailer.version = in[37];
+                trailer.magic = magic;
+                return true;
+            }
+
+            uint64_t TraceClockNs(TraceClock clock)
+            {
+                struct timespec now;
+                ::clock_gettime(clock == TraceClock::kRealtime ? CLOCK_REALTIME : CLOCK_MONOTONIC, &now);
+                return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+            }
+
+            uint32_t LocalSenderId()
+            {
+                static const uint32_t senderId = makeSenderId();
+                return senderId;
+            }
+
+            uint64_t NewTraceId()
+            {
+                return (static_cast<uint64_t>(LocalSenderId()) << 32) | g_nextTraceId.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            const TraceContext *GetCurrentTraceContext()
+            {
+                return t_currentContext;
+            }
+
+            ScopedTraceContext::ScopedTraceContext(const TraceContext &context) : previous_(t_currentContext)
+            {
+                t_currentContext = &context;
+            }
+
+            ScopedTraceContext::~ScopedTraceContext()
+            {
+                t_currentContext = previous_;
+            }
+
+        } // namespace trace
+
+    } // namespace com
+
+} // namespace ara
@@ -0,0 +1,168 @@
+#include <cstdlib>
+#include <new>
+#include <thread>
+
+#include "ara/com/utils/rcu.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace utils
+        {
+            RcuDomain &RcuDomain::Instance()
+            {
+                // 不析构 其他线程退出时还会访问读者记录 C++14 的 new 不保证 64 字节对齐 放在对齐的静态存储里
+                alignas(RcuDomain) static unsigned char storage[sizeof(RcuDomain)];
+                static RcuDomain *domain = new (storage) RcuDomain();
+                return *domain;
+            }
+
+            RcuDomain::RcuDomain() : epoch_(1), readers_(nullptr)
+            {
+            }
+
+            RcuDomain::ThreadReader::~ThreadReader()
+            {
+                if (reader != nullptr)
+                {
+                    reader->depth = 0;
+                    reader->epoch.store(0, std::memory_order_seq_cst);
+                    reader->used.store(false, std::memory_order_release);
+                }
+            }
+
+            RcuDomain::Reader *RcuDomain::threadReader()
+            {
+                static thread_local ThreadReader holder;
+                if (holder.reader == nullptr)
+                {
+                    holder.reader = Instance().acquireReader();
+                }
+                return holder.reader;
+            }
+
+            RcuDomain::Reader *RcuDomain::acquireReader()
+            {
+                for (Reader *reader = readers_.load(std::memory_order_acquire); reader != nullptr; reader = reader->next)
+                {
+                    bool expected = false;
+                    if (!reader->used.load(std::memory_order_relaxed) &&
+                        reader->used.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                    {
+                        return reader;
+                    }
+                }
+                void *memory = nullptr;
+                if (posix_memalign(&memory, alignof(Reader), sizeof(Reader)) != 0)
+                {
+                    throw std::bad_alloc();
+                }
+                Reader *reader = new (memory) Reader();
+                reader->used.store(true, std::memory_order_relaxed);
+                reader->next = readers_.load(std::memory_order_relaxed);
+                while (!readers_.compare_exchange_weak(reader->next, reader, std::memory_order_release, std::memory_order_relaxed))
+                {
+                }
+                return reader;
+            }
+
+            RcuDomain::ReadGuard::ReadGuard() noexcept
+            {
+                Reader *reader = threadReader();
+                if (reader->depth++ == 0)
+                {
+                    // 写入 epoch 和之后读指针都是 seq_cst 写端看到 0 时读端一定读到新指针
+                    reader->epoch.store(Instance().epoch_.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+                }
+            }
+
+            RcuDomain::ReadGuard::~ReadGuard()
+            {
+                Reader *reader = threadReader();
+                if (--reader->depth == 0)
+                {
+                    reader->epoch.store(0, std::memory_order_release);
+                }
+            }
+
+            uint64_t RcuDomain::oldestReader() const
+            {
+                uint64_t oldest = UINT64_MAX;
+                for (Reader *reader = readers_.load(std::memory_order_acquire); reader != nullptr; reader = reader->next)
+                {
+                    const uint64_t epoch = reader->epoch.load(std::memory_order_seq_cst);
+                    if (epoch != 0 && epoch < oldest)
+                    {
+                        oldest = epoch;
+                    }
+                }
+                return oldest;
+            }
+
+            std::vector<std::function<void()>> RcuDomain::collect()
+            {
+                std::vector<std::function<void()>> ready;
+                const uint64_t oldest = oldestReader();
+                auto keep = retired_.begin();
+                for (auto entry = retired_.begin(); entry != retired_.end(); ++entry)
+                {
+                    if (entry->epoch <= oldest)
+                    {
+                        ready.push_back(std::move(entry->deleter));
+                    }
+                    else
+                    {
+                        *keep++ = std::move(*entry);
+                    }
+                }
+                retired_.erase(keep, retired_.end());
+                return ready;
+            }
+
+            void RcuDomain::Retire(std::function<void()> deleter)
+            {
+                // 指针已经换掉 之后进入读区的读者拿到的 epoch 不小于这个值
+                const uint64_t epoch = epoch_.fetch_add(1, std::memory_order_seq_cst) + 1;
+                std::vector<std::function<void()>> ready;
+                {
+                    std::lock_guard<std::mutex> lock(retiredMutex_);
+                    retired_.push_back(Retired{epoch, std::move(deleter)});
+                    ready = collect();
+                }
+                // 析构旧对象可能再次 Retire 不能持有锁
+                for (std::function<void()> &release : ready)
+                {
+                    release();
+                }
+            }
+
+            void RcuDomain::Synchronize()
+            {
+                const uint64_t epoch = epoch_.fetch_add(1, std::memory_order_seq_cst) + 1;
+                while (oldestReader() < epoch)
+                {
+                    std::this_thread::yield();
+                }
+                std::vector<std::function<void()>> ready;
+                {
+                    std::lock_guard<std::mutex> lock(retiredMutex_);
+                    ready = collect();
+                }
+                for (std::function<void()> &release : ready)
+                {
+                    release();
+                }
+            }
+
+            size_t RcuDomain::PendingCount() const
+            {
+                std::lock_guard<std::mutex> lock(retiredMutex_);
+                return retired_.size();
+            }
+
+        } // namespace utils
+
+    } // namespace com
+
+} // namespace ara
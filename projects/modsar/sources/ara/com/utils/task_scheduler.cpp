@@ -0,0 +1,99 @@
+#include "ara/com/utils/task_scheduler.h"
+
+namespace ara
+{
+    namespace com
+    {
+        namespace utils
+        {
+            TaskScheduler &TaskScheduler::Instance()
+            {
+                static TaskScheduler instance;
+                return instance;
+            }
+
+            TaskScheduler::TaskScheduler() : nextId_(1), stopping_(false)
+            {
+                thread_ = std::thread([this]
+                                      { run(); });
+            }
+
+            TaskScheduler::~TaskScheduler()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    stopping_ = true;
+                }
+                wakeup_.notify_one();
+                thread_.join();
+            }
+
+            uint64_t TaskScheduler::At(Clock::time_point deadline, Task task)
+            {
+                uint64_t id;
+                bool earliest;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    id = nextId_++;
+                    tasks_.emplace(TaskKey(deadline, id), std::move(task));
+                    index_.emplace(id, deadline);
+                    earliest = tasks_.begin()->first.second == id;
+                }
+                if (earliest)
+                {
+                    wakeup_.notify_one();
+                }
+                return id;
+            }
+
+            bool TaskScheduler::Cancel(uint64_t id)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                auto found = index_.find(id);
+                if (found == index_.end())
+                {
+                    return false;
+                }
+                tasks_.erase(TaskKey(found->second, id));
+                index_.erase(found);
+                return true;
+            }
+
+            size_t TaskScheduler::Pending() const
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return tasks_.size();
+            }
+
+            void TaskScheduler::run()
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                while (!stopping_)
+                {
+                    if (tasks_.empty())
+                    {
+                        wakeup_.wait(lock);
+                        continue;
+                    }
+                    auto first = tasks_.begin();
+                    // 等待期间这个任务可能被取消 不能引用 map 里的 deadline
+                    const Clock::time_point deadline = first->first.first;
+                    if (deadline > Clock::now())
+                    {
+                        wakeup_.wait_until(lock, deadline);
+                        continue;
+                    }
+                    Task task = std::move(first->second);
+                    index_.erase(first->first.second);
+                    tasks_.erase(first);
+                    lock.unlock();
+                    task();
+                    lock.lock();
+                }
+            }
+
+        } // namespace utils
+
+    } // namespace com
+
+} // namespace ara
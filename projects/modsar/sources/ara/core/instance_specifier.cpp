@@ -0,0 +1,43 @@
+#include "ara/core/instance_specifier.h"
+
+namespace ara
+{
+    namespace core
+    {
+        namespace
+        {
+            bool isLetter(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'); }
+
+            bool isDigit(char c) { return c >= '0' && c <= '9'; }
+        } // namespace
+
+        Result<InstanceSpecifier> InstanceSpecifier::Create(StringView metaModelIdentifier)
+        {
+            const char *data = metaModelIdentifier.data();
+            const int size = metaModelIdentifier.size();
+            if (size == 0)
+            {
+                return Result<InstanceSpecifier>::FromError(MakeErrorCode(CoreErrc::kInvalidMetaModelPath, 0));
+            }
+            int segmentStart = 0;
+            for (int i = 0; i <= size; ++i)
+            {
+                if (i == size || data[i] == '/')
+                {
+                    if (i == segmentStart)
+                    {
+                        return Result<InstanceSpecifier>::FromError(MakeErrorCode(CoreErrc::kInvalidMetaModelPath, 0));
+                    }
+                    segmentStart = i + 1;
+                }
+                else if (!(isLetter(data[i]) || (i != segmentStart && (isDigit(data[i]) || data[i] == '_'))))
+                {
+                    return Result<InstanceSpecifier>::FromError(MakeErrorCode(CoreErrc::kInvalidMetaModelShortname, 0));
+                }
+            }
+            return Result<InstanceSpecifier>::FromValue(InstanceSpecifier(Interned(), InternTable::Instance().Intern(metaModelIdentifier)));
+        }
+
+    } // namespace core
+
+} // namespace ara
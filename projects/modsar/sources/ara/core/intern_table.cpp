@@ -0,0 +1,91 @@
+#include <exception>
+
+#include "ara/core/intern_table.h"
+
+namespace ara
+{
+    namespace core
+    {
+        constexpr size_t InternTable::kChunkSize;
+        constexpr size_t InternTable::kMaxChunks;
+
+        InternTable &InternTable::Instance()
+        {
+            // 不析构 静态对象析构后仍可能有标识被比较或打印
+            static InternTable *table = new InternTable();
+            return *table;
+        }
+
+        InternTable::InternTable() : size_(0)
+        {
+            for (std::atomic<Chunk *> &chunk : chunks_)
+            {
+                chunk.store(nullptr, std::memory_order_relaxed);
+            }
+            // 序号 0 固定为空字符串 哈希也记为 0 使空字符串的句柄为 kEmptyInternHandle
+            Chunk *first = new Chunk();
+            (*first)[0] = new std::string();
+            chunks_[0].store(first, std::memory_order_relaxed);
+            handles_.emplace(Key{(*first)[0]->data(), 0, 0}, kEmptyInternHandle);
+            size_.store(1, std::memory_order_release);
+        }
+
+        uint32_t InternTable::hashOf(const char *data, size_t size) noexcept
+        {
+            // FNV-1a
+            uint32_t hash = 2166136261U;
+            for (size_t i = 0; i < size; ++i)
+            {
+                hash ^= static_cast<uint8_t>(data[i]);
+                hash *= 16777619U;
+            }
+            return hash;
+        }
+
+        InternHandle InternTable::Intern(StringView value)
+        {
+            const size_t length = static_cast<size_t>(value.size());
+            if (length == 0)
+            {
+                return kEmptyInternHandle;
+            }
+            const uint32_t hash = hashOf(value.data(), length);
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto found = handles_.find(Key{value.data(), length, hash});
+            if (found != handles_.end())
+            {
+                return found->second;
+            }
+            const uint32_t index = size_.load(std::memory_order_relaxed);
+            if (index / kChunkSize >= kMaxChunks)
+            {
+                std::terminate();
+            }
+            Chunk *chunk = chunks_[index / kChunkSize].load(std::memory_order_relaxed);
+            if (chunk == nullptr)
+            {
+                chunk = new Chunk();
+                chunks_[index / kChunkSize].store(chunk, std::memory_order_release);
+            }
+            const std::string *stored = new std::string(value.data(), length);
+            (*chunk)[index % kChunkSize] = stored;
+            const InternHandle handle = (static_cast<InternHandle>(hash) << 32) | index;
+            handles_.emplace(Key{stored->data(), length, hash}, handle);
+            size_.store(index + 1, std::memory_order_release);
+            return handle;
+        }
+
+        StringView InternTable::Lookup(InternHandle handle) const noexcept
+        {
+            const uint32_t index = IndexOf(handle);
+            if (index >= size_.load(std::memory_order_acquire))
+            {
+                return StringView();
+            }
+            const std::string *stored = (*chunks_[index / kChunkSize].load(std::memory_order_acquire))[index % kChunkSize];
+            return StringView(stored->data(), static_cast<int>(stored->size()));
+        }
+
+    } // namespace core
+
+} // namespace ara
@@ -0,0 +1,267 @@
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <thread>
+
+#include "ara/core/time_triggered_executor.h"
+
+namespace ara
+{
+    namespace core
+    {
+        namespace
+        {
+            int64_t monotonicNs()
+            {
+                struct timespec now;
+                ::clock_gettime(CLOCK_MONOTONIC, &now);
+                return static_cast<int64_t>(now.tv_sec) * 1000000000LL + now.tv_nsec;
+            }
+
+            /**
+             * \brief 睡到绝对时间 不受睡眠期间被信号打断影响
+             */
+            void sleepUntil(int64_t deadlineNs)
+            {
+                struct timespec deadline;
+                deadline.tv_sec = static_cast<time_t>(deadlineNs / 1000000000LL);
+                deadline.tv_nsec = static_cast<long>(deadlineNs % 1000000000LL);
+                while (::clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR)
+                {
+                }
+            }
+
+            void storeMax(std::atomic<uint64_t> &target, uint64_t value)
+            {
+                // 只有 activity 所在的线程写
+                if (value > target.load(std::memory_order_relaxed))
+                {
+                    target.store(value, std::memory_order_relaxed);
+                }
+            }
+        } // namespace
+
+        struct TimeTriggeredExecutor::ActivityState
+        {
+            ActivityState(const ActivityConfig &activityConfig, Activity function)
+                : config(activityConfig), activity(std::move(function)), releaseNs(0), runs(0), overruns(0), skipped(0),
+                  jitterSumNs(0), maxJitterNs(0), maxExecutionNs(0), lastExecutionNs(0), priorityApplied(false)
+            {
+            }
+
+            const ActivityConfig config;
+            const Activity activity;
+            int64_t releaseNs; // 下一次释放时间 只在所在线程访问
+            std::atomic<uint64_t> runs;
+            std::atomic<uint64_t> overruns;
+            std::atomic<uint64_t> skipped;
+            std::atomic<uint64_t> jitterSumNs;
+            std::atomic<uint64_t> maxJitterNs;
+            std::atomic<uint64_t> maxExecutionNs;
+            std::atomic<uint64_t> lastExecutionNs;
+            std::atomic<bool> priorityApplied;
+        };
+
+        struct TimeTriggeredExecutor::Lane
+        {
+            int cpu = -1;
+            int priority = 0;                       // 线程上 activity 的最高优先级
+            std::vector<ActivityState *> activities; // 按注册顺序
+            std::thread thread;
+        };
+
+        TimeTriggeredExecutor::TimeTriggeredExecutor() : running_(false)
+        {
+        }
+
+        TimeTriggeredExecutor::~TimeTriggeredExecutor()
+        {
+            Stop();
+        }
+
+        Result<size_t> TimeTriggeredExecutor::AddActivity(const ActivityConfig &config, Activity activity)
+        {
+            const int cpus = static_cast<int>(std::thread::hardware_concurrency());
+            if (IsRunning() || !activity || config.period.count() <= 0 || config.offset.count() < 0 || config.offset >= config.period ||
+                config.budget.count() < 0 || config.cpu < -1 || (cpus > 0 && config.cpu >= cpus) || config.priority < 0 ||
+                config.priority > 99)
+            {
+                return Result<size_t>::FromError(MakeErrorCode(CoreErrc::kInvalidArgument, 0));
+            }
+            activities_.emplace_back(new ActivityState(config, std::move(activity)));
+            return Result<size_t>::FromValue(activities_.size() - 1);
+        }
+
+        void TimeTriggeredExecutor::SetOverrunHandler(OverrunHandler handler)
+        {
+            overrunHandler_ = std::move(handler);
+        }
+
+        Result<void> TimeTriggeredExecutor::Start(std::chrono::nanoseconds startDelay)
+        {
+            std::lock_guard<std::mutex> lock(startMutex_);
+            if (IsRunning() || activities_.empty())
+            {
+                return Result<void>::FromError(MakeErrorCode(CoreErrc::kInvalidArgument, 0));
+            }
+            lanes_.clear();
+            for (const std::unique_ptr<ActivityState> &activity : activities_)
+            {
+                std::vector<std::unique_ptr<Lane>>::iterator lane =
+                    std::find_if(lanes_.begin(), lanes_.end(), [&activity](const std::unique_ptr<Lane> &existing)
+                                 { return existing->cpu == activity->config.cpu; });
+                if (lane == lanes_.end())
+                {
+                    lanes_.emplace_back(new Lane());
+                    lanes_.back()->cpu = activity->config.cpu;
+                    lane = lanes_.end() - 1;
+                }
+                (*lane)->activities.push_back(activity.get());
+                (*lane)->priority = std::max((*lane)->priority, activity->config.priority);
+            }
+
+            running_.store(true, std::memory_order_release);
+            const int64_t startNs = monotonicNs() + startDelay.count();
+            bool pinned = true;
+            for (const std::unique_ptr<Lane> &lane : lanes_)
+            {
+                Lane *current = lane.get();
+                current->thread = std::thread([this, current, startNs]
+                                              { runLane(*current, startNs); });
+                // 线程在 startNs 之前只是在睡眠 启动后再设置亲和性和优先级不影响第一个周期
+                if (current->cpu >= 0)
+                {
+                    cpu_set_t set;
+                    CPU_ZERO(&set);
+                    CPU_SET(current->cpu, &set);
+                    pinned = pinned && ::pthread_setaffinity_np(current->thread.native_handle(), sizeof(set), &set) == 0;
+                }
+                bool prioritySet = false;
+                if (current->priority > 0)
+                {
+                    struct sched_param param;
+                    param.sched_priority = current->priority;
+                    // 没有 CAP_SYS_NICE 时失败 保持默认调度继续运行
+                    prioritySet = ::pthread_setschedparam(current->thread.native_handle(), SCHED_FIFO, &param) == 0;
+                }
+                for (ActivityState *activity : current->activities)
+                {
+                    activity->priorityApplied.store(activity->config.priority == 0 || prioritySet, std::memory_order_relaxed);
+                }
+            }
+            if (!pinned)
+            {
+                running_.store(false, std::memory_order_release);
+                for (const std::unique_ptr<Lane> &lane : lanes_)
+                {
+                    lane->thread.join();
+                }
+                lanes_.clear();
+                return Result<void>::FromError(MakeErrorCode(CoreErrc::kInvalidArgument, 0));
+            }
+            return Result<void>::FromValue();
+        }
+
+        void TimeTriggeredExecutor::Stop()
+        {
+            std::lock_guard<std::mutex> lock(startMutex_);
+            running_.store(false, std::memory_order_release);
+            for (const std::unique_ptr<Lane> &lane : lanes_)
+            {
+                if (lane->thread.joinable())
+                {
+                    lane->thread.join();
+                }
+            }
+            lanes_.clear();
+        }
+
+        ActivityStatistics TimeTriggeredExecutor::GetStatistics(size_t id) const
+        {
+            ActivityStatistics statistics;
+            if (id >= activities_.size())
+            {
+                return statistics;
+            }
+            const ActivityState &activity = *activities_[id];
+            statistics.runs = activity.runs.load(std::memory_order_relaxed);
+            statistics.overruns = activity.overruns.load(std::memory_order_relaxed);
+            statistics.skipped = activity.skipped.load(std::memory_order_relaxed);
+            statistics.maxJitterNs = activity.maxJitterNs.load(std::memory_order_relaxed);
+            statistics.meanJitterNs = statistics.runs != 0 ? activity.jitterSumNs.load(std::memory_order_relaxed) / statistics.runs : 0;
+            statistics.maxExecutionNs = activity.maxExecutionNs.load(std::memory_order_relaxed);
+            statistics.lastExecutionNs = activity.lastExecutionNs.load(std::memory_order_relaxed);
+            statistics.priorityApplied = activity.priorityApplied.load(std::memory_order_relaxed);
+            return statistics;
+        }
+
+        void TimeTriggeredExecutor::runLane(Lane &lane, int64_t startNs)
+        {
+            for (ActivityState *activity : lane.activities)
+            {
+                activity->releaseNs = startNs + activity->config.offset.count();
+            }
+            while (running_.load(std::memory_order_acquire))
+            {
+                int64_t next = lane.activities.front()->releaseNs;
+                for (const ActivityState *activity : lane.activities)
+                {
+                    next = std::min(next, activity->releaseNs);
+                }
+                sleepUntil(next);
+                if (!running_.load(std::memory_order_acquire))
+                {
+                    break;
+                }
+                // 被前面 activity 拖延的释放留到下一轮 按释放时间先后执行
+                for (ActivityState *activity : lane.activities)
+                {
+                    if (activity->releaseNs <= next)
+                    {
+                        runActivity(*activity);
+                    }
+                }
+            }
+        }
+
+        void TimeTriggeredExecutor::runActivity(ActivityState &activity)
+        {
+            const int64_t release = activity.releaseNs;
+            const int64_t begin = monotonicNs();
+            activity.activity();
+            const int64_t end = monotonicNs();
+
+            const uint64_t jitter = static_cast<uint64_t>(std::max<int64_t>(begin - release, 0));
+            const uint64_t execution = static_cast<uint64_t>(end - begin);
+            activity.runs.fetch_add(1, std::memory_order_relaxed);
+            activity.jitterSumNs.fetch_add(jitter, std::memory_order_relaxed);
+            storeMax(activity.maxJitterNs, jitter);
+            storeMax(activity.maxExecutionNs, execution);
+            activity.lastExecutionNs.store(execution, std::memory_order_relaxed);
+
+            const int64_t period = activity.config.period.count();
+            const int64_t deadline = release + (activity.config.budget.count() > 0 ? activity.config.budget.count() : period);
+            if (end > deadline)
+            {
+                activity.overruns.fetch_add(1, std::memory_order_relaxed);
+                if (overrunHandler_)
+                {
+                    overrunHandler_(activity.config.name, std::chrono::nanoseconds(execution), std::chrono::nanoseconds(end - deadline));
+                }
+            }
+
+            activity.releaseNs = release + period;
+            if (activity.releaseNs <= end && activity.config.overrunPolicy == OverrunPolicy::kSkip)
+            {
+                const int64_t missed = (end - activity.releaseNs) / period + 1;
+                activity.skipped.fetch_add(static_cast<uint64_t>(missed), std::memory_order_relaxed);
+                activity.releaseNs += missed * period;
+            }
+        }
+
+    } // namespace core
+
+} // namespace ara
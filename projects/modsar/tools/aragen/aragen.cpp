@@ -0,0 +1,911 @@
+/**
+ * \copyright bcsc all rights reseverd
+ * \brief 由 IDL 生成静态的 proxy 和 skeleton 没有虚调用和 std::function
+ * \author ZYL
+ * \date 2026/10/18
+ *
+ * g++ -O2 -std=c++14 -o aragen aragen.cpp
+ * ./aragen helloworld.idl -o ../../codelabs/codegen
+ *
+ * 输入是 ARXML 里服务接口描述的一个子集 写成下面的文本格式 (完整语法见 Readme.md)
+ * \code
+ * package helloworld;
+ * struct HelloRequest { uint32 id; string name; }
+ * service Greeter
+ * {
+ *     id 0x1234;
+ *     version 1 0;
+ *     method SayHello 0x0001 (HelloRequest) returns (HelloReply);
+ *     fireandforget method Ping 0x0002 (uint32);
+ *     event Greeted 0x8001 group 0x0001 (HelloReply);
+ * }
+ * \endcode
+ * 每个 IDL 文件生成一个 <文件名>_service.hpp 包含
+ * - 结构体和 ARA_COM_SOMEIP_STRUCT 序列化描述
+ * - <Service>Service 编译期的方法和事件表
+ * - <Service>Proxy<Transport, Listener> 方法调用直接序列化后交给 transport
+ * - <Service>Skeleton<Derived, Transport> 按 method id switch 到派生类的成员函数
+ */
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct Token
+    {
+        enum Kind
+        {
+            kEnd,
+            kName,
+            kNumber,
+            kSymbol
+        };
+
+        Kind kind;
+        std::string text;
+        int line;
+    };
+
+    struct Field
+    {
+        std::string type; // C++ 类型
+        std::string name;
+    };
+
+    struct Struct
+    {
+        std::string name;
+        std::vector<Field> fields;
+    };
+
+    struct Method
+    {
+        std::string name;
+        uint32_t id;
+        bool fireAndForget;
+        std::string request;
+        std::string response;
+    };
+
+    struct Event
+    {
+        std::string name;
+        uint32_t id;
+        uint32_t eventgroupId;
+        std::string sample;
+    };
+
+    struct Service
+    {
+        std::string name;
+        uint32_t id = 0;
+        uint32_t majorVersion = 1;
+        uint32_t minorVersion = 0;
+        std::vector<Method> methods;
+        std::vector<Event> events;
+    };
+
+    struct Idl
+    {
+        std::vector<std::string> package;
+        std::vector<Struct> structs;
+        std::vector<Service> services;
+    };
+
+    /**
+     * \brief 出错时打印 文件:行: 信息 并退出
+     */
+    [[noreturn]] void fail(const std::string &file, int line, const std::string &message)
+    {
+        std::fprintf(stderr, "%s:%d: %s\n", file.c_str(), line, message.c_str());
+        std::exit(1);
+    }
+
+    std::vector<Token> tokenize(const std::string &file, const std::string &text)
+    {
+        std::vector<Token> tokens;
+        int line = 1;
+        size_t i = 0;
+        while (i < text.size())
+        {
+            const char c = text[i];
+            if (c == '\n')
+            {
+                ++line;
+                ++i;
+            }
+            else if (std::isspace(static_cast<unsigned char>(c)))
+            {
+                ++i;
+            }
+            else if (c == '/' && i + 1 < text.size() && text[i + 1] == '/')
+            {
+                while (i < text.size() && text[i] != '\n')
+                {
+                    ++i;
+                }
+            }
+            else if (c == '/' && i + 1 < text.size() && text[i + 1] == '*')
+            {
+                const size_t end = text.find("*/", i + 2);
+                if (end == std::string::npos)
+                {
+                    fail(file, line, "unterminated comment");
+                }
+                for (; i < end + 2; ++i)
+                {
+                    line += text[i] == '\n' ? 1 : 0;
+                }
+            }
+            else if (std::isalpha(static_cast<unsigned char>(c)) || c == '_')
+            {
+                const size_t begin = i;
+                while (i < text.size() && (std::isalnum(static_cast<unsigned char>(text[i])) || text[i] == '_'))
+                {
+                    ++i;
+                }
+                tokens.push_back(Token{Token::kName, text.substr(begin, i - begin), line});
+            }
+            else if (std::isdigit(static_cast<unsigned char>(c)))
+            {
+                const size_t begin = i;
+                while (i < text.size() && std::isalnum(static_cast<unsigned char>(text[i])))
+                {
+                    ++i;
+                }
+                tokens.push_back(Token{Token::kNumber, text.substr(begin, i - begin), line});
+            }
+            else if (std::string("{}()<>;,.").find(c) != std::string::npos)
+            {
+                tokens.push_back(Token{Token::kSymbol, std::string(1, c), line});
+                ++i;
+            }
+            else
+            {
+                fail(file, line, std::string("unexpected character '") + c + "'");
+            }
+        }
+        tokens.push_back(Token{Token::kEnd, "", line});
+        return tokens;
+    }
+
+    /**
+     * \brief 递归下降 结构体和服务只能引用前面已经声明的结构体
+     */
+    class Parser
+    {
+    public:
+        Parser(const std::string &file, std::vector<Token> tokens) : file_(file), tokens_(std::move(tokens)), next_(0) {}
+
+        Idl Parse()
+        {
+            Idl idl;
+            expectWord("package");
+            idl.package.push_back(name());
+            while (accept("."))
+            {
+                idl.package.push_back(name());
+            }
+            expect(";");
+            while (peek().kind != Token::kEnd)
+            {
+                if (acceptWord("struct"))
+                {
+                    idl.structs.push_back(parseStruct());
+                }
+                else if (acceptWord("service"))
+                {
+                    idl.services.push_back(parseService());
+                }
+                else
+                {
+                    fail(file_, peek().line, "expected 'struct' or 'service' but got '" + peek().text + "'");
+                }
+            }
+            return idl;
+        }
+
+    private:
+        const Token &peek() const { return tokens_[next_]; }
+
+        const Token &take() { return tokens_[next_ < tokens_.size() - 1 ? next_++ : next_]; }
+
+        bool accept(const std::string &symbol)
+        {
+            if (peek().kind == Token::kSymbol && peek().text == symbol)
+            {
+                ++next_;
+                return true;
+            }
+            return false;
+        }
+
+        bool acceptWord(const std::string &word)
+        {
+            if (peek().kind == Token::kName && peek().text == word)
+            {
+                ++next_;
+                return true;
+            }
+            return false;
+        }
+
+        void expect(const std::string &symbol)
+        {
+            if (!accept(symbol))
+            {
+                fail(file_, peek().line, "expected '" + symbol + "' but got '" + peek().text + "'");
+            }
+        }
+
+        void expectWord(const std::string &word)
+        {
+            if (!acceptWord(word))
+            {
+                fail(file_, peek().line, "expected '" + word + "' but got '" + peek().text + "'");
+            }
+        }
+
+        std::string name()
+        {
+            if (peek().kind != Token::kName)
+            {
+                fail(file_, peek().line, "expected a name but got '" + peek().text + "'");
+            }
+            return take().text;
+        }
+
+        uint32_t number(uint32_t max)
+        {
+            const Token &token = take();
+            char *end = nullptr;
+            const unsigned long value = std::strtoul(token.text.c_str(), &end, 0);
+            if (token.kind != Token::kNumber || *end != '\0' || value > max)
+            {
+                fail(file_, token.line, "expected a number up to " + std::to_string(max) + " but got '" + token.text + "'");
+            }
+            return static_cast<uint32_t>(value);
+        }
+
+        /**
+         * \brief IDL 类型转成 C++ 类型
+         */
+        std::string type()
+        {
+            static const std::map<std::string, std::string> primitives = {
+                {"bool", "bool"}, {"int8", "int8_t"}, {"int16", "int16_t"}, {"int32", "int32_t"}, {"int64", "int64_t"}, {"uint8", "uint8_t"}, {"uint16", "uint16_t"}, {"uint32", "uint32_t"}, {"uint64", "uint64_t"}, {"float32", "float"}, {"float64", "double"}, {"string", "std::string"}};
+            const int line = peek().line;
+            const std::string word = name();
+            auto primitive = primitives.find(word);
+            if (primitive != primitives.end())
+            {
+                return primitive->second;
+            }
+            if (word == "vector")
+            {
+                expect("<");
+                const std::string element = type();
+                expect(">");
+                return "std::vector<" + element + ">";
+            }
+            if (word == "array")
+            {
+                expect("<");
+                const std::string element = type();
+                expect(",");
+                const uint32_t size = number(0xFFFF);
+                expect(">");
+                return "std::array<" + element + ", " + std::to_string(size) + ">";
+            }
+            if (structs_.count(word) == 0)
+            {
+                fail(file_, line, "unknown type '" + word + "'");
+            }
+            return word;
+        }
+
+        void declare(const std::string &name, int line)
+        {
+            if (!names_.insert(name).second)
+            {
+                fail(file_, line, "'" + name + "' is already declared");
+            }
+        }
+
+        Struct parseStruct()
+        {
+            Struct result;
+            const int line = peek().line;
+            result.name = name();
+            declare(result.name, line);
+            expect("{");
+            std::set<std::string> fields;
+            while (!accept("}"))
+            {
+                Field field;
+                field.type = type();
+                const int fieldLine = peek().line;
+                field.name = name();
+                if (!fields.insert(field.name).second)
+                {
+                    fail(file_, fieldLine, "duplicate field '" + field.name + "'");
+                }
+                expect(";");
+                result.fields.push_back(field);
+            }
+            accept(";");
+            if (result.fields.empty())
+            {
+                fail(file_, line, "struct '" + result.name + "' has no fields");
+            }
+            structs_.insert(result.name);
+            return result;
+        }
+
+        std::string parameter()
+        {
+            expect("(");
+            const std::string result = type();
+            expect(")");
+            return result;
+        }
+
+        Service parseService()
+        {
+            Service service;
+            const int line = peek().line;
+            service.name = name();
+            declare(service.name, line);
+            expect("{");
+            std::set<std::string> members;
+            std::set<uint32_t> ids;
+            while (!accept("}"))
+            {
+                const int memberLine = peek().line;
+                if (acceptWord("id"))
+                {
+                    service.id = number(0xFFFE);
+                    expect(";");
+                    continue;
+                }
+                if (acceptWord("version"))
+                {
+                    service.majorVersion = number(0xFF);
+                    service.minorVersion = number(0xFFFFFFFF);
+                    expect(";");
+                    continue;
+                }
+                std::string member;
+                uint32_t id;
+                if (acceptWord("event"))
+                {
+                    Event event;
+                    event.name = member = name();
+                    event.id = id = number(0xFFFE);
+                    expectWord("group");
+                    event.eventgroupId = number(0xFFFE);
+                    event.sample = parameter();
+                    if (event.id < 0x8000)
+                    {
+                        fail(file_, memberLine, "event id of '" + event.name + "' must be in 0x8000..0xFFFE");
+                    }
+                    service.events.push_back(event);
+                }
+                else
+                {
+                    Method method;
+                    method.fireAndForget = acceptWord("fireandforget");
+                    expectWord("method");
+                    method.name = member = name();
+                    method.id = id = number(0x7FFF);
+                    method.request = parameter();
+                    if (!method.fireAndForget)
+                    {
+                        expectWord("returns");
+                        method.response = parameter();
+                    }
+                    service.methods.push_back(method);
+                }
+                expect(";");
+                if (!members.insert(member).second)
+                {
+                    fail(file_, memberLine, "duplicate member '" + member + "'");
+                }
+                if (!ids.insert(id).second)
+                {
+                    fail(file_, memberLine, "duplicate id of '" + member + "'");
+                }
+            }
+            accept(";");
+            if (service.id == 0)
+            {
+                fail(file_, line, "service '" + service.name + "' has no id");
+            }
+            return service;
+        }
+
+        const std::string file_;
+        const std::vector<Token> tokens_;
+        size_t next_;
+        std::set<std::string> names_;   // 已声明的结构体和服务
+        std::set<std::string> structs_; // 已声明的结构体
+    };
+
+    std::string hex(uint32_t value)
+    {
+        char text[16];
+        std::snprintf(text, sizeof(text), "0x%04X", value);
+        return text;
+    }
+
+    std::string lowerFirst(std::string text)
+    {
+        text[0] = static_cast<char>(std::tolower(static_cast<unsigned char>(text[0])));
+        return text;
+    }
+
+    /**
+     * \brief 按行输出 自动缩进 每层 4 个空格
+     */
+    class Writer
+    {
+    public:
+        Writer &Line(const std::string &text = std::string())
+        {
+            if (!text.empty() && (text[0] == '}' || text.compare(0, 7, "public:") == 0 || text.compare(0, 8, "private:") == 0))
+            {
+                --depth_;
+            }
+            // case 和 switch 的大括号对齐
+            const bool label = text.compare(0, 5, "case ") == 0 || text.compare(0, 8, "default:") == 0;
+            out_ << (text.empty() ? std::string() : std::string((depth_ - (label ? 1 : 0)) * 4, ' ') + text) << '\n';
+            if (!text.empty() && (text[0] == '{' || text.compare(0, 7, "public:") == 0 || text.compare(0, 8, "private:") == 0))
+            {
+                ++depth_;
+            }
+            return *this;
+        }
+
+        /**
+         * \brief head 里调用的第一个实参是 lambda 之前的参数 lambda 体换行后和它对齐
+         */
+        Writer &Call(const std::string &head, const std::string &body)
+        {
+            Line(head);
+            out_ << std::string(depth_ * 4 + head.find(">(") + 2, ' ') << body << '\n';
+            return *this;
+        }
+
+        std::string Text() const { return out_.str(); }
+
+    private:
+        std::ostringstream out_;
+        int depth_ = 0;
+    };
+
+    void emitStruct(Writer &w, const Struct &value)
+    {
+        w.Line("struct " + value.name).Line("{");
+        std::string members;
+        for (const Field &field : value.fields)
+        {
+            w.Line(field.type + " " + field.name + "{};");
+            members += ", &" + value.name + "::" + field.name;
+        }
+        w.Line("};").Line();
+        w.Line("ARA_COM_SOMEIP_STRUCT(" + value.name + members + ")").Line();
+    }
+
+    void emitDescriptor(Writer &w, const Service &service)
+    {
+        w.Line("/**");
+        w.Line(" * \\brief " + service.name + " 的编译期描述 service " + hex(service.id) + " 版本 " + std::to_string(service.majorVersion) + "." +
+               std::to_string(service.minorVersion));
+        w.Line(" */");
+        w.Line("struct " + service.name + "Service").Line("{");
+        w.Line("static constexpr uint16_t kServiceId = " + hex(service.id) + ";");
+        w.Line("static constexpr uint8_t kMajorVersion = " + std::to_string(service.majorVersion) + ";");
+        w.Line("static constexpr uint32_t kMinorVersion = " + std::to_string(service.minorVersion) + ";").Line();
+        std::string server, client, events, all;
+        for (const Method &method : service.methods)
+        {
+            if (method.fireAndForget)
+            {
+                w.Line("using " + method.name + " = ::ara::com::codegen::FireAndForget<" + hex(method.id) + ", " + method.request + ">;");
+            }
+            else
+            {
+                w.Line("using " + method.name + " = ::ara::com::codegen::Method<" + hex(method.id) + ", " + method.request + ", " + method.response + ">;");
+                client += (client.empty() ? "" : ", ") + method.name;
+            }
+            server += (server.empty() ? "" : ", ") + method.name;
+            all += (all.empty() ? "" : ", ") + method.name;
+        }
+        for (const Event &event : service.events)
+        {
+            w.Line("using " + event.name + " = ::ara::com::codegen::Event<" + hex(event.id) + ", " + hex(event.eventgroupId) + ", " + event.sample + ">;");
+            client += (client.empty() ? "" : ", ") + event.name;
+            events += (events.empty() ? "" : ", ") + event.name;
+            all += (all.empty() ? "" : ", ") + event.name;
+        }
+        w.Line();
+        w.Line("using ServerMessages = ::ara::com::codegen::IdList<" + server + ">; // skeleton 接收的请求");
+        w.Line("using ClientMessages = ::ara::com::codegen::IdList<" + client + ">; // proxy 接收的应答和事件");
+        w.Line("using Events = ::ara::com::codegen::EventList<" + events + ">;").Line();
+        w.Line("static_assert(::ara::com::codegen::IdList<" + all + ">::kDistinct, \"duplicate method or event id\");");
+        w.Line("};").Line();
+    }
+
+    void emitProxy(Writer &w, const Service &service)
+    {
+        const std::string proxy = service.name + "Proxy";
+        const std::string listener = service.name + "IgnoreEvents";
+        w.Line("/**");
+        w.Line(" * \\brief " + proxy + " 默认的事件接收者 丢弃全部事件");
+        w.Line(" */");
+        w.Line("struct " + listener).Line("{");
+        for (const Event &event : service.events)
+        {
+            w.Line("void On" + event.name + "(const " + event.sample + " &) {}");
+        }
+        w.Line("};").Line();
+
+        const bool calls = std::any_of(service.methods.begin(), service.methods.end(), [](const Method &method) { return !method.fireAndForget; });
+        w.Line("/**");
+        w.Line(" * \\brief " + service.name + " 的 proxy 方法调用直接序列化后交给 Transport");
+        w.Line(" *");
+        w.Line(" * 收到的应答按 method id switch 到对应方法的 CallSlotTable 事件交给 Listener 的 On<事件名>");
+        if (calls)
+        {
+            w.Line(" * 超过 SetCallTimeout 的时长仍未应答的调用以 kCommunicationLinkError 结束");
+        }
+        w.Line(" * Listener 的函数在 transport 的接收线程上执行");
+        w.Line(" */");
+        w.Line("template <typename Transport, typename Listener = " + listener + ">");
+        w.Line("class " + proxy).Line("{");
+        w.Line("public:");
+        w.Line("using Service = " + service.name + "Service;").Line();
+        w.Line("/**");
+        w.Line(" * \\brief 构造时注册应答和事件的接收 不订阅事件");
+        w.Line(" * \\param maxInFlight 每个方法的最大在途调用数");
+        w.Line(" */");
+        std::string initializers = ": transport_(transport), endpoint_{Service::kServiceId, instanceId}, listener_(std::move(listener))";
+        for (const Method &method : service.methods)
+        {
+            if (!method.fireAndForget)
+            {
+                initializers += ", " + lowerFirst(method.name) + "Calls_(std::make_shared<::ara::com::rpc::CallSlotTable<" + method.response +
+                                ">>(maxInFlight))";
+            }
+        }
+        if (calls)
+        {
+            initializers += ", callTimeout_(::ara::com::rpc::kDefaultCallTimeout)";
+        }
+        initializers += ", subscribed_(false)";
+        w.Line(proxy + "(Transport &transport, uint16_t instanceId, Listener listener = Listener(), size_t " + (calls ? "maxInFlight" : "/* maxInFlight */") + " = 64)");
+        w.Line("    " + initializers);
+        w.Line("{");
+        w.Line("listenId_ = transport_.Listen(::ara::com::codegen::Role::kClient, endpoint_, Service::ClientMessages::Ids().data(),");
+        w.Line("                              Service::ClientMessages::kSize, &" + proxy + "::onMessage, this);");
+        w.Line("}").Line();
+        w.Line("/**");
+        w.Line(" * \\brief 注销接收后 在途调用以 kServiceNotAvailable 结束");
+        w.Line(" */");
+        w.Line("~" + proxy + "()").Line("{");
+        if (!service.events.empty())
+        {
+            w.Line("Unsubscribe();");
+        }
+        w.Line("transport_.Unlisten(listenId_);");
+        w.Line("}").Line();
+        w.Line(proxy + "(const " + proxy + " &) = delete;");
+        w.Line(proxy + " &operator=(const " + proxy + " &) = delete;").Line();
+        for (const Method &method : service.methods)
+        {
+            if (method.fireAndForget)
+            {
+                w.Line("ara::core::Result<void> " + method.name + "(const " + method.request + " &request)").Line("{");
+                w.Line("return ::ara::com::codegen::Send<Service::" + method.name + ">(transport_, endpoint_, request);");
+            }
+            else
+            {
+                w.Line("ara::core::Future<" + method.response + "> " + method.name + "(const " + method.request + " &request)").Line("{");
+                w.Line("return ::ara::com::codegen::Call<Service::" + method.name + ">(transport_, listenId_, endpoint_, " + lowerFirst(method.name) +
+                       "Calls_, request, callTimeout_);");
+            }
+            w.Line("}").Line();
+        }
+        if (calls)
+        {
+            w.Line("/**");
+            w.Line(" * \\brief 之后发出的调用等待应答的时长 默认 ::ara::com::rpc::kDefaultCallTimeout");
+            w.Line(" */");
+            w.Line("void SetCallTimeout(std::chrono::milliseconds timeout) { callTimeout_ = timeout; }").Line();
+        }
+        if (!service.events.empty())
+        {
+            w.Line("void Subscribe()").Line("{");
+            w.Line("if (!subscribed_)").Line("{");
+            w.Line("transport_.Subscribe(endpoint_, Service::Events::Addresses().data(), Service::Events::kSize);");
+            w.Line("subscribed_ = true;");
+            w.Line("}");
+            w.Line("}").Line();
+            w.Line("void Unsubscribe()").Line("{");
+            w.Line("if (subscribed_)").Line("{");
+            w.Line("transport_.Unsubscribe(endpoint_, Service::Events::Addresses().data(), Service::Events::kSize);");
+            w.Line("subscribed_ = false;");
+            w.Line("}");
+            w.Line("}").Line();
+        }
+        w.Line("Listener &GetListener() { return listener_; }").Line();
+        w.Line("private:");
+        w.Line("static void onMessage(void *target, const ::ara::com::codegen::InboundMessage &message)").Line("{");
+        if (!calls && service.events.empty())
+        {
+            w.Line("static_cast<void>(target);").Line("static_cast<void>(message);");
+        }
+        else
+        {
+            w.Line(proxy + " &self = *static_cast<" + proxy + " *>(target);");
+            w.Line("switch (message.id)").Line("{");
+            for (const Method &method : service.methods)
+            {
+                if (!method.fireAndForget)
+                {
+                    w.Line("case Service::" + method.name + "::kId:");
+                    w.Line("::ara::com::codegen::Complete<Service::" + method.name + ">(*self." + lowerFirst(method.name) + "Calls_, message);");
+                    w.Line("break;");
+                }
+            }
+            for (const Event &event : service.events)
+            {
+                w.Line("case Service::" + event.name + "::kId:");
+                w.Call("::ara::com::codegen::Deliver<Service::" + event.name + ">(message, [&self](const " + event.sample + " &sample)",
+                       "{ self.listener_.On" + event.name + "(sample); });");
+                w.Line("break;");
+            }
+            w.Line("default:");
+            w.Line("break;");
+            w.Line("}");
+        }
+        w.Line("}").Line();
+        w.Line("Transport &transport_;");
+        w.Line("const ::ara::com::codegen::Endpoint endpoint_;");
+        w.Line("Listener listener_;");
+        for (const Method &method : service.methods)
+        {
+            if (!method.fireAndForget)
+            {
+                w.Line("std::shared_ptr<::ara::com::rpc::CallSlotTable<" + method.response + ">> " + lowerFirst(method.name) + "Calls_;");
+            }
+        }
+        if (calls)
+        {
+            w.Line("std::chrono::milliseconds callTimeout_;");
+        }
+        w.Line("bool subscribed_;");
+        w.Line("uint64_t listenId_;");
+        w.Line("};").Line();
+    }
+
+    void emitSkeleton(Writer &w, const Service &service)
+    {
+        const std::string skeleton = service.name + "Skeleton";
+        w.Line("/**");
+        w.Line(" * \\brief " + service.name + " 的 skeleton 派生类以 public 成员函数实现全部方法");
+        w.Line(" *");
+        for (const Method &method : service.methods)
+        {
+            if (method.fireAndForget)
+            {
+                w.Line(" * void " + method.name + "(const " + method.request + " &request);");
+            }
+            else
+            {
+                w.Line(" * ara::core::Result<" + method.response + "> " + method.name + "(const " + method.request + " &request);");
+            }
+        }
+        w.Line(" *");
+        w.Line(" * 请求按 method id switch 后直接调用派生类的函数 返回错误时发送错误应答");
+        w.Line(" * 派生类的析构函数里先调用 StopOfferService");
+        w.Line(" */");
+        w.Line("template <typename Derived, typename Transport>");
+        w.Line("class " + skeleton).Line("{");
+        w.Line("public:");
+        w.Line("using Service = " + service.name + "Service;").Line();
+        // 事件成员在 public 段 先于 transport_ 初始化
+        std::string initializers = ": ";
+        for (const Event &event : service.events)
+        {
+            initializers += event.name + "(transport, ::ara::com::codegen::Endpoint{Service::kServiceId, instanceId}), ";
+        }
+        initializers += "transport_(transport), endpoint_{Service::kServiceId, instanceId}, listenId_(::ara::com::codegen::kInvalidListenId)";
+        w.Line(skeleton + "(Transport &transport, uint16_t instanceId)");
+        w.Line("    " + initializers);
+        w.Line("{");
+        w.Line("}").Line();
+        w.Line("~" + skeleton + "()").Line("{");
+        w.Line("StopOfferService();");
+        w.Line("}").Line();
+        w.Line(skeleton + "(const " + skeleton + " &) = delete;");
+        w.Line(skeleton + " &operator=(const " + skeleton + " &) = delete;").Line();
+        w.Line("/**");
+        w.Line(" * \\return 同一实例的方法已被其他 skeleton 注册时返回 kCouldNotExecute");
+        w.Line(" */");
+        w.Line("ara::core::Result<void> OfferService()").Line("{");
+        w.Line("if (listenId_ == ::ara::com::codegen::kInvalidListenId)").Line("{");
+        w.Line("listenId_ = transport_.Listen(::ara::com::codegen::Role::kServer, endpoint_, Service::ServerMessages::Ids().data(),");
+        w.Line("                              Service::ServerMessages::kSize, &" + skeleton + "::onMessage, this);");
+        w.Line("if (listenId_ == ::ara::com::codegen::kInvalidListenId)").Line("{");
+        w.Line("return ara::core::Result<void>::FromError(::ara::com::MakeErrorCode(::ara::com::ComErrc::kCouldNotExecute, 0));");
+        w.Line("}");
+        w.Line("transport_.OfferService(endpoint_, Service::Events::Addresses().data(), Service::Events::kSize);");
+        w.Line("}");
+        w.Line("return ara::core::Result<void>::FromValue();");
+        w.Line("}").Line();
+        w.Line("void StopOfferService()").Line("{");
+        w.Line("if (listenId_ != ::ara::com::codegen::kInvalidListenId)").Line("{");
+        w.Line("transport_.StopOfferService(endpoint_, Service::Events::Addresses().data(), Service::Events::kSize);");
+        w.Line("transport_.Unlisten(listenId_);");
+        w.Line("listenId_ = ::ara::com::codegen::kInvalidListenId;");
+        w.Line("}");
+        w.Line("}").Line();
+        for (const Event &event : service.events)
+        {
+            w.Line("::ara::com::codegen::EventSender<Service::" + event.name + ", Transport> " + event.name + "; // " + event.name + ".Send(sample)");
+        }
+        if (!service.events.empty())
+        {
+            w.Line();
+        }
+        w.Line("private:");
+        const bool calls = std::any_of(service.methods.begin(), service.methods.end(), [](const Method &method) { return !method.fireAndForget; });
+        w.Line("static void onMessage(void *target, const ::ara::com::codegen::InboundMessage &message)").Line("{");
+        if (service.methods.empty())
+        {
+            w.Line("static_cast<void>(target);").Line("static_cast<void>(message);");
+        }
+        else
+        {
+            if (calls)
+            {
+                w.Line(skeleton + " &self = *static_cast<" + skeleton + " *>(target);");
+                w.Line("Derived &service = static_cast<Derived &>(self);");
+            }
+            else
+            {
+                w.Line("Derived &service = static_cast<Derived &>(*static_cast<" + skeleton + " *>(target));");
+            }
+            w.Line("switch (message.id)").Line("{");
+            for (const Method &method : service.methods)
+            {
+                w.Line("case Service::" + method.name + "::kId:");
+                if (method.fireAndForget)
+                {
+                    w.Call("::ara::com::codegen::Accept<Service::" + method.name + ">(message, [&service](const " + method.request + " &request)",
+                           "{ service." + method.name + "(request); });");
+                }
+                else
+                {
+                    w.Call("::ara::com::codegen::Serve<Service::" + method.name + ">(self.transport_, message, [&service](const " + method.request + " &request)",
+                           "{ return service." + method.name + "(request); });");
+                }
+                w.Line("break;");
+            }
+            w.Line("default:");
+            w.Line("break;");
+            w.Line("}");
+        }
+        w.Line("}").Line();
+        w.Line("Transport &transport_;");
+        w.Line("const ::ara::com::codegen::Endpoint endpoint_;");
+        w.Line("uint64_t listenId_;");
+        w.Line("};").Line();
+    }
+
+    std::string generate(const Idl &idl, const std::string &source, const std::string &output)
+    {
+        std::string guard = "_";
+        for (char c : output)
+        {
+            guard += std::isalnum(static_cast<unsigned char>(c)) ? static_cast<char>(std::toupper(static_cast<unsigned char>(c))) : '_';
+        }
+        guard += "_";
+        Writer w;
+        w.Line("/**");
+        w.Line(" * \\copyright bcsc all rights reseverd");
+        w.Line(" * \\brief 由 aragen 从 " + source + " 生成 不要手工修改");
+        w.Line(" * \\author aragen");
+        w.Line(" */");
+        w.Line("#ifndef " + guard).Line("#define " + guard).Line();
+        w.Line("#include <array>").Line("#include <chrono>").Line("#include <cstdint>").Line("#include <memory>").Line("#include <string>");
+        w.Line("#include <utility>").Line("#include <vector>").Line();
+        w.Line("#include \"ara/com/codegen/static_service.hpp\"").Line();
+        for (const std::string &part : idl.package)
+        {
+            w.Line("namespace " + part).Line("{");
+        }
+        for (const Struct &value : idl.structs)
+        {
+            emitStruct(w, value);
+        }
+        for (const Service &service : idl.services)
+        {
+            emitDescriptor(w, service);
+            emitProxy(w, service);
+            emitSkeleton(w, service);
+        }
+        for (auto part = idl.package.rbegin(); part != idl.package.rend(); ++part)
+        {
+            w.Line("} // namespace " + *part);
+        }
+        w.Line().Line("#endif // " + guard);
+        return w.Text();
+    }
+
+    std::string baseName(const std::string &path)
+    {
+        const size_t slash = path.find_last_of('/');
+        std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+        const size_t dot = name.find_last_of('.');
+        return dot == std::string::npos ? name : name.substr(0, dot);
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    std::string input;
+    std::string directory = ".";
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string argument = argv[i];
+        if (argument == "-o" && i + 1 < argc)
+        {
+            directory = argv[++i];
+        }
+        else if (input.empty() && argument[0] != '-')
+        {
+            input = argument;
+        }
+        else
+        {
+            input.clear();
+            break;
+        }
+    }
+    if (input.empty())
+    {
+        std::fprintf(stderr, "usage: %s <file.idl> [-o directory]\n", argv[0]);
+        return 1;
+    }
+    std::ifstream in(input);
+    if (!in)
+    {
+        std::fprintf(stderr, "cannot read %s\n", input.c_str());
+        return 1;
+    }
+    std::stringstream text;
+    text << in.rdbuf();
+    const Idl idl = Parser(input, tokenize(input, text.str())).Parse();
+    const std::string output = baseName(input) + "_service.hpp";
+    const std::string path = directory + "/" + output;
+    std::ofstream out(path);
+    out << generate(idl, baseName(input) + ".idl", output);
+    if (!out)
+    {
+        std::fprintf(stderr, "cannot write %s\n", path.c_str());
+        return 1;
+    }
+    std::printf("%s\n", path.c_str());
+    return 0;
+}